@@ -0,0 +1,35 @@
+#ifndef BENCH_SUPPORT_H
+#define BENCH_SUPPORT_H
+
+#include <stdint.h>
+#include <benchmark/benchmark.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_CYCLE_COUNTER 1
+#endif
+
+// Time-stamp counter, or 0 where none is available
+inline uint64_t benchCycleCount() {
+#ifdef BENCH_HAS_CYCLE_COUNTER
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+// Report ns/sample and (where available) cycles/sample for a benchmark that
+// processed samplesPerIteration samples per iteration.
+inline void reportPerSample(benchmark::State& state, uint64_t samplesPerIteration, uint64_t cycles) {
+  uint64_t samples = samplesPerIteration * state.iterations();
+  state.SetItemsProcessed(samples);
+  state.counters["ns/sample"] = benchmark::Counter((double)samples,
+      benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+#ifdef BENCH_HAS_CYCLE_COUNTER
+  state.counters["cycles/sample"] = (double)cycles / (double)samples;
+#else
+  (void)cycles;
+#endif
+}
+
+#endif // BENCH_SUPPORT_H
@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "DoorFleet.h"
+#include "DoorMonitor.h"
+#include "DoorTraceFixtures.h"
+#include "BenchSupport.h"
+
+// DoorFleet (structure of arrays) vs one DoorMonitor per door, 1 to 100k doors
+
+#define FLEET_BENCH_FRAMES 8
+
+// FLEET_BENCH_FRAMES ticks of input for every door, each door at a different
+// point of a shared random trace
+struct FleetFrames {
+  std::vector<float> y[FLEET_BENCH_FRAMES];
+  std::vector<float> z[FLEET_BENCH_FRAMES];
+  std::vector<uint8_t> valid[FLEET_BENCH_FRAMES];
+};
+
+static FleetFrames makeFrames(size_t doors) {
+  static const std::vector<TraceSample> trace = randomDoorTrace(400, 11);
+  FleetFrames frames;
+  for (int f = 0; f < FLEET_BENCH_FRAMES; f++) {
+    frames.y[f].resize(doors);
+    frames.z[f].resize(doors);
+    frames.valid[f].resize(doors);
+    for (size_t d = 0; d < doors; d++) {
+      const TraceSample& s = trace[(d * 37 + f) % trace.size()];
+      AccelData a = traceSampleToAccel(s);
+      frames.y[f][d] = a.y;
+      frames.z[f][d] = a.z;
+      frames.valid[f][d] = s.valid;
+    }
+  }
+  return frames;
+}
+
+static void BM_FleetUpdate(benchmark::State& state) {
+  size_t doors = (size_t)state.range(0);
+  FleetFrames frames = makeFrames(doors);
+  DoorFleet fleet(doors);
+  std::vector<FleetTransition> transitions(doors);
+  fleet.initializeAll(frames.y[0].data(), frames.z[0].data(), 1000);
+  unsigned long now = 1000;
+  uint64_t cycles = 0;
+
+  for (auto _ : state) {
+    int f = (int)((now / TRACE_PERIOD_MS) % FLEET_BENCH_FRAMES);
+    now += TRACE_PERIOD_MS;
+    uint64_t start = benchCycleCount();
+    benchmark::DoNotOptimize(fleet.update(frames.y[f].data(), frames.z[f].data(), frames.valid[f].data(),
+                                          now, transitions.data(), transitions.size()));
+    cycles += benchCycleCount() - start;
+  }
+  reportPerSample(state, doors, cycles);
+}
+
+static void BM_MonitorPerDoor(benchmark::State& state) {
+  size_t doors = (size_t)state.range(0);
+  FleetFrames frames = makeFrames(doors);
+  std::vector<DoorMonitor> monitors(doors);
+  for (size_t d = 0; d < doors; d++) {
+    monitors[d].initialize(frames.y[0][d], frames.z[0][d], 1000);
+  }
+  unsigned long now = 1000;
+  uint64_t cycles = 0;
+
+  for (auto _ : state) {
+    int f = (int)((now / TRACE_PERIOD_MS) % FLEET_BENCH_FRAMES);
+    now += TRACE_PERIOD_MS;
+    uint64_t start = benchCycleCount();
+    size_t transitions = 0;
+    for (size_t d = 0; d < doors; d++) {
+      AccelData a;
+      a.x = 0;
+      a.y = frames.y[f][d];
+      a.z = frames.z[f][d];
+      a.valid = frames.valid[f][d];
+      DoorState before = monitors[d].getState();
+      transitions += monitors[d].updateState(a, now) != before;
+    }
+    benchmark::DoNotOptimize(transitions);
+    cycles += benchCycleCount() - start;
+  }
+  reportPerSample(state, doors, cycles);
+}
+
+BENCHMARK(BM_FleetUpdate)->ArgName("doors")->RangeMultiplier(10)->Range(1, 100000);
+BENCHMARK(BM_MonitorPerDoor)->ArgName("doors")->RangeMultiplier(10)->Range(1, 100000);
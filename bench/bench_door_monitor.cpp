@@ -0,0 +1,229 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "DoorMonitorImpl.h"
+#include "DoorStaticConfig.h"
+#include "DoorSnapshot.h"
+#include "DoorTraceFixtures.h"
+#include "BenchSupport.h"
+
+// Per-sample cost of the DoorMonitor hot path under different workloads
+
+enum Workload {
+  WORKLOAD_STEADY,          // closed and at rest, low noise
+  WORKLOAD_MOVING,          // continuous open/close cycles
+  WORKLOAD_NOISY,           // at rest with vibration well above the threshold
+  WORKLOAD_SENSOR_FAILURE   // every read fails
+};
+
+static const char* const WORKLOAD_NAMES[] = {"steady", "moving", "noisy", "sensor_failure"};
+
+struct BenchTrace {
+  std::vector<AccelData> samples;
+  std::vector<unsigned long> times;
+};
+
+static BenchTrace makeTrace(Workload workload, unsigned long periodMs) {
+  static const TraceSegment steady[] = {{60000, 0, 0, 10, false}};
+  static const TraceSegment moving[] = {
+    {3000, 0, 90, 30, false}, {2000, 90, 90, 20, false},
+    {3000, 90, 0, 30, false}, {2000, 0, 0, 20, false}
+  };
+  static const TraceSegment noisy[] = {{60000, 0, 0, 400, false}};
+  static const TraceSegment failure[] = {{60000, 0, 0, 0, true}};
+
+  std::vector<TraceSample> raw;
+  switch (workload) {
+    case WORKLOAD_STEADY: raw = synthesizeTrace(steady, 1, periodMs, 7); break;
+    case WORKLOAD_MOVING:
+      for (int cycle = 0; cycle < 6; cycle++) {
+        std::vector<TraceSample> part = synthesizeTrace(moving, 4, periodMs, 7 + cycle);
+        unsigned long offset = raw.empty() ? 0 : raw.back().time + periodMs - part[0].time;
+        for (size_t i = 0; i < part.size(); i++) {
+          part[i].time += offset;
+          raw.push_back(part[i]);
+        }
+      }
+      break;
+    case WORKLOAD_NOISY: raw = synthesizeTrace(noisy, 1, periodMs, 7); break;
+    case WORKLOAD_SENSOR_FAILURE: raw = synthesizeTrace(failure, 1, periodMs, 7); break;
+  }
+
+  BenchTrace trace;
+  for (size_t i = 0; i < raw.size(); i++) {
+    trace.samples.push_back(traceSampleToAccel(raw[i]));
+    trace.times.push_back(raw[i].time);
+  }
+  return trace;
+}
+
+// ============================================================================
+// updateState: Arg(0) = workload, Arg(1) = sample period in ms
+// ============================================================================
+
+static void BM_UpdateState(benchmark::State& state) {
+  Workload workload = (Workload)state.range(0);
+  BenchTrace trace = makeTrace(workload, (unsigned long)state.range(1));
+  DoorMonitor monitor;
+  uint64_t cycles = 0;
+
+  for (auto _ : state) {
+    monitor.reset();
+    monitor.initialize(9.8f, 0.0f, trace.times[0]);
+    uint64_t start = benchCycleCount();
+    for (size_t i = 0; i < trace.samples.size(); i++) {
+      benchmark::DoNotOptimize(monitor.updateState(trace.samples[i], trace.times[i]));
+    }
+    cycles += benchCycleCount() - start;
+  }
+  state.SetLabel(WORKLOAD_NAMES[workload]);
+  reportPerSample(state, trace.samples.size(), cycles);
+}
+
+BENCHMARK(BM_UpdateState)
+  ->ArgNames({"workload", "period_ms"})
+  ->ArgsProduct({{WORKLOAD_STEADY, WORKLOAD_MOVING, WORKLOAD_NOISY, WORKLOAD_SENSOR_FAILURE}, {100}})
+  ->ArgsProduct({{WORKLOAD_MOVING}, {1, 10, 50}});
+
+// ============================================================================
+// Batch ingestion: Arg(0) = batch size
+// ============================================================================
+
+static void BM_UpdateStateBatch(benchmark::State& state) {
+  BenchTrace trace = makeTrace(WORKLOAD_MOVING, TRACE_PERIOD_MS);
+  size_t batch = (size_t)state.range(0);
+  std::vector<DoorTransition> transitions(batch);
+  DoorMonitor monitor;
+  uint64_t cycles = 0;
+
+  for (auto _ : state) {
+    monitor.reset();
+    monitor.initialize(9.8f, 0.0f, trace.times[0]);
+    uint64_t start = benchCycleCount();
+    for (size_t i = 0; i < trace.samples.size(); i += batch) {
+      size_t n = trace.samples.size() - i < batch ? trace.samples.size() - i : batch;
+      benchmark::DoNotOptimize(monitor.updateStateBatch(&trace.samples[i], &trace.times[i], n,
+                                                        transitions.data(), transitions.size()));
+    }
+    cycles += benchCycleCount() - start;
+  }
+  reportPerSample(state, trace.samples.size(), cycles);
+}
+
+BENCHMARK(BM_UpdateStateBatch)->ArgName("batch")->Arg(1)->Arg(8)->Arg(32)->Arg(64);
+
+// ============================================================================
+// Config source: runtime struct vs compile-time constants, on the moving
+// workload
+// ============================================================================
+
+struct BenchNoChecksConfig : public DefaultStaticConfig {
+  static constexpr unsigned long maxOpenTime = DOOR_CHECK_DISABLED;
+  static constexpr unsigned long maxCloseTime = DOOR_CHECK_DISABLED;
+  static constexpr unsigned long stallTimeout = DOOR_CHECK_DISABLED;
+};
+
+template <typename Monitor>
+static void BM_UpdateStateConfig(benchmark::State& state) {
+  BenchTrace trace = makeTrace(WORKLOAD_MOVING, TRACE_PERIOD_MS);
+  Monitor monitor;
+  uint64_t cycles = 0;
+
+  for (auto _ : state) {
+    monitor.reset();
+    monitor.initialize(9.8f, 0.0f, trace.times[0]);
+    uint64_t start = benchCycleCount();
+    for (size_t i = 0; i < trace.samples.size(); i++) {
+      benchmark::DoNotOptimize(monitor.updateState(trace.samples[i], trace.times[i]));
+    }
+    cycles += benchCycleCount() - start;
+  }
+  state.counters["bytes"] = (double)sizeof(Monitor);
+  reportPerSample(state, trace.samples.size(), cycles);
+}
+
+BENCHMARK_TEMPLATE(BM_UpdateStateConfig, DoorMonitor);
+BENCHMARK_TEMPLATE(BM_UpdateStateConfig, DoorMonitorT<float, DefaultStaticConfig>);
+BENCHMARK_TEMPLATE(BM_UpdateStateConfig, DoorMonitorT<float, BenchNoChecksConfig>);
+
+// ============================================================================
+// Warm restart snapshot: save + encode (after every batch on the device) and
+// decode + restore (once at boot)
+// ============================================================================
+
+static void BM_SnapshotSave(benchmark::State& state) {
+  DoorMonitor monitor;
+  monitor.setArrivalConfig(DEFAULT_ARRIVAL_CONFIG);
+  monitor.initialize(9.8f, 0.0f, 0);
+  DoorSnapshot snapshot;
+  uint8_t blob[DOOR_SNAPSHOT_SIZE];
+  unsigned long time = 0;
+
+  for (auto _ : state) {
+    monitor.saveSnapshot(snapshot, ++time);
+    encodeDoorSnapshot(snapshot, blob);
+    benchmark::DoNotOptimize(blob);
+  }
+  state.counters["bytes"] = DOOR_SNAPSHOT_SIZE;
+}
+
+BENCHMARK(BM_SnapshotSave);
+
+static void BM_SnapshotRestore(benchmark::State& state) {
+  DoorMonitor monitor;
+  monitor.initialize(9.8f, 0.0f, 0);
+  DoorSnapshot snapshot;
+  uint8_t blob[DOOR_SNAPSHOT_SIZE];
+  monitor.saveSnapshot(snapshot, 1000);
+  encodeDoorSnapshot(snapshot, blob);
+
+  for (auto _ : state) {
+    bool ok = decodeDoorSnapshot(blob, sizeof(blob), snapshot) && monitor.restoreSnapshot(snapshot, 50);
+    benchmark::DoNotOptimize(ok);
+  }
+}
+
+BENCHMARK(BM_SnapshotRestore);
+
+// ============================================================================
+// Static helpers
+// ============================================================================
+
+static void BM_IsInClosedPosition(benchmark::State& state) {
+  BenchTrace trace = makeTrace(WORKLOAD_MOVING, TRACE_PERIOD_MS);
+  const DoorMonitorConfig& c = DEFAULT_CONFIG;
+  uint64_t cycles = 0;
+
+  for (auto _ : state) {
+    uint64_t start = benchCycleCount();
+    size_t closed = 0;
+    for (size_t i = 0; i < trace.samples.size(); i++) {
+      closed += DoorMonitor::isInClosedPosition(trace.samples[i].y, trace.samples[i].z,
+                                                c.closedPositionY, c.closedPositionZ, c.positionTolerance);
+    }
+    benchmark::DoNotOptimize(closed);
+    cycles += benchCycleCount() - start;
+  }
+  reportPerSample(state, trace.samples.size(), cycles);
+}
+
+BENCHMARK(BM_IsInClosedPosition);
+
+static void BM_DetermineDirection(benchmark::State& state) {
+  BenchTrace trace = makeTrace(WORKLOAD_MOVING, TRACE_PERIOD_MS);
+  uint64_t cycles = 0;
+
+  for (auto _ : state) {
+    uint64_t start = benchCycleCount();
+    size_t opening = 0;
+    for (size_t i = 1; i < trace.samples.size(); i++) {
+      opening += DoorMonitor::determineDirection(trace.samples[i].y, trace.samples[i - 1].y,
+                                                 trace.samples[i].z, trace.samples[i - 1].z,
+                                                 DEFAULT_CONFIG.accelThreshold) == DOOR_OPENING;
+    }
+    benchmark::DoNotOptimize(opening);
+    cycles += benchCycleCount() - start;
+  }
+  reportPerSample(state, trace.samples.size() - 1, cycles);
+}
+
+BENCHMARK(BM_DetermineDirection);
@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+#include <math.h>
+#include <vector>
+#include "DoorPositionEstimator.h"
+#include "DoorMonitor.h"
+#include "DoorTraceFixtures.h"
+#include "BenchSupport.h"
+
+// DoorPositionEstimator: cost per sample on top of DoorMonitor, and how far
+// the arrival estimate is off over a run of identical cycles.
+
+static const TraceSegment POSITION_BENCH_CYCLE[] = {
+  {3000, 0, 0, 20, false},
+  {3000, 0, 90, 30, false},
+  {4000, 90, 90, 20, false},
+  {3000, 90, 0, 30, false},
+  {4000, 0, 0, 20, false}
+};
+#define POSITION_BENCH_SEGMENTS (sizeof(POSITION_BENCH_CYCLE) / sizeof(POSITION_BENCH_CYCLE[0]))
+#define POSITION_BENCH_CYCLES 8
+
+static std::vector<TraceSample> benchPositionTrace(uint32_t seed) {
+  std::vector<TraceSegment> segments;
+  for (size_t c = 0; c < POSITION_BENCH_CYCLES; c++) {
+    segments.insert(segments.end(), POSITION_BENCH_CYCLE, POSITION_BENCH_CYCLE + POSITION_BENCH_SEGMENTS);
+  }
+  return synthesizeTrace(segments.data(), segments.size(), TRACE_PERIOD_MS, seed);
+}
+
+// ============================================================================
+// Per-sample cost
+// ============================================================================
+
+static void BM_DoorPositionUpdate(benchmark::State& state) {
+  std::vector<TraceSample> trace = benchPositionTrace(1);
+  std::vector<AccelData> samples;
+  for (size_t i = 0; i < trace.size(); i++) {
+    samples.push_back(traceSampleToAccel(trace[i]));
+  }
+  DoorPositionEstimator position;
+  uint64_t cycles = 0;
+
+  for (auto _ : state) {
+    position.reset();
+    uint64_t start = benchCycleCount();
+    for (size_t i = 0; i < samples.size(); i++) {
+      position.update(samples[i], trace[i].time);
+    }
+    cycles += benchCycleCount() - start;
+    benchmark::DoNotOptimize(position.getPosition());
+  }
+  reportPerSample(state, samples.size(), cycles);
+}
+BENCHMARK(BM_DoorPositionUpdate);
+
+// ============================================================================
+// Arrival estimate error against the end of each synthesized travel. The
+// first opening and closing go by velocity alone (reported separately: the
+// low-passed velocity lags the start, so early estimates run long)
+// ============================================================================
+
+static void BM_DoorPositionEta(benchmark::State& state) {
+  double totalError = 0;
+  double worstError = 0;
+  size_t estimates = 0;
+  double velocityError = 0;
+  size_t velocityEstimates = 0;
+  for (auto _ : state) {
+    totalError = worstError = velocityError = 0;
+    estimates = velocityEstimates = 0;
+    for (uint32_t seed = 1; seed <= 4; seed++) {
+      std::vector<TraceSample> trace = benchPositionTrace(seed);
+      DoorMonitor monitor;
+      DoorPositionEstimator position;
+      monitor.addTransitionListener(DoorPositionEstimator::transitionListener, &position);
+      monitor.initialize(traceSampleToAccel(trace[0]).y, traceSampleToAccel(trace[0]).z, trace[0].time);
+
+      // Travels: segments 1 and 3 of each cycle
+      std::vector<unsigned long> travelStarts;
+      std::vector<unsigned long> travelEnds;
+      unsigned long time = 1000;
+      for (size_t c = 0; c < POSITION_BENCH_CYCLES; c++) {
+        for (size_t s = 0; s < POSITION_BENCH_SEGMENTS; s++) {
+          if (s == 1 || s == 3) travelStarts.push_back(time);
+          time += POSITION_BENCH_CYCLE[s].durationMs;
+          if (s == 1 || s == 3) travelEnds.push_back(time);
+        }
+      }
+
+      size_t next = 0;
+      for (size_t i = 0; i < trace.size(); i++) {
+        AccelData a = traceSampleToAccel(trace[i]);
+        monitor.updateState(a, trace[i].time);
+        position.update(a, trace[i].time);
+        while (next < travelEnds.size() && trace[i].time >= travelEnds[next]) next++;
+        unsigned long remaining;
+        // Only while the door really travels; the monitor reports movement
+        // for a stop timeout longer
+        if (next < travelEnds.size() && trace[i].time >= travelStarts[next] &&
+            position.estimateArrival(remaining)) {
+          double error = fabs((double)remaining - (double)(travelEnds[next] - trace[i].time));
+          if (next < 2) {
+            velocityError += error;
+            velocityEstimates++;
+          } else {
+            totalError += error;
+            worstError = error > worstError ? error : worstError;
+            estimates++;
+          }
+        }
+      }
+      benchmark::DoNotOptimize(position.getTravelTime(DOOR_OPENING));
+    }
+  }
+  state.counters["estimates"] = (double)estimates;
+  state.counters["mean_err_ms"] = estimates ? totalError / (double)estimates : 0;
+  state.counters["worst_err_ms"] = worstError;
+  state.counters["velocity_err_ms"] = velocityEstimates ? velocityError / (double)velocityEstimates : 0;
+}
+BENCHMARK(BM_DoorPositionEta);
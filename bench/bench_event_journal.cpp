@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include <stdlib.h>
+#include <string>
+#include "EventJournal.h"
+#include "FileJournalStorage.h"
+
+// EventJournal on the file backend: record encoding, appends with and
+// without batching (storage writes per record), and streaming reads
+
+#define JOURNAL_BENCH_SEGMENTS 4
+#define JOURNAL_BENCH_SEGMENT_SIZE 4096
+
+static std::string benchJournalPrefix() {
+  const char* dir = getenv("TMPDIR");
+  return std::string(dir ? dir : "/tmp") + "/bench_event_journal.";
+}
+
+// Door cycle with realistic gaps: opening, open for minutes, closing, closed for hours
+static void nextTransition(size_t i, DoorState& state, unsigned long& time) {
+  static const DoorState cycle[] = {DOOR_OPENING, DOOR_OPEN, DOOR_CLOSING, DOOR_CLOSED};
+  static const unsigned long gaps[] = {3600000, 12000, 300000, 12000};
+  state = cycle[i % 4];
+  time += gaps[i % 4];
+}
+
+static void BM_JournalEncode(benchmark::State& state) {
+  uint8_t out[JOURNAL_MAX_RECORD_SIZE];
+  DoorState door = DOOR_CLOSED;
+  unsigned long time = 0;
+  size_t bytes = 0;
+  size_t i = 0;
+  for (auto _ : state) {
+    unsigned long previous = time;
+    nextTransition(i++, door, time);
+    bytes += encodeJournalRecord((uint8_t)door, (uint32_t)(time - previous), out);
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["bytes/record"] = (double)bytes / (double)state.iterations();
+}
+BENCHMARK(BM_JournalEncode);
+
+// range(0): 1 = flush after every record (unbatched), 0 = buffered
+static void BM_JournalAppend(benchmark::State& state) {
+  bool flushEach = state.range(0) != 0;
+  FileJournalStorage storage(benchJournalPrefix());
+  storage.removeAll(JOURNAL_BENCH_SEGMENTS);
+  EventJournal journal(storage, JOURNAL_BENCH_SEGMENTS, JOURNAL_BENCH_SEGMENT_SIZE);
+  journal.begin(0);
+  uint32_t writesBefore = journal.getWriteCount();
+
+  DoorState door = DOOR_CLOSED;
+  unsigned long time = 0;
+  size_t i = 0;
+  for (auto _ : state) {
+    nextTransition(i++, door, time);
+    journal.append(door, time);
+    if (flushEach) {
+      journal.flush();
+    }
+  }
+  journal.flush();
+  state.SetItemsProcessed(state.iterations());
+  state.counters["writes/record"] = (double)(journal.getWriteCount() - writesBefore) / (double)state.iterations();
+  storage.removeAll(JOURNAL_BENCH_SEGMENTS);
+}
+BENCHMARK(BM_JournalAppend)->ArgName("flush_each")->Arg(0)->Arg(1);
+
+static void BM_JournalReadAll(benchmark::State& state) {
+  FileJournalStorage storage(benchJournalPrefix());
+  storage.removeAll(JOURNAL_BENCH_SEGMENTS);
+  {
+    EventJournal journal(storage, JOURNAL_BENCH_SEGMENTS, JOURNAL_BENCH_SEGMENT_SIZE);
+    journal.begin(0);
+    DoorState door = DOOR_CLOSED;
+    unsigned long time = 0;
+    for (size_t i = 0; i < 20000; i++) {
+      nextTransition(i, door, time);
+      journal.append(door, time);
+    }
+    journal.flush();
+  }
+
+  size_t entries = 0;
+  for (auto _ : state) {
+    JournalReader reader(storage, JOURNAL_BENCH_SEGMENTS);
+    JournalEntry entry;
+    while (reader.next(entry)) {
+      entries++;
+    }
+  }
+  state.SetItemsProcessed(entries);
+  state.counters["entries"] = (double)entries / (double)state.iterations();
+  storage.removeAll(JOURNAL_BENCH_SEGMENTS);
+}
+BENCHMARK(BM_JournalReadAll);
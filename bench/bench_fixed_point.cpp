@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "DoorMonitor.h"
+#include "DoorTraceFixtures.h"
+#include "BenchSupport.h"
+
+// Float vs fixed-point DoorMonitorT over the same raw-count trace
+
+template <typename Scalar>
+static std::vector<AccelDataT<Scalar> > convertTrace(const std::vector<TraceSample>& trace);
+
+template <>
+std::vector<AccelData> convertTrace<float>(const std::vector<TraceSample>& trace) {
+  std::vector<AccelData> out(trace.size());
+  for (size_t i = 0; i < trace.size(); i++) {
+    out[i] = traceSampleToAccel(trace[i]);
+  }
+  return out;
+}
+
+template <>
+std::vector<AccelDataT<int16_t> > convertTrace<int16_t>(const std::vector<TraceSample>& trace) {
+  std::vector<AccelDataT<int16_t> > out(trace.size());
+  for (size_t i = 0; i < trace.size(); i++) {
+    out[i].x = trace[i].x;
+    out[i].y = trace[i].y;
+    out[i].z = trace[i].z;
+    out[i].valid = trace[i].valid;
+  }
+  return out;
+}
+
+template <>
+std::vector<AccelDataT<int32_t> > convertTrace<int32_t>(const std::vector<TraceSample>& trace) {
+  std::vector<AccelDataT<int32_t> > out(trace.size());
+  for (size_t i = 0; i < trace.size(); i++) {
+    out[i].x = (int32_t)trace[i].x << 8;
+    out[i].y = (int32_t)trace[i].y << 8;
+    out[i].z = (int32_t)trace[i].z << 8;
+    out[i].valid = trace[i].valid;
+  }
+  return out;
+}
+
+template <typename Scalar>
+static void BM_UpdateStateScalar(benchmark::State& state) {
+  std::vector<TraceSample> trace = randomDoorTrace(500, 42);
+  std::vector<AccelDataT<Scalar> > samples = convertTrace<Scalar>(trace);
+  DoorMonitorT<Scalar> monitor(quantizeConfig<Scalar>(DEFAULT_CONFIG));
+  uint64_t cycles = 0;
+
+  for (auto _ : state) {
+    monitor.reset();
+    monitor.initialize(samples[0].y, samples[0].z, trace[0].time);
+    uint64_t start = benchCycleCount();
+    for (size_t i = 0; i < samples.size(); i++) {
+      benchmark::DoNotOptimize(monitor.updateState(samples[i], trace[i].time));
+    }
+    cycles += benchCycleCount() - start;
+  }
+  reportPerSample(state, samples.size(), cycles);
+}
+
+BENCHMARK_TEMPLATE(BM_UpdateStateScalar, float);
+BENCHMARK_TEMPLATE(BM_UpdateStateScalar, int16_t);
+BENCHMARK_TEMPLATE(BM_UpdateStateScalar, int32_t);
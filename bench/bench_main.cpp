@@ -0,0 +1,4 @@
+#include <benchmark/benchmark.h>
+
+// Native benchmarks: pio run -e bench -t exec
+BENCHMARK_MAIN();
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "PositionClassifier.h"
+#include "DoorTraceFixtures.h"
+#include "BenchSupport.h"
+
+// Block position classification vs the per-sample DoorMonitor helpers
+
+struct PositionBlock {
+  std::vector<float> y;
+  std::vector<float> z;
+};
+
+static PositionBlock makeBlock(size_t n) {
+  std::vector<TraceSample> trace = randomDoorTrace(400, 3);
+  PositionBlock block;
+  for (size_t i = 0; i < n; i++) {
+    const TraceSample& s = trace[i % trace.size()];
+    AccelData a = traceSampleToAccel(s);
+    block.y.push_back(a.y);
+    block.z.push_back(a.z);
+  }
+  return block;
+}
+
+static void BM_ClassifyPositions(benchmark::State& state) {
+  size_t n = (size_t)state.range(0);
+  PositionBlock block = makeBlock(n);
+  std::vector<uint32_t> closed(positionMaskWords(n)), open(positionMaskWords(n)), intermediate(positionMaskWords(n));
+  uint64_t cycles = 0;
+
+  for (auto _ : state) {
+    uint64_t start = benchCycleCount();
+    classifyPositions(block.y.data(), block.z.data(), n, DEFAULT_CONFIG,
+                      closed.data(), open.data(), intermediate.data());
+    cycles += benchCycleCount() - start;
+    benchmark::ClobberMemory();
+  }
+  state.SetLabel(positionClassifierImpl());
+  reportPerSample(state, n, cycles);
+}
+
+static void BM_ClassifyPositionsScalar(benchmark::State& state) {
+  size_t n = (size_t)state.range(0);
+  PositionBlock block = makeBlock(n);
+  std::vector<uint32_t> closed(positionMaskWords(n)), open(positionMaskWords(n)), intermediate(positionMaskWords(n));
+  uint64_t cycles = 0;
+
+  for (auto _ : state) {
+    uint64_t start = benchCycleCount();
+    classifyPositionsScalar(block.y.data(), block.z.data(), n, DEFAULT_CONFIG,
+                            closed.data(), open.data(), intermediate.data());
+    cycles += benchCycleCount() - start;
+    benchmark::ClobberMemory();
+  }
+  reportPerSample(state, n, cycles);
+}
+
+static void BM_DoorMonitorPositionHelpers(benchmark::State& state) {
+  size_t n = (size_t)state.range(0);
+  PositionBlock block = makeBlock(n);
+  const DoorMonitorConfig& c = DEFAULT_CONFIG;
+  uint64_t cycles = 0;
+
+  for (auto _ : state) {
+    uint64_t start = benchCycleCount();
+    size_t closed = 0, open = 0;
+    for (size_t i = 0; i < n; i++) {
+      if (DoorMonitor::isInClosedPosition(block.y[i], block.z[i], c.closedPositionY, c.closedPositionZ, c.positionTolerance)) {
+        closed++;
+      } else if (DoorMonitor::isInOpenPosition(block.y[i], block.z[i], c.openPositionY, c.openPositionZ, c.positionTolerance)) {
+        open++;
+      }
+    }
+    benchmark::DoNotOptimize(closed);
+    benchmark::DoNotOptimize(open);
+    cycles += benchCycleCount() - start;
+  }
+  reportPerSample(state, n, cycles);
+}
+
+BENCHMARK(BM_ClassifyPositions)->ArgName("samples")->Arg(256)->Arg(65536);
+BENCHMARK(BM_ClassifyPositionsScalar)->ArgName("samples")->Arg(256)->Arg(65536);
+BENCHMARK(BM_DoorMonitorPositionHelpers)->ArgName("samples")->Arg(256)->Arg(65536);
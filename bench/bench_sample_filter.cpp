@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "SampleFilter.h"
+#include "ConfigSweep.h"
+#include "SamplingScheduler.h"
+#include "DoorTraceFixtures.h"
+#include "BenchSupport.h"
+
+// Noise filter kernels: per-sample cost of the filter stage, and what each
+// does to DoorMonitor on door cycles with single-sample spikes injected
+// (spurious = transitions not made on the same trace without spikes), at
+// the 10 Hz DoorMonitor rate and at the 5 Hz idle (cycle mode) rate
+
+#define FILTER_BENCH_BATCH 32   // ACQUISITION_BATCH_SIZE on the device
+
+static std::vector<AccelData> toAccel(const std::vector<TraceSample>& raw) {
+  std::vector<AccelData> samples;
+  for (size_t i = 0; i < raw.size(); i++) {
+    samples.push_back(traceSampleToAccel(raw[i]));
+  }
+  return samples;
+}
+
+// ============================================================================
+// Filter stage cost, as loop() runs it: one batch at a time
+// ============================================================================
+
+template <typename Kernel>
+static void BM_SampleFilter(benchmark::State& state) {
+  std::vector<AccelData> input = toAccel(doorCycleTrace(3));
+  std::vector<AccelData> work(input);
+  AccelFilter<Kernel> filter;
+  uint64_t cycles = 0;
+
+  for (auto _ : state) {
+    work = input;
+    uint64_t start = benchCycleCount();
+    for (size_t i = 0; i < work.size(); i += FILTER_BENCH_BATCH) {
+      size_t n = work.size() - i < FILTER_BENCH_BATCH ? work.size() - i : FILTER_BENCH_BATCH;
+      filter.applyBatch(&work[i], n);
+    }
+    cycles += benchCycleCount() - start;
+    benchmark::DoNotOptimize(work.data());
+  }
+  state.SetLabel(Kernel::name());
+  reportPerSample(state, input.size(), cycles);
+}
+
+BENCHMARK_TEMPLATE(BM_SampleFilter, PassThroughKernel);
+BENCHMARK_TEMPLATE(BM_SampleFilter, MedianKernel<3>);
+BENCHMARK_TEMPLATE(BM_SampleFilter, MedianKernel<5>);
+BENCHMARK_TEMPLATE(BM_SampleFilter, MovingAverageKernel<4>);
+BENCHMARK_TEMPLATE(BM_SampleFilter, ExponentialKernel<2>);
+
+// Every stride-th sample, as the sensor delivers it at a lower rate
+static std::vector<TraceSample> decimate(const std::vector<TraceSample>& trace, size_t stride) {
+  std::vector<TraceSample> kept;
+  for (size_t i = 0; i < trace.size(); i += stride) {
+    kept.push_back(trace[i]);
+  }
+  return kept;
+}
+
+// ============================================================================
+// False transitions: Arg(0) = SampleFilterKind, Arg(1) = sample period (ms)
+// ============================================================================
+
+static void BM_FilteredSpikyCycles(benchmark::State& state) {
+  SampleFilterKind kind = (SampleFilterKind)state.range(0);
+  size_t stride = (size_t)state.range(1) / TRACE_PERIOD_MS;
+  std::vector<LabeledTrace> traces;
+  for (uint32_t seed = 1; seed <= 8; seed++) {
+    std::vector<TraceSample> clean = decimate(doorCycleTrace(seed), stride);
+    std::vector<TraceSample> spiked = clean;
+    injectSpikes(spiked, 50, 1200, seed * 7);
+
+    LabeledTrace reference;
+    reference.samples = toAccel(clean);
+    for (size_t i = 0; i < clean.size(); i++) {
+      reference.times.push_back(clean[i].time);
+    }
+    std::vector<DoorTransition> transitions;
+    SweepScore ignored;
+    scoreConfig(DEFAULT_CONFIG, reference, SweepOptions(), transitions, ignored);
+
+    LabeledTrace trace;
+    trace.samples = toAccel(spiked);
+    trace.times = reference.times;
+    for (size_t i = 0; i < transitions.size(); i++) {
+      TraceLabel label = {transitions[i].time, transitions[i].to};
+      trace.labels.push_back(label);
+    }
+    traces.push_back(trace);
+  }
+
+  SweepScore score;
+  std::vector<DoorTransition> transitions;
+  size_t samples = 0;
+  for (auto _ : state) {
+    score = SweepScore();
+    for (size_t t = 0; t < traces.size(); t++) {
+      LabeledTrace filtered = traces[t];
+      SelectableSampleFilter filter(kind);
+      filter.applyBatch(&filtered.samples[0], filtered.samples.size());
+      scoreConfig(DEFAULT_CONFIG, filtered, SweepOptions(), transitions, score);
+      samples += filtered.samples.size();
+    }
+  }
+  state.SetLabel(sampleFilterName(kind));
+  state.SetItemsProcessed(samples);
+  state.counters["expected"] = (double)score.expected;
+  state.counters["missed"] = (double)(score.expected - score.matched);
+  state.counters["spurious"] = (double)(score.detected - score.matched);
+  state.counters["latency_ms"] = score.meanLatency();
+}
+
+BENCHMARK(BM_FilteredSpikyCycles)
+  ->ArgNames({"filter", "period_ms"})
+  ->ArgsProduct({benchmark::CreateDenseRange(SAMPLE_FILTER_NONE, SAMPLE_FILTER_KIND_COUNT - 1, 1),
+                 {TRACE_PERIOD_MS, 1000 / SAMPLING_IDLE_RATE_HZ}});
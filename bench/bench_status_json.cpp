@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+#include "StatusJson.h"
+#include "LegacyStatusJson.h"
+
+// /status serialization: fixed buffer writer vs the original String concatenation
+
+static void setupMonitor(DoorMonitor& monitor, AccelData& accel) {
+  monitor.initialize(9.8f, 0.0f, 1000);
+  accel.x = 0.13f;
+  accel.y = 10.47f;
+  accel.z = -0.62f;
+  accel.valid = true;
+  monitor.updateState(accel, 1100);
+}
+
+static void BM_StatusJsonWriter(benchmark::State& state) {
+  DoorMonitor monitor;
+  AccelData accel;
+  setupMonitor(monitor, accel);
+  char buffer[STATUS_JSON_BUFFER_SIZE];
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(writeStatusJson(buffer, sizeof(buffer), monitor, accel));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StatusJsonWriter);
+
+static void BM_StatusJsonStringConcat(benchmark::State& state) {
+  DoorMonitor monitor;
+  AccelData accel;
+  setupMonitor(monitor, accel);
+
+  for (auto _ : state) {
+    std::string json = legacyStatusJson(monitor, accel);
+    benchmark::DoNotOptimize(json.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StatusJsonStringConcat);
@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+#include "TelemetryHistory.h"
+
+// TelemetryHistory::add() cost per sample (100 Hz spacing, the top of the FIFO range),
+// including the bucket roll-overs of all three tiers
+
+static void BM_TelemetryAdd(benchmark::State& state) {
+  TelemetryHistory history;
+  unsigned long time = 0;
+  float y = 9.0f;
+  for (auto _ : state) {
+    time += 10;
+    y = y > 10.0f ? 9.0f : y + 0.01f;
+    history.add(time, y, 0.5f);
+  }
+  benchmark::DoNotOptimize(history.getBucketCount(0));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TelemetryAdd);
+
+// Encoding a full tier, as /telemetry?format=bin does
+static void BM_TelemetryEncodeTier(benchmark::State& state) {
+  TelemetryHistory history;
+  for (unsigned long t = 0; t <= 130000; t += 10) {
+    history.add(t, 9.5f, 0.5f);
+  }
+  uint8_t out[TELEMETRY_BINARY_HEADER_SIZE + TELEMETRY_TIER_BUCKETS * TELEMETRY_BINARY_BUCKET_SIZE];
+  for (auto _ : state) {
+    encodeTelemetryHeader(history, 0, out);
+    uint8_t* p = out + TELEMETRY_BINARY_HEADER_SIZE;
+    for (size_t i = 0; i < history.getBucketCount(0); i++) {
+      encodeTelemetryBucket(history.getBucket(0, i), p);
+      p += TELEMETRY_BINARY_BUCKET_SIZE;
+    }
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetBytesProcessed(state.iterations() * sizeof(out));
+}
+BENCHMARK(BM_TelemetryEncodeTier);
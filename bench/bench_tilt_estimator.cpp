@@ -0,0 +1,145 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "TiltEstimator.h"
+#include "DoorMonitor.h"
+#include "DoorTraceFixtures.h"
+#include "BenchSupport.h"
+
+// Angle mode: cost of TiltEstimator + updateStateAngle() per sample, and how
+// fast each mode reports door cycles. The accel mode gets every fifth sample
+// (DOOR_MONITOR_INTERVAL_MS), the angle mode all of them at 50 Hz.
+
+#define TILT_BENCH_PERIOD_MS 20
+#define TILT_BENCH_ACCEL_STRIDE 5
+
+static const TraceSegment TILT_BENCH_CYCLE[] = {
+  {3000, 0, 0, 30, false},
+  {3000, 0, 90, 30, false},     // 30 deg/s
+  {4000, 90, 90, 30, false},
+  {12000, 90, 0, 30, false},    // 7.5 deg/s
+  {4000, 0, 0, 30, false}
+};
+#define TILT_BENCH_SEGMENTS (sizeof(TILT_BENCH_CYCLE) / sizeof(TILT_BENCH_CYCLE[0]))
+
+static std::vector<ImuTraceSample> benchImuTrace(uint32_t seed) {
+  return synthesizeImuTrace(TILT_BENCH_CYCLE, TILT_BENCH_SEGMENTS, TILT_BENCH_PERIOD_MS, 1.5f, 0.5f, seed);
+}
+
+// ============================================================================
+// Per-sample cost
+// ============================================================================
+
+static void BM_TiltEstimatorUpdate(benchmark::State& state) {
+  std::vector<ImuTraceSample> trace = benchImuTrace(1);
+  TiltEstimator estimator;
+  uint64_t cycles = 0;
+
+  for (auto _ : state) {
+    uint64_t start = benchCycleCount();
+    for (size_t i = 0; i < trace.size(); i++) {
+      estimator.update(trace[i].y, trace[i].z, trace[i].gyroRate, trace[i].time);
+    }
+    cycles += benchCycleCount() - start;
+    benchmark::DoNotOptimize(estimator.getAngle());
+    estimator.reset();
+  }
+  reportPerSample(state, trace.size(), cycles);
+}
+BENCHMARK(BM_TiltEstimatorUpdate);
+
+static void BM_AngleModeUpdate(benchmark::State& state) {
+  std::vector<ImuTraceSample> trace = benchImuTrace(1);
+  TiltEstimator estimator;
+  DoorMonitor monitor;
+  uint64_t cycles = 0;
+
+  for (auto _ : state) {
+    monitor.reset();
+    estimator.reset();
+    uint64_t start = benchCycleCount();
+    for (size_t i = 0; i < trace.size(); i++) {
+      estimator.update(trace[i].y, trace[i].z, trace[i].gyroRate, trace[i].time);
+      DoorAngleSample sample = {estimator.getAngle(), estimator.getRate(), true};
+      monitor.updateStateAngle(sample, trace[i].time);
+    }
+    cycles += benchCycleCount() - start;
+    benchmark::DoNotOptimize(monitor.getState());
+  }
+  reportPerSample(state, trace.size(), cycles);
+}
+BENCHMARK(BM_AngleModeUpdate);
+
+// ============================================================================
+// Detection: Arg(0) = 0 accel mode, 1 angle mode
+// ============================================================================
+
+static void BM_DetectCycles(benchmark::State& state) {
+  bool angleMode = state.range(0) != 0;
+  unsigned long motionStart[2];
+  unsigned long motionEnd[2];
+  unsigned long time = 1000;
+  for (size_t s = 0; s < TILT_BENCH_SEGMENTS; s++) {
+    if (s == 1 || s == 3) motionStart[s / 2] = time;
+    if (s == 2 || s == 4) motionEnd[s / 2 - 1] = time;
+    time += TILT_BENCH_CYCLE[s].durationMs;
+  }
+
+  double startLatency = 0;
+  double settleLatency = 0;
+  size_t starts = 0;
+  size_t settles = 0;
+  size_t transitions = 0;
+  size_t expected = 0;
+  for (auto _ : state) {
+    startLatency = settleLatency = 0;
+    starts = settles = transitions = expected = 0;
+    for (uint32_t seed = 1; seed <= 8; seed++) {
+      std::vector<ImuTraceSample> trace = benchImuTrace(seed);
+      DoorMonitor monitor;
+      TiltEstimator estimator;
+      size_t seen = 0;
+      if (angleMode) {
+        monitor.initializeAngle(TiltEstimator::accelAngle(trace[0].y, trace[0].z), trace[0].time);
+      } else {
+        monitor.initialize(trace[0].y, trace[0].z, trace[0].time);
+      }
+      for (size_t i = 0; i < trace.size(); i++) {
+        DoorState before = monitor.getState();
+        if (angleMode) {
+          estimator.update(trace[i].y, trace[i].z, trace[i].gyroRate, trace[i].time);
+          DoorAngleSample sample = {estimator.getAngle(), estimator.getRate(), true};
+          monitor.updateStateAngle(sample, trace[i].time);
+        } else if (i % TILT_BENCH_ACCEL_STRIDE == 0) {
+          AccelData sample = {0, trace[i].y, trace[i].z, true};
+          monitor.updateState(sample, trace[i].time);
+        }
+        DoorState after = monitor.getState();
+        if (after == before) {
+          continue;
+        }
+        transitions++;
+        // Expected sequence: OPENING, OPEN, CLOSING, CLOSED
+        static const DoorState sequence[] = {DOOR_OPENING, DOOR_OPEN, DOOR_CLOSING, DOOR_CLOSED};
+        if (seen < 4 && after == sequence[seen]) {
+          if (seen % 2 == 0) {
+            startLatency += (double)(trace[i].time - motionStart[seen / 2]);
+            starts++;
+          } else {
+            settleLatency += (double)(trace[i].time - motionEnd[seen / 2]);
+            settles++;
+          }
+          seen++;
+        }
+      }
+      expected += 4;
+      benchmark::DoNotOptimize(monitor.getState());
+    }
+  }
+  state.SetLabel(angleMode ? "angle" : "accel");
+  state.counters["expected"] = (double)expected;
+  state.counters["missed"] = (double)(expected - starts - settles);
+  state.counters["spurious"] = (double)(transitions - starts - settles);
+  state.counters["start_ms"] = starts ? startLatency / (double)starts : 0;
+  state.counters["settle_ms"] = settles ? settleLatency / (double)settles : 0;
+}
+BENCHMARK(BM_DetectCycles)->ArgName("angle")->DenseRange(0, 1);
@@ -0,0 +1,123 @@
+#ifndef CONFIG_SWEEP_H
+#define CONFIG_SWEEP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "DoorMonitor.h"
+
+// Scoring DoorMonitorConfig candidates against labeled traces, for the
+// tools/tune parameter sweep.
+//
+// A label file lists the transitions a trace should produce, one per line:
+//
+//   # time_ms STATE
+//   4000 OPENING
+//   7200 OPEN
+//
+// STATE is a name as printed by doorStateName(). A detected transition
+// matches a label when it goes to the labeled state no more than
+// earlyToleranceMs before and matchWindowMs after the label time. Each
+// detection matches at most one label.
+
+#define SWEEP_DEFAULT_MATCH_WINDOW_MS 3000
+#define SWEEP_DEFAULT_EARLY_TOLERANCE_MS 500
+
+struct TraceLabel {
+  unsigned long time;
+  DoorState state;
+};
+
+// A decoded trace plus its labels. Sweeps share these read-only across workers.
+struct LabeledTrace {
+  std::vector<AccelData> samples;
+  std::vector<unsigned long> times;
+  std::vector<TraceLabel> labels;
+};
+
+struct SweepOptions {
+  unsigned long matchWindowMs;
+  unsigned long earlyToleranceMs;
+
+  SweepOptions()
+    : matchWindowMs(SWEEP_DEFAULT_MATCH_WINDOW_MS),
+      earlyToleranceMs(SWEEP_DEFAULT_EARLY_TOLERANCE_MS) {}
+};
+
+// Accuracy and latency of one config, accumulated over traces
+struct SweepScore {
+  size_t expected;             // labels
+  size_t detected;             // transitions DoorMonitor made
+  size_t matched;              // labels matched by a detection
+  unsigned long totalLatency;  // ms, over matched labels (early detections count as 0)
+  unsigned long maxLatency;
+
+  SweepScore() : expected(0), detected(0), matched(0), totalLatency(0), maxLatency(0) {}
+
+  // F1 of matched transitions: 1 = every label found and nothing spurious
+  float accuracy() const {
+    return expected + detected == 0 ? 1.0f : 2.0f * matched / (float)(expected + detected);
+  }
+  float meanLatency() const { return matched == 0 ? 0.0f : (float)totalLatency / matched; }
+
+  void add(const SweepScore& other);
+};
+
+// Ranking: higher accuracy first, then lower mean latency
+bool sweepScoreBetter(const SweepScore& a, const SweepScore& b);
+
+// Parse a state name as printed by doorStateName(); false if unknown
+bool doorStateFromName(const char* name, size_t length, DoorState& state);
+
+// Parse label file text. Labels must be in time order. Returns false (and the
+// 1-based line number in errorLine) on a malformed line.
+bool parseTraceLabels(const char* text, size_t size, std::vector<TraceLabel>& labels, size_t* errorLine);
+
+// Match detected transitions against labels and add the result to score
+void scoreTransitions(const std::vector<DoorTransition>& detected, const std::vector<TraceLabel>& labels,
+                      const SweepOptions& options, SweepScore& score);
+
+// Run one config over one trace and add its score, starting from the first
+// valid sample. transitions is scratch space reused between calls.
+void scoreConfig(const DoorMonitorConfig& config, const LabeledTrace& trace, const SweepOptions& options,
+                 std::vector<DoorTransition>& transitions, SweepScore& score);
+
+// Parameters a sweep can vary
+enum SweepParam {
+  SWEEP_ACCEL_THRESHOLD,
+  SWEEP_STOP_TIMEOUT,
+  SWEEP_MAX_OPEN_TIME,
+  SWEEP_MAX_CLOSE_TIME,
+  SWEEP_STALL_THRESHOLD,
+  SWEEP_STALL_TIMEOUT,
+  SWEEP_POSITION_TOLERANCE,
+  SWEEP_PARAM_COUNT
+};
+
+// Values first, first + step, ... up to last (inclusive) for one parameter
+struct SweepAxis {
+  SweepParam param;
+  float first;
+  float last;
+  float step;
+};
+
+// Name used on the tune command line, e.g. "threshold"
+const char* sweepParamName(SweepParam param);
+bool sweepParamFromName(const char* name, SweepParam& param);
+float getSweepParam(const DoorMonitorConfig& config, SweepParam param);
+void setSweepParam(DoorMonitorConfig& config, SweepParam param, float value);
+
+// Cartesian product of the axes applied to base
+std::vector<DoorMonitorConfig> buildConfigGrid(const DoorMonitorConfig& base, const std::vector<SweepAxis>& axes);
+
+#ifndef ARDUINO
+// Score every config on every trace using threadCount workers (0 = one per
+// core). Workers claim configs from a shared atomic cursor, so faster workers
+// take more of the grid; traces are shared, never copied. scores[i] is the
+// total for configs[i].
+void runConfigSweep(const std::vector<LabeledTrace>& traces, const std::vector<DoorMonitorConfig>& configs,
+                    const SweepOptions& options, unsigned threadCount, std::vector<SweepScore>& scores);
+#endif
+
+#endif // CONFIG_SWEEP_H
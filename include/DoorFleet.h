@@ -0,0 +1,77 @@
+#ifndef DOOR_FLEET_H
+#define DOOR_FLEET_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "DoorMonitor.h"
+
+// Consecutive failed reads before a door reports a sensor failure (as DoorMonitor)
+#define DOOR_FLEET_FAILURE_LIMIT 5
+
+// Doors per block of the update pass; remaining doors are done one at a time.
+// 16 lanes of the uint8_t valid flags fill a 16-byte SIMD register.
+#define DOOR_FLEET_LANES 16
+
+// Transition of one door during a DoorFleet tick
+struct FleetTransition {
+  uint32_t door;
+  DoorState from;
+  DoorState to;
+};
+
+// Many doors evaluated in lockstep. Holds the same per-door state as
+// DoorMonitor, but as one array per field (structure of arrays) so a tick
+// updates every door in a single branch-free pass the compiler can vectorize.
+// Each door makes exactly the transitions a DoorMonitor with the same config
+// (and early arrival off) would make on the same samples.
+//
+// All per-door fields are 32 bits wide so the update loop has a uniform
+// vector width. Timestamps are millis() values and wrap at 32 bits, as on
+// the device.
+class DoorFleet {
+private:
+  DoorMonitorConfig config;
+  size_t doorCount;
+
+  std::vector<uint32_t> state;              // DoorState
+  std::vector<uint32_t> lastMovementDirection;
+  std::vector<float> lastAccelY;
+  std::vector<float> lastAccelZ;
+  std::vector<uint32_t> lastMovementTime;
+  std::vector<uint32_t> stateChangeTime;
+  std::vector<uint32_t> lastStallCheckTime;
+  std::vector<uint32_t> consecutiveSensorFailures;  // saturates at 255
+  std::vector<uint32_t> previousState;      // scratch for transition detection
+
+public:
+  explicit DoorFleet(size_t doors, const DoorMonitorConfig& cfg = DEFAULT_CONFIG);
+
+  size_t size() const { return doorCount; }
+
+  // Same as DoorMonitor::initialize, for one door or for all doors at once
+  void initialize(size_t door, float initialAccelY, float initialAccelZ, unsigned long currentTime);
+  void initializeAll(const float* initialAccelY, const float* initialAccelZ, unsigned long currentTime);
+
+  // One tick: a sample for every door taken at currentTime. valid[i] is
+  // nonzero for a good read. Transitions are written to the output array
+  // (up to maxTransitions). Returns the total number of transitions, which
+  // may be more than maxTransitions.
+  size_t update(const float* accelY, const float* accelZ, const uint8_t* valid, unsigned long currentTime,
+                FleetTransition* transitions, size_t maxTransitions);
+
+  DoorState getState(size_t door) const { return (DoorState)state[door]; }
+  DoorState getLastMovementDirection(size_t door) const { return (DoorState)lastMovementDirection[door]; }
+  bool isSensorHealthy(size_t door) const { return consecutiveSensorFailures[door] < DOOR_FLEET_FAILURE_LIMIT; }
+  unsigned long getTimeInCurrentState(size_t door, unsigned long currentTime) const {
+    return (uint32_t)currentTime - stateChangeTime[door];
+  }
+
+  void setConfig(const DoorMonitorConfig& cfg) { config = cfg; }
+  const DoorMonitorConfig& getConfig() const { return config; }
+
+  // Back to the freshly constructed state for every door
+  void reset();
+};
+
+#endif // DOOR_FLEET_H
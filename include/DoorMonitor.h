@@ -2,6 +2,13 @@
 #define DOOR_MONITOR_H
 
 #include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+#include <string.h>
+
+#ifdef DOOR_MONITOR_METRICS
+#include "Histogram.h"
+#endif
 
 // Door state enumeration
 enum DoorState {
@@ -16,50 +23,245 @@ enum DoorState {
   DOOR_ERROR_STALLED
 };
 
+// How a real-valued threshold is mapped onto an integer sample scale
+enum QuantizeMode {
+  QUANTIZE_NEAREST,
+  QUANTIZE_FLOOR,   // for "value > threshold" and "value <= tolerance" comparisons
+  QUANTIZE_CEIL     // for "value < threshold" comparisons
+};
+
+// Numeric traits for the sample type of DoorMonitorT.
+// Value is the type used for differences, sums and thresholds; toBits() and
+// fromBits() carry a sample through a DoorSnapshot, SNAPSHOT_KIND tags it.
+template <typename Scalar>
+struct DoorScalarTraits;
+
+// m/s^2 as float (the original implementation)
+template <>
+struct DoorScalarTraits<float> {
+  typedef float Value;
+  static const int FRACTION_BITS = 0;
+  static Value quantize(float v, QuantizeMode) { return v; }
+  static float defaultUnitsPerMs2() { return 1.0f; }
+  static const uint8_t SNAPSHOT_KIND = 1;
+  static uint32_t toBits(float v) { uint32_t bits; memcpy(&bits, &v, sizeof(bits)); return bits; }
+  static float fromBits(uint32_t bits) { float v; memcpy(&v, &bits, sizeof(v)); return v; }
+};
+
+// Raw MPU-6050 counts (Q15.0), no soft-float on the update path
+template <>
+struct DoorScalarTraits<int16_t> {
+  typedef int32_t Value;
+  static const int FRACTION_BITS = 0;
+  static Value quantize(float v, QuantizeMode mode) {
+    return (Value)(mode == QUANTIZE_FLOOR ? floorf(v) : mode == QUANTIZE_CEIL ? ceilf(v) : roundf(v));
+  }
+  static float defaultUnitsPerMs2() { return 4096.0f / 9.80665f; }  // +/-8 g range
+  static const uint8_t SNAPSHOT_KIND = 2;
+  static uint32_t toBits(int16_t v) { return (uint32_t)(int32_t)v; }
+  static int16_t fromBits(uint32_t bits) { return (int16_t)(int32_t)bits; }
+};
+
+// Raw MPU-6050 counts with 8 fractional bits (Q23.8) for sub-count thresholds
+template <>
+struct DoorScalarTraits<int32_t> {
+  typedef int32_t Value;
+  static const int FRACTION_BITS = 8;
+  static Value quantize(float v, QuantizeMode mode) {
+    return DoorScalarTraits<int16_t>::quantize(v, mode);
+  }
+  static float defaultUnitsPerMs2() { return 4096.0f * (1 << FRACTION_BITS) / 9.80665f; }
+  static const uint8_t SNAPSHOT_KIND = 3;
+  static uint32_t toBits(int32_t v) { return (uint32_t)v; }
+  static int32_t fromBits(uint32_t bits) { return (int32_t)bits; }
+};
+
 // Acceleration data structure
-struct AccelData {
-  float x;
-  float y;
-  float z;
+template <typename Scalar>
+struct AccelDataT {
+  Scalar x;
+  Scalar y;
+  Scalar z;
   bool valid;
 };
 
+typedef AccelDataT<float> AccelData;
+
+// Name of a state as used in /status and the serial log, e.g. "CLOSED"
+const char* doorStateName(DoorState state);
+
+// State transition reported by batch updates
+struct DoorTransition {
+  unsigned long time;  // timestamp of the sample that caused the transition
+  DoorState from;
+  DoorState to;
+};
+
+#define DOOR_MONITOR_MAX_LISTENERS 4
+
+// Called once per state change made by updateState()/updateStateBatch(), right
+// after the change (getState() already returns transition.to). direction is
+// getLastMovementDirection() at that point. Listeners must not update the
+// monitor or add/remove listeners.
+typedef void (*DoorTransitionListener)(void* context, const DoorTransition& transition, DoorState direction);
+
+#ifdef DOOR_MONITOR_METRICS
+#define DOOR_METRICS_BUCKETS 20
+
+// Instrumentation kept by DoorMonitorT when built with -DDOOR_MONITOR_METRICS.
+// Without the flag none of this exists and updateState() is unchanged.
+struct DoorMonitorMetrics {
+  uint32_t samplesProcessed;
+  Histogram<DOOR_METRICS_BUCKETS> motionLatency;  // ms, first significant sample -> OPENING/CLOSING
+  Histogram<DOOR_METRICS_BUCKETS> settleLatency;  // ms, last significant sample -> CLOSED/OPEN/STOPPED
+  Histogram<DOOR_METRICS_BUCKETS> updateTime;     // ns per updateState() call
+
+  // Motion episode in progress (first significant sample not yet resolved)
+  bool motionActive;
+  unsigned long motionStartTime;
+
+  DoorMonitorMetrics() : samplesProcessed(0), motionActive(false), motionStartTime(0) {}
+};
+#endif
+
 // Door monitor configuration
-struct DoorMonitorConfig {
-  float accelThreshold;        // m/s^2 threshold for detecting movement
+template <typename Scalar>
+struct DoorMonitorConfigT {
+  typedef typename DoorScalarTraits<Scalar>::Value Value;
+
+  Value accelThreshold;        // m/s^2 threshold for detecting movement
   unsigned long stopTimeout;   // milliseconds without movement = stopped
   unsigned long maxOpenTime;   // maximum time to fully open (timeout detection)
   unsigned long maxCloseTime;  // maximum time to fully close (timeout detection)
-  float stallThreshold;        // acceleration threshold for stall detection
+  Value stallThreshold;        // acceleration threshold for stall detection
   unsigned long stallTimeout;  // time with minimal movement = stalled
-  float closedPositionY;       // Y-axis value when door is closed (typically 9.8)
-  float closedPositionZ;       // Z-axis value when door is closed (typically 0)
-  float openPositionY;         // Y-axis value when door is open (typically 0)
-  float openPositionZ;         // Z-axis value when door is open (typically 9.8)
-  float positionTolerance;     // tolerance for position detection
+  Value closedPositionY;       // Y-axis value when door is closed (typically 9.8)
+  Value closedPositionZ;       // Z-axis value when door is closed (typically 0)
+  Value openPositionY;         // Y-axis value when door is open (typically 0)
+  Value openPositionZ;         // Z-axis value when door is open (typically 9.8)
+  Value positionTolerance;     // tolerance for position detection
 };
 
-// Door monitor class
-class DoorMonitor {
-private:
+typedef DoorMonitorConfigT<float> DoorMonitorConfig;
+
+// Default configuration
+const DoorMonitorConfig DEFAULT_CONFIG = {
+  0.5,    // accelThreshold (m/s^2)
+  2000,   // stopTimeout (ms)
+  30000,  // maxOpenTime (ms)
+  30000,  // maxCloseTime (ms)
+  0.1,    // stallThreshold (m/s^2)
+  5000,   // stallTimeout (ms)
+  9.8,    // closedPositionY (m/s^2)
+  0.0,    // closedPositionZ (m/s^2)
+  0.0,    // openPositionY (m/s^2)
+  9.8,    // openPositionZ (m/s^2)
+  1.0     // positionTolerance (m/s^2) - increased from 0.5 to 1.0 for real-world sensor noise
+};
+
+// Convert an m/s^2 configuration to the sample scale of DoorMonitorT<Scalar>.
+// unitsPerMs2 is the number of Scalar units per m/s^2 (including fractional bits).
+// Thresholds are rounded so integer comparisons give the same result as the float
+// comparisons; position references are rounded to the nearest unit.
+template <typename Scalar>
+DoorMonitorConfigT<Scalar> quantizeConfig(const DoorMonitorConfig& cfg,
+                                          float unitsPerMs2 = DoorScalarTraits<Scalar>::defaultUnitsPerMs2()) {
+  typedef DoorScalarTraits<Scalar> Traits;
+  DoorMonitorConfigT<Scalar> out;
+  out.accelThreshold = Traits::quantize(cfg.accelThreshold * unitsPerMs2, QUANTIZE_FLOOR);
+  out.stopTimeout = cfg.stopTimeout;
+  out.maxOpenTime = cfg.maxOpenTime;
+  out.maxCloseTime = cfg.maxCloseTime;
+  out.stallThreshold = Traits::quantize(cfg.stallThreshold * unitsPerMs2, QUANTIZE_CEIL);
+  out.stallTimeout = cfg.stallTimeout;
+  out.closedPositionY = Traits::quantize(cfg.closedPositionY * unitsPerMs2, QUANTIZE_NEAREST);
+  out.closedPositionZ = Traits::quantize(cfg.closedPositionZ * unitsPerMs2, QUANTIZE_NEAREST);
+  out.openPositionY = Traits::quantize(cfg.openPositionY * unitsPerMs2, QUANTIZE_NEAREST);
+  out.openPositionZ = Traits::quantize(cfg.openPositionZ * unitsPerMs2, QUANTIZE_NEAREST);
+  out.positionTolerance = Traits::quantize(cfg.positionTolerance * unitsPerMs2, QUANTIZE_FLOOR);
+  return out;
+}
+
+// Where DoorMonitorT reads its thresholds from. The default,
+// DoorRuntimeConfig, is a DoorMonitorConfigT that setConfig() can change. A
+// literal type declaring every DoorMonitorConfigT field as a static constexpr
+// member fixes them at compile time instead: comparisons against them fold
+// into the code and a check whose timeout is DOOR_CHECK_DISABLED drops out.
+//
+//   struct GarageDoor {
+//     static constexpr float accelThreshold = 0.5f;
+//     static constexpr unsigned long stopTimeout = 2000;
+//     ...
+//     static constexpr unsigned long stallTimeout = DOOR_CHECK_DISABLED;
+//   };
+//   DoorMonitorT<float, GarageDoor> monitor;
+//
+// Such a monitor has no setConfig(), and the file that declares it includes
+// DoorMonitorImpl.h (DoorMonitor and the fixed-point monitors are compiled
+// once in DoorMonitor.cpp). See DoorStaticConfig.h.
+#define DOOR_CHECK_DISABLED ((unsigned long)-1)  // as a timeout: the check never fires
+
+template <typename Scalar>
+struct DoorRuntimeConfig : public DoorMonitorConfigT<Scalar> {
+  DoorRuntimeConfig() : DoorMonitorConfigT<Scalar>(quantizeConfig<Scalar>(DEFAULT_CONFIG)) {}
+  DoorRuntimeConfig(const DoorMonitorConfigT<Scalar>& cfg) : DoorMonitorConfigT<Scalar>(cfg) {}
+};
+
+// Angle mode: door angle and angular velocity (e.g. from TiltEstimator)
+// instead of consecutive accel samples. The rate reacts within a sample or
+// two of the door starting to move and stays near zero while it doesn't, so
+// the stop timeout can be much shorter than in the accel mode.
+struct DoorAngleSample {
+  float angle;  // degrees, 0 = closed, 90 = open
+  float rate;   // deg/s, positive = opening
+  bool valid;
+};
+
+struct DoorAngleConfig {
+  float rateThreshold;         // deg/s of angular velocity that counts as movement
+  float stallRate;             // deg/s below which a moving door is stalling
+  unsigned long stopTimeout;   // milliseconds below rateThreshold = stopped
+  float closedAngle;           // degrees when the door is closed (typically 0)
+  float openAngle;             // degrees when the door is open (typically 90)
+  float angleTolerance;        // tolerance for position detection (degrees)
+};
+
+// Early arrival (accel mode): a moving door that has stayed inside the
+// positionTolerance band of either end for windowSamples consecutive samples
+// with little spread is reported CLOSED/OPEN right away instead of after
+// stopTimeout. A door that keeps bouncing still settles by the timeout. Off
+// while windowSamples is 0, which is how a monitor starts.
+#define DOOR_ARRIVAL_MAX_WINDOW 8
+
+template <typename Scalar>
+struct DoorArrivalConfigT {
+  typedef typename DoorScalarTraits<Scalar>::Value Value;
+
+  uint8_t windowSamples;       // samples judged together, 0 = off (at most DOOR_ARRIVAL_MAX_WINDOW)
+  unsigned long settleTime;    // milliseconds since the last significant movement, at least
+  Value settleDeviation;       // max standard deviation of Y and Z (combined) over the window
+};
+
+typedef DoorArrivalConfigT<float> DoorArrivalConfig;
+
+struct DoorSnapshot;  // DoorSnapshot.h
+
+// State, queries and transition listeners shared by every DoorMonitorT,
+// whatever its sample type or config source
+class DoorMonitorBase {
+protected:
   DoorState currentState;
   DoorState lastMovementDirection;  // Track last known movement direction
-  float lastAccelY;
-  float lastAccelZ;
-  unsigned long lastMovementTime;
   unsigned long stateChangeTime;
-  unsigned long lastStallCheckTime;
-  DoorMonitorConfig config;
   bool sensorHealthy;
-  int consecutiveSensorFailures;
-  
+  DoorTransitionListener listeners[DOOR_MONITOR_MAX_LISTENERS];
+  void* listenerContexts[DOOR_MONITOR_MAX_LISTENERS];
+  size_t listenerCount;
+
+  DoorMonitorBase();
+  void notifyListeners(DoorState from, DoorState to, unsigned long currentTime);
+
 public:
-  DoorMonitor();
-  DoorMonitor(const DoorMonitorConfig& cfg);
-  
-  // Core state update function
-  DoorState updateState(const AccelData& accel, unsigned long currentTime);
-  
   // State queries
   DoorState getState() const { return currentState; }
   const char* getStateString() const;
@@ -69,37 +271,158 @@ public:
   bool isSensorHealthy() const { return sensorHealthy; }
   unsigned long getTimeInCurrentState(unsigned long currentTime) const;
   DoorState getLastMovementDirection() const { return lastMovementDirection; }
-  
-  // Configuration
-  void setConfig(const DoorMonitorConfig& cfg) { config = cfg; }
-  DoorMonitorConfig getConfig() const { return config; }
-  
+
+  // Transition listeners, called in registration order. Returns false when
+  // all DOOR_MONITOR_MAX_LISTENERS slots are taken (or listener is NULL).
+  // Listeners survive reset() and setConfig(); initialize() and reset() do
+  // not notify.
+  bool addTransitionListener(DoorTransitionListener listener, void* context);
+  bool removeTransitionListener(DoorTransitionListener listener, void* context);
+  size_t getListenerCount() const { return listenerCount; }
+};
+
+// Door monitor state machine, generic over the sample type:
+//   DoorMonitorT<float>   - m/s^2 (DoorMonitor)
+//   DoorMonitorT<int16_t> - raw sensor counts (DoorMonitorFixed16)
+//   DoorMonitorT<int32_t> - raw sensor counts in Q23.8 (DoorMonitorFixed32)
+// and over where the thresholds come from (see DoorRuntimeConfig).
+template <typename Scalar, typename ConfigSource = DoorRuntimeConfig<Scalar> >
+class DoorMonitorT : public DoorMonitorBase {
+public:
+  typedef typename DoorScalarTraits<Scalar>::Value Value;
+  typedef AccelDataT<Scalar> Sample;
+  typedef DoorMonitorConfigT<Scalar> Config;
+  typedef DoorArrivalConfigT<Scalar> ArrivalConfig;
+
+private:
+  Scalar lastAccelY;
+  Scalar lastAccelZ;
+  unsigned long lastMovementTime;
+  unsigned long lastStallCheckTime;
+  ConfigSource config;
+  int consecutiveSensorFailures;
+
+  DoorAngleConfig angleConfig;
+
+  // Early arrival window (ring of the last samples while moving)
+  ArrivalConfig arrivalConfig;
+  Scalar arrivalY[DOOR_ARRIVAL_MAX_WINDOW];
+  Scalar arrivalZ[DOOR_ARRIVAL_MAX_WINDOW];
+  uint8_t arrivalCount;
+  uint8_t arrivalNext;
+
+  // The state machine; updateState() and updateStateAngle() wrap it with
+  // notification (and metrics)
+  DoorState updateStateCore(const Sample& accel, unsigned long currentTime);
+  DoorState updateStateAngleCore(const DoorAngleSample& sample, unsigned long currentTime);
+
+  // Steps shared by both inputs
+  bool trackSensorHealth(bool valid, unsigned long currentTime);
+  void recordMovement(DoorState direction, unsigned long currentTime);
+  bool checkTravelErrors(bool slow, unsigned long currentTime);
+  bool isStopDue(unsigned long stopTimeout, unsigned long currentTime) const;
+  bool hasArrived(Scalar accelY, Scalar accelZ, unsigned long currentTime);
+  DoorState accelToPosition(Scalar accelY, Scalar accelZ) const;
+  DoorState angleToPosition(float angle) const;
+#ifdef DOOR_MONITOR_METRICS
+  DoorMonitorMetrics metrics;
+
+  void recordMetrics(DoorState before, DoorState after, unsigned long movementBefore, unsigned long currentTime,
+                     unsigned long stopTimeout);
+#endif
+
+public:
+  DoorMonitorT();
+  DoorMonitorT(const Config& cfg);  // DoorRuntimeConfig only
+
+  // Core state update function
+  DoorState updateState(const Sample& accel, unsigned long currentTime);
+
+  // Batch update: runs the state machine over n samples (times[i] belongs to samples[i]).
+  // Up to maxTransitions transitions are written to transitions (may be NULL when
+  // maxTransitions is 0). Returns the total number of transitions that occurred,
+  // which can exceed maxTransitions if the output array was too small.
+  size_t updateStateBatch(const Sample* samples, const unsigned long* times, size_t n,
+                          DoorTransition* transitions, size_t maxTransitions);
+
+  // Angle mode update (see DoorAngleSample). Feed a monitor either accel
+  // samples or angle samples, not both. maxOpenTime, maxCloseTime and
+  // stallTimeout come from the Config; an invalid sample only counts towards
+  // sensor failure.
+  DoorState updateStateAngle(const DoorAngleSample& sample, unsigned long currentTime);
+
+  // Configuration (setConfig() only with DoorRuntimeConfig)
+  void setConfig(const Config& cfg) { config = cfg; }
+  Config getConfig() const;
+  void setAngleConfig(const DoorAngleConfig& cfg) { angleConfig = cfg; }
+  DoorAngleConfig getAngleConfig() const { return angleConfig; }
+  void setArrivalConfig(const ArrivalConfig& cfg) { arrivalConfig = cfg; arrivalCount = 0; }
+  ArrivalConfig getArrivalConfig() const { return arrivalConfig; }
+
+  // Warm restart (see DoorSnapshot.h). saveSnapshot() records the state as
+  // of currentTime; restoreSnapshot() resumes it as if currentTime were that
+  // moment, keeping config, listeners and metrics. Returns false, leaving the
+  // monitor as it was, for a snapshot of another sample type or with
+  // out-of-range fields.
+  void saveSnapshot(DoorSnapshot& out, unsigned long currentTime) const;
+  bool restoreSnapshot(const DoorSnapshot& snapshot, unsigned long currentTime);
+
+#ifdef DOOR_MONITOR_METRICS
+  // Instrumentation (only with -DDOOR_MONITOR_METRICS)
+  const DoorMonitorMetrics& getMetrics() const { return metrics; }
+  void resetMetrics() { metrics = DoorMonitorMetrics(); }
+#endif
+
   // Reset/initialization
   void reset();
-  void initialize(float initialAccelY, float initialAccelZ, unsigned long currentTime);
-  
+  void initialize(Scalar initialAccelY, Scalar initialAccelZ, unsigned long currentTime);
+  void initializeAngle(float initialAngle, unsigned long currentTime);
+
   // Testable helper functions
-  static float calculateAccelChange(float current, float previous);
-  static bool isMovementSignificant(float accelChange, float threshold);
+  static Value calculateAccelChange(Scalar current, Scalar previous);
+  static bool isMovementSignificant(Value accelChange, Value threshold);
   static bool hasTimedOut(unsigned long elapsed, unsigned long timeout);
-  static bool isInClosedPosition(float accelY, float accelZ, float closedY, float closedZ, float tolerance);
-  static bool isInOpenPosition(float accelY, float accelZ, float openY, float openZ, float tolerance);
-  static DoorState determineDirection(float currentY, float previousY, float currentZ, float previousZ, float threshold);
+  static bool isInClosedPosition(Scalar accelY, Scalar accelZ, Value closedY, Value closedZ, Value tolerance);
+  static bool isInOpenPosition(Scalar accelY, Scalar accelZ, Value openY, Value openZ, Value tolerance);
+  static DoorState determineDirection(Scalar currentY, Scalar previousY, Scalar currentZ, Scalar previousZ, Value threshold);
+  static bool isAtAngle(float angle, float target, float tolerance);
 };
 
-// Default configuration
-const DoorMonitorConfig DEFAULT_CONFIG = {
-  0.5,    // accelThreshold (m/s^2)
-  2000,   // stopTimeout (ms)
-  30000,  // maxOpenTime (ms)
-  30000,  // maxCloseTime (ms)
-  0.1,    // stallThreshold (m/s^2)
-  5000,   // stallTimeout (ms)
-  9.8,    // closedPositionY (m/s^2)
-  0.0,    // closedPositionZ (m/s^2)
-  0.0,    // openPositionY (m/s^2)
-  9.8,    // openPositionZ (m/s^2)
-  1.0     // positionTolerance (m/s^2) - increased from 0.5 to 1.0 for real-world sensor noise
+typedef DoorMonitorT<float> DoorMonitor;
+typedef DoorMonitorT<int16_t> DoorMonitorFixed16;
+typedef DoorMonitorT<int32_t> DoorMonitorFixed32;
+
+// Compiled in DoorMonitor.cpp
+extern template class DoorMonitorT<float>;
+extern template class DoorMonitorT<int16_t>;
+extern template class DoorMonitorT<int32_t>;
+
+// Default angle mode configuration
+const DoorAngleConfig DEFAULT_ANGLE_CONFIG = {
+  3.0,    // rateThreshold (deg/s)
+  0.5,    // stallRate (deg/s)
+  300,    // stopTimeout (ms)
+  0.0,    // closedAngle (deg)
+  90.0,   // openAngle (deg)
+  6.0     // angleTolerance (deg) - about positionTolerance at 1 g
 };
 
+// Suggested early arrival settings for 10 Hz monitoring (about 500 ms after
+// the door comes to rest instead of 2000 ms)
+const DoorArrivalConfig DEFAULT_ARRIVAL_CONFIG = {
+  5,      // windowSamples
+  400,    // settleTime (ms)
+  0.1     // settleDeviation (m/s^2)
+};
+
+template <typename Scalar>
+DoorArrivalConfigT<Scalar> quantizeArrivalConfig(const DoorArrivalConfig& cfg,
+                                                 float unitsPerMs2 = DoorScalarTraits<Scalar>::defaultUnitsPerMs2()) {
+  DoorArrivalConfigT<Scalar> out;
+  out.windowSamples = cfg.windowSamples;
+  out.settleTime = cfg.settleTime;
+  out.settleDeviation = DoorScalarTraits<Scalar>::quantize(cfg.settleDeviation * unitsPerMs2, QUANTIZE_FLOOR);
+  return out;
+}
+
 #endif // DOOR_MONITOR_H
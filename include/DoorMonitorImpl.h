@@ -0,0 +1,503 @@
+#ifndef DOOR_MONITOR_IMPL_H
+#define DOOR_MONITOR_IMPL_H
+
+// DoorMonitorT member definitions. DoorMonitor.cpp compiles them for the
+// runtime-config monitors; include this header where a DoorMonitorT with a
+// static config (see DoorRuntimeConfig) is declared.
+
+#include "DoorMonitor.h"
+#include "DoorSnapshot.h"
+
+#ifdef DOOR_MONITOR_METRICS
+#ifdef ARDUINO
+#include <Arduino.h>
+
+// CPU cycle counter; differences are converted to ns
+static inline uint32_t metricsTicks() {
+  return ESP.getCycleCount();
+}
+
+static inline uint32_t metricsTicksToNs(uint32_t ticks) {
+  return (uint32_t)((uint64_t)ticks * 1000 / ESP.getCpuFreqMHz());
+}
+#else
+#include <chrono>
+
+static inline uint32_t metricsTicks() {
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static inline uint32_t metricsTicksToNs(uint32_t ticks) {
+  return ticks;
+}
+#endif
+#endif
+
+template <typename T>
+static inline T absoluteValue(T v) {
+  return v < 0 ? -v : v;
+}
+
+template <typename Scalar, typename ConfigSource>
+DoorMonitorT<Scalar, ConfigSource>::DoorMonitorT()
+  : lastAccelY(0),
+    lastAccelZ(0),
+    lastMovementTime(0),
+    lastStallCheckTime(0),
+    config(),
+    consecutiveSensorFailures(0),
+    angleConfig(DEFAULT_ANGLE_CONFIG),
+    arrivalConfig(),
+    arrivalCount(0),
+    arrivalNext(0) {}
+
+template <typename Scalar, typename ConfigSource>
+DoorMonitorT<Scalar, ConfigSource>::DoorMonitorT(const Config& cfg) : DoorMonitorT() {
+  config = cfg;
+}
+
+template <typename Scalar, typename ConfigSource>
+typename DoorMonitorT<Scalar, ConfigSource>::Config DoorMonitorT<Scalar, ConfigSource>::getConfig() const {
+  Config cfg = {
+    config.accelThreshold, config.stopTimeout, config.maxOpenTime, config.maxCloseTime,
+    config.stallThreshold, config.stallTimeout, config.closedPositionY, config.closedPositionZ,
+    config.openPositionY, config.openPositionZ, config.positionTolerance
+  };
+  return cfg;
+}
+
+template <typename Scalar, typename ConfigSource>
+void DoorMonitorT<Scalar, ConfigSource>::reset() {
+  currentState = DOOR_UNKNOWN;
+  lastMovementDirection = DOOR_UNKNOWN;
+  lastAccelY = 0;
+  lastAccelZ = 0;
+  lastMovementTime = 0;
+  stateChangeTime = 0;
+  lastStallCheckTime = 0;
+  sensorHealthy = true;
+  consecutiveSensorFailures = 0;
+  arrivalCount = 0;
+#ifdef DOOR_MONITOR_METRICS
+  metrics.motionActive = false;
+#endif
+}
+
+template <typename Scalar, typename ConfigSource>
+void DoorMonitorT<Scalar, ConfigSource>::initialize(Scalar initialAccelY, Scalar initialAccelZ, unsigned long currentTime) {
+  lastAccelY = initialAccelY;
+  lastAccelZ = initialAccelZ;
+  lastMovementTime = currentTime;
+  stateChangeTime = currentTime;
+  lastStallCheckTime = currentTime;
+  currentState = accelToPosition(initialAccelY, initialAccelZ);
+  sensorHealthy = true;
+  consecutiveSensorFailures = 0;
+  arrivalCount = 0;
+}
+
+template <typename Scalar, typename ConfigSource>
+void DoorMonitorT<Scalar, ConfigSource>::initializeAngle(float initialAngle, unsigned long currentTime) {
+  lastMovementTime = currentTime;
+  stateChangeTime = currentTime;
+  lastStallCheckTime = currentTime;
+  currentState = angleToPosition(initialAngle);
+  sensorHealthy = true;
+  consecutiveSensorFailures = 0;
+}
+
+template <typename Scalar, typename ConfigSource>
+void DoorMonitorT<Scalar, ConfigSource>::saveSnapshot(DoorSnapshot& out, unsigned long currentTime) const {
+  typedef DoorScalarTraits<Scalar> Traits;
+  out.sampleKind = Traits::SNAPSHOT_KIND;
+  out.state = currentState;
+  out.lastMovementDirection = lastMovementDirection;
+  out.sensorHealthy = sensorHealthy;
+  out.sensorFailures = consecutiveSensorFailures < 255 ? (uint8_t)consecutiveSensorFailures : 255;
+  out.stateAge = currentTime - stateChangeTime;
+  out.movementAge = currentTime - lastMovementTime;
+  out.stallCheckAge = currentTime - lastStallCheckTime;
+  out.lastAccelY = Traits::toBits(lastAccelY);
+  out.lastAccelZ = Traits::toBits(lastAccelZ);
+  out.arrivalCount = arrivalCount;
+  out.arrivalNext = arrivalNext;
+  // Only the filled part of the ring; the rest was never written
+  for (size_t i = 0; i < DOOR_ARRIVAL_MAX_WINDOW; i++) {
+    out.arrivalY[i] = out.arrivalZ[i] = 0;
+  }
+  for (size_t i = 1; i <= arrivalCount; i++) {
+    size_t k = (arrivalNext + DOOR_ARRIVAL_MAX_WINDOW - i) % DOOR_ARRIVAL_MAX_WINDOW;
+    out.arrivalY[k] = Traits::toBits(arrivalY[k]);
+    out.arrivalZ[k] = Traits::toBits(arrivalZ[k]);
+  }
+}
+
+template <typename Scalar, typename ConfigSource>
+bool DoorMonitorT<Scalar, ConfigSource>::restoreSnapshot(const DoorSnapshot& snapshot, unsigned long currentTime) {
+  typedef DoorScalarTraits<Scalar> Traits;
+  if (snapshot.sampleKind != Traits::SNAPSHOT_KIND || snapshot.state > DOOR_ERROR_STALLED ||
+      snapshot.lastMovementDirection > DOOR_ERROR_STALLED || snapshot.arrivalCount > DOOR_ARRIVAL_MAX_WINDOW ||
+      snapshot.arrivalNext >= DOOR_ARRIVAL_MAX_WINDOW) {
+    return false;
+  }
+  currentState = snapshot.state;
+  lastMovementDirection = snapshot.lastMovementDirection;
+  sensorHealthy = snapshot.sensorHealthy;
+  consecutiveSensorFailures = snapshot.sensorFailures;
+  stateChangeTime = currentTime - snapshot.stateAge;
+  lastMovementTime = currentTime - snapshot.movementAge;
+  lastStallCheckTime = currentTime - snapshot.stallCheckAge;
+  lastAccelY = Traits::fromBits(snapshot.lastAccelY);
+  lastAccelZ = Traits::fromBits(snapshot.lastAccelZ);
+  arrivalCount = snapshot.arrivalCount;
+  arrivalNext = snapshot.arrivalNext;
+  for (size_t i = 0; i < DOOR_ARRIVAL_MAX_WINDOW; i++) {
+    arrivalY[i] = Traits::fromBits(snapshot.arrivalY[i]);
+    arrivalZ[i] = Traits::fromBits(snapshot.arrivalZ[i]);
+  }
+#ifdef DOOR_MONITOR_METRICS
+  metrics.motionActive = false;
+#endif
+  return true;
+}
+
+template <typename Scalar, typename ConfigSource>
+typename DoorMonitorT<Scalar, ConfigSource>::Value DoorMonitorT<Scalar, ConfigSource>::calculateAccelChange(Scalar current, Scalar previous) {
+  return absoluteValue((Value)current - (Value)previous);
+}
+
+template <typename Scalar, typename ConfigSource>
+bool DoorMonitorT<Scalar, ConfigSource>::isMovementSignificant(Value accelChange, Value threshold) {
+  return accelChange > threshold;
+}
+
+template <typename Scalar, typename ConfigSource>
+bool DoorMonitorT<Scalar, ConfigSource>::hasTimedOut(unsigned long elapsed, unsigned long timeout) {
+  return elapsed > timeout;
+}
+
+template <typename Scalar, typename ConfigSource>
+bool DoorMonitorT<Scalar, ConfigSource>::isInClosedPosition(Scalar accelY, Scalar accelZ, Value closedY, Value closedZ, Value tolerance) {
+  return (absoluteValue((Value)accelY - closedY) <= tolerance) && (absoluteValue((Value)accelZ - closedZ) <= tolerance);
+}
+
+template <typename Scalar, typename ConfigSource>
+bool DoorMonitorT<Scalar, ConfigSource>::isInOpenPosition(Scalar accelY, Scalar accelZ, Value openY, Value openZ, Value tolerance) {
+  return (absoluteValue((Value)accelY - openY) <= tolerance) && (absoluteValue((Value)accelZ - openZ) <= tolerance);
+}
+
+template <typename Scalar, typename ConfigSource>
+DoorState DoorMonitorT<Scalar, ConfigSource>::determineDirection(Scalar currentY, Scalar previousY, Scalar currentZ, Scalar previousZ, Value threshold) {
+  Value yChange = (Value)currentY - (Value)previousY;
+  Value zChange = (Value)currentZ - (Value)previousZ;
+  
+  // The panel turns from Y = g (closed) to Z = g (open), so Z rises while
+  // opening and falls while closing
+  if (zChange > threshold / 2) {
+    return DOOR_OPENING;
+  } else if (zChange < -threshold / 2) {
+    return DOOR_CLOSING;
+  }
+  
+  // Z flat: near the open end the turn only shows on Y (rising = closing);
+  // near the closed end a Y change is the lift starting (upward = opening)
+  bool nearOpen = absoluteValue((Value)currentZ) > absoluteValue((Value)currentY);
+  if (yChange > threshold) {
+    return nearOpen ? DOOR_CLOSING : DOOR_OPENING;
+  } else if (yChange < -threshold) {
+    return nearOpen ? DOOR_OPENING : DOOR_CLOSING;
+  }
+  
+  return DOOR_UNKNOWN;
+}
+
+template <typename Scalar, typename ConfigSource>
+bool DoorMonitorT<Scalar, ConfigSource>::isAtAngle(float angle, float target, float tolerance) {
+  return absoluteValue(angle - target) <= tolerance;
+}
+
+// CLOSED or OPEN when inside that end's tolerance band, else STOPPED
+template <typename Scalar, typename ConfigSource>
+DoorState DoorMonitorT<Scalar, ConfigSource>::accelToPosition(Scalar accelY, Scalar accelZ) const {
+  if (isInClosedPosition(accelY, accelZ, config.closedPositionY, config.closedPositionZ, config.positionTolerance)) {
+    return DOOR_CLOSED;
+  } else if (isInOpenPosition(accelY, accelZ, config.openPositionY, config.openPositionZ, config.positionTolerance)) {
+    return DOOR_OPEN;
+  }
+  return DOOR_STOPPED;
+}
+
+template <typename Scalar, typename ConfigSource>
+DoorState DoorMonitorT<Scalar, ConfigSource>::angleToPosition(float angle) const {
+  if (isAtAngle(angle, angleConfig.closedAngle, angleConfig.angleTolerance)) {
+    return DOOR_CLOSED;
+  } else if (isAtAngle(angle, angleConfig.openAngle, angleConfig.angleTolerance)) {
+    return DOOR_OPEN;
+  }
+  return DOOR_STOPPED;
+}
+
+template <typename Scalar, typename ConfigSource>
+DoorState DoorMonitorT<Scalar, ConfigSource>::updateState(const Sample& accel, unsigned long currentTime) {
+  DoorState before = currentState;
+#ifdef DOOR_MONITOR_METRICS
+  uint32_t startTicks = metricsTicks();
+  unsigned long movementBefore = lastMovementTime;
+  DoorState after = updateStateCore(accel, currentTime);
+  metrics.updateTime.record(metricsTicksToNs(metricsTicks() - startTicks));
+  recordMetrics(before, after, movementBefore, currentTime, config.stopTimeout);
+#else
+  DoorState after = updateStateCore(accel, currentTime);
+#endif
+  if (after != before && listenerCount > 0) {
+    notifyListeners(before, after, currentTime);
+  }
+  return after;
+}
+
+template <typename Scalar, typename ConfigSource>
+DoorState DoorMonitorT<Scalar, ConfigSource>::updateStateAngle(const DoorAngleSample& sample, unsigned long currentTime) {
+  DoorState before = currentState;
+#ifdef DOOR_MONITOR_METRICS
+  uint32_t startTicks = metricsTicks();
+  unsigned long movementBefore = lastMovementTime;
+  DoorState after = updateStateAngleCore(sample, currentTime);
+  metrics.updateTime.record(metricsTicksToNs(metricsTicks() - startTicks));
+  recordMetrics(before, after, movementBefore, currentTime, angleConfig.stopTimeout);
+#else
+  DoorState after = updateStateAngleCore(sample, currentTime);
+#endif
+  if (after != before && listenerCount > 0) {
+    notifyListeners(before, after, currentTime);
+  }
+  return after;
+}
+
+#ifdef DOOR_MONITOR_METRICS
+template <typename Scalar, typename ConfigSource>
+void DoorMonitorT<Scalar, ConfigSource>::recordMetrics(DoorState before, DoorState after, unsigned long movementBefore,
+                                         unsigned long currentTime, unsigned long stopTimeout) {
+  metrics.samplesProcessed++;
+
+  // updateStateCore stamps lastMovementTime on every significant sample
+  bool significant = lastMovementTime == currentTime && movementBefore != currentTime;
+  bool wasMoving = before == DOOR_OPENING || before == DOOR_CLOSING;
+  bool nowMoving = after == DOOR_OPENING || after == DOOR_CLOSING;
+
+  if (significant && !metrics.motionActive && !wasMoving) {
+    metrics.motionActive = true;
+    metrics.motionStartTime = currentTime;
+  }
+
+  if (nowMoving && !wasMoving && metrics.motionActive) {
+    metrics.motionLatency.record((uint32_t)(currentTime - metrics.motionStartTime));
+  }
+
+  if (after != before) {
+    if (wasMoving && (after == DOOR_CLOSED || after == DOOR_OPEN || after == DOOR_STOPPED)) {
+      metrics.settleLatency.record((uint32_t)(currentTime - movementBefore));
+    }
+    if (!nowMoving) {
+      metrics.motionActive = false;
+    }
+  } else if (!nowMoving && metrics.motionActive && hasTimedOut(currentTime - lastMovementTime, stopTimeout)) {
+    // A blip that never became motion
+    metrics.motionActive = false;
+  }
+}
+#endif
+
+// Returns false while the sensor is in failure (the sample must be ignored)
+template <typename Scalar, typename ConfigSource>
+bool DoorMonitorT<Scalar, ConfigSource>::trackSensorHealth(bool valid, unsigned long currentTime) {
+  if (!valid) {
+    consecutiveSensorFailures++;
+    if (consecutiveSensorFailures >= 5) {
+      sensorHealthy = false;
+      if (currentState != DOOR_ERROR_SENSOR_FAILURE) {
+        currentState = DOOR_ERROR_SENSOR_FAILURE;
+        stateChangeTime = currentTime;
+      }
+      return false;
+    }
+  } else {
+    consecutiveSensorFailures = 0;
+    sensorHealthy = true;
+  }
+  
+  if (currentState == DOOR_ERROR_SENSOR_FAILURE && sensorHealthy) {
+    // Recovered from sensor failure
+    currentState = DOOR_UNKNOWN;
+    stateChangeTime = currentTime;
+  }
+  return true;
+}
+
+template <typename Scalar, typename ConfigSource>
+void DoorMonitorT<Scalar, ConfigSource>::recordMovement(DoorState direction, unsigned long currentTime) {
+  lastMovementTime = currentTime;
+  lastStallCheckTime = currentTime;
+  
+  if (direction == DOOR_UNKNOWN) {
+    return;
+  }
+  if (direction != currentState) {
+    // Starting to move from stopped/error, or reversing
+    currentState = direction;
+    stateChangeTime = currentTime;
+  }
+  lastMovementDirection = direction;
+}
+
+// Timeout and stall checks while moving without significant movement.
+// Returns true when the door entered an error state.
+template <typename Scalar, typename ConfigSource>
+bool DoorMonitorT<Scalar, ConfigSource>::checkTravelErrors(bool slow, unsigned long currentTime) {
+  if (currentState != DOOR_OPENING && currentState != DOOR_CLOSING) {
+    return false;
+  }
+  
+  // Check for timeout (taking too long to complete)
+  unsigned long timeInState = getTimeInCurrentState(currentTime);
+  unsigned long maxTime = (currentState == DOOR_OPENING) ? config.maxOpenTime : config.maxCloseTime;
+  if (hasTimedOut(timeInState, maxTime)) {
+    currentState = DOOR_ERROR_TIMEOUT;
+    stateChangeTime = currentTime;
+    return true;
+  }
+  
+  // Check for stall (moving but very slow)
+  if (slow) {
+    unsigned long stallTime = currentTime - lastStallCheckTime;
+    if (hasTimedOut(stallTime, config.stallTimeout)) {
+      currentState = DOOR_ERROR_STALLED;
+      stateChangeTime = currentTime;
+      return true;
+    }
+  } else {
+    lastStallCheckTime = currentTime;
+  }
+  return false;
+}
+
+// True when the door has been still for stopTimeout in a state that should
+// now settle into CLOSED/OPEN/STOPPED
+template <typename Scalar, typename ConfigSource>
+bool DoorMonitorT<Scalar, ConfigSource>::isStopDue(unsigned long stopTimeout, unsigned long currentTime) const {
+  return hasTimedOut(currentTime - lastMovementTime, stopTimeout) &&
+         currentState != DOOR_STOPPED &&
+         currentState != DOOR_CLOSED &&
+         currentState != DOOR_OPEN &&
+         currentState != DOOR_ERROR_SENSOR_FAILURE &&
+         currentState != DOOR_ERROR_TIMEOUT &&
+         currentState != DOOR_ERROR_STALLED;
+}
+
+// Early arrival: adds a still sample to the window while moving. True once
+// the last windowSamples samples are all still, the newest is at an end and
+// their spread is within settleDeviation.
+template <typename Scalar, typename ConfigSource>
+bool DoorMonitorT<Scalar, ConfigSource>::hasArrived(Scalar accelY, Scalar accelZ, unsigned long currentTime) {
+  size_t window = arrivalConfig.windowSamples < DOOR_ARRIVAL_MAX_WINDOW ? arrivalConfig.windowSamples
+                                                                          : DOOR_ARRIVAL_MAX_WINDOW;
+  if (window == 0 || !isMoving()) {
+    return false;
+  }
+  arrivalY[arrivalNext] = accelY;
+  arrivalZ[arrivalNext] = accelZ;
+  arrivalNext = (arrivalNext + 1) % DOOR_ARRIVAL_MAX_WINDOW;
+  if (arrivalCount < DOOR_ARRIVAL_MAX_WINDOW) {
+    arrivalCount++;
+  }
+  if (arrivalCount < window || currentTime - lastMovementTime < arrivalConfig.settleTime ||
+      accelToPosition(accelY, accelZ) == DOOR_STOPPED) {
+    return false;
+  }
+  
+  // Relative to the newest sample so fixed-point values stay small as floats
+  float sumY = 0, sumZ = 0, sumSquares = 0;
+  for (size_t i = 1; i <= window; i++) {
+    size_t k = (arrivalNext + DOOR_ARRIVAL_MAX_WINDOW - i) % DOOR_ARRIVAL_MAX_WINDOW;
+    float dy = (float)((Value)arrivalY[k] - (Value)accelY);
+    float dz = (float)((Value)arrivalZ[k] - (Value)accelZ);
+    sumY += dy;
+    sumZ += dz;
+    sumSquares += dy * dy + dz * dz;
+  }
+  float n = (float)window;
+  float variance = (sumSquares - (sumY * sumY + sumZ * sumZ) / n) / n;
+  float bound = (float)arrivalConfig.settleDeviation;
+  return variance <= bound * bound;
+}
+
+template <typename Scalar, typename ConfigSource>
+DoorState DoorMonitorT<Scalar, ConfigSource>::updateStateCore(const Sample& accel, unsigned long currentTime) {
+  if (!trackSensorHealth(accel.valid, currentTime)) {
+    return currentState;
+  }
+  
+  Scalar accelY = accel.y;
+  Scalar accelZ = accel.z;
+  Value yChange = calculateAccelChange(accelY, lastAccelY);
+  Value zChange = calculateAccelChange(accelZ, lastAccelZ);
+  Value totalChange = yChange + zChange;
+  
+  // Check for significant movement
+  if (isMovementSignificant(totalChange, config.accelThreshold)) {
+    // Determine direction based on Y and Z changes
+    arrivalCount = 0;
+    recordMovement(determineDirection(accelY, lastAccelY, accelZ, lastAccelZ, config.accelThreshold), currentTime);
+  } else if (!checkTravelErrors(totalChange < config.stallThreshold, currentTime) &&
+             (isStopDue(config.stopTimeout, currentTime) || hasArrived(accelY, accelZ, currentTime))) {
+    // Check if stopped in closed or open position
+    currentState = accelToPosition(accelY, accelZ);
+    stateChangeTime = currentTime;
+  }
+  
+  lastAccelY = accelY;
+  lastAccelZ = accelZ;
+  return currentState;
+}
+
+template <typename Scalar, typename ConfigSource>
+DoorState DoorMonitorT<Scalar, ConfigSource>::updateStateAngleCore(const DoorAngleSample& sample, unsigned long currentTime) {
+  // Unlike accel samples, an invalid angle sample carries no value at all
+  if (!trackSensorHealth(sample.valid, currentTime) || !sample.valid) {
+    return currentState;
+  }
+  
+  float speed = absoluteValue(sample.rate);
+  if (speed > angleConfig.rateThreshold) {
+    recordMovement(sample.rate > 0 ? DOOR_OPENING : DOOR_CLOSING, currentTime);
+  } else if (!checkTravelErrors(speed < angleConfig.stallRate, currentTime) &&
+             isStopDue(angleConfig.stopTimeout, currentTime)) {
+    currentState = angleToPosition(sample.angle);
+    stateChangeTime = currentTime;
+  }
+  return currentState;
+}
+
+template <typename Scalar, typename ConfigSource>
+size_t DoorMonitorT<Scalar, ConfigSource>::updateStateBatch(const Sample* samples, const unsigned long* times, size_t n,
+                                              DoorTransition* transitions, size_t maxTransitions) {
+  size_t transitionCount = 0;
+  DoorState previousState = currentState;
+  
+  for (size_t i = 0; i < n; i++) {
+    DoorState newState = updateState(samples[i], times[i]);
+    if (newState != previousState) {
+      if (transitionCount < maxTransitions) {
+        transitions[transitionCount].time = times[i];
+        transitions[transitionCount].from = previousState;
+        transitions[transitionCount].to = newState;
+      }
+      transitionCount++;
+      previousState = newState;
+    }
+  }
+  
+  return transitionCount;
+}
+
+#endif // DOOR_MONITOR_IMPL_H
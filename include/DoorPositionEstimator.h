@@ -0,0 +1,95 @@
+#ifndef DOOR_POSITION_ESTIMATOR_H
+#define DOOR_POSITION_ESTIMATOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "DoorMonitor.h"
+
+// Fractional door position, velocity and time to arrival.
+//
+// Position is the projection of (accelY, accelZ) onto the line from the
+// closed to the open reference in DoorMonitorConfig: 0 = closed, 1 = open,
+// clamped to that range. For the default references (1 g on Y, 1 g on Z)
+// this is (1 - cos a + sin a) / 2 for door angle a, within 2% of a / 90.
+// Velocity is its low-passed derivative in fractions per second.
+//
+// Travel times are learned from the door itself: register
+// transitionListener with DoorMonitor (context = the estimator). A run
+// starts when the monitor reports movement with the door near one end and is
+// timed until the position passes POSITION_TRAVEL_END of the way to the
+// other; runs that end in STOPPED (or an error) or start mid-travel are
+// dropped. The full travel time (scaled from the covered fraction) is
+// averaged per direction. The direction of travel always comes from the
+// end the run left, never from OPENING vs CLOSING, so a run is timed the
+// same way whichever input mode drives the monitor.
+//
+// estimateArrival() gives the time left while the monitor reports movement:
+// the remaining fraction of the learned travel time, or of the current
+// velocity until a travel time has been learned. Everything is O(1) per
+// sample.
+
+#define POSITION_VELOCITY_TIME_CONSTANT_MS 300
+#define POSITION_TRAVEL_END 0.95f         // fraction of the way at which a run completes
+#define POSITION_TRAVEL_START 0.3f        // runs start within this fraction of an end
+#define POSITION_TRAVEL_WEIGHT_SHIFT 2    // learned += (measured - learned) / 4
+#define POSITION_MIN_SPEED 0.05f          // fraction/s; slower gives no velocity ETA
+#define POSITION_MAX_GAP_MS 1000          // longer gaps restart the velocity
+
+class DoorPositionEstimator {
+private:
+  float closedY;
+  float closedZ;
+  float axisY;          // open - closed reference
+  float axisZ;
+  float inverseLength2;
+
+  float position;
+  float velocity;
+  unsigned long lastTime;
+  bool primed;
+
+  DoorState state;      // as reported by the last transition
+  bool runActive;
+  DoorState runDirection;
+  unsigned long runStart;
+  float runStartPosition;
+  unsigned long travelTime[2];  // ms, [0] opening, [1] closing; 0 = not learned
+  uint16_t travelCount[2];
+
+  void onTransition(const DoorTransition& transition);
+  void learn(size_t direction, unsigned long measured);
+
+public:
+  explicit DoorPositionEstimator(const DoorMonitorConfig& config = DEFAULT_CONFIG);
+
+  void setConfig(const DoorMonitorConfig& config);
+
+  // One filtered sample; invalid samples are skipped
+  void update(const AccelData& sample, unsigned long time);
+
+  // Forget position and the run in progress; learned travel times are kept
+  void reset();
+
+  float getPosition() const { return position; }
+  float getVelocity() const { return velocity; }
+  DoorState getState() const { return state; }
+
+  // DOOR_OPENING or DOOR_CLOSING while moving (by velocity, else the run in
+  // progress), DOOR_UNKNOWN otherwise
+  DoorState getDirection() const;
+
+  // Learned full travel time for DOOR_OPENING or DOOR_CLOSING, 0 until a run
+  // completed. setTravelTime() restores a saved value.
+  unsigned long getTravelTime(DoorState direction) const;
+  uint16_t getTravelCount(DoorState direction) const;
+  void setTravelTime(DoorState direction, unsigned long ms);
+
+  // Time until the door reaches the end it is moving towards. Returns false
+  // when the door is not moving or there is nothing to go on yet.
+  bool estimateArrival(unsigned long& remainingMs) const;
+
+  // DoorTransitionListener; context is the DoorPositionEstimator
+  static void transitionListener(void* context, const DoorTransition& transition, DoorState direction);
+};
+
+#endif // DOOR_POSITION_ESTIMATOR_H
@@ -0,0 +1,52 @@
+#ifndef DOOR_SNAPSHOT_H
+#define DOOR_SNAPSHOT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "DoorMonitor.h"
+
+// Everything a DoorMonitorT needs to carry on after a warm reboot, so a
+// board reset mid-travel comes back OPENING/CLOSING with its timers and
+// failure count instead of re-deriving the state from one reading.
+//
+// Times are stored as ages before the snapshot, since millis() restarts on
+// every boot. Config, listeners and metrics are not part of it.
+//
+// Blob layout (DOOR_SNAPSHOT_SIZE bytes, little-endian):
+//
+//    0  "GDSN" | version u8 | sample kind u8 | state u8 | direction u8
+//    8  flags u8 (bit 0: sensor healthy) | arrival count u8 | arrival next u8
+//       | sensor failures u8 (saturates at 255)
+//   12  state age u32 | movement age u32 | stall check age u32 (ms)
+//   24  last sample y u32 | z u32 (DoorScalarTraits::toBits)
+//   32  arrival window y u32 x DOOR_ARRIVAL_MAX_WINDOW, then z
+//   96  CRC-32 of bytes 0-95
+
+#define DOOR_SNAPSHOT_MAGIC "GDSN"
+#define DOOR_SNAPSHOT_VERSION 1
+#define DOOR_SNAPSHOT_SIZE (32 + 8 * DOOR_ARRIVAL_MAX_WINDOW + 4)
+
+struct DoorSnapshot {
+  uint8_t sampleKind;  // DoorScalarTraits<Scalar>::SNAPSHOT_KIND
+  DoorState state;
+  DoorState lastMovementDirection;
+  bool sensorHealthy;
+  uint8_t sensorFailures;
+  unsigned long stateAge;
+  unsigned long movementAge;
+  unsigned long stallCheckAge;
+  uint32_t lastAccelY;
+  uint32_t lastAccelZ;
+  uint8_t arrivalCount;
+  uint8_t arrivalNext;
+  uint32_t arrivalY[DOOR_ARRIVAL_MAX_WINDOW];
+  uint32_t arrivalZ[DOOR_ARRIVAL_MAX_WINDOW];
+};
+
+// Write the blob; out needs DOOR_SNAPSHOT_SIZE bytes
+void encodeDoorSnapshot(const DoorSnapshot& snapshot, uint8_t* out);
+
+// Returns false if data is short or not an intact blob of this version
+bool decodeDoorSnapshot(const uint8_t* data, size_t size, DoorSnapshot& snapshot);
+
+#endif // DOOR_SNAPSHOT_H
@@ -0,0 +1,23 @@
+#ifndef DOOR_STATIC_CONFIG_H
+#define DOOR_STATIC_CONFIG_H
+
+#include "DoorMonitor.h"
+
+// DEFAULT_CONFIG as a static config for DoorMonitorT<float, ...> (see
+// DoorRuntimeConfig). The d1_static build monitors with it; copy it for an
+// installation with other thresholds or with checks it does not need.
+struct DefaultStaticConfig {
+  static constexpr float accelThreshold = 0.5f;
+  static constexpr unsigned long stopTimeout = 2000;
+  static constexpr unsigned long maxOpenTime = 30000;
+  static constexpr unsigned long maxCloseTime = 30000;
+  static constexpr float stallThreshold = 0.1f;
+  static constexpr unsigned long stallTimeout = 5000;
+  static constexpr float closedPositionY = 9.8f;
+  static constexpr float closedPositionZ = 0.0f;
+  static constexpr float openPositionY = 0.0f;
+  static constexpr float openPositionZ = 9.8f;
+  static constexpr float positionTolerance = 1.0f;
+};
+
+#endif // DOOR_STATIC_CONFIG_H
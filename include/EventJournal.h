@@ -0,0 +1,131 @@
+#ifndef EVENT_JOURNAL_H
+#define EVENT_JOURNAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "DoorMonitor.h"
+#include "JournalStorage.h"
+
+// Append-only journal of door state changes, kept in a ring of segments so
+// flash use is bounded and writes rotate over the whole area.
+//
+// Segment layout, little-endian:
+//
+//   header (12 bytes): "GDJR" | sequence u32 | base time u32 (ms)
+//   records:           varint((delta << 4) | kind)
+//
+// kind is the new DoorState (0-8), delta the ms since the previous record
+// (or the segment base time). kind 0xF marks a boot: delta is then the
+// absolute millis() at boot and later deltas count from it, since the clock
+// restarts on every reboot. A record is 1-2 bytes for changes within a
+// second, 3 bytes within two minutes, at most 6.
+//
+// The writer buffers records in RAM and writes them in one append when the
+// buffer fills, when the oldest buffered record is flushIntervalMs old
+// (checked by poll()), or on flush(). A segment that is full is closed and
+// the oldest segment is cleared and reused with the next sequence number.
+// A torn record at the end of the newest segment (power lost mid-write) is
+// left in place and writing continues in a fresh segment.
+
+#define JOURNAL_MAGIC "GDJR"
+#define JOURNAL_HEADER_SIZE 12
+#define JOURNAL_MAX_RECORD_SIZE 6
+#define JOURNAL_KIND_BOOT 0xF
+#define JOURNAL_MAX_SEGMENTS 16
+#define JOURNAL_DEFAULT_SEGMENTS 4
+#define JOURNAL_DEFAULT_SEGMENT_SIZE 4096
+#define JOURNAL_BUFFER_SIZE 64
+#define JOURNAL_DEFAULT_FLUSH_INTERVAL_MS 60000
+#define JOURNAL_READ_CHUNK_SIZE 64
+
+enum JournalEntryType {
+  JOURNAL_ENTRY_STATE,  // door changed to state
+  JOURNAL_ENTRY_BOOT    // device (re)started; time is millis() at boot
+};
+
+struct JournalEntry {
+  JournalEntryType type;
+  unsigned long time;
+  DoorState state;  // DOOR_UNKNOWN for boot entries
+};
+
+// Record encode/decode. encode returns the bytes written (out needs
+// JOURNAL_MAX_RECORD_SIZE). decode returns the bytes consumed, or 0 if data
+// holds no complete, valid record.
+size_t encodeJournalRecord(uint8_t kind, uint32_t delta, uint8_t* out);
+size_t decodeJournalRecord(const uint8_t* data, size_t size, uint8_t& kind, uint32_t& delta);
+
+class EventJournal {
+private:
+  JournalStorage& storage;
+  uint8_t segmentCount;
+  uint32_t segmentSize;
+  unsigned long flushIntervalMs;
+
+  uint8_t current;          // segment being written
+  uint32_t sequence;        // its sequence number
+  uint32_t segmentUsed;     // bytes in it, including buffered records
+  unsigned long lastTime;   // time of the last record
+  uint8_t buffer[JOURNAL_BUFFER_SIZE];
+  size_t buffered;
+  unsigned long bufferedSince;
+  bool ready;
+  uint32_t writeCount;
+
+  bool startSegment(uint8_t segment, uint32_t seq, unsigned long baseTime);
+  bool appendRecord(uint8_t kind, unsigned long time);
+
+public:
+  // segmentCount is clamped to 1..JOURNAL_MAX_SEGMENTS
+  EventJournal(JournalStorage& storage, uint8_t segmentCount = JOURNAL_DEFAULT_SEGMENTS,
+               uint32_t segmentSize = JOURNAL_DEFAULT_SEGMENT_SIZE,
+               unsigned long flushIntervalMs = JOURNAL_DEFAULT_FLUSH_INTERVAL_MS);
+
+  // Find the newest segment and record a boot at now. Returns false if the
+  // storage could not be written; the journal then ignores appends.
+  bool begin(unsigned long now);
+
+  // Record a state change. Returns false if the journal is not ready or a
+  // needed write failed (the record is dropped).
+  bool append(DoorState state, unsigned long time);
+
+  // Flush if the oldest buffered record has waited flushIntervalMs
+  bool poll(unsigned long now);
+  bool flush();
+
+  bool isReady() const { return ready; }
+  size_t getBuffered() const { return buffered; }
+  uint8_t getCurrentSegment() const { return current; }
+  uint32_t getWriteCount() const { return writeCount; }  // storage appends, for wear estimates
+  uint8_t getSegmentCount() const { return segmentCount; }
+  uint32_t getSegmentSize() const { return segmentSize; }
+};
+
+// Streams entries from oldest to newest, reading JOURNAL_READ_CHUNK_SIZE
+// bytes at a time so the journal never has to fit in RAM. Only flushed
+// records are visible.
+class JournalReader {
+private:
+  JournalStorage& storage;
+  uint8_t segmentCount;
+  uint8_t order[JOURNAL_MAX_SEGMENTS];  // segments by sequence, oldest first
+  size_t orderCount;
+  size_t orderIndex;
+  uint8_t segment;
+  uint32_t segmentSize;     // bytes stored in the segment being read
+  uint32_t offset;          // next unread byte in it
+  uint8_t chunk[JOURNAL_READ_CHUNK_SIZE];
+  size_t chunkSize;
+  size_t chunkPos;
+  unsigned long time;
+
+  bool openSegment();
+
+public:
+  JournalReader(JournalStorage& storage, uint8_t segmentCount = JOURNAL_DEFAULT_SEGMENTS);
+
+  bool next(JournalEntry& entry);
+  void rewind();
+};
+
+#endif // EVENT_JOURNAL_H
@@ -0,0 +1,175 @@
+#ifndef EVENT_STREAM_H
+#define EVENT_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "DoorMonitor.h"
+
+#define SSE_MAX_SUBSCRIBERS 4
+#define SSE_TELEMETRY_INTERVAL_MS 1000   // periodic telemetry while nothing changes (0 = off)
+#define SSE_KEEPALIVE_INTERVAL_MS 15000  // comment frame to detect dead subscribers
+#define SSE_MAX_FRAME_SIZE 512
+#define SSE_WRITE_TIMEOUT_MS 50          // client write timeout, bounds a write the TCP window can't take
+
+// Kind of record pushed to subscribers
+enum SseEventType {
+  SSE_EVENT_NONE,
+  SSE_EVENT_STATE,      // door state changed
+  SSE_EVENT_TELEMETRY,  // periodic sensor/state snapshot
+  SSE_EVENT_BUCKET,     // telemetry history bucket committed
+  SSE_EVENT_KEEPALIVE   // comment only, no payload
+};
+
+// Decides when to push: immediately on a state change, otherwise at the
+// telemetry rate, with keep-alive comments in between when telemetry is off.
+class SsePublishPolicy {
+private:
+  unsigned long telemetryIntervalMs;
+  unsigned long lastPublishTime;
+  DoorState lastState;
+  bool started;
+  bool changed;
+
+public:
+  explicit SsePublishPolicy(unsigned long telemetryInterval = SSE_TELEMETRY_INTERVAL_MS)
+    : telemetryIntervalMs(telemetryInterval), lastPublishTime(0), lastState(DOOR_UNKNOWN), started(false), changed(false) {}
+
+  void setTelemetryInterval(unsigned long intervalMs) { telemetryIntervalMs = intervalMs; }
+  unsigned long getTelemetryInterval() const { return telemetryIntervalMs; }
+
+  // Report a transition seen by a DoorMonitor listener, so the next poll()
+  // sends a state event even if the door has since returned to lastState
+  void markStateChanged() { changed = true; }
+
+  SseEventType poll(DoorState state, unsigned long currentTime) {
+    if (!started || changed || state != lastState) {
+      started = true;
+      changed = false;
+      lastState = state;
+      lastPublishTime = currentTime;
+      return SSE_EVENT_STATE;
+    }
+    unsigned long sinceLast = currentTime - lastPublishTime;
+    if (telemetryIntervalMs > 0 && sinceLast >= telemetryIntervalMs) {
+      lastPublishTime = currentTime;
+      return SSE_EVENT_TELEMETRY;
+    }
+    if (sinceLast >= SSE_KEEPALIVE_INTERVAL_MS) {
+      lastPublishTime = currentTime;
+      return SSE_EVENT_KEEPALIVE;
+    }
+    return SSE_EVENT_NONE;
+  }
+};
+
+// Format one Server-Sent Events frame into out. Returns the frame length, or 0 if
+// it does not fit. A NULL/empty data yields a keep-alive comment frame.
+inline size_t formatSseFrame(char* out, size_t outSize, SseEventType type, const char* data, size_t dataLength) {
+  const char* header;
+  switch (type) {
+    case SSE_EVENT_STATE: header = "event: state\ndata: "; break;
+    case SSE_EVENT_TELEMETRY: header = "event: telemetry\ndata: "; break;
+    case SSE_EVENT_BUCKET: header = "event: bucket\ndata: "; break;
+    default: header = ":\n\n"; data = NULL; dataLength = 0; break;
+  }
+  size_t headerLength = strlen(header);
+  size_t total = headerLength + (data ? dataLength + 2 : 0);
+  if (total > outSize) {
+    return 0;
+  }
+  memcpy(out, header, headerLength);
+  if (data) {
+    memcpy(out + headerLength, data, dataLength);
+    out[headerLength + dataLength] = '\n';
+    out[headerLength + dataLength + 1] = '\n';
+  }
+  return total;
+}
+
+// Fixed set of SSE subscribers. Client must provide connected(), stop(),
+// availableForWrite() and write(const uint8_t*, size_t) like Arduino's
+// WiFiClient; copies must share the underlying connection.
+template <typename Client, size_t MaxSubscribers = SSE_MAX_SUBSCRIBERS>
+class SseHub {
+private:
+  Client clients[MaxSubscribers];
+  bool active[MaxSubscribers];
+
+public:
+  SseHub() {
+    for (size_t i = 0; i < MaxSubscribers; i++) {
+      active[i] = false;
+    }
+  }
+
+  // Forget subscribers whose connection has closed
+  void prune() {
+    for (size_t i = 0; i < MaxSubscribers; i++) {
+      if (active[i] && !clients[i].connected()) {
+        clients[i] = Client();
+        active[i] = false;
+      }
+    }
+  }
+
+  bool hasCapacity() {
+    prune();
+    return subscriberCount() < MaxSubscribers;
+  }
+
+  bool subscribe(const Client& client) {
+    prune();
+    for (size_t i = 0; i < MaxSubscribers; i++) {
+      if (!active[i]) {
+        clients[i] = client;
+        active[i] = true;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  size_t subscriberCount() const {
+    size_t count = 0;
+    for (size_t i = 0; i < MaxSubscribers; i++) {
+      if (active[i]) {
+        count++;
+      }
+    }
+    return count;
+  }
+
+  // Write a preformatted frame to every subscriber. WiFiClient::write()
+  // blocks until the frame is sent or the client times out, so a subscriber
+  // without send buffer space for the whole frame (a stalled peer) is
+  // disconnected without writing, as is one that is gone or writes short.
+  size_t broadcast(const char* frame, size_t length) {
+    size_t delivered = 0;
+    for (size_t i = 0; i < MaxSubscribers; i++) {
+      if (!active[i]) {
+        continue;
+      }
+      if (clients[i].connected() && hasWriteSpace(clients[i], length) &&
+          clients[i].write((const uint8_t*)frame, length) == length) {
+        delivered++;
+      } else {
+        clients[i].stop();
+        clients[i] = Client();
+        active[i] = false;
+      }
+    }
+    return delivered;
+  }
+
+  static size_t capacity() { return MaxSubscribers; }
+
+private:
+  // availableForWrite() is an int on some cores
+  static bool hasWriteSpace(Client& client, size_t length) {
+    long space = (long)client.availableForWrite();
+    return space >= 0 && (size_t)space >= length;
+  }
+};
+
+#endif // EVENT_STREAM_H
@@ -0,0 +1,31 @@
+#ifndef FILE_JOURNAL_STORAGE_H
+#define FILE_JOURNAL_STORAGE_H
+
+#ifndef ARDUINO
+
+#include <string>
+#include "JournalStorage.h"
+
+// JournalStorage over plain files, for native tests, benchmarks and tools:
+// segment n is the file "<prefix><n>", e.g. "/tmp/journal." -> "/tmp/journal.0"
+class FileJournalStorage : public JournalStorage {
+private:
+  std::string prefix;
+
+  std::string path(uint8_t segment) const;
+
+public:
+  explicit FileJournalStorage(const std::string& pathPrefix) : prefix(pathPrefix) {}
+
+  uint32_t size(uint8_t segment) override;
+  bool read(uint8_t segment, uint32_t offset, uint8_t* data, size_t length) override;
+  bool append(uint8_t segment, const uint8_t* data, size_t length) override;
+  bool clear(uint8_t segment) override;
+
+  // Delete every segment file up to count
+  void removeAll(uint8_t count);
+};
+
+#endif // ARDUINO
+
+#endif // FILE_JOURNAL_STORAGE_H
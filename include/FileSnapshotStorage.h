@@ -0,0 +1,26 @@
+#ifndef FILE_SNAPSHOT_STORAGE_H
+#define FILE_SNAPSHOT_STORAGE_H
+
+#ifndef ARDUINO
+
+#include <string>
+#include "SnapshotStorage.h"
+
+// SnapshotStorage in a plain file, for native tests and tools
+class FileSnapshotStorage : public SnapshotStorage {
+private:
+  std::string path;
+
+public:
+  explicit FileSnapshotStorage(const std::string& filePath) : path(filePath) {}
+
+  bool load(uint8_t* data, size_t length) override;
+  bool save(const uint8_t* data, size_t length) override;
+
+  // Delete the file
+  void remove();
+};
+
+#endif // ARDUINO
+
+#endif // FILE_SNAPSHOT_STORAGE_H
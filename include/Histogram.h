@@ -0,0 +1,95 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Fixed-size histogram of unsigned values with power-of-two buckets:
+// bucket 0 holds 0, bucket k holds [2^(k-1), 2^k), and the last bucket
+// also takes everything larger. Recording is O(1) with no allocation, so it
+// is safe in the sampling path. Percentiles are reported as the upper bound
+// of the bucket they fall in, clamped to the exact maximum.
+template <size_t Buckets>
+class Histogram {
+private:
+  uint32_t counts[Buckets];
+  uint32_t total;
+  uint32_t minValue;
+  uint32_t maxValue;
+  uint64_t sum;
+
+public:
+  Histogram() { reset(); }
+
+  void reset() {
+    for (size_t i = 0; i < Buckets; i++) {
+      counts[i] = 0;
+    }
+    total = 0;
+    minValue = 0;
+    maxValue = 0;
+    sum = 0;
+  }
+
+  static size_t bucketFor(uint32_t value) {
+    size_t bucket = 0;
+    while (value != 0 && bucket < Buckets - 1) {
+      value >>= 1;
+      bucket++;
+    }
+    return bucket;
+  }
+
+  // Largest value that lands in a bucket (the last bucket is open-ended)
+  static uint32_t bucketUpperBound(size_t bucket) {
+    if (bucket == 0) {
+      return 0;
+    }
+    if (bucket >= 32 || bucket == Buckets - 1) {
+      return 0xFFFFFFFFu;
+    }
+    return (1u << bucket) - 1;
+  }
+
+  void record(uint32_t value) {
+    counts[bucketFor(value)]++;
+    if (total == 0 || value < minValue) {
+      minValue = value;
+    }
+    if (value > maxValue) {
+      maxValue = value;
+    }
+    total++;
+    sum += value;
+  }
+
+  static constexpr size_t bucketCount() { return Buckets; }
+  uint32_t getBucket(size_t bucket) const { return counts[bucket]; }
+  uint32_t getCount() const { return total; }
+  uint32_t getMin() const { return minValue; }
+  uint32_t getMax() const { return maxValue; }
+  uint64_t getSum() const { return sum; }
+  uint32_t getMean() const { return total == 0 ? 0 : (uint32_t)(sum / total); }
+
+  // Value at or below which the given fraction of samples fall (0..100)
+  uint32_t getPercentile(uint32_t percent) const {
+    if (total == 0) {
+      return 0;
+    }
+    uint64_t rank = ((uint64_t)total * percent + 99) / 100;
+    if (rank == 0) {
+      rank = 1;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < Buckets; i++) {
+      seen += counts[i];
+      if (seen >= rank) {
+        uint32_t bound = bucketUpperBound(i);
+        return bound < maxValue ? bound : maxValue;
+      }
+    }
+    return maxValue;
+  }
+};
+
+#endif // HISTOGRAM_H
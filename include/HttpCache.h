@@ -0,0 +1,9 @@
+#ifndef HTTP_CACHE_H
+#define HTTP_CACHE_H
+
+// True if an If-None-Match header value matches etag (a quoted entity tag).
+// Uses the weak comparison If-None-Match requires: "*" matches anything, the
+// header may list several tags, and a W/ prefix is ignored.
+bool etagMatches(const char* ifNoneMatch, const char* etag);
+
+#endif // HTTP_CACHE_H
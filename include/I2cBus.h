@@ -0,0 +1,20 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Minimal register-oriented I2C bus interface.
+// Implemented by WireI2cBus on the ESP8266 and by a fake bus in native tests.
+class I2cBus {
+public:
+  virtual ~I2cBus() {}
+  
+  // Write a single register. Returns false on bus error / NACK.
+  virtual bool writeRegister(uint8_t address, uint8_t reg, uint8_t value) = 0;
+  
+  // Burst read length bytes starting at reg. Returns false on bus error / short read.
+  virtual bool readRegisters(uint8_t address, uint8_t reg, uint8_t* data, size_t length) = 0;
+};
+
+#endif // I2C_BUS_H
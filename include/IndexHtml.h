@@ -0,0 +1,226 @@
+// Generated by tools/embed_web.py from web/index.html - do not edit.
+#ifndef INDEX_HTML_H
+#define INDEX_HTML_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+
+// 11050 bytes uncompressed
+#define INDEX_HTML_ETAG "\"d78d1e44f63337ed\""
+
+const size_t INDEX_HTML_GZ_LEN = 3308;
+const uint8_t INDEX_HTML_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xcd, 0x1a, 0xdb, 0x72, 0xdb, 0xc6,
+  0xf5, 0x3d, 0x5f, 0xb1, 0x66, 0x26, 0x21, 0x50, 0x13, 0xe0, 0x45, 0xb2, 0x2a, 0x8b, 0x97, 0x8c,
+  0x62, 0xcb, 0xb5, 0x5b, 0x3b, 0xf1, 0x54, 0x4a, 0x6a, 0x5b, 0xa3, 0xc9, 0x2c, 0x80, 0x05, 0x89,
+  0x08, 0xc4, 0xb2, 0xc0, 0x92, 0x14, 0xe3, 0xf8, 0x2b, 0xfa, 0xd0, 0x99, 0x4e, 0x66, 0xfa, 0xde,
+  0xc7, 0x7e, 0x42, 0x3f, 0x25, 0x5f, 0xd0, 0x4f, 0xe8, 0x39, 0xbb, 0xb8, 0xec, 0x82, 0x20, 0x25,
+  0x39, 0x4d, 0xa7, 0xe3, 0x91, 0xc9, 0xdd, 0x3d, 0xe7, 0xec, 0xb9, 0x9f, 0xb3, 0xbb, 0x1c, 0x3d,
+  0x78, 0xfa, 0xf5, 0x93, 0x8b, 0xb7, 0xaf, 0xcf, 0xc8, 0x4c, 0xcc, 0xe3, 0xc9, 0x27, 0xa3, 0xe2,
+  0x83, 0xd1, 0x60, 0xf2, 0x09, 0x21, 0xa3, 0x39, 0x13, 0x94, 0xf8, 0x33, 0x9a, 0x66, 0x4c, 0x8c,
+  0x5b, 0xdf, 0x5c, 0x3c, 0x73, 0x8e, 0x5b, 0xd5, 0x42, 0x42, 0xe7, 0x6c, 0xdc, 0x5a, 0x45, 0x6c,
+  0xbd, 0xe0, 0xa9, 0x68, 0x11, 0x9f, 0x27, 0x82, 0x25, 0x00, 0xb8, 0x8e, 0x02, 0x31, 0x1b, 0x07,
+  0x6c, 0x15, 0xf9, 0xcc, 0x91, 0x83, 0x0e, 0x89, 0x92, 0x48, 0x44, 0x34, 0x76, 0x32, 0x9f, 0xc6,
+  0x6c, 0xdc, 0x57, 0x64, 0x32, 0xb1, 0x89, 0x19, 0x7e, 0x23, 0xc4, 0xe3, 0xc1, 0x86, 0xbc, 0x27,
+  0x21, 0xd0, 0x70, 0x42, 0x3a, 0x8f, 0xe2, 0xcd, 0x09, 0x39, 0x4d, 0x01, 0x63, 0x48, 0x04, 0xbb,
+  0x11, 0x0e, 0x8d, 0xa3, 0x69, 0x72, 0x42, 0x7c, 0xd8, 0x80, 0xa5, 0x43, 0x32, 0xa7, 0xe9, 0x34,
+  0x82, 0xf1, 0xa0, 0xb7, 0xb8, 0x19, 0x12, 0x8f, 0xfa, 0xd7, 0xd3, 0x94, 0x2f, 0x93, 0xe0, 0x84,
+  0x7c, 0x1a, 0x3e, 0xc2, 0x7f, 0x43, 0xf2, 0x41, 0xd2, 0x75, 0x91, 0x2b, 0x1a, 0x25, 0x2c, 0x05,
+  0xea, 0x73, 0x7a, 0xa3, 0xf8, 0x39, 0x21, 0xc7, 0x3d, 0x89, 0x59, 0xd0, 0xe9, 0x11, 0xba, 0x14,
+  0xbc, 0x40, 0x9a, 0xf5, 0x01, 0xd8, 0xe7, 0x31, 0x4f, 0x81, 0xde, 0xc1, 0xc1, 0x41, 0x49, 0xcc,
+  0x5b, 0x0a, 0xc1, 0x13, 0xf2, 0x5e, 0x8e, 0x08, 0x09, 0xa2, 0x6c, 0x11, 0x53, 0xe0, 0x34, 0x4a,
+  0x62, 0xd8, 0xc2, 0xf1, 0x62, 0xee, 0x5f, 0x0f, 0xf3, 0xc5, 0x05, 0x0d, 0x82, 0x28, 0x99, 0x2a,
+  0x1e, 0xc9, 0x21, 0x6e, 0x97, 0xaf, 0x48, 0x21, 0xb3, 0xe8, 0x07, 0x06, 0x6b, 0x87, 0xd5, 0x74,
+  0xc1, 0x4b, 0x5f, 0x03, 0xf5, 0x97, 0x69, 0x86, 0x5c, 0x2c, 0x78, 0x24, 0x05, 0xcf, 0xa7, 0x3d,
+  0x9e, 0x06, 0x0c, 0xa6, 0x13, 0x9e, 0x30, 0x73, 0xce, 0x49, 0x69, 0x10, 0x2d, 0x33, 0x10, 0x50,
+  0x23, 0xa2, 0x24, 0x59, 0xcf, 0x22, 0x51, 0x41, 0x97, 0x2a, 0x73, 0x0a, 0x41, 0x07, 0xfd, 0xc7,
+  0x47, 0xcf, 0x0e, 0x2a, 0x72, 0x37, 0x4e, 0x36, 0xa3, 0x01, 0x5f, 0xa3, 0x76, 0x80, 0x4d, 0x72,
+  0x04, 0x7f, 0xe9, 0xd4, 0xa3, 0x56, 0xaf, 0x23, 0xff, 0xb9, 0x7d, 0x5b, 0x01, 0x1b, 0xca, 0x39,
+  0x99, 0xf1, 0x95, 0x54, 0x36, 0x5f, 0x50, 0x3f, 0x12, 0xa0, 0x9c, 0x9e, 0x7b, 0x0c, 0x46, 0x4c,
+  0x69, 0x92, 0x85, 0x3c, 0x9d, 0x9f, 0xa8, 0xaf, 0x31, 0x15, 0xec, 0xad, 0xe5, 0x0c, 0x16, 0x37,
+  0x76, 0xa9, 0xdd, 0x4c, 0x50, 0xb1, 0xcc, 0x4a, 0xed, 0x6a, 0x6a, 0xea, 0x1f, 0x6f, 0xab, 0x49,
+  0xaa, 0xb5, 0xd7, 0xa8, 0xed, 0x1d, 0x2a, 0xe9, 0x0f, 0xb4, 0xa5, 0x2d, 0xf9, 0x4d, 0xf5, 0x18,
+  0xd2, 0x03, 0x1e, 0xea, 0xb3, 0x59, 0x7a, 0x62, 0x38, 0x68, 0xcc, 0x42, 0x61, 0x68, 0x45, 0x09,
+  0xe5, 0xa4, 0x7c, 0x0d, 0x3a, 0x29, 0x1d, 0x26, 0x8c, 0x19, 0x78, 0xdf, 0xf7, 0xcb, 0x4c, 0x44,
+  0xe1, 0xc6, 0xc9, 0x23, 0xe7, 0x84, 0x64, 0xa0, 0x33, 0x70, 0x23, 0x26, 0xd6, 0x8c, 0x25, 0x43,
+  0xc3, 0x23, 0x40, 0xd4, 0x4a, 0xc8, 0x63, 0xe9, 0xf5, 0x4a, 0x3a, 0x8f, 0x83, 0xda, 0x41, 0xad,
+  0x7d, 0x80, 0xc9, 0x78, 0x1c, 0x05, 0xe4, 0x53, 0xc6, 0x58, 0x4d, 0xa9, 0x4e, 0x4c, 0x3d, 0x16,
+  0x17, 0x01, 0xb6, 0x66, 0xd1, 0x74, 0x06, 0xdb, 0x79, 0x3c, 0x0e, 0x86, 0xa5, 0xa3, 0x1f, 0x1d,
+  0x1d, 0x55, 0x58, 0x2c, 0x01, 0xbf, 0x73, 0xa6, 0x29, 0x90, 0xd3, 0xd8, 0xc6, 0xf1, 0x50, 0xfe,
+  0xef, 0x08, 0x36, 0x5f, 0xa0, 0x11, 0x51, 0x7d, 0xcb, 0x79, 0x82, 0xea, 0x0d, 0xd3, 0xe2, 0x0f,
+  0x60, 0xe8, 0x02, 0x66, 0x1e, 0xe9, 0x31, 0x96, 0x1b, 0xac, 0xb6, 0x85, 0x4f, 0xd3, 0xa0, 0x34,
+  0xb9, 0x1e, 0xc8, 0x86, 0x3d, 0x4a, 0xc9, 0x25, 0xc9, 0x5b, 0x3d, 0x7e, 0xdb, 0x7c, 0x87, 0xb7,
+  0x38, 0x6f, 0xce, 0x8d, 0xa1, 0xa6, 0xdc, 0xf7, 0x30, 0x44, 0x4d, 0x25, 0x29, 0x89, 0x4a, 0xcd,
+  0x4b, 0x29, 0x4d, 0x3a, 0x2b, 0x1a, 0x2f, 0x99, 0x49, 0x67, 0x20, 0x8d, 0xb6, 0x47, 0xff, 0x7a,
+  0xa2, 0xc9, 0xc9, 0x2c, 0x21, 0x6b, 0xee, 0xe3, 0xe6, 0xf1, 0xe3, 0xc7, 0x55, 0xa2, 0x8b, 0x79,
+  0xc6, 0x02, 0x2d, 0x71, 0x1d, 0x3e, 0x39, 0x7d, 0xf6, 0xa8, 0xd7, 0xb8, 0x65, 0x8e, 0xc2, 0x17,
+  0x2c, 0xd1, 0x10, 0xf2, 0x04, 0xb0, 0x07, 0x21, 0xe0, 0x3c, 0xfd, 0xee, 0x23, 0x36, 0x92, 0x78,
+  0x1f, 0xb7, 0x1b, 0x62, 0x81, 0xe5, 0x35, 0xc4, 0x30, 0x7c, 0x0c, 0xd9, 0xfb, 0x4e, 0x6c, 0x7e,
+  0x14, 0x62, 0x26, 0xf8, 0x62, 0x61, 0x08, 0x18, 0x1e, 0x1e, 0x1e, 0x1c, 0x1c, 0xdd, 0x8a, 0xb8,
+  0x4c, 0xae, 0x13, 0xbe, 0xd6, 0x65, 0x94, 0xf6, 0xd9, 0xaf, 0xff, 0x66, 0x16, 0x35, 0x9b, 0xee,
+  0x05, 0xd8, 0xcd, 0x6b, 0x0e, 0x00, 0xb5, 0x3c, 0x16, 0x33, 0x87, 0x5f, 0xdf, 0xcb, 0x5e, 0x39,
+  0x56, 0x48, 0xa3, 0xf8, 0x5e, 0x6a, 0x10, 0xd1, 0x9c, 0x41, 0xc2, 0x99, 0x2f, 0x6a, 0x4e, 0x3b,
+  0xd8, 0x72, 0x5a, 0x3d, 0x67, 0xa6, 0x48, 0xa9, 0x8c, 0x2a, 0x90, 0x28, 0xaf, 0x81, 0x25, 0x37,
+  0x11, 0x88, 0x99, 0x6e, 0x1c, 0x41, 0xbd, 0x8c, 0x14, 0x25, 0xb8, 0xac, 0x81, 0x5a, 0xde, 0xf3,
+  0x7d, 0x7f, 0xd8, 0x90, 0x43, 0xaa, 0xec, 0x81, 0x59, 0x20, 0x67, 0xa6, 0x56, 0x58, 0xf7, 0xec,
+  0x05, 0xc1, 0x18, 0x33, 0x5f, 0x48, 0x2d, 0x1b, 0x9d, 0x46, 0xe1, 0xc1, 0x46, 0x01, 0xc9, 0x09,
+  0x7d, 0x0a, 0xa9, 0x3c, 0xbd, 0xc6, 0xae, 0x00, 0xb0, 0xf2, 0x9e, 0xa3, 0xdf, 0xeb, 0x7d, 0x36,
+  0x24, 0xb3, 0x5c, 0x71, 0xfd, 0x41, 0x29, 0xe3, 0xa8, 0x9b, 0x77, 0x42, 0xa3, 0xae, 0xea, 0xbd,
+  0x46, 0xd8, 0x0e, 0xc9, 0x16, 0x29, 0x88, 0x56, 0xc4, 0x8f, 0x69, 0x96, 0x8d, 0x5b, 0x65, 0x27,
+  0xd3, 0x52, 0x2d, 0xd3, 0x68, 0xd6, 0x9f, 0xfc, 0xfb, 0xef, 0x7f, 0xfb, 0x07, 0xf9, 0x1d, 0x4d,
+  0xe9, 0x94, 0x91, 0xa7, 0xe0, 0x83, 0xe4, 0x15, 0x87, 0x94, 0xc1, 0x53, 0x20, 0xd4, 0x57, 0x50,
+  0x0a, 0x54, 0x23, 0xa3, 0xa5, 0xf6, 0x9c, 0x50, 0xe3, 0x3a, 0xe6, 0xe5, 0x72, 0xbd, 0x11, 0x42,
+  0xe6, 0xca, 0xd6, 0xe4, 0xd4, 0xf7, 0x21, 0x65, 0xbe, 0x25, 0xd6, 0xb7, 0x2c, 0x15, 0x11, 0xb4,
+  0x77, 0xf6, 0xa8, 0x0b, 0xc0, 0x7b, 0x51, 0x65, 0x7a, 0x6c, 0x91, 0x28, 0x18, 0xb7, 0x28, 0xa2,
+  0xbf, 0x6d, 0x4d, 0x1c, 0xe7, 0x76, 0x34, 0x4c, 0x87, 0xad, 0xc9, 0xbc, 0x9b, 0xfd, 0xeb, 0x9f,
+  0x06, 0xb0, 0x39, 0xf8, 0xc5, 0xb2, 0xbc, 0x23, 0xd6, 0x73, 0x9e, 0x46, 0x3f, 0xa0, 0xbe, 0x3f,
+  0x46, 0x9a, 0x77, 0xff, 0x57, 0xd2, 0xbc, 0xb9, 0xbf, 0x00, 0x6f, 0xfe, 0x6b, 0x02, 0x68, 0x5f,
+  0xb7, 0x1d, 0x51, 0x76, 0x26, 0xcd, 0x3e, 0x58, 0x36, 0x4d, 0xba, 0xa0, 0x10, 0x52, 0x49, 0x0d,
+  0x22, 0x97, 0x54, 0xba, 0xfe, 0x39, 0x4c, 0xb1, 0x13, 0x88, 0x25, 0x00, 0xab, 0x63, 0xa1, 0x68,
+  0xf9, 0x7e, 0x15, 0x05, 0x99, 0x3a, 0x5b, 0x93, 0x97, 0x9c, 0x62, 0x76, 0x70, 0x5d, 0xd7, 0xc4,
+  0xdd, 0x6d, 0x87, 0x7b, 0x72, 0x77, 0xae, 0xfa, 0xda, 0xa7, 0x70, 0x68, 0x8a, 0xe2, 0x6c, 0x0f,
+  0x87, 0x81, 0x82, 0xf8, 0x1f, 0xb0, 0xf4, 0x0a, 0x9a, 0xf4, 0x39, 0xb6, 0x9c, 0xbb, 0x99, 0x99,
+  0xf3, 0x15, 0xb0, 0xa0, 0x3c, 0xe1, 0x57, 0xe1, 0xe1, 0x35, 0xd4, 0x36, 0x11, 0xc1, 0x89, 0x61,
+  0x37, 0x0f, 0x8b, 0x1c, 0xe4, 0x57, 0xe4, 0xe2, 0x54, 0x90, 0x3b, 0x30, 0x42, 0xc5, 0xeb, 0x5f,
+  0x9f, 0x95, 0x73, 0x19, 0x56, 0xe4, 0xb9, 0x2c, 0xbe, 0xfb, 0x1c, 0x59, 0xc2, 0x29, 0xb0, 0x7b,
+  0xb0, 0x53, 0x16, 0x67, 0xf0, 0x2f, 0x9a, 0x09, 0xb2, 0x5c, 0x04, 0x18, 0x30, 0x1a, 0x61, 0x0d,
+  0xa2, 0xa4, 0xfa, 0xcb, 0x83, 0x59, 0x2f, 0xa9, 0x77, 0x53, 0xc4, 0x73, 0x85, 0xb1, 0xad, 0x82,
+  0xbc, 0xf8, 0x03, 0xdf, 0xd4, 0x11, 0x11, 0x4b, 0xc7, 0xad, 0x5e, 0x15, 0xcf, 0x79, 0x95, 0x6e,
+  0x4d, 0x06, 0x64, 0x1e, 0x25, 0xa3, 0xae, 0x02, 0xde, 0x8b, 0xdd, 0x47, 0xe0, 0xd9, 0x9d, 0x40,
+  0x07, 0xad, 0xc9, 0x23, 0x18, 0x6f, 0xb2, 0x3a, 0xb4, 0xa9, 0x6f, 0x9f, 0x26, 0x2b, 0x9a, 0x29,
+  0x33, 0x15, 0x1d, 0x40, 0x0b, 0x94, 0xa8, 0xe6, 0x77, 0xe8, 0x31, 0xdf, 0x2d, 0x17, 0x44, 0x8d,
+  0x5a, 0x84, 0x27, 0x7e, 0x1c, 0xf9, 0xd7, 0x60, 0x16, 0x68, 0x90, 0xa6, 0x2c, 0xc5, 0x24, 0x67,
+  0xd9, 0xad, 0xc9, 0x85, 0x1a, 0xca, 0x7a, 0xaf, 0x33, 0x53, 0x92, 0x1d, 0x65, 0x7e, 0x1a, 0x2d,
+  0x84, 0xda, 0x21, 0x5c, 0x26, 0x3e, 0xfa, 0x2d, 0x31, 0xa8, 0x54, 0x87, 0x6c, 0x26, 0xfc, 0x99,
+  0xd5, 0xee, 0xe6, 0xab, 0x6d, 0xbb, 0xd4, 0x81, 0x2b, 0x66, 0x2c, 0xb1, 0x52, 0x96, 0x2d, 0x78,
+  0x92, 0x31, 0x32, 0x9e, 0x90, 0xe2, 0xbb, 0xfb, 0x7d, 0xc6, 0x13, 0xcb, 0xae, 0x83, 0xa2, 0xb2,
+  0x10, 0xec, 0x7d, 0x39, 0x8f, 0x57, 0x0f, 0xe0, 0xaa, 0x31, 0x73, 0x63, 0x3e, 0x95, 0xeb, 0x6e,
+  0xbe, 0x0f, 0x34, 0x53, 0x5f, 0x90, 0xb6, 0x4c, 0xdb, 0xe5, 0x4c, 0x9b, 0x9c, 0x90, 0x76, 0x21,
+  0x1c, 0x8d, 0x53, 0xe8, 0x84, 0x36, 0x24, 0x4a, 0xc8, 0x22, 0xe5, 0x53, 0xd8, 0x3a, 0x6b, 0x77,
+  0xa4, 0x3d, 0xca, 0x63, 0x37, 0x9c, 0xdd, 0x8c, 0x33, 0x9c, 0x29, 0x6e, 0xca, 0x12, 0x68, 0x0f,
+  0xe5, 0xa6, 0x95, 0xb4, 0x31, 0x13, 0x44, 0xb9, 0xda, 0x59, 0x4c, 0xc6, 0x24, 0xe0, 0xfe, 0x12,
+  0xb3, 0xa0, 0x3b, 0x65, 0xe2, 0x2c, 0x96, 0x09, 0xf1, 0xcb, 0xcd, 0x8b, 0xc0, 0x6a, 0x2b, 0x98,
+  0x76, 0xb9, 0x55, 0x81, 0xe3, 0x46, 0x09, 0xf4, 0x5f, 0x17, 0xd0, 0xbb, 0x22, 0x36, 0xca, 0x83,
+  0x2b, 0x6c, 0x0b, 0x4c, 0x5a, 0xf2, 0x2b, 0x3a, 0x67, 0x06, 0x98, 0x2b, 0xf8, 0x4b, 0xbe, 0x66,
+  0xe9, 0x13, 0x9a, 0x31, 0xcb, 0x76, 0x53, 0x06, 0x07, 0x68, 0x9f, 0x59, 0x5d, 0xd2, 0x9d, 0x76,
+  0x48, 0xfb, 0xbb, 0x6a, 0xbb, 0xe2, 0x7a, 0x69, 0x17, 0x7b, 0x79, 0x9d, 0x68, 0xdb, 0xdb, 0xfc,
+  0xe4, 0x4b, 0xc3, 0xdb, 0x48, 0xa8, 0xb6, 0xab, 0x89, 0x82, 0x5a, 0x01, 0x5e, 0x9f, 0x45, 0x37,
+  0x2c, 0xb0, 0x06, 0xf6, 0xdd, 0x68, 0xbd, 0xdb, 0x49, 0xeb, 0xdd, 0xbd, 0x69, 0xbd, 0xd9, 0x49,
+  0xeb, 0x4d, 0x03, 0xad, 0xdb, 0x48, 0xaa, 0x42, 0xd6, 0x44, 0x32, 0xca, 0x5e, 0xc9, 0x35, 0xf4,
+  0xc5, 0xb7, 0x67, 0xe7, 0xd2, 0x01, 0xbf, 0xe2, 0xed, 0xdb, 0x99, 0x2c, 0xab, 0x41, 0x33, 0xd5,
+  0xd3, 0x72, 0x7d, 0x07, 0x65, 0xcd, 0x1d, 0x8b, 0x12, 0x07, 0xd8, 0x6d, 0xc7, 0x29, 0x21, 0xa2,
+  0x90, 0xa8, 0x80, 0x29, 0xd6, 0x6d, 0x2d, 0xae, 0x34, 0x1c, 0x03, 0xc6, 0x5d, 0xb0, 0x14, 0x6f,
+  0x48, 0x4b, 0x25, 0xf5, 0x6c, 0xf2, 0x90, 0xb4, 0x3f, 0x23, 0x78, 0xd0, 0x6c, 0x57, 0x71, 0xb3,
+  0x45, 0xdc, 0x05, 0xaf, 0x79, 0x95, 0x91, 0x07, 0xe3, 0x31, 0x81, 0xa3, 0x0d, 0x0b, 0x21, 0x69,
+  0x05, 0xb6, 0x11, 0xc8, 0xe5, 0x96, 0x0f, 0x81, 0x4f, 0x62, 0xb5, 0x81, 0x6e, 0x23, 0x89, 0x2e,
+  0x9e, 0x72, 0x7a, 0x76, 0xc9, 0x41, 0x5f, 0x72, 0x40, 0x32, 0x22, 0x38, 0x99, 0x72, 0x5b, 0x63,
+  0xe2, 0xc3, 0x27, 0xe6, 0xe7, 0x4e, 0x6d, 0x2f, 0x9a, 0x75, 0x5d, 0x4c, 0x37, 0xe8, 0x54, 0x1d,
+  0x5f, 0x6f, 0x09, 0x71, 0xad, 0x88, 0x56, 0x91, 0x57, 0x60, 0x36, 0x04, 0xba, 0x06, 0xbf, 0x41,
+  0xb3, 0xfe, 0xfc, 0xd3, 0x5f, 0xc8, 0xd7, 0x7f, 0x90, 0x96, 0xfd, 0xf9, 0xa7, 0xbf, 0x92, 0x67,
+  0xa7, 0x2f, 0x5e, 0x9e, 0x3d, 0x6d, 0x6f, 0x11, 0xda, 0x4e, 0x05, 0x75, 0x42, 0xe5, 0x11, 0x5d,
+  0xd2, 0xd2, 0x8e, 0xde, 0x4d, 0xee, 0x92, 0xf0, 0x35, 0x10, 0x4a, 0xd8, 0x9a, 0x3c, 0x85, 0x8c,
+  0x62, 0xdd, 0x1e, 0x50, 0x65, 0x4d, 0xaf, 0xa9, 0x0f, 0x08, 0xc9, 0x7c, 0x84, 0xf7, 0xf1, 0x17,
+  0x00, 0x73, 0x0e, 0x79, 0x38, 0x99, 0x5a, 0x7b, 0x32, 0xaa, 0xea, 0x17, 0x54, 0x33, 0xdb, 0x50,
+  0x41, 0x8a, 0x9c, 0xf9, 0xf1, 0x05, 0x44, 0xa5, 0x6c, 0x6d, 0xd6, 0xa7, 0x48, 0x9a, 0xa5, 0xe9,
+  0xae, 0xb2, 0x02, 0x4b, 0x50, 0xcd, 0xda, 0xdf, 0x48, 0xce, 0x08, 0xea, 0x8c, 0x05, 0x27, 0x50,
+  0x27, 0x60, 0x5e, 0x2b, 0x13, 0xe4, 0xf6, 0x44, 0x6f, 0xa8, 0xa6, 0xfd, 0x84, 0xc3, 0x48, 0x09,
+  0x7d, 0x86, 0x3b, 0xb4, 0xf7, 0x96, 0x9c, 0x6e, 0x17, 0x3a, 0xc8, 0x38, 0x86, 0x7a, 0x1d, 0x6f,
+  0xc8, 0x1a, 0x04, 0x21, 0x20, 0x0d, 0x61, 0x2b, 0xd8, 0x04, 0x2a, 0x02, 0x94, 0xb1, 0x39, 0x89,
+  0x32, 0x88, 0x2b, 0xba, 0x02, 0xfe, 0xa8, 0x17, 0x33, 0x62, 0xf1, 0x38, 0x20, 0x1e, 0xf4, 0x85,
+  0x19, 0x54, 0x3a, 0x28, 0x81, 0xd9, 0xd2, 0xc3, 0x92, 0xed, 0xc1, 0x28, 0x8e, 0xe6, 0x91, 0x50,
+  0x2a, 0x50, 0xd9, 0x21, 0x8e, 0xd1, 0x3a, 0x29, 0x5a, 0x6c, 0x19, 0xc7, 0xc3, 0x72, 0x45, 0x76,
+  0x17, 0xaf, 0x1b, 0x97, 0x4b, 0x8b, 0x81, 0x74, 0xa9, 0x40, 0x18, 0x69, 0xd9, 0x52, 0x83, 0x18,
+  0xfe, 0x0f, 0x4a, 0xca, 0x66, 0x62, 0xa9, 0xe8, 0x65, 0x4c, 0xbc, 0xc0, 0xab, 0x11, 0x38, 0x1c,
+  0x5a, 0xba, 0xe9, 0x3b, 0x64, 0x80, 0x11, 0x5e, 0xa9, 0x64, 0x8b, 0x93, 0x06, 0xcc, 0xa2, 0x15,
+  0xea, 0x90, 0x47, 0x3a, 0xf2, 0x87, 0xba, 0x2e, 0x91, 0xb5, 0x75, 0x94, 0x04, 0xe0, 0x9c, 0x67,
+  0xa8, 0xc0, 0x73, 0xbe, 0x84, 0x8c, 0x56, 0x2b, 0xe0, 0x72, 0x2e, 0x8f, 0x02, 0x0d, 0x0a, 0x7c,
+  0x50, 0x2a, 0x5d, 0xab, 0xdb, 0x08, 0xce, 0x13, 0x09, 0x03, 0xf0, 0xcc, 0x74, 0x23, 0xdc, 0xab,
+  0x51, 0x0b, 0xe0, 0x5f, 0x31, 0xa3, 0x69, 0x29, 0x43, 0x05, 0x34, 0xdc, 0x09, 0x63, 0x2a, 0xc1,
+  0x00, 0x34, 0x94, 0xba, 0xdb, 0x6a, 0x7a, 0x2e, 0x24, 0x45, 0xfb, 0xf2, 0xfb, 0xf3, 0xaf, 0xbf,
+  0x72, 0x17, 0xf8, 0x00, 0x67, 0x31, 0x57, 0xf6, 0x32, 0x95, 0xee, 0xca, 0xae, 0x43, 0x4a, 0xef,
+  0xd2, 0x20, 0x90, 0x82, 0xbe, 0x84, 0xe6, 0x99, 0x81, 0x33, 0x2b, 0xe7, 0x66, 0x10, 0x0d, 0xb9,
+  0x06, 0xec, 0x5b, 0x11, 0x04, 0xc3, 0xd8, 0x10, 0xe9, 0xe6, 0x3e, 0x48, 0xde, 0xd2, 0xbf, 0x66,
+  0x02, 0x83, 0x0e, 0xd5, 0x0b, 0xeb, 0xd2, 0xd8, 0x5f, 0xca, 0xd9, 0x26, 0xfe, 0x4b, 0x8a, 0x10,
+  0x37, 0x0a, 0x2a, 0x83, 0x78, 0x9e, 0x83, 0xdb, 0xe3, 0x15, 0xdb, 0x7a, 0x06, 0x31, 0x8c, 0x0f,
+  0x0e, 0xbe, 0x8a, 0x41, 0x98, 0xb2, 0x20, 0x42, 0x3c, 0x16, 0xf2, 0x94, 0x11, 0x0a, 0x7a, 0xf1,
+  0x38, 0x17, 0x36, 0x81, 0x36, 0x8a, 0x41, 0x9b, 0x9f, 0x65, 0x2c, 0xd0, 0x6c, 0x9d, 0xb2, 0x1c,
+  0x0d, 0x34, 0x1b, 0xd2, 0x38, 0x63, 0x35, 0xee, 0x79, 0x22, 0x2f, 0xa1, 0xc7, 0x04, 0xa2, 0x61,
+  0xcb, 0x17, 0x4a, 0x64, 0x9b, 0xd4, 0xbc, 0xd6, 0xd2, 0xec, 0xa9, 0x6f, 0x21, 0xd2, 0x25, 0xdb,
+  0x65, 0x0e, 0x9e, 0xc8, 0xe4, 0x84, 0x36, 0xd7, 0xa2, 0x30, 0x4f, 0x1e, 0x84, 0x01, 0x6f, 0xe5,
+  0xf6, 0x66, 0x98, 0xea, 0xf9, 0xc5, 0x4c, 0xb9, 0x43, 0x23, 0xe7, 0x5c, 0x14, 0xc6, 0x22, 0xd5,
+  0x55, 0x63, 0x98, 0xf2, 0x39, 0xe9, 0x96, 0x66, 0xfc, 0x02, 0x1f, 0xdc, 0xa8, 0x18, 0x7b, 0xf2,
+  0x11, 0x69, 0xe0, 0x78, 0x1b, 0xc8, 0x92, 0x78, 0xc3, 0xc8, 0xd2, 0x0e, 0x26, 0xa9, 0xa4, 0xa0,
+  0x75, 0x44, 0x6e, 0xa0, 0xd3, 0x16, 0xfd, 0x23, 0x02, 0x1d, 0x04, 0x51, 0x16, 0x25, 0x16, 0x9c,
+  0xa2, 0xba, 0x73, 0x7a, 0xd3, 0x9d, 0x33, 0x38, 0xa8, 0xbd, 0x55, 0x18, 0xe4, 0x9d, 0x8d, 0x3d,
+  0x79, 0xcf, 0xed, 0xf5, 0x89, 0xbc, 0xf9, 0xe9, 0x10, 0xe7, 0x60, 0xf0, 0xdb, 0xa3, 0x63, 0x59,
+  0x52, 0x54, 0x85, 0x2b, 0xa8, 0x9e, 0x86, 0x10, 0x1c, 0x80, 0x45, 0x05, 0x38, 0x07, 0xf5, 0x67,
+  0x18, 0xb0, 0x90, 0x22, 0x2b, 0x63, 0xe7, 0x1b, 0xd1, 0x34, 0x8d, 0x56, 0x2c, 0x23, 0x70, 0x6e,
+  0xa2, 0xa4, 0xa5, 0x26, 0x5b, 0x2a, 0x81, 0xba, 0x66, 0xbe, 0xbb, 0x88, 0x64, 0xd0, 0xf4, 0x6a,
+  0x69, 0xb0, 0x70, 0xa3, 0x31, 0xb9, 0xbc, 0xaa, 0x2d, 0x9d, 0x25, 0x41, 0x11, 0x65, 0x92, 0x27,
+  0x08, 0x2b, 0xc2, 0x43, 0x99, 0xa1, 0x81, 0x1b, 0xa8, 0x8c, 0x05, 0x13, 0xd9, 0x8c, 0xaf, 0x93,
+  0x8e, 0x84, 0xcc, 0x9d, 0x30, 0x56, 0x97, 0x30, 0x66, 0x4a, 0xc5, 0xc9, 0xca, 0x2f, 0xbc, 0x65,
+  0x18, 0xea, 0xb9, 0x03, 0xb7, 0xc5, 0x07, 0xf1, 0xaa, 0x44, 0xd3, 0x6f, 0x61, 0x58, 0xc0, 0xe9,
+  0x69, 0xc9, 0xe7, 0x4b, 0x99, 0x94, 0x10, 0x1c, 0xcb, 0xd2, 0x37, 0x52, 0xff, 0xd6, 0xa0, 0x23,
+  0xbd, 0xaa, 0x0a, 0xbb, 0x4a, 0x08, 0x1d, 0xf2, 0x60, 0x60, 0x1d, 0x37, 0x41, 0x6e, 0x6b, 0x02,
+  0xdf, 0x51, 0x53, 0x62, 0xe1, 0x96, 0x91, 0x54, 0x1d, 0x7c, 0x8c, 0xd4, 0xee, 0xf0, 0xf5, 0xe1,
+  0x43, 0x3d, 0xf1, 0x21, 0x90, 0x67, 0xe0, 0x6a, 0xd8, 0xa1, 0xc2, 0x0e, 0x01, 0x1b, 0xdf, 0x00,
+  0x10, 0xd3, 0x73, 0x17, 0xcb, 0x6c, 0x66, 0x15, 0x8c, 0xbd, 0x90, 0x12, 0xf4, 0x07, 0xd0, 0xf1,
+  0x45, 0xe4, 0x37, 0x44, 0x7e, 0x09, 0xe1, 0x4b, 0x21, 0x53, 0xbd, 0x66, 0xe4, 0xcc, 0x2a, 0x22,
+  0xde, 0xe5, 0xe0, 0x8a, 0x8c, 0xa1, 0x01, 0xcd, 0xdd, 0xe9, 0x0b, 0x65, 0x8a, 0x13, 0xd8, 0x64,
+  0x4e, 0x17, 0xd6, 0x0a, 0xe3, 0x75, 0xa5, 0xda, 0x4b, 0xbb, 0x56, 0x3f, 0xa0, 0xbe, 0xa7, 0x74,
+  0xbd, 0x15, 0xad, 0x66, 0x89, 0x7e, 0x8f, 0xc7, 0xf8, 0x0e, 0xfa, 0x77, 0xc4, 0x83, 0x57, 0x50,
+  0xc5, 0xc0, 0x13, 0xf0, 0x43, 0x99, 0xff, 0xc3, 0x49, 0xbe, 0x92, 0x91, 0xec, 0x3a, 0x92, 0x4f,
+  0x2a, 0x59, 0x94, 0x40, 0x95, 0x41, 0x47, 0x89, 0xf1, 0xb6, 0x04, 0xe2, 0x59, 0x25, 0x1d, 0x36,
+  0x5f, 0x88, 0x8d, 0xe9, 0x14, 0xb5, 0xa4, 0x27, 0x3d, 0xd7, 0x2c, 0xb7, 0xca, 0x99, 0x91, 0x05,
+  0xd9, 0x64, 0x57, 0xce, 0xfc, 0xe3, 0x8f, 0x9a, 0x89, 0xc7, 0xca, 0x53, 0x6d, 0x48, 0x32, 0x62,
+  0x99, 0x26, 0xba, 0xbb, 0x14, 0xdc, 0x8d, 0x4d, 0xd5, 0xc5, 0x2c, 0x99, 0x8a, 0x19, 0x28, 0xeb,
+  0x15, 0x15, 0x33, 0x57, 0x3e, 0x4c, 0x58, 0x56, 0xbe, 0x9b, 0x14, 0x90, 0x38, 0x25, 0x7d, 0x9b,
+  0x4c, 0x26, 0x13, 0x02, 0x47, 0x82, 0x6e, 0x1e, 0x5b, 0x85, 0x2e, 0x6c, 0xd0, 0x72, 0x5f, 0x3f,
+  0x78, 0x94, 0x9b, 0x01, 0x43, 0xbd, 0x3a, 0x37, 0x3a, 0xc0, 0x04, 0x5f, 0x31, 0x40, 0xd2, 0x86,
+  0x84, 0x59, 0x60, 0x95, 0x36, 0x32, 0xdc, 0xb0, 0xaf, 0xdc, 0x30, 0xa7, 0x93, 0x3b, 0xe2, 0xb6,
+  0x53, 0x48, 0x6d, 0x34, 0x39, 0xb8, 0x5a, 0x56, 0x62, 0xe4, 0x01, 0xfc, 0xf9, 0xe7, 0x44, 0x1f,
+  0xef, 0xf1, 0x9a, 0x5a, 0xa4, 0x18, 0x74, 0xb3, 0x38, 0x82, 0x4e, 0xc2, 0x41, 0xb1, 0x1a, 0x42,
+  0x50, 0x53, 0xec, 0xf0, 0x8e, 0xae, 0x57, 0x3a, 0x49, 0x0d, 0xd0, 0xc8, 0x19, 0x5e, 0x23, 0x33,
+  0x4d, 0xe9, 0xc2, 0x33, 0x0c, 0x6f, 0x40, 0xa8, 0x9b, 0xa7, 0x7d, 0x47, 0x9e, 0x62, 0xf7, 0xaa,
+  0x41, 0x52, 0x48, 0xae, 0x7c, 0xa0, 0x02, 0xd4, 0x7c, 0xe8, 0xc7, 0x11, 0x20, 0xfd, 0x09, 0x27,
+  0x6b, 0x80, 0xea, 0xf1, 0xaa, 0x0e, 0xf9, 0x5c, 0xce, 0x1a, 0xcc, 0x88, 0x9b, 0x0a, 0x08, 0xf8,
+  0x78, 0x82, 0xbf, 0x70, 0xb8, 0x11, 0x56, 0x7b, 0x10, 0x98, 0xdd, 0xd9, 0x02, 0xce, 0x04, 0xcc,
+  0x90, 0x2c, 0x8c, 0x62, 0x28, 0x1b, 0x96, 0x87, 0xa6, 0xf3, 0xec, 0xa1, 0xd1, 0xb3, 0x2a, 0xe0,
+  0x5c, 0xf8, 0xa6, 0x30, 0x89, 0x39, 0x50, 0x92, 0xb1, 0x00, 0xc5, 0xcb, 0x72, 0x5d, 0xb7, 0x40,
+  0x41, 0x6f, 0x90, 0x24, 0xcb, 0x45, 0xef, 0xb2, 0x77, 0x05, 0xe1, 0x7f, 0x79, 0x70, 0xa5, 0xf5,
+  0x24, 0xf2, 0xf4, 0x18, 0x95, 0x34, 0xe8, 0xcd, 0x1e, 0x1a, 0xb0, 0xe8, 0x5d, 0xf6, 0x25, 0x8d,
+  0x43, 0x9d, 0x06, 0xb2, 0x0a, 0x34, 0x1c, 0x64, 0x66, 0x44, 0xfa, 0x18, 0x1e, 0x30, 0x84, 0x73,
+  0x73, 0xcf, 0x7d, 0x34, 0xc4, 0x49, 0x27, 0xff, 0xfa, 0x41, 0xdb, 0x14, 0xd5, 0x15, 0x21, 0x6d,
+  0x0b, 0x40, 0x71, 0xd9, 0x86, 0xc4, 0x69, 0x58, 0xa7, 0x8b, 0xb1, 0xa6, 0xf3, 0xb9, 0xc1, 0x9a,
+  0x80, 0x28, 0xa6, 0x6d, 0x1c, 0x72, 0x08, 0x7f, 0xe0, 0xfa, 0xc8, 0x00, 0x52, 0xb1, 0xea, 0xeb,
+  0xc7, 0x98, 0x02, 0x0a, 0x16, 0xcd, 0x5e, 0x39, 0x0c, 0xa1, 0x79, 0xc7, 0xf8, 0x1c, 0xf4, 0x60,
+  0x55, 0x55, 0x09, 0xf3, 0x10, 0x7a, 0x79, 0xd9, 0xeb, 0x90, 0x76, 0xfe, 0xf6, 0xd9, 0x06, 0xe9,
+  0x2f, 0x0f, 0x70, 0xac, 0xde, 0xa5, 0xdb, 0x57, 0x57, 0x2e, 0xc4, 0xf9, 0x19, 0x14, 0x7b, 0xcb,
+  0xba, 0x0c, 0x3b, 0xea, 0x69, 0xf4, 0xaa, 0xd6, 0x6c, 0x81, 0x73, 0xa0, 0x95, 0xe3, 0x73, 0x7c,
+  0xf4, 0x44, 0x37, 0x41, 0x20, 0xbc, 0x26, 0x38, 0xec, 0x69, 0x27, 0x2d, 0x84, 0x82, 0xe3, 0x13,
+  0xbf, 0x66, 0x06, 0x5c, 0x05, 0x50, 0x3a, 0x4c, 0xb1, 0xa1, 0xd7, 0x21, 0x91, 0x5d, 0x3f, 0x2a,
+  0xa2, 0x35, 0x3c, 0xbb, 0xdc, 0xf3, 0x8f, 0xd0, 0xb9, 0x59, 0x37, 0x52, 0xc9, 0x4a, 0x58, 0x1b,
+  0xe4, 0xec, 0x77, 0xc8, 0x06, 0x6c, 0x19, 0xc2, 0x64, 0xff, 0xca, 0xee, 0x60, 0xc1, 0x2a, 0x4d,
+  0x5c, 0xac, 0x5d, 0x21, 0xa0, 0x06, 0x65, 0x37, 0xdc, 0x43, 0x16, 0x6c, 0x7b, 0x6c, 0x1a, 0x25,
+  0xaf, 0x81, 0x82, 0xde, 0x38, 0xa2, 0x7e, 0x31, 0x07, 0xe0, 0x7d, 0x53, 0xad, 0x3b, 0xbd, 0x8f,
+  0x2c, 0x0f, 0x3c, 0x74, 0xa8, 0x3a, 0xa1, 0xad, 0x6c, 0x5b, 0x5e, 0xf3, 0x28, 0x40, 0xa5, 0x00,
+  0x8c, 0xfd, 0x0b, 0x6e, 0x8a, 0x5f, 0x89, 0x3e, 0xb8, 0xb2, 0x8d, 0x73, 0x8b, 0xec, 0x51, 0x11,
+  0x6d, 0xce, 0x57, 0xf7, 0x40, 0xab, 0x58, 0xd3, 0xdb, 0xe3, 0x6d, 0x25, 0x29, 0xdb, 0x56, 0x1a,
+  0xfa, 0x70, 0xfb, 0xd5, 0x43, 0x43, 0xf6, 0xac, 0x37, 0x79, 0xf5, 0x6b, 0xed, 0x86, 0x56, 0xf8,
+  0x73, 0x79, 0xa1, 0x8f, 0x37, 0x58, 0x65, 0x19, 0xbe, 0xd3, 0xa5, 0x05, 0xb4, 0xa9, 0x74, 0xf3,
+  0xa5, 0xec, 0xe4, 0xb6, 0xef, 0x2e, 0x8c, 0xbe, 0x70, 0xd7, 0x15, 0x46, 0xed, 0xda, 0xa2, 0xea,
+  0xe0, 0xcd, 0x9b, 0x8b, 0x6d, 0x45, 0x94, 0x29, 0xfd, 0xcf, 0x4b, 0x96, 0x6e, 0xce, 0xe5, 0x4b,
+  0x07, 0x4f, 0x4f, 0xe3, 0xd8, 0x6a, 0x37, 0xfd, 0x62, 0xa1, 0x6d, 0x97, 0x8e, 0x94, 0x3f, 0x2d,
+  0x68, 0x8e, 0x94, 0xff, 0xa8, 0x21, 0x7f, 0x5d, 0x68, 0x38, 0x0b, 0xfd, 0x82, 0xcd, 0x64, 0xce,
+  0x56, 0x57, 0x5e, 0x78, 0x40, 0x74, 0x53, 0x86, 0xbe, 0x83, 0x97, 0x6d, 0xea, 0x6d, 0xa6, 0xad,
+  0xbb, 0x4a, 0xce, 0x48, 0x05, 0x0d, 0x6d, 0x94, 0x0e, 0x5a, 0xeb, 0x16, 0xf3, 0xde, 0xff, 0x61,
+  0x8e, 0x86, 0x27, 0x0d, 0x70, 0x44, 0xd9, 0x53, 0x55, 0x90, 0x3b, 0x0f, 0x6e, 0xf9, 0xf1, 0xac,
+  0x70, 0xb2, 0x46, 0xb8, 0x51, 0xb7, 0x78, 0x38, 0x19, 0x75, 0xd5, 0x0f, 0x30, 0x46, 0x5d, 0xf5,
+  0x93, 0xd8, 0xff, 0x00, 0x8e, 0x51, 0xb1, 0x21, 0x2a, 0x2b, 0x00, 0x00,
+};
+
+#endif // INDEX_HTML_H
@@ -0,0 +1,27 @@
+#ifndef JOURNAL_STORAGE_H
+#define JOURNAL_STORAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Segment store behind EventJournal: a fixed number of append-only byte
+// segments, numbered from 0. Implemented by LittleFsJournalStorage on the
+// ESP8266 and FileJournalStorage on native builds (one file per segment).
+class JournalStorage {
+public:
+  virtual ~JournalStorage() {}
+
+  // Bytes stored in a segment (0 if it does not exist yet)
+  virtual uint32_t size(uint8_t segment) = 0;
+
+  // Read length bytes at offset. Returns false on error or short read.
+  virtual bool read(uint8_t segment, uint32_t offset, uint8_t* data, size_t length) = 0;
+
+  // Append to the end of a segment, creating it if needed. Returns false on error.
+  virtual bool append(uint8_t segment, const uint8_t* data, size_t length) = 0;
+
+  // Empty a segment so it can be reused. Returns false on error.
+  virtual bool clear(uint8_t segment) = 0;
+};
+
+#endif // JOURNAL_STORAGE_H
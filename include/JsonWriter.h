@@ -0,0 +1,57 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define JSON_MAX_DECIMALS 6
+
+// Minimal JSON object writer into a caller-provided buffer. Never allocates.
+// If the buffer is too small the output is truncated at a value boundary and
+// overflowed() returns true; the buffer is always NUL terminated.
+class JsonWriter {
+private:
+  char* buffer;
+  size_t capacity;
+  size_t length;
+  bool overflow;
+  bool needComma;
+
+  void append(const char* text, size_t n);
+  void appendChar(char c) { append(&c, 1); }
+  void appendString(const char* text);
+  void appendKey(const char* key);
+
+public:
+  JsonWriter(char* buf, size_t cap);
+
+  void beginObject();
+  void beginObject(const char* key);  // nested object value
+  void endObject();
+  void beginArray(const char* key);
+  void endArray();
+
+  void addString(const char* key, const char* value);
+  void addFloat(const char* key, float value, uint8_t decimals);
+  void addBool(const char* key, bool value);
+  void addUnsigned(const char* key, unsigned long value);
+  void addInt(const char* key, long value);
+
+  // Array elements (key-less values)
+  void addFloatElement(float value, uint8_t decimals);
+  void addUnsignedElement(unsigned long value);
+  void addIntElement(long value);
+
+  const char* c_str() const { return buffer; }
+  size_t size() const { return length; }
+  bool overflowed() const { return overflow; }
+
+  // Format like printf("%.*f") (and Arduino String(float, decimals)) without
+  // touching the heap. Exact for |value| * 10^decimals < 2^53; nan/inf are
+  // written as "nan"/"inf" like dtostrf. Returns the length written (excluding
+  // the NUL), or 0 if out is too small. decimals is capped at JSON_MAX_DECIMALS.
+  static size_t formatFloat(char* out, size_t outSize, float value, uint8_t decimals);
+  static size_t formatUnsigned(char* out, size_t outSize, unsigned long value);
+};
+
+#endif // JSON_WRITER_H
@@ -0,0 +1,75 @@
+#ifndef LITTLE_FS_JOURNAL_STORAGE_H
+#define LITTLE_FS_JOURNAL_STORAGE_H
+
+#ifdef ARDUINO
+
+#include <LittleFS.h>
+#include "JournalStorage.h"
+
+// JournalStorage on LittleFS: segment n is the file "<prefix><n>", e.g.
+// "/journal." -> "/journal.0". LittleFS does its own block wear levelling;
+// the journal keeps writes append-only and batched so each flush programs as
+// few pages as possible.
+class LittleFsJournalStorage : public JournalStorage {
+private:
+  const char* prefix;
+
+  void path(uint8_t segment, char* out, size_t size) const {
+    snprintf(out, size, "%s%u", prefix, (unsigned)segment);
+  }
+
+public:
+  // LittleFS.begin() must have succeeded before the journal is used
+  explicit LittleFsJournalStorage(const char* pathPrefix) : prefix(pathPrefix) {}
+
+  uint32_t size(uint8_t segment) override {
+    char name[32];
+    path(segment, name, sizeof(name));
+    File f = LittleFS.open(name, "r");
+    if (!f) {
+      return 0;
+    }
+    uint32_t length = f.size();
+    f.close();
+    return length;
+  }
+
+  bool read(uint8_t segment, uint32_t offset, uint8_t* data, size_t length) override {
+    char name[32];
+    path(segment, name, sizeof(name));
+    File f = LittleFS.open(name, "r");
+    if (!f) {
+      return false;
+    }
+    bool ok = f.seek(offset, SeekSet) && f.read(data, length) == length;
+    f.close();
+    return ok;
+  }
+
+  bool append(uint8_t segment, const uint8_t* data, size_t length) override {
+    char name[32];
+    path(segment, name, sizeof(name));
+    File f = LittleFS.open(name, "a");
+    if (!f) {
+      return false;
+    }
+    bool ok = f.write(data, length) == length;
+    f.close();
+    return ok;
+  }
+
+  bool clear(uint8_t segment) override {
+    char name[32];
+    path(segment, name, sizeof(name));
+    File f = LittleFS.open(name, "w");
+    if (!f) {
+      return false;
+    }
+    f.close();
+    return true;
+  }
+};
+
+#endif // ARDUINO
+
+#endif // LITTLE_FS_JOURNAL_STORAGE_H
@@ -0,0 +1,79 @@
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Histogram.h"
+
+// Timing of the firmware main loop, to see how much HTTP handling and Serial
+// output cost the sampling path.
+//
+// loop() calls beginLoop() on entry and endPhase() after each phase; a phase
+// lasts from the previous mark to now. acquireSamples() reports each FIFO
+// drain with recordAcquisition(), so the spacing between drains shows the
+// acquisition jitter. All times are microseconds from the caller (micros() on
+// the device) and may wrap.
+//
+// Histograms cover a rolling window: when a window has run for windowUs the
+// next beginLoop() starts a fresh one, and getWindow() reports the last
+// complete window (or the one in progress until the first completes).
+//
+// Not synchronized. On the ESP8266 the acquisition ticker runs from the SDK
+// task, never in the middle of loop(), so no locking is needed there.
+
+#define LOOP_PROFILER_BUCKETS 20             // up to ~0.5 s resolved, longer in the last bucket
+#define LOOP_PROFILER_WINDOW_US 10000000UL   // 10 s
+
+enum LoopPhase {
+  LOOP_PHASE_CLIENT,   // server.handleClient() and the trigger pin
+  LOOP_PHASE_SENSOR,   // draining the sample ring buffer
+  LOOP_PHASE_UPDATE,   // DoorMonitor state update
+  LOOP_PHASE_EVENTS,   // SSE publishing
+  LOOP_PHASE_SERIAL,   // Serial logging
+  LOOP_PHASE_COUNT
+};
+
+// Name used in the /profile document, e.g. "client"
+const char* loopPhaseName(LoopPhase phase);
+
+struct LoopProfileWindow {
+  Histogram<LOOP_PROFILER_BUCKETS> phases[LOOP_PHASE_COUNT];  // us per phase
+  Histogram<LOOP_PROFILER_BUCKETS> loopPeriod;                // us between loop() entries
+  Histogram<LOOP_PROFILER_BUCKETS> acquisitionInterval;       // us between FIFO drains
+  Histogram<LOOP_PROFILER_BUCKETS> acquisitionTime;           // us per FIFO drain
+  uint32_t startTime;
+  uint32_t duration;  // us covered; set when the window completes
+
+  void reset(uint32_t now);
+};
+
+class LoopProfiler {
+private:
+  LoopProfileWindow windows[2];
+  uint8_t current;
+  bool completed;
+  uint32_t windowUs;
+
+  uint32_t lastLoopStart;
+  uint32_t phaseStart;
+  uint32_t lastAcquisition;
+  bool haveLoop;
+  bool haveAcquisition;
+
+public:
+  explicit LoopProfiler(uint32_t windowUs = LOOP_PROFILER_WINDOW_US);
+
+  void beginLoop(uint32_t now);
+  // Record the time since beginLoop() or the previous endPhase(); ignored
+  // before the first beginLoop()
+  void endPhase(LoopPhase phase, uint32_t now);
+  void recordAcquisition(uint32_t start, uint32_t end);
+
+  const LoopProfileWindow& getWindow() const;
+  bool isWindowComplete() const { return completed; }
+  uint32_t getWindowUs() const { return windowUs; }
+
+  void reset();
+};
+
+#endif // LOOP_PROFILER_H
@@ -0,0 +1,145 @@
+#ifndef MPU6050_FIFO_H
+#define MPU6050_FIFO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "I2cBus.h"
+#include "DoorMonitor.h"
+
+// MPU-6050 register map (subset used by the FIFO driver)
+#define MPU6050_DEFAULT_ADDRESS  0x68
+#define MPU6050_REG_SMPLRT_DIV   0x19
+#define MPU6050_REG_CONFIG       0x1A
+#define MPU6050_REG_GYRO_CONFIG  0x1B
+#define MPU6050_REG_ACCEL_CONFIG 0x1C
+#define MPU6050_REG_FIFO_EN      0x23
+#define MPU6050_REG_ACCEL_XOUT_H 0x3B
+#define MPU6050_REG_USER_CTRL    0x6A
+#define MPU6050_REG_PWR_MGMT_1   0x6B
+#define MPU6050_REG_PWR_MGMT_2   0x6C
+#define MPU6050_REG_FIFO_COUNT_H 0x72
+#define MPU6050_REG_FIFO_R_W     0x74
+#define MPU6050_REG_WHO_AM_I     0x75
+
+#define MPU6050_WHO_AM_I_VALUE   0x68  // WHO_AM_I contents, whatever the AD0 address
+#define MPU6050_FIFO_EN_ACCEL    0x08  // FIFO_EN: XYZ accel into FIFO
+#define MPU6050_FIFO_EN_GYRO_X   0x40  // FIFO_EN: gyro X into FIFO (after the accel)
+#define MPU6050_USER_CTRL_FIFO_EN    0x40
+#define MPU6050_USER_CTRL_FIFO_RESET 0x04
+#define MPU6050_PWR_MGMT_1_CLK_PLL_X 0x01
+#define MPU6050_PWR_MGMT_1_TEMP_DIS  0x08
+#define MPU6050_PWR_MGMT_1_CYCLE     0x20
+#define MPU6050_PWR_MGMT_2_STBY_GYRO 0x07  // STBY_XG | STBY_YG | STBY_ZG
+
+#define MPU6050_FIFO_SIZE        1024  // bytes of on-chip FIFO
+#define MPU6050_ACCEL_FRAME_SIZE 6     // bytes per accel-only FIFO frame
+#define MPU6050_GYRO_X_FRAME_SIZE 8    // bytes per accel + gyro X FIFO frame
+#define MPU6050_BURST_FRAMES     20    // accel-only frames per I2C transaction
+#define MPU6050_BURST_BYTES      (MPU6050_BURST_FRAMES * MPU6050_ACCEL_FRAME_SIZE)  // fits the Wire buffer
+#define MPU6050_GYRO_OUTPUT_RATE 1000  // Hz with the DLPF enabled
+#define MPU6050_GYRO_COUNTS_PER_DPS 131.0f  // +/-250 deg/s range (FS_SEL 0)
+
+#define STANDARD_GRAVITY 9.80665f
+
+// Accelerometer full-scale range (ACCEL_CONFIG AFS_SEL)
+enum AccelRange {
+  ACCEL_RANGE_2G,
+  ACCEL_RANGE_4G,
+  ACCEL_RANGE_8G,
+  ACCEL_RANGE_16G
+};
+
+// Accelerometer-only low power mode wake-up rate (PWR_MGMT_2 LP_WAKE_CTRL)
+enum CycleWakeRate {
+  CYCLE_WAKE_1_25HZ,
+  CYCLE_WAKE_5HZ,
+  CYCLE_WAKE_20HZ,
+  CYCLE_WAKE_40HZ
+};
+
+// One accelerometer sample as raw sensor counts
+struct RawAccelSample {
+  int16_t x;
+  int16_t y;
+  int16_t z;
+};
+
+// Burst reader for the MPU-6050 on-chip FIFO configured for accel-only frames.
+// Replaces per-sample getEvent() calls (accel + temp + gyro, 14 bytes each) with
+// 6 bytes per sample read in bursts, plus one 2-byte FIFO count read per burst.
+// Optionally each frame also carries the gyro X rate (8 bytes per sample), the
+// door's rotation axis, for TiltEstimator.
+class Mpu6050Fifo {
+private:
+  I2cBus& bus;
+  uint8_t address;
+  AccelRange range;
+  unsigned long samplePeriodUs;
+  uint32_t overflowCount;
+  bool cycling;
+  uint8_t fifoDivider;  // SMPLRT_DIV for FIFO sampling, kept across cycle mode
+  bool gyroX;
+  size_t frameSize;
+
+  static uint8_t rateDivider(unsigned int sampleRateHz);
+  bool queuedSamples(size_t maxSamples, size_t& count, size_t& available);
+  size_t burstFrames() const { return MPU6050_BURST_BYTES / frameSize; }
+  bool readFrames(RawAccelSample* samples, int16_t* gyroCounts, size_t count);
+
+public:
+  Mpu6050Fifo(I2cBus& i2c, uint8_t i2cAddress = MPU6050_DEFAULT_ADDRESS);
+
+  // Configure sample rate (4..1000 Hz), range and enable the FIFO, accel-only
+  // or with gyro X at +/-250 deg/s.
+  bool begin(AccelRange accelRange, unsigned int sampleRateHz, bool withGyroX = false);
+
+  // Change the FIFO sample rate (4..1000 Hz); queued samples are discarded so
+  // readBatch() never spaces old samples by the new period
+  bool setSampleRate(unsigned int sampleRateHz);
+
+  // Accelerometer-only cycle mode: the gyros and temperature sensor stand by,
+  // the chip sleeps between single accel samples at the first wake rate at or
+  // above sampleRateHz (1.25, 5, 20 or 40 Hz) and the FIFO is stopped. Read
+  // samples with readLatest(); exitCycleMode() restores FIFO sampling at the
+  // previous rate. There is no gyro data in cycle mode.
+  bool enterCycleMode(unsigned int sampleRateHz);
+  bool exitCycleMode();
+
+  // Read the accel data registers (the newest sample) and convert to m/s^2
+  bool readLatest(AccelData& sample);
+
+  // Discard FIFO contents and restart collection
+  bool resetFifo();
+
+  // Number of bytes currently queued in the FIFO; returns false on bus error
+  bool readFifoCount(uint16_t& count);
+
+  // Burst read up to maxSamples raw samples, oldest first. count receives the
+  // number read. A FIFO overflow resets the FIFO and reads nothing; a partly
+  // written frame at the end is left for the next read. Returns false on bus
+  // error.
+  bool readRaw(RawAccelSample* samples, size_t maxSamples, size_t& count);
+
+  // Burst read and convert to m/s^2. The newest frame in the FIFO is stamped
+  // currentTime and the rest spaced back by the sample period, so when more
+  // than maxSamples are queued the ones read end before currentTime and the
+  // next read continues from there. gyroRates (may be NULL)
+  // receives gyro X in deg/s, or NAN when the FIFO carries no gyro data.
+  bool readBatch(AccelData* samples, unsigned long* times, size_t maxSamples,
+                 unsigned long currentTime, size_t& count, float* gyroRates = NULL);
+
+  AccelRange getRange() const { return range; }
+  // FIFO sample period, or the wake period in cycle mode
+  unsigned long getSamplePeriodUs() const { return samplePeriodUs; }
+  bool isCycleMode() const { return cycling; }
+  bool hasGyroX() const { return gyroX; }
+  uint32_t getOverflowCount() const { return overflowCount; }
+
+  // Conversion helpers
+  static float countsPerG(AccelRange accelRange);
+  static float countsToMs2(int16_t counts, AccelRange accelRange);
+  static float gyroCountsToDps(int16_t counts);
+  static void decodeFrame(const uint8_t* frame, RawAccelSample& sample);
+};
+
+#endif // MPU6050_FIFO_H
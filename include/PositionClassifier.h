@@ -0,0 +1,42 @@
+#ifndef POSITION_CLASSIFIER_H
+#define POSITION_CLASSIFIER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "DoorMonitor.h"
+
+// Block classification of Y/Z samples into closed / open / intermediate, for
+// re-classifying recorded traces (e.g. while tuning positionTolerance).
+//
+// Results are bitmasks: sample i is bit (i % 32) of word i / 32. Each mask
+// array needs positionMaskWords(n) words; unused bits of the last word are 0.
+// A sample is closed when isInClosedPosition() holds, open when
+// isInOpenPosition() holds and it is not closed (the order DoorMonitor checks
+// them in), and intermediate otherwise.
+//
+// The implementation is picked at compile time: AVX2 (8 samples per step)
+// when __AVX2__ is defined, SSE2 (4 per step) when __SSE2__ is defined, and a
+// portable scalar loop otherwise or when POSITION_CLASSIFIER_SCALAR is
+// defined. All give identical results.
+
+#define POSITION_MASK_BITS 32
+
+inline size_t positionMaskWords(size_t n) {
+  return (n + POSITION_MASK_BITS - 1) / POSITION_MASK_BITS;
+}
+
+// Any mask pointer may be NULL if that class isn't needed
+void classifyPositions(const float* accelY, const float* accelZ, size_t n, const DoorMonitorConfig& config,
+                       uint32_t* closedMask, uint32_t* openMask, uint32_t* intermediateMask);
+
+// The portable implementation, always available (reference for tests and benchmarks)
+void classifyPositionsScalar(const float* accelY, const float* accelZ, size_t n, const DoorMonitorConfig& config,
+                             uint32_t* closedMask, uint32_t* openMask, uint32_t* intermediateMask);
+
+// "avx2", "sse2" or "scalar"
+const char* positionClassifierImpl();
+
+// Number of set bits in the first n bits of a mask
+size_t countPositions(const uint32_t* mask, size_t n);
+
+#endif // POSITION_CLASSIFIER_H
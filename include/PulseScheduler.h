@@ -0,0 +1,39 @@
+#ifndef PULSE_SCHEDULER_H
+#define PULSE_SCHEDULER_H
+
+#include <stdint.h>
+
+#define TRIGGER_PULSE_MS 500      // how long the opener button is "pressed"
+#define TRIGGER_COOLDOWN_MS 1000  // requests this soon after a pulse are coalesced
+
+// Non-blocking output pulse: request() starts a pulse, update() is polled from
+// loop() with the current time and says whether the output should be high.
+// Requests while a pulse is running (or within the cooldown after it) are
+// coalesced instead of queued, so double clicks do not reverse the door.
+class PulseScheduler {
+private:
+  unsigned long pulseDuration;
+  unsigned long cooldown;
+  unsigned long pulseStart;
+  bool active;
+  bool pending;        // pulse finished, cooldown still running
+  uint32_t pulseCount;
+  uint32_t coalescedCount;
+
+public:
+  PulseScheduler(unsigned long durationMs = TRIGGER_PULSE_MS, unsigned long cooldownMs = TRIGGER_COOLDOWN_MS);
+
+  // Start a pulse. Returns false if the request was coalesced into the current one.
+  bool request(unsigned long currentTime);
+
+  // Advance the pulse. Returns true while the output should be driven high.
+  bool update(unsigned long currentTime);
+
+  bool isActive() const { return active; }
+  bool isBusy() const { return active || pending; }
+  unsigned long getRemaining(unsigned long currentTime) const;
+  uint32_t getPulseCount() const { return pulseCount; }
+  uint32_t getCoalescedCount() const { return coalescedCount; }
+};
+
+#endif // PULSE_SCHEDULER_H
@@ -0,0 +1,47 @@
+#ifndef RTC_SNAPSHOT_STORAGE_H
+#define RTC_SNAPSHOT_STORAGE_H
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+#include <string.h>
+#include "SnapshotStorage.h"
+
+// SnapshotStorage in the ESP8266's RTC user memory: 512 bytes addressed in
+// 4-byte blocks that keep their contents through resets (watchdog,
+// exception, ESP.restart(), OTA) but not power loss. The first 128 bytes
+// belong to the OTA boot loader, hence the default offset.
+#define RTC_SNAPSHOT_DEFAULT_BLOCK 32
+#define RTC_SNAPSHOT_MAX_SIZE 256
+
+class RtcSnapshotStorage : public SnapshotStorage {
+private:
+  uint32_t block;
+
+public:
+  explicit RtcSnapshotStorage(uint32_t firstBlock = RTC_SNAPSHOT_DEFAULT_BLOCK) : block(firstBlock) {}
+
+  bool load(uint8_t* data, size_t length) override {
+    uint32_t words[RTC_SNAPSHOT_MAX_SIZE / 4];
+    size_t padded = (length + 3) & ~(size_t)3;
+    if (padded > sizeof(words) || !ESP.rtcUserMemoryRead(block, words, padded)) {
+      return false;
+    }
+    memcpy(data, words, length);
+    return true;
+  }
+
+  bool save(const uint8_t* data, size_t length) override {
+    uint32_t words[RTC_SNAPSHOT_MAX_SIZE / 4] = {0};
+    size_t padded = (length + 3) & ~(size_t)3;
+    if (padded > sizeof(words)) {
+      return false;
+    }
+    memcpy(words, data, length);
+    return ESP.rtcUserMemoryWrite(block, words, padded);
+  }
+};
+
+#endif // ARDUINO
+
+#endif // RTC_SNAPSHOT_STORAGE_H
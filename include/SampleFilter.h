@@ -0,0 +1,259 @@
+#ifndef SAMPLE_FILTER_H
+#define SAMPLE_FILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "DoorMonitor.h"
+
+// Noise filter stage between the sensor and DoorMonitor, which compares
+// consecutive samples and so sees every single-sample spike as movement.
+//
+// A kernel filters one axis a sample at a time with fixed state:
+//   PassThroughKernel        - no filtering
+//   MovingAverageKernel<N>   - mean of the last N samples
+//   ExponentialKernel<Shift> - y += (x - y) / 2^Shift
+//   MedianKernel<N>          - median of the last N samples (N odd); removes
+//                              spikes shorter than N / 2 + 1 samples
+// The first sample after construction or reset() fills the kernel's history,
+// so a fresh filter starts at the signal instead of ramping up from 0.
+// AccelFilter<Kernel> runs one kernel per axis; the kernel is a template
+// argument so the per-sample call inlines and nothing is allocated.
+
+class PassThroughKernel {
+public:
+  float apply(float value) { return value; }
+  void reset() {}
+  static const char* name() { return "none"; }
+};
+
+// Running sum, recomputed from the window once per wrap so float rounding
+// does not accumulate
+template <size_t N>
+class MovingAverageKernel {
+  static_assert(N >= 1, "MovingAverageKernel needs a window");
+
+private:
+  float window[N];
+  float sum;
+  size_t next;
+  bool primed;
+
+public:
+  MovingAverageKernel() { reset(); }
+
+  float apply(float value) {
+    if (!primed) {
+      for (size_t i = 0; i < N; i++) {
+        window[i] = value;
+      }
+      sum = value * N;
+      primed = true;
+      return value;
+    }
+    sum += value - window[next];
+    window[next] = value;
+    if (++next == N) {
+      next = 0;
+      sum = 0;
+      for (size_t i = 0; i < N; i++) {
+        sum += window[i];
+      }
+    }
+    return sum / N;
+  }
+
+  void reset() {
+    next = 0;
+    sum = 0;
+    primed = false;
+  }
+
+  static const char* name() { return "average"; }
+};
+
+template <unsigned Shift>
+class ExponentialKernel {
+  static_assert(Shift >= 1 && Shift <= 8, "ExponentialKernel shift out of range");
+
+private:
+  float state;
+  bool primed;
+
+public:
+  ExponentialKernel() { reset(); }
+
+  float apply(float value) {
+    if (!primed) {
+      state = value;
+      primed = true;
+    } else {
+      state += (value - state) * (1.0f / (1 << Shift));
+    }
+    return state;
+  }
+
+  void reset() {
+    state = 0;
+    primed = false;
+  }
+
+  static const char* name() { return "exponential"; }
+};
+
+// Keeps the window both in arrival order and sorted; each sample replaces the
+// oldest value in the sorted copy with one O(N) shift
+template <size_t N>
+class MedianKernel {
+  static_assert(N >= 3 && N % 2 == 1, "MedianKernel needs an odd window of at least 3");
+
+private:
+  float window[N];
+  float sorted[N];
+  size_t next;
+  bool primed;
+
+public:
+  MedianKernel() { reset(); }
+
+  float apply(float value) {
+    if (!primed) {
+      for (size_t i = 0; i < N; i++) {
+        window[i] = value;
+        sorted[i] = value;
+      }
+      primed = true;
+      return value;
+    }
+
+    float oldest = window[next];
+    window[next] = value;
+    if (++next == N) {
+      next = 0;
+    }
+
+    size_t i = 0;
+    while (i + 1 < N && sorted[i] != oldest) {
+      i++;
+    }
+    if (value > oldest) {
+      for (; i + 1 < N && sorted[i + 1] < value; i++) {
+        sorted[i] = sorted[i + 1];
+      }
+    } else {
+      for (; i > 0 && sorted[i - 1] > value; i--) {
+        sorted[i] = sorted[i - 1];
+      }
+    }
+    sorted[i] = value;
+    return sorted[N / 2];
+  }
+
+  void reset() {
+    next = 0;
+    primed = false;
+  }
+
+  static const char* name() { return "median"; }
+};
+
+// Filters accelY and accelZ (the axes DoorMonitor reads); accelX passes
+// through. An invalid sample passes through unchanged and resets the
+// kernels, so values from before a sensor dropout do not leak past it.
+template <typename Kernel>
+class AccelFilter {
+private:
+  Kernel y;
+  Kernel z;
+
+public:
+  void apply(AccelData& sample) {
+    if (!sample.valid) {
+      reset();
+      return;
+    }
+    sample.y = y.apply(sample.y);
+    sample.z = z.apply(sample.z);
+  }
+
+  void applyBatch(AccelData* samples, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+      apply(samples[i]);
+    }
+  }
+
+  void reset() {
+    y.reset();
+    z.reset();
+  }
+
+  static const char* name() { return Kernel::name(); }
+};
+
+#ifndef ARDUINO
+// Run-time choice among stock kernels, for host tools that compare them on
+// recorded traces (the firmware picks its kernel at compile time)
+enum SampleFilterKind {
+  SAMPLE_FILTER_NONE,
+  SAMPLE_FILTER_MEDIAN3,
+  SAMPLE_FILTER_MEDIAN5,
+  SAMPLE_FILTER_AVERAGE4,
+  SAMPLE_FILTER_EXPONENTIAL2,
+  SAMPLE_FILTER_KIND_COUNT
+};
+
+// Names as accepted on tool command lines, e.g. "median5"
+inline const char* sampleFilterName(SampleFilterKind kind) {
+  static const char* const names[SAMPLE_FILTER_KIND_COUNT] = {
+    "none", "median3", "median5", "average4", "exponential2"
+  };
+  return kind < SAMPLE_FILTER_KIND_COUNT ? names[kind] : "";
+}
+
+inline bool sampleFilterFromName(const char* name, SampleFilterKind& kind) {
+  for (int i = 0; i < SAMPLE_FILTER_KIND_COUNT; i++) {
+    const char* candidate = sampleFilterName((SampleFilterKind)i);
+    size_t j = 0;
+    while (candidate[j] && candidate[j] == name[j]) {
+      j++;
+    }
+    if (candidate[j] == name[j]) {
+      kind = (SampleFilterKind)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+class SelectableSampleFilter {
+private:
+  SampleFilterKind kind;
+  AccelFilter<MedianKernel<3> > median3;
+  AccelFilter<MedianKernel<5> > median5;
+  AccelFilter<MovingAverageKernel<4> > average4;
+  AccelFilter<ExponentialKernel<2> > exponential2;
+
+public:
+  explicit SelectableSampleFilter(SampleFilterKind filterKind = SAMPLE_FILTER_NONE) : kind(filterKind) {}
+
+  void applyBatch(AccelData* samples, size_t n) {
+    switch (kind) {
+      case SAMPLE_FILTER_MEDIAN3: median3.applyBatch(samples, n); break;
+      case SAMPLE_FILTER_MEDIAN5: median5.applyBatch(samples, n); break;
+      case SAMPLE_FILTER_AVERAGE4: average4.applyBatch(samples, n); break;
+      case SAMPLE_FILTER_EXPONENTIAL2: exponential2.applyBatch(samples, n); break;
+      default: break;
+    }
+  }
+
+  void reset() {
+    median3.reset();
+    median5.reset();
+    average4.reset();
+    exponential2.reset();
+  }
+
+  SampleFilterKind getKind() const { return kind; }
+};
+#endif
+
+#endif // SAMPLE_FILTER_H
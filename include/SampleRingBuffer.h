@@ -0,0 +1,79 @@
+#ifndef SAMPLE_RING_BUFFER_H
+#define SAMPLE_RING_BUFFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "DoorMonitor.h"
+
+// Sensor sample with the time it was acquired
+struct TimedSample {
+  AccelData accel;
+  float gyroRate;  // gyro X in deg/s, NAN when the sample has none
+  unsigned long time;
+};
+
+// Fixed-capacity, allocation-free single-producer/single-consumer ring buffer.
+// One context (timer callback on the ESP8266, a thread on native) may call push(),
+// one other context may call pop()/popBatch(). No locks are taken: the producer
+// only writes head, the consumer only writes tail. Capacity must be a power of two.
+template <typename T, size_t Capacity>
+class SpscRingBuffer {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "SpscRingBuffer capacity must be a power of two");
+
+private:
+  T buffer[Capacity];
+  std::atomic<size_t> head;        // next slot to write (producer)
+  std::atomic<size_t> tail;        // next slot to read (consumer)
+  std::atomic<uint32_t> dropped;   // pushes rejected because the buffer was full
+
+public:
+  SpscRingBuffer() : head(0), tail(0), dropped(0) {}
+
+  // Producer side. Returns false (and counts a drop) if the buffer is full.
+  bool push(const T& item) {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= Capacity) {
+      dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      return false;
+    }
+    buffer[h & (Capacity - 1)] = item;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. Returns false if the buffer is empty.
+  bool pop(T& item) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = buffer[t & (Capacity - 1)];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. Pops up to maxItems items in FIFO order, returns the count.
+  size_t popBatch(T* items, size_t maxItems) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    size_t available = head.load(std::memory_order_acquire) - t;
+    size_t count = available < maxItems ? available : maxItems;
+    for (size_t i = 0; i < count; i++) {
+      items[i] = buffer[(t + i) & (Capacity - 1)];
+    }
+    tail.store(t + count, std::memory_order_release);
+    return count;
+  }
+
+  // Approximate when called concurrently with the other side
+  size_t size() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+  bool empty() const { return size() == 0; }
+  static constexpr size_t capacity() { return Capacity; }
+  uint32_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+};
+
+// Buffer between sensor acquisition and DoorMonitor evaluation
+typedef SpscRingBuffer<TimedSample, 64> SampleRingBuffer;
+
+#endif // SAMPLE_RING_BUFFER_H
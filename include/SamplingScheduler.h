@@ -0,0 +1,53 @@
+#ifndef SAMPLING_SCHEDULER_H
+#define SAMPLING_SCHEDULER_H
+
+#include <stdint.h>
+
+#define SAMPLING_IDLE_RATE_HZ 5         // MPU-6050 cycle mode while the door rests
+#define SAMPLING_ACTIVE_RATE_HZ 50      // FIFO rate while moving or about to move
+#define SAMPLING_IDLE_DELAY_MS 30000    // at rest this long before dropping to idle
+
+enum SamplingMode {
+  SAMPLING_ACTIVE,
+  SAMPLING_IDLE
+};
+
+// Chooses the sensor sampling rate from the door state. Polled from loop()
+// with whether the door is at a position (CLOSED or OPEN): after it has
+// rested for the idle delay the scheduler drops to the idle rate, and it
+// returns to the active rate on the first update that is not at rest, or
+// immediately on boost() (a trigger request, before any motion is visible).
+// Starts active so the state is settled at full rate after boot.
+class SamplingScheduler {
+private:
+  unsigned int idleRate;
+  unsigned int activeRate;
+  unsigned long idleDelay;
+  SamplingMode mode;
+  bool resting;
+  unsigned long restStart;
+  unsigned long modeStart;
+  unsigned long idleTotal;   // completed idle periods
+  uint32_t switchCount;
+
+  void setMode(SamplingMode next, unsigned long currentTime);
+
+public:
+  SamplingScheduler(unsigned int idleRateHz = SAMPLING_IDLE_RATE_HZ,
+                    unsigned int activeRateHz = SAMPLING_ACTIVE_RATE_HZ,
+                    unsigned long idleDelayMs = SAMPLING_IDLE_DELAY_MS);
+
+  // Returns the mode to sample in from now on
+  SamplingMode update(bool atRest, unsigned long currentTime);
+
+  // Switch to the active rate now and restart the idle delay
+  void boost(unsigned long currentTime);
+
+  SamplingMode getMode() const { return mode; }
+  unsigned int getRateHz() const { return mode == SAMPLING_IDLE ? idleRate : activeRate; }
+  uint32_t getSwitchCount() const { return switchCount; }
+  // Total time spent in idle mode, including the current idle period
+  unsigned long getIdleTime(unsigned long currentTime) const;
+};
+
+#endif // SAMPLING_SCHEDULER_H
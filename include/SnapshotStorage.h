@@ -0,0 +1,22 @@
+#ifndef SNAPSHOT_STORAGE_H
+#define SNAPSHOT_STORAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Slot holding one DoorSnapshot blob across reboots. Implemented by
+// RtcSnapshotStorage on the ESP8266 (survives resets, not power loss) and
+// FileSnapshotStorage on native builds. The blob carries its own CRC, so
+// load() may return whatever happens to be there.
+class SnapshotStorage {
+public:
+  virtual ~SnapshotStorage() {}
+
+  // Read length bytes. Returns false on error or if nothing is stored.
+  virtual bool load(uint8_t* data, size_t length) = 0;
+
+  // Replace the stored bytes. Returns false on error.
+  virtual bool save(const uint8_t* data, size_t length) = 0;
+};
+
+#endif // SNAPSHOT_STORAGE_H
@@ -0,0 +1,65 @@
+#ifndef STATUS_JSON_H
+#define STATUS_JSON_H
+
+#include <stddef.h>
+#include "DoorMonitor.h"
+#include "LoopProfiler.h"
+#include "EventJournal.h"
+#include "TelemetryHistory.h"
+#include "DoorPositionEstimator.h"
+
+#define STATUS_JSON_BUFFER_SIZE 384
+
+// Serialize the /status document into buffer without heap allocation.
+// Returns the length written, or 0 if the buffer was too small.
+size_t writeStatusJson(char* buffer, size_t capacity, const DoorMonitorBase& monitor, const AccelData& accel);
+
+// The same with the position estimate appended:
+//   "position":{"percent":42.5,"velocity":8.3,"etaMs":6800,"openingMs":12000,"closingMs":13500}
+// velocity in percent per second (positive = opening), etaMs only while an
+// arrival estimate exists, travel times 0 until learned.
+size_t writeStatusJson(char* buffer, size_t capacity, const DoorMonitorBase& monitor, const AccelData& accel,
+                       const DoorPositionEstimator& position);
+
+#ifdef DOOR_MONITOR_METRICS
+#define METRICS_JSON_BUFFER_SIZE 1024
+
+// Serialize the /metrics document (DoorMonitor instrumentation histograms).
+// Returns the length written, or 0 if the buffer was too small.
+size_t writeMetricsJson(char* buffer, size_t capacity, const DoorMonitorMetrics& metrics);
+#endif
+
+#define LOOP_PROFILE_JSON_BUFFER_SIZE 2048
+
+// Serialize the /profile document (the profiler's reporting window: loop
+// period and acquisition spacing with buckets, per-phase summaries without).
+// Returns the length written, or 0 if the buffer was too small.
+size_t writeLoopProfileJson(char* buffer, size_t capacity, const LoopProfiler& profiler);
+
+#define JOURNAL_ENTRY_JSON_BUFFER_SIZE 64
+
+// Serialize one /history entry: {"time":1200,"state":"OPENING"}, or
+// {"time":500,"boot":true} for a restart. Returns 0 if the buffer was too small.
+size_t writeJournalEntryJson(char* buffer, size_t capacity, const JournalEntry& entry);
+
+#define TELEMETRY_JSON_HEADER_BUFFER_SIZE 96
+#define TELEMETRY_BUCKET_JSON_BUFFER_SIZE 48
+#define TELEMETRY_BUCKET_EVENT_JSON_BUFFER_SIZE 128
+
+// The /telemetry?format=json document is streamed in pieces: this header
+// ({"tier":0,"periodMs":1000,"endMs":..,"scale":0.01,"buckets":[), then one
+// writeTelemetryBucketJson() per bucket, comma separated, then "]}".
+// Returns 0 if the buffer was too small.
+size_t writeTelemetryJsonHeader(char* buffer, size_t capacity, const TelemetryHistory& history, uint8_t tier);
+
+// One bucket as [minY,maxY,meanY,minZ,maxZ,meanZ] in stored units (multiply
+// by scale for m/s^2), or null for a period without samples
+size_t writeTelemetryBucketJson(char* buffer, size_t capacity, const TelemetryBucket& bucket);
+
+// The newest committed bucket of a tier, for the SSE "bucket" event:
+// {"tier":0,"periodMs":1000,"endMs":..,"bucket":[..] or null}. endMs tells
+// subscribers how many periods passed since the last one (the skipped ones
+// were empty). Returns 0 if the buffer was too small or the tier is empty.
+size_t writeTelemetryBucketEventJson(char* buffer, size_t capacity, const TelemetryHistory& history, uint8_t tier);
+
+#endif // STATUS_JSON_H
@@ -0,0 +1,85 @@
+#ifndef TELEMETRY_HISTORY_H
+#define TELEMETRY_HISTORY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Multi-resolution history of accelY/accelZ for the web UI sparkline.
+//
+// Each tier is a fixed ring of TELEMETRY_TIER_BUCKETS buckets holding the
+// min, max and mean of the samples in one period (1 s, 1 min, 1 h), stored as
+// int16 in 0.01 m/s^2. Every sample goes straight into the open bucket of
+// each tier; a bucket is committed when a sample lands past its end, and
+// periods without samples are committed as empty buckets. Memory is fixed
+// and add() is O(1) apart from filling gaps (at most one ring per tier).
+// Periods are aligned to multiples of their length in millis().
+
+#define TELEMETRY_TIER_COUNT 3
+#define TELEMETRY_TIER_BUCKETS 120        // 2 min / 2 h / 5 days
+#define TELEMETRY_UNITS_PER_MS2 100       // stored value = m/s^2 * 100
+#define TELEMETRY_NO_DATA (-32768)        // every field of an empty bucket
+
+#define TELEMETRY_BINARY_VERSION 1
+#define TELEMETRY_BINARY_HEADER_SIZE 12
+#define TELEMETRY_BINARY_BUCKET_SIZE 12
+
+struct TelemetryBucket {
+  int16_t minY;
+  int16_t maxY;
+  int16_t meanY;
+  int16_t minZ;
+  int16_t maxZ;
+  int16_t meanZ;
+
+  bool isEmpty() const { return meanY == TELEMETRY_NO_DATA; }
+};
+
+class TelemetryHistory {
+private:
+  // Open bucket of a tier
+  struct Accumulator {
+    unsigned long start;
+    unsigned long end;
+    int64_t sumY;
+    int64_t sumZ;
+    uint32_t count;
+    int16_t minY;
+    int16_t maxY;
+    int16_t minZ;
+    int16_t maxZ;
+  };
+
+  TelemetryBucket buckets[TELEMETRY_TIER_COUNT][TELEMETRY_TIER_BUCKETS];
+  size_t head[TELEMETRY_TIER_COUNT];   // next slot to write
+  size_t filled[TELEMETRY_TIER_COUNT];
+  Accumulator current[TELEMETRY_TIER_COUNT];
+  bool started;
+
+  void commit(uint8_t tier, const TelemetryBucket& bucket);
+  void roll(uint8_t tier, unsigned long time);
+
+public:
+  TelemetryHistory();
+
+  void add(unsigned long time, float accelY, float accelZ);
+  void reset();
+
+  static unsigned long getPeriod(uint8_t tier);
+  size_t getBucketCount(uint8_t tier) const { return filled[tier]; }
+  // Committed bucket i of a tier, 0 = oldest
+  const TelemetryBucket& getBucket(uint8_t tier, size_t i) const;
+  // End of the newest committed bucket (0 before the first)
+  unsigned long getEndTime(uint8_t tier) const;
+};
+
+// Packed binary form of a tier, little-endian:
+//
+//   header (12 bytes): version u8 | tier u8 | bucket count u16 |
+//                      period u32 (ms) | end time u32 (ms, newest bucket)
+//   bucket (12 bytes): minY maxY meanY minZ maxZ meanZ, each i16
+//
+// Buckets follow the header oldest first.
+void encodeTelemetryHeader(const TelemetryHistory& history, uint8_t tier, uint8_t* out);
+void encodeTelemetryBucket(const TelemetryBucket& bucket, uint8_t* out);
+
+#endif // TELEMETRY_HISTORY_H
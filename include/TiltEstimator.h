@@ -0,0 +1,65 @@
+#ifndef TILT_ESTIMATOR_H
+#define TILT_ESTIMATOR_H
+
+#include <stdint.h>
+
+// Door angle and angular velocity from accel Y/Z and the gyro X rate, as
+// input for DoorMonitor's angle mode (updateStateAngle).
+//
+// The accelerometer gives an absolute angle, atan2(accelZ, accelY) with
+// 0 = closed/vertical and 90 = open/horizontal, but every vibration shows up
+// in it. The gyro rate is clean but offset by a bias that drifts with
+// temperature. A complementary filter with bias estimation fuses the two:
+//
+//   error = accelAngle - angle
+//   bias  -= ki * error * dt
+//   rate  = gyro - bias
+//   angle += (rate + kp * error) * dt
+//
+// kp = 1 / timeConstant, ki = kp^2 / 4 (critically damped), so the gyro
+// dominates over shorter spans and the accelerometer pins the angle and the
+// bias over longer ones. Without gyro data (updateAccelOnly, e.g. while the
+// sensor is in cycle mode) the angle and rate are low-passed from the accel
+// angle alone, with the same time constant.
+//
+// Angles are in degrees, rates in deg/s, positive towards open.
+
+#define TILT_TIME_CONSTANT_MS 500
+#define TILT_MAX_GAP_MS 1000  // longer gaps between samples restart from the accel angle
+
+class TiltEstimator {
+private:
+  float timeConstantMs;
+  float gyroSign;
+  float angle;
+  float rate;
+  float bias;
+  float lastAccelAngle;
+  unsigned long lastTime;
+  bool primed;
+
+  // Start (or restart) at the accel angle; returns the time step in s, or
+  // a negative value when the estimate was restarted
+  float step(float accelAngleDeg, unsigned long time);
+
+public:
+  // gyroSign is 1 or -1, whichever makes the gyro X rate positive while the
+  // door opens (it depends on how the sensor is mounted)
+  explicit TiltEstimator(float timeConstantMs = TILT_TIME_CONSTANT_MS, float gyroSign = 1.0f);
+
+  // One sample; gyroRate is gyro X in deg/s as read from the sensor
+  void update(float accelY, float accelZ, float gyroRate, unsigned long time);
+  void updateAccelOnly(float accelY, float accelZ, unsigned long time);
+
+  // Forget the angle; the learned bias is kept unless clearBias is set
+  void reset(bool clearBias = false);
+
+  float getAngle() const { return angle; }
+  float getRate() const { return rate; }
+  float getBias() const { return bias; }
+  bool isPrimed() const { return primed; }
+
+  static float accelAngle(float accelY, float accelZ);
+};
+
+#endif // TILT_ESTIMATOR_H
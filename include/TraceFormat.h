@@ -0,0 +1,82 @@
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Mpu6050Fifo.h"
+
+// Binary sensor trace format (.gdt), little-endian:
+//
+//   header (16 bytes): "GDTR" | version u8 | AccelRange u8 | reserved u16 |
+//                      start time u32 (ms) | sample count u32 (0 = unknown)
+//   record  (8 bytes): delta u16 (ms since previous record) | x i16 | y i16 | z i16
+//
+// A record with x = y = z = -32768 is a failed sensor read. A record with
+// delta 0xFFFF is a time skip of 65535 ms and carries no sample.
+
+#define TRACE_MAGIC "GDTR"
+#define TRACE_VERSION 1
+#define TRACE_HEADER_SIZE 16
+#define TRACE_RECORD_SIZE 8
+#define TRACE_DELTA_SKIP 0xFFFF
+#define TRACE_INVALID_COUNTS (-32768)
+
+struct TraceHeader {
+  uint8_t version;
+  AccelRange range;
+  unsigned long startTime;
+  uint32_t sampleCount;
+};
+
+struct TraceRecord {
+  unsigned long time;
+  RawAccelSample accel;
+  bool valid;
+};
+
+// Header encode/decode. decode returns false on bad magic/version/size.
+void encodeTraceHeader(const TraceHeader& header, uint8_t* out);
+bool decodeTraceHeader(const uint8_t* data, size_t size, TraceHeader& header);
+
+// Incremental record encoder
+class TraceEncoder {
+private:
+  unsigned long lastTime;
+
+public:
+  explicit TraceEncoder(unsigned long startTime) : lastTime(startTime) {}
+
+  // Encode one sample (plus any time-skip records it needs). Returns the bytes
+  // written, or 0 if out is too small. Records must be in time order.
+  size_t encode(const TraceRecord& record, uint8_t* out, size_t outSize);
+};
+
+// Sequential reader over an in-memory (e.g. memory-mapped) trace
+class TraceReader {
+private:
+  const uint8_t* data;
+  size_t size;
+  size_t offset;
+  unsigned long time;
+  TraceHeader header;
+  bool headerValid;
+
+public:
+  TraceReader(const uint8_t* traceData, size_t traceSize);
+
+  bool isValid() const { return headerValid; }
+  const TraceHeader& getHeader() const { return header; }
+
+  // Next sample in the trace; false at the end
+  bool next(TraceRecord& record);
+
+  // Decode up to maxSamples samples straight into DoorMonitor batch arrays
+  size_t nextBatch(AccelData* samples, unsigned long* times, size_t maxSamples);
+
+  void rewind();
+};
+
+// Convert a trace record to m/s^2 for DoorMonitor
+AccelData traceRecordToAccel(const TraceRecord& record, AccelRange range);
+
+#endif // TRACE_FORMAT_H
@@ -0,0 +1,42 @@
+#ifndef WIRE_I2C_BUS_H
+#define WIRE_I2C_BUS_H
+
+#ifdef ARDUINO
+
+#include <Wire.h>
+#include "I2cBus.h"
+
+// I2cBus implementation on top of the Arduino Wire library
+class WireI2cBus : public I2cBus {
+private:
+  TwoWire& wire;
+  
+public:
+  explicit WireI2cBus(TwoWire& w) : wire(w) {}
+  
+  bool writeRegister(uint8_t address, uint8_t reg, uint8_t value) override {
+    wire.beginTransmission(address);
+    wire.write(reg);
+    wire.write(value);
+    return wire.endTransmission() == 0;
+  }
+  
+  bool readRegisters(uint8_t address, uint8_t reg, uint8_t* data, size_t length) override {
+    wire.beginTransmission(address);
+    wire.write(reg);
+    if (wire.endTransmission(false) != 0) {
+      return false;
+    }
+    if (wire.requestFrom(address, (uint8_t)length) != length) {
+      return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+      data[i] = wire.read();
+    }
+    return true;
+  }
+};
+
+#endif // ARDUINO
+
+#endif // WIRE_I2C_BUS_H
@@ -0,0 +1,268 @@
+#include "ConfigSweep.h"
+#include <string.h>
+
+#ifndef ARDUINO
+#include <atomic>
+#include <thread>
+#endif
+
+#define SWEEP_CHUNK_SIZE 64
+
+static const DoorState NAMED_STATES[] = {
+  DOOR_CLOSED, DOOR_OPEN, DOOR_STOPPED, DOOR_OPENING, DOOR_CLOSING, DOOR_UNKNOWN,
+  DOOR_ERROR_SENSOR_FAILURE, DOOR_ERROR_TIMEOUT, DOOR_ERROR_STALLED
+};
+
+static const char* const PARAM_NAMES[SWEEP_PARAM_COUNT] = {
+  "threshold", "stop", "maxopen", "maxclose", "stall", "stalltime", "tolerance"
+};
+
+void SweepScore::add(const SweepScore& other) {
+  expected += other.expected;
+  detected += other.detected;
+  matched += other.matched;
+  totalLatency += other.totalLatency;
+  if (other.maxLatency > maxLatency) {
+    maxLatency = other.maxLatency;
+  }
+}
+
+bool sweepScoreBetter(const SweepScore& a, const SweepScore& b) {
+  if (a.accuracy() != b.accuracy()) {
+    return a.accuracy() > b.accuracy();
+  }
+  return a.meanLatency() < b.meanLatency();
+}
+
+bool doorStateFromName(const char* name, size_t length, DoorState& state) {
+  for (size_t i = 0; i < sizeof(NAMED_STATES) / sizeof(NAMED_STATES[0]); i++) {
+    const char* candidate = doorStateName(NAMED_STATES[i]);
+    if (strlen(candidate) == length && strncmp(candidate, name, length) == 0) {
+      state = NAMED_STATES[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool isBlank(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+bool parseTraceLabels(const char* text, size_t size, std::vector<TraceLabel>& labels, size_t* errorLine) {
+  labels.clear();
+  size_t line = 0;
+  size_t pos = 0;
+
+  while (pos < size) {
+    line++;
+    size_t end = pos;
+    while (end < size && text[end] != '\n') {
+      end++;
+    }
+
+    size_t p = pos;
+    while (p < end && isBlank(text[p])) p++;
+    if (p < end && text[p] != '#') {
+      // time
+      unsigned long time = 0;
+      size_t digits = 0;
+      while (p < end && text[p] >= '0' && text[p] <= '9') {
+        time = time * 10 + (unsigned long)(text[p] - '0');
+        p++;
+        digits++;
+      }
+      while (p < end && isBlank(text[p])) p++;
+      // state
+      size_t nameStart = p;
+      while (p < end && !isBlank(text[p]) && text[p] != '#') p++;
+      size_t nameLength = p - nameStart;
+      while (p < end && isBlank(text[p])) p++;
+
+      TraceLabel label;
+      label.time = time;
+      bool ok = digits > 0 && (p == end || text[p] == '#') &&
+                doorStateFromName(text + nameStart, nameLength, label.state) &&
+                (labels.empty() || labels.back().time <= time);
+      if (!ok) {
+        if (errorLine) {
+          *errorLine = line;
+        }
+        return false;
+      }
+      labels.push_back(label);
+    }
+
+    pos = end + 1;
+  }
+  return true;
+}
+
+void scoreTransitions(const std::vector<DoorTransition>& detected, const std::vector<TraceLabel>& labels,
+                      const SweepOptions& options, SweepScore& score) {
+  score.expected += labels.size();
+  score.detected += detected.size();
+
+  // Both lists are in time order; first is the earliest detection that can
+  // still match a label, and matched detections are skipped via used.
+  std::vector<bool> used(detected.size(), false);
+  size_t first = 0;
+  for (size_t l = 0; l < labels.size(); l++) {
+    const TraceLabel& label = labels[l];
+    unsigned long earliest = label.time > options.earlyToleranceMs ? label.time - options.earlyToleranceMs : 0;
+    unsigned long latest = label.time + options.matchWindowMs;
+    while (first < detected.size() && detected[first].time < earliest) {
+      first++;
+    }
+    for (size_t d = first; d < detected.size() && detected[d].time <= latest; d++) {
+      if (!used[d] && detected[d].to == label.state) {
+        used[d] = true;
+        unsigned long latency = detected[d].time > label.time ? detected[d].time - label.time : 0;
+        score.matched++;
+        score.totalLatency += latency;
+        if (latency > score.maxLatency) {
+          score.maxLatency = latency;
+        }
+        break;
+      }
+    }
+  }
+}
+
+void scoreConfig(const DoorMonitorConfig& config, const LabeledTrace& trace, const SweepOptions& options,
+                 std::vector<DoorTransition>& transitions, SweepScore& score) {
+  transitions.clear();
+  // Start from the first valid reading, as setup() and replay do
+  size_t first = 0;
+  while (first < trace.samples.size() && !trace.samples[first].valid) {
+    first++;
+  }
+  if (first == trace.samples.size()) {
+    scoreTransitions(transitions, trace.labels, options, score);
+    return;
+  }
+
+  DoorTransition chunk[SWEEP_CHUNK_SIZE];
+  DoorMonitor monitor(config);
+  monitor.initialize(trace.samples[first].y, trace.samples[first].z, trace.times[first]);
+
+  for (size_t i = first + 1; i < trace.samples.size(); i += SWEEP_CHUNK_SIZE) {
+    size_t n = trace.samples.size() - i;
+    if (n > SWEEP_CHUNK_SIZE) {
+      n = SWEEP_CHUNK_SIZE;
+    }
+    // At most one transition per sample, so the chunk buffer never overflows
+    size_t count = monitor.updateStateBatch(&trace.samples[i], &trace.times[i], n, chunk, SWEEP_CHUNK_SIZE);
+    transitions.insert(transitions.end(), chunk, chunk + count);
+  }
+  scoreTransitions(transitions, trace.labels, options, score);
+}
+
+const char* sweepParamName(SweepParam param) {
+  return param < SWEEP_PARAM_COUNT ? PARAM_NAMES[param] : "";
+}
+
+bool sweepParamFromName(const char* name, SweepParam& param) {
+  for (int i = 0; i < SWEEP_PARAM_COUNT; i++) {
+    if (strcmp(name, PARAM_NAMES[i]) == 0) {
+      param = (SweepParam)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+float getSweepParam(const DoorMonitorConfig& config, SweepParam param) {
+  switch (param) {
+    case SWEEP_ACCEL_THRESHOLD: return config.accelThreshold;
+    case SWEEP_STOP_TIMEOUT: return (float)config.stopTimeout;
+    case SWEEP_MAX_OPEN_TIME: return (float)config.maxOpenTime;
+    case SWEEP_MAX_CLOSE_TIME: return (float)config.maxCloseTime;
+    case SWEEP_STALL_THRESHOLD: return config.stallThreshold;
+    case SWEEP_STALL_TIMEOUT: return (float)config.stallTimeout;
+    case SWEEP_POSITION_TOLERANCE: return config.positionTolerance;
+    default: return 0;
+  }
+}
+
+void setSweepParam(DoorMonitorConfig& config, SweepParam param, float value) {
+  unsigned long ms = value < 0 ? 0 : (unsigned long)(value + 0.5f);
+  switch (param) {
+    case SWEEP_ACCEL_THRESHOLD: config.accelThreshold = value; break;
+    case SWEEP_STOP_TIMEOUT: config.stopTimeout = ms; break;
+    case SWEEP_MAX_OPEN_TIME: config.maxOpenTime = ms; break;
+    case SWEEP_MAX_CLOSE_TIME: config.maxCloseTime = ms; break;
+    case SWEEP_STALL_THRESHOLD: config.stallThreshold = value; break;
+    case SWEEP_STALL_TIMEOUT: config.stallTimeout = ms; break;
+    case SWEEP_POSITION_TOLERANCE: config.positionTolerance = value; break;
+    default: break;
+  }
+}
+
+std::vector<DoorMonitorConfig> buildConfigGrid(const DoorMonitorConfig& base, const std::vector<SweepAxis>& axes) {
+  std::vector<DoorMonitorConfig> grid(1, base);
+  for (size_t a = 0; a < axes.size(); a++) {
+    const SweepAxis& axis = axes[a];
+    // Step count from the range so float rounding can't drop the last value
+    size_t steps = axis.step > 0 && axis.last >= axis.first
+                 ? (size_t)((axis.last - axis.first) / axis.step + 0.5f) + 1 : 1;
+
+    std::vector<DoorMonitorConfig> next;
+    next.reserve(grid.size() * steps);
+    for (size_t g = 0; g < grid.size(); g++) {
+      for (size_t s = 0; s < steps; s++) {
+        DoorMonitorConfig config = grid[g];
+        setSweepParam(config, axis.param, axis.first + axis.step * s);
+        next.push_back(config);
+      }
+    }
+    grid.swap(next);
+  }
+  return grid;
+}
+
+#ifndef ARDUINO
+
+void runConfigSweep(const std::vector<LabeledTrace>& traces, const std::vector<DoorMonitorConfig>& configs,
+                    const SweepOptions& options, unsigned threadCount, std::vector<SweepScore>& scores) {
+  scores.assign(configs.size(), SweepScore());
+  if (threadCount == 0) {
+    threadCount = std::thread::hardware_concurrency();
+  }
+  if (threadCount == 0) {
+    threadCount = 1;
+  }
+  if (threadCount > configs.size()) {
+    threadCount = configs.size() > 0 ? (unsigned)configs.size() : 1;
+  }
+
+  // Each worker claims the next unscored config and writes only its own
+  // scores[] slot, so the only shared mutable state is the cursor.
+  std::atomic<size_t> cursor(0);
+  SweepScore* results = scores.empty() ? NULL : &scores[0];
+  auto worker = [&]() {
+    std::vector<DoorTransition> transitions;
+    for (;;) {
+      size_t c = cursor.fetch_add(1, std::memory_order_relaxed);
+      if (c >= configs.size()) {
+        break;
+      }
+      SweepScore score;
+      for (size_t t = 0; t < traces.size(); t++) {
+        scoreConfig(configs[c], traces[t], options, transitions, score);
+      }
+      results[c] = score;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < threadCount; i++) {
+    threads.push_back(std::thread(worker));
+  }
+  worker();
+  for (size_t i = 0; i < threads.size(); i++) {
+    threads[i].join();
+  }
+}
+
+#endif
@@ -0,0 +1,228 @@
+#include "DoorFleet.h"
+#include <string.h>
+#include <math.h>
+
+static inline uint32_t clampTimeout(unsigned long timeout) {
+  return timeout > 0xFFFFFFFFul ? 0xFFFFFFFFu : (uint32_t)timeout;
+}
+
+// a when cond, else b, without a branch
+static inline uint32_t select(bool cond, uint32_t a, uint32_t b) {
+  return b ^ ((a ^ b) & (0u - (uint32_t)cond));
+}
+
+DoorFleet::DoorFleet(size_t doors, const DoorMonitorConfig& cfg)
+  : config(cfg),
+    doorCount(doors),
+    state(doors),
+    lastMovementDirection(doors),
+    lastAccelY(doors),
+    lastAccelZ(doors),
+    lastMovementTime(doors),
+    stateChangeTime(doors),
+    lastStallCheckTime(doors),
+    consecutiveSensorFailures(doors),
+    previousState(doors) {
+  reset();
+}
+
+void DoorFleet::reset() {
+  for (size_t i = 0; i < doorCount; i++) {
+    state[i] = DOOR_UNKNOWN;
+    lastMovementDirection[i] = DOOR_UNKNOWN;
+    lastAccelY[i] = 0;
+    lastAccelZ[i] = 0;
+    lastMovementTime[i] = 0;
+    stateChangeTime[i] = 0;
+    lastStallCheckTime[i] = 0;
+    consecutiveSensorFailures[i] = 0;
+  }
+}
+
+void DoorFleet::initialize(size_t door, float initialAccelY, float initialAccelZ, unsigned long currentTime) {
+  lastAccelY[door] = initialAccelY;
+  lastAccelZ[door] = initialAccelZ;
+  lastMovementTime[door] = (uint32_t)currentTime;
+  stateChangeTime[door] = (uint32_t)currentTime;
+  lastStallCheckTime[door] = (uint32_t)currentTime;
+
+  if (DoorMonitor::isInClosedPosition(initialAccelY, initialAccelZ, config.closedPositionY, config.closedPositionZ, config.positionTolerance)) {
+    state[door] = DOOR_CLOSED;
+  } else if (DoorMonitor::isInOpenPosition(initialAccelY, initialAccelZ, config.openPositionY, config.openPositionZ, config.positionTolerance)) {
+    state[door] = DOOR_OPEN;
+  } else {
+    state[door] = DOOR_STOPPED;
+  }
+
+  consecutiveSensorFailures[door] = 0;
+}
+
+void DoorFleet::initializeAll(const float* initialAccelY, const float* initialAccelZ, unsigned long currentTime) {
+  for (size_t i = 0; i < doorCount; i++) {
+    initialize(i, initialAccelY[i], initialAccelZ[i], currentTime);
+  }
+}
+
+// Config in the form the update pass uses
+struct FleetParams {
+  float threshold;
+  float stallThreshold;
+  float closedY;
+  float closedZ;
+  float openY;
+  float openZ;
+  float tolerance;
+  uint32_t stopTimeout;
+  uint32_t maxOpenTime;
+  uint32_t maxCloseTime;
+  uint32_t stallTimeout;
+};
+
+// One tick for doors [base, base + Lanes). A constant lane count lets the
+// compiler vectorize at -O2 without a scalar epilogue, and __restrict tells it
+// the arrays don't alias.
+template <size_t Lanes>
+static inline void updateDoors(size_t base, const FleetParams& p, uint32_t now,
+                               const float* __restrict accelY, const float* __restrict accelZ,
+                               const uint8_t* __restrict valid,
+                               uint32_t* __restrict st, uint32_t* __restrict dir,
+                               float* __restrict lastY, float* __restrict lastZ,
+                               uint32_t* __restrict moveTime, uint32_t* __restrict changeTime,
+                               uint32_t* __restrict stallTime, uint32_t* __restrict failures) {
+  const float threshold = p.threshold;
+  const float stallThreshold = p.stallThreshold;
+  const float closedY = p.closedY;
+  const float closedZ = p.closedZ;
+  const float openY = p.openY;
+  const float openZ = p.openZ;
+  const float tolerance = p.tolerance;
+  const uint32_t stopTimeout = p.stopTimeout;
+  const uint32_t maxOpenTime = p.maxOpenTime;
+  const uint32_t maxCloseTime = p.maxCloseTime;
+  const uint32_t stallTimeout = p.stallTimeout;
+
+  // Branch-free transcription of DoorMonitor::updateState: every path is
+  // computed and the result picked with masks, so the loop has no control
+  // flow and the compiler can vectorize it.
+  for (size_t i = base; i < base + Lanes; i++) {
+    const uint32_t s = st[i];
+    const float y = accelY[i];
+    const float z = accelZ[i];
+    const float ly = lastY[i];
+    const float lz = lastZ[i];
+    const uint32_t lastChange = changeTime[i];
+    const uint32_t lastStall = stallTime[i];
+    const uint32_t lastMove = moveTime[i];
+
+    // Sensor health
+    const uint32_t previousFailures = failures[i];
+    const uint32_t f = select(valid[i] != 0, 0, previousFailures + (previousFailures < 255u));
+    const bool failed = f >= DOOR_FLEET_FAILURE_LIMIT;
+
+    // Recovery from a sensor failure restarts in UNKNOWN
+    const bool recovered = s == DOOR_ERROR_SENSOR_FAILURE;
+    const uint32_t s1 = select(recovered, DOOR_UNKNOWN, s);
+    const uint32_t change1 = select(recovered, now, lastChange);
+
+    const float dy = y - ly;
+    const float dz = z - lz;
+    const float totalChange = fabsf(dy) + fabsf(dz);
+    const bool moving = totalChange > threshold;
+
+    // Movement: follow the direction of the change (Z first, then Y by which
+    // end the door is nearer; see DoorMonitor::determineDirection)
+    const bool zUp = dz > threshold / 2;
+    const bool zDown = dz < -threshold / 2;
+    const bool zFlat = !(zUp | zDown);
+    const bool nearOpen = fabsf(z) > fabsf(y);
+    const bool yUp = dy > threshold;
+    const bool yDown = dy < -threshold;
+    const bool towardOpen = zUp | (zFlat & ((nearOpen & yDown) | (!nearOpen & yUp)));
+    const bool towardClosed = zDown | (zFlat & ((nearOpen & yUp) | (!nearOpen & yDown)));
+    const bool hasDirection = towardOpen | towardClosed;
+    const uint32_t direction = select(towardOpen, DOOR_OPENING, DOOR_CLOSING);
+    const uint32_t movingState = select(hasDirection, direction, s1);
+    const bool movingChanged = hasDirection & (direction != s1);
+
+    // No movement: timeout, stall and stop checks
+    const bool isOpening = s1 == DOOR_OPENING;
+    const bool inMotion = isOpening | (s1 == DOOR_CLOSING);
+    const uint32_t maxTime = select(isOpening, maxOpenTime, maxCloseTime);
+    const bool timedOut = inMotion & ((now - change1) > maxTime);
+    const bool slow = totalChange < stallThreshold;
+    const bool stalled = inMotion & !timedOut & slow & ((now - lastStall) > stallTimeout);
+    const bool stopped = !timedOut & !stalled & ((now - lastMove) > stopTimeout) &
+                         (inMotion | (s1 == DOOR_UNKNOWN));
+    const bool closed = (fabsf(y - closedY) <= tolerance) & (fabsf(z - closedZ) <= tolerance);
+    const bool open = (fabsf(y - openY) <= tolerance) & (fabsf(z - openZ) <= tolerance);
+    const uint32_t restState = select(closed, DOOR_CLOSED, select(open, DOOR_OPEN, DOOR_STOPPED));
+    const uint32_t stillState = select(timedOut, DOOR_ERROR_TIMEOUT,
+                                select(stalled, DOOR_ERROR_STALLED,
+                                select(stopped, restState, s1)));
+    const bool stillChanged = timedOut | stalled | stopped;
+    const bool stallReset = inMotion & !timedOut & !slow;
+
+    const uint32_t healthyState = select(moving, movingState, stillState);
+    const bool healthyChanged = (moving & movingChanged) | (!moving & stillChanged);
+    const bool healthy = !failed;
+    const bool changedNow = (failed & !recovered) | (healthy & healthyChanged);
+
+    st[i] = select(failed, DOOR_ERROR_SENSOR_FAILURE, healthyState);
+    changeTime[i] = select(changedNow, now, select(failed, lastChange, change1));
+    dir[i] = select(healthy & moving & hasDirection, direction, dir[i]);
+    moveTime[i] = select(healthy & moving, now, lastMove);
+    stallTime[i] = select(healthy & (moving | stallReset), now, lastStall);
+    lastY[i] = failed ? ly : y;
+    lastZ[i] = failed ? lz : z;
+    failures[i] = f;
+  }
+}
+
+size_t DoorFleet::update(const float* accelY, const float* accelZ, const uint8_t* valid, unsigned long currentTime,
+                         FleetTransition* transitions, size_t maxTransitions) {
+  if (doorCount == 0) {
+    return 0;
+  }
+  memcpy(&previousState[0], &state[0], doorCount * sizeof(uint32_t));
+
+  FleetParams p;
+  p.threshold = config.accelThreshold;
+  p.stallThreshold = config.stallThreshold;
+  p.closedY = config.closedPositionY;
+  p.closedZ = config.closedPositionZ;
+  p.openY = config.openPositionY;
+  p.openZ = config.openPositionZ;
+  p.tolerance = config.positionTolerance;
+  p.stopTimeout = clampTimeout(config.stopTimeout);
+  p.maxOpenTime = clampTimeout(config.maxOpenTime);
+  p.maxCloseTime = clampTimeout(config.maxCloseTime);
+  p.stallTimeout = clampTimeout(config.stallTimeout);
+  const uint32_t now = (uint32_t)currentTime;
+
+  size_t door = 0;
+  for (; door + DOOR_FLEET_LANES <= doorCount; door += DOOR_FLEET_LANES) {
+    updateDoors<DOOR_FLEET_LANES>(door, p, now, accelY, accelZ, valid,
+                                  &state[0], &lastMovementDirection[0], &lastAccelY[0], &lastAccelZ[0],
+                                  &lastMovementTime[0], &stateChangeTime[0], &lastStallCheckTime[0],
+                                  &consecutiveSensorFailures[0]);
+  }
+  for (; door < doorCount; door++) {
+    updateDoors<1>(door, p, now, accelY, accelZ, valid,
+                   &state[0], &lastMovementDirection[0], &lastAccelY[0], &lastAccelZ[0],
+                   &lastMovementTime[0], &stateChangeTime[0], &lastStallCheckTime[0],
+                   &consecutiveSensorFailures[0]);
+  }
+
+  size_t transitionCount = 0;
+  for (size_t i = 0; i < doorCount; i++) {
+    if (state[i] != previousState[i]) {
+      if (transitionCount < maxTransitions) {
+        transitions[transitionCount].door = (uint32_t)i;
+        transitions[transitionCount].from = (DoorState)previousState[i];
+        transitions[transitionCount].to = (DoorState)state[i];
+      }
+      transitionCount++;
+    }
+  }
+  return transitionCount;
+}
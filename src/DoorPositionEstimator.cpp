@@ -0,0 +1,155 @@
+#include "DoorPositionEstimator.h"
+
+static size_t directionIndex(DoorState direction) {
+  return direction == DOOR_CLOSING ? 1 : 0;
+}
+
+DoorPositionEstimator::DoorPositionEstimator(const DoorMonitorConfig& config) {
+  setConfig(config);
+  travelTime[0] = travelTime[1] = 0;
+  travelCount[0] = travelCount[1] = 0;
+  reset();
+}
+
+void DoorPositionEstimator::setConfig(const DoorMonitorConfig& config) {
+  closedY = config.closedPositionY;
+  closedZ = config.closedPositionZ;
+  axisY = config.openPositionY - config.closedPositionY;
+  axisZ = config.openPositionZ - config.closedPositionZ;
+  float length2 = axisY * axisY + axisZ * axisZ;
+  inverseLength2 = length2 > 0 ? 1.0f / length2 : 0;
+}
+
+void DoorPositionEstimator::reset() {
+  position = 0;
+  velocity = 0;
+  lastTime = 0;
+  primed = false;
+  state = DOOR_UNKNOWN;
+  runActive = false;
+  runDirection = DOOR_UNKNOWN;
+  runStart = 0;
+  runStartPosition = 0;
+}
+
+void DoorPositionEstimator::update(const AccelData& sample, unsigned long time) {
+  if (!sample.valid) {
+    return;
+  }
+
+  float projected = ((sample.y - closedY) * axisY + (sample.z - closedZ) * axisZ) * inverseLength2;
+  projected = projected < 0 ? 0 : projected > 1 ? 1 : projected;
+
+  unsigned long elapsed = time - lastTime;
+  if (!primed || elapsed > POSITION_MAX_GAP_MS) {
+    velocity = 0;
+    primed = true;
+  } else if (elapsed > 0) {
+    float k = (float)elapsed / (float)(POSITION_VELOCITY_TIME_CONSTANT_MS + elapsed);
+    velocity += ((projected - position) * 1000.0f / elapsed - velocity) * k;
+  }
+  position = projected;
+  lastTime = time;
+
+  // Samples from before the transition (same batch) don't count
+  if (!runActive || (long)(time - runStart) < 0) {
+    return;
+  }
+  bool opening = runDirection == DOOR_OPENING;
+  if (opening ? position >= POSITION_TRAVEL_END : position <= 1 - POSITION_TRAVEL_END) {
+    float covered = opening ? position - runStartPosition : runStartPosition - position;
+    learn(directionIndex(runDirection), (unsigned long)((time - runStart) / covered));
+    runActive = false;
+  }
+}
+
+void DoorPositionEstimator::learn(size_t direction, unsigned long measured) {
+  if (travelCount[direction] == 0) {
+    travelTime[direction] = measured;
+  } else {
+    long delta = (long)measured - (long)travelTime[direction];
+    travelTime[direction] += delta / (1 << POSITION_TRAVEL_WEIGHT_SHIFT);
+  }
+  if (travelCount[direction] < UINT16_MAX) {
+    travelCount[direction]++;
+  }
+}
+
+static bool isMovingState(DoorState state) {
+  return state == DOOR_OPENING || state == DOOR_CLOSING;
+}
+
+void DoorPositionEstimator::onTransition(const DoorTransition& transition) {
+  bool wasMoving = isMovingState(state);
+  state = transition.to;
+  if (!isMovingState(state)) {
+    runActive = false;
+    return;
+  }
+  if (wasMoving) {
+    return;  // OPENING <-> CLOSING; the position decides whether the run completes
+  }
+
+  // The end it starts from gives the direction
+  if (position <= POSITION_TRAVEL_START) {
+    runDirection = DOOR_OPENING;
+  } else if (position >= 1 - POSITION_TRAVEL_START) {
+    runDirection = DOOR_CLOSING;
+  } else {
+    runActive = false;
+    return;
+  }
+  runActive = true;
+  runStart = transition.time;
+  runStartPosition = position;
+}
+
+void DoorPositionEstimator::transitionListener(void* context, const DoorTransition& transition, DoorState) {
+  static_cast<DoorPositionEstimator*>(context)->onTransition(transition);
+}
+
+unsigned long DoorPositionEstimator::getTravelTime(DoorState direction) const {
+  return travelTime[directionIndex(direction)];
+}
+
+uint16_t DoorPositionEstimator::getTravelCount(DoorState direction) const {
+  return travelCount[directionIndex(direction)];
+}
+
+void DoorPositionEstimator::setTravelTime(DoorState direction, unsigned long ms) {
+  size_t i = directionIndex(direction);
+  travelTime[i] = ms;
+  travelCount[i] = ms > 0 ? 1 : 0;
+}
+
+DoorState DoorPositionEstimator::getDirection() const {
+  if (!isMovingState(state)) {
+    return DOOR_UNKNOWN;
+  }
+  if (velocity >= POSITION_MIN_SPEED) {
+    return DOOR_OPENING;
+  } else if (velocity <= -POSITION_MIN_SPEED) {
+    return DOOR_CLOSING;
+  }
+  return runActive ? runDirection : DOOR_UNKNOWN;
+}
+
+bool DoorPositionEstimator::estimateArrival(unsigned long& remainingMs) const {
+  DoorState direction = getDirection();
+  if (direction == DOOR_UNKNOWN) {
+    return false;
+  }
+  float remaining = direction == DOOR_OPENING ? 1 - position : position;
+  unsigned long travel = travelTime[directionIndex(direction)];
+  if (travel > 0) {
+    remainingMs = (unsigned long)(remaining * travel);
+    return true;
+  }
+
+  float speed = direction == DOOR_OPENING ? velocity : -velocity;
+  if (speed < POSITION_MIN_SPEED) {
+    return false;
+  }
+  remainingMs = (unsigned long)(remaining * 1000.0f / speed);
+  return true;
+}
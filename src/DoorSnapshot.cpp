@@ -0,0 +1,74 @@
+#include "DoorSnapshot.h"
+#include <string.h>
+
+#define SNAPSHOT_CRC_OFFSET (DOOR_SNAPSHOT_SIZE - 4)
+
+static void putU32(uint8_t* out, uint32_t v) {
+  out[0] = (uint8_t)(v & 0xFF);
+  out[1] = (uint8_t)((v >> 8) & 0xFF);
+  out[2] = (uint8_t)((v >> 16) & 0xFF);
+  out[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t getU32(const uint8_t* in) {
+  return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+// CRC-32 (IEEE, reflected), bitwise: 100 bytes do not warrant a table
+static uint32_t snapshotCrc(const uint8_t* data, size_t size) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < size; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+void encodeDoorSnapshot(const DoorSnapshot& snapshot, uint8_t* out) {
+  memcpy(out, DOOR_SNAPSHOT_MAGIC, 4);
+  out[4] = DOOR_SNAPSHOT_VERSION;
+  out[5] = snapshot.sampleKind;
+  out[6] = (uint8_t)snapshot.state;
+  out[7] = (uint8_t)snapshot.lastMovementDirection;
+  out[8] = snapshot.sensorHealthy ? 1 : 0;
+  out[9] = snapshot.arrivalCount;
+  out[10] = snapshot.arrivalNext;
+  out[11] = snapshot.sensorFailures;
+  putU32(out + 12, (uint32_t)snapshot.stateAge);
+  putU32(out + 16, (uint32_t)snapshot.movementAge);
+  putU32(out + 20, (uint32_t)snapshot.stallCheckAge);
+  putU32(out + 24, snapshot.lastAccelY);
+  putU32(out + 28, snapshot.lastAccelZ);
+  for (size_t i = 0; i < DOOR_ARRIVAL_MAX_WINDOW; i++) {
+    putU32(out + 32 + 4 * i, snapshot.arrivalY[i]);
+    putU32(out + 32 + 4 * (DOOR_ARRIVAL_MAX_WINDOW + i), snapshot.arrivalZ[i]);
+  }
+  putU32(out + SNAPSHOT_CRC_OFFSET, snapshotCrc(out, SNAPSHOT_CRC_OFFSET));
+}
+
+bool decodeDoorSnapshot(const uint8_t* data, size_t size, DoorSnapshot& snapshot) {
+  if (size < DOOR_SNAPSHOT_SIZE || memcmp(data, DOOR_SNAPSHOT_MAGIC, 4) != 0 ||
+      data[4] != DOOR_SNAPSHOT_VERSION ||
+      getU32(data + SNAPSHOT_CRC_OFFSET) != snapshotCrc(data, SNAPSHOT_CRC_OFFSET)) {
+    return false;
+  }
+  snapshot.sampleKind = data[5];
+  snapshot.state = (DoorState)data[6];
+  snapshot.lastMovementDirection = (DoorState)data[7];
+  snapshot.sensorHealthy = (data[8] & 1) != 0;
+  snapshot.arrivalCount = data[9];
+  snapshot.arrivalNext = data[10];
+  snapshot.sensorFailures = data[11];
+  snapshot.stateAge = getU32(data + 12);
+  snapshot.movementAge = getU32(data + 16);
+  snapshot.stallCheckAge = getU32(data + 20);
+  snapshot.lastAccelY = getU32(data + 24);
+  snapshot.lastAccelZ = getU32(data + 28);
+  for (size_t i = 0; i < DOOR_ARRIVAL_MAX_WINDOW; i++) {
+    snapshot.arrivalY[i] = getU32(data + 32 + 4 * i);
+    snapshot.arrivalZ[i] = getU32(data + 32 + 4 * (DOOR_ARRIVAL_MAX_WINDOW + i));
+  }
+  return true;
+}
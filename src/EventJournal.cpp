@@ -0,0 +1,307 @@
+#include "EventJournal.h"
+#include <string.h>
+
+static void putU32(uint8_t* out, uint32_t v) {
+  out[0] = (uint8_t)(v & 0xFF);
+  out[1] = (uint8_t)((v >> 8) & 0xFF);
+  out[2] = (uint8_t)((v >> 16) & 0xFF);
+  out[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t getU32(const uint8_t* in) {
+  return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+static uint8_t clampSegments(uint8_t count) {
+  if (count == 0) {
+    return 1;
+  }
+  return count > JOURNAL_MAX_SEGMENTS ? JOURNAL_MAX_SEGMENTS : count;
+}
+
+// Header of a segment; false if missing or not a journal segment
+static bool readSegmentHeader(JournalStorage& storage, uint8_t segment, uint32_t& sequence, uint32_t& baseTime) {
+  uint8_t header[JOURNAL_HEADER_SIZE];
+  if (storage.size(segment) < JOURNAL_HEADER_SIZE ||
+      !storage.read(segment, 0, header, JOURNAL_HEADER_SIZE) ||
+      memcmp(header, JOURNAL_MAGIC, 4) != 0) {
+    return false;
+  }
+  sequence = getU32(header + 4);
+  baseTime = getU32(header + 8);
+  return true;
+}
+
+static bool validKind(uint8_t kind) {
+  return kind <= DOOR_ERROR_STALLED || kind == JOURNAL_KIND_BOOT;
+}
+
+// True if the records after the header decode exactly to the end of the segment
+static bool segmentIntact(JournalStorage& storage, uint8_t segment, uint32_t size) {
+  uint8_t chunk[JOURNAL_READ_CHUNK_SIZE];
+  uint32_t offset = JOURNAL_HEADER_SIZE;
+  while (offset < size) {
+    size_t n = size - offset;
+    if (n > sizeof(chunk)) {
+      n = sizeof(chunk);
+    }
+    if (!storage.read(segment, offset, chunk, n)) {
+      return false;
+    }
+    // A record split by the chunk end is decoded again from the next read
+    size_t pos = 0;
+    uint8_t kind;
+    uint32_t delta;
+    while (size_t used = decodeJournalRecord(chunk + pos, n - pos, kind, delta)) {
+      if (!validKind(kind)) {
+        return false;
+      }
+      pos += used;
+    }
+    if (pos == 0) {
+      return false;
+    }
+    offset += pos;
+  }
+  return true;
+}
+
+size_t encodeJournalRecord(uint8_t kind, uint32_t delta, uint8_t* out) {
+  uint64_t value = ((uint64_t)delta << 4) | (kind & 0xF);
+  size_t n = 0;
+  while (value >= 0x80) {
+    out[n++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  out[n++] = (uint8_t)value;
+  return n;
+}
+
+size_t decodeJournalRecord(const uint8_t* data, size_t size, uint8_t& kind, uint32_t& delta) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < size && i < JOURNAL_MAX_RECORD_SIZE; i++) {
+    value |= (uint64_t)(data[i] & 0x7F) << (7 * i);
+    if ((data[i] & 0x80) == 0) {
+      if ((value >> 36) != 0) {
+        return 0;
+      }
+      kind = (uint8_t)(value & 0xF);
+      delta = (uint32_t)(value >> 4);
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+EventJournal::EventJournal(JournalStorage& storage, uint8_t segmentCount, uint32_t segmentSize,
+                           unsigned long flushIntervalMs)
+  : storage(storage),
+    segmentCount(clampSegments(segmentCount)),
+    segmentSize(segmentSize < JOURNAL_HEADER_SIZE + JOURNAL_MAX_RECORD_SIZE
+                ? JOURNAL_HEADER_SIZE + JOURNAL_MAX_RECORD_SIZE : segmentSize),
+    flushIntervalMs(flushIntervalMs),
+    current(0),
+    sequence(0),
+    segmentUsed(0),
+    lastTime(0),
+    buffered(0),
+    bufferedSince(0),
+    ready(false),
+    writeCount(0) {}
+
+bool EventJournal::startSegment(uint8_t segment, uint32_t seq, unsigned long baseTime) {
+  uint8_t header[JOURNAL_HEADER_SIZE];
+  memcpy(header, JOURNAL_MAGIC, 4);
+  putU32(header + 4, seq);
+  putU32(header + 8, (uint32_t)baseTime);
+
+  writeCount++;
+  if (!storage.clear(segment) || !storage.append(segment, header, JOURNAL_HEADER_SIZE)) {
+    return false;
+  }
+  current = segment;
+  sequence = seq;
+  segmentUsed = JOURNAL_HEADER_SIZE;
+  lastTime = baseTime;
+  return true;
+}
+
+bool EventJournal::begin(unsigned long now) {
+  ready = false;
+  buffered = 0;
+
+  bool found = false;
+  uint8_t newest = 0;
+  uint32_t newestSequence = 0;
+  for (uint8_t s = 0; s < segmentCount; s++) {
+    uint32_t seq, base;
+    if (readSegmentHeader(storage, s, seq, base) && (!found || seq > newestSequence)) {
+      found = true;
+      newest = s;
+      newestSequence = seq;
+    }
+  }
+
+  if (!found) {
+    if (!startSegment(0, 0, now)) {
+      return false;
+    }
+  } else {
+    uint32_t size = storage.size(newest);
+    bool intact = segmentIntact(storage, newest, size);
+    current = newest;
+    sequence = newestSequence;
+    segmentUsed = size;
+    if ((!intact || segmentUsed + JOURNAL_MAX_RECORD_SIZE > segmentSize) &&
+        !startSegment((uint8_t)((newest + 1) % segmentCount), newestSequence + 1, now)) {
+      return false;
+    }
+  }
+
+  ready = true;
+  // Write the boot marker right away so restarts are recorded even if no
+  // state change follows
+  return appendRecord(JOURNAL_KIND_BOOT, now) && flush();
+}
+
+bool EventJournal::appendRecord(uint8_t kind, unsigned long time) {
+  if (!ready) {
+    return false;
+  }
+
+  uint8_t record[JOURNAL_MAX_RECORD_SIZE];
+  uint32_t delta = kind == JOURNAL_KIND_BOOT ? (uint32_t)time : (uint32_t)(time - lastTime);
+  size_t n = encodeJournalRecord(kind, delta, record);
+
+  if (segmentUsed + n > segmentSize) {
+    // Close this segment; the next one continues from lastTime so deltas stay valid
+    if (!flush() || !startSegment((uint8_t)((current + 1) % segmentCount), sequence + 1, lastTime)) {
+      return false;
+    }
+  }
+  if (buffered + n > JOURNAL_BUFFER_SIZE && !flush()) {
+    return false;
+  }
+
+  if (buffered == 0) {
+    bufferedSince = time;
+  }
+  memcpy(buffer + buffered, record, n);
+  buffered += n;
+  segmentUsed += n;
+  lastTime = time;
+  return true;
+}
+
+bool EventJournal::append(DoorState state, unsigned long time) {
+  return appendRecord((uint8_t)state, time);
+}
+
+bool EventJournal::poll(unsigned long now) {
+  if (buffered == 0 || now - bufferedSince < flushIntervalMs) {
+    return true;
+  }
+  return flush();
+}
+
+bool EventJournal::flush() {
+  if (buffered == 0) {
+    return true;
+  }
+  // On failure the records stay buffered and the next flush retries them
+  writeCount++;
+  if (!storage.append(current, buffer, buffered)) {
+    return false;
+  }
+  buffered = 0;
+  return true;
+}
+
+JournalReader::JournalReader(JournalStorage& storage, uint8_t segmentCount)
+  : storage(storage), segmentCount(clampSegments(segmentCount)) {
+  rewind();
+}
+
+void JournalReader::rewind() {
+  uint32_t sequences[JOURNAL_MAX_SEGMENTS];
+  orderCount = 0;
+  for (uint8_t s = 0; s < segmentCount; s++) {
+    uint32_t seq, base;
+    if (!readSegmentHeader(storage, s, seq, base)) {
+      continue;
+    }
+    // Insertion sort by sequence
+    size_t i = orderCount++;
+    while (i > 0 && sequences[i - 1] > seq) {
+      sequences[i] = sequences[i - 1];
+      order[i] = order[i - 1];
+      i--;
+    }
+    sequences[i] = seq;
+    order[i] = s;
+  }
+  orderIndex = 0;
+  openSegment();
+}
+
+bool JournalReader::openSegment() {
+  while (orderIndex < orderCount) {
+    uint32_t seq, base;
+    segment = order[orderIndex];
+    if (readSegmentHeader(storage, segment, seq, base)) {
+      segmentSize = storage.size(segment);
+      offset = JOURNAL_HEADER_SIZE;
+      chunkSize = 0;
+      chunkPos = 0;
+      time = base;
+      return true;
+    }
+    orderIndex++;
+  }
+  return false;
+}
+
+bool JournalReader::next(JournalEntry& entry) {
+  while (orderIndex < orderCount) {
+    // Keep at least one whole record in the chunk while the segment has more
+    if (chunkSize - chunkPos < JOURNAL_MAX_RECORD_SIZE && offset < segmentSize) {
+      size_t remaining = chunkSize - chunkPos;
+      memmove(chunk, chunk + chunkPos, remaining);
+      size_t n = segmentSize - offset;
+      if (n > sizeof(chunk) - remaining) {
+        n = sizeof(chunk) - remaining;
+      }
+      if (!storage.read(segment, offset, chunk + remaining, n)) {
+        n = 0;
+        offset = segmentSize;
+      }
+      offset += n;
+      chunkSize = remaining + n;
+      chunkPos = 0;
+    }
+
+    uint8_t kind;
+    uint32_t delta;
+    size_t used = chunkPos < chunkSize ? decodeJournalRecord(chunk + chunkPos, chunkSize - chunkPos, kind, delta) : 0;
+    if (used == 0 || !validKind(kind)) {
+      // End of segment, or a torn record: move on to the next segment
+      orderIndex++;
+      openSegment();
+      continue;
+    }
+    chunkPos += used;
+
+    if (kind == JOURNAL_KIND_BOOT) {
+      time = delta;
+      entry.type = JOURNAL_ENTRY_BOOT;
+      entry.state = DOOR_UNKNOWN;
+    } else {
+      time += delta;
+      entry.type = JOURNAL_ENTRY_STATE;
+      entry.state = (DoorState)kind;
+    }
+    entry.time = time;
+    return true;
+  }
+  return false;
+}
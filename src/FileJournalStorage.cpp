@@ -0,0 +1,52 @@
+#ifndef ARDUINO
+
+#include "FileJournalStorage.h"
+#include <stdio.h>
+
+std::string FileJournalStorage::path(uint8_t segment) const {
+  char suffix[4];
+  snprintf(suffix, sizeof(suffix), "%u", (unsigned)segment);
+  return prefix + suffix;
+}
+
+uint32_t FileJournalStorage::size(uint8_t segment) {
+  FILE* f = fopen(path(segment).c_str(), "rb");
+  if (!f) {
+    return 0;
+  }
+  long length = fseek(f, 0, SEEK_END) == 0 ? ftell(f) : -1;
+  fclose(f);
+  return length > 0 ? (uint32_t)length : 0;
+}
+
+bool FileJournalStorage::read(uint8_t segment, uint32_t offset, uint8_t* data, size_t length) {
+  FILE* f = fopen(path(segment).c_str(), "rb");
+  if (!f) {
+    return false;
+  }
+  bool ok = fseek(f, (long)offset, SEEK_SET) == 0 && fread(data, 1, length, f) == length;
+  fclose(f);
+  return ok;
+}
+
+bool FileJournalStorage::append(uint8_t segment, const uint8_t* data, size_t length) {
+  FILE* f = fopen(path(segment).c_str(), "ab");
+  if (!f) {
+    return false;
+  }
+  bool ok = fwrite(data, 1, length, f) == length;
+  return fclose(f) == 0 && ok;
+}
+
+bool FileJournalStorage::clear(uint8_t segment) {
+  FILE* f = fopen(path(segment).c_str(), "wb");
+  return f && fclose(f) == 0;
+}
+
+void FileJournalStorage::removeAll(uint8_t count) {
+  for (uint8_t s = 0; s < count; s++) {
+    remove(path(s).c_str());
+  }
+}
+
+#endif // ARDUINO
@@ -0,0 +1,29 @@
+#ifndef ARDUINO
+
+#include "FileSnapshotStorage.h"
+#include <stdio.h>
+
+bool FileSnapshotStorage::load(uint8_t* data, size_t length) {
+  FILE* f = fopen(path.c_str(), "rb");
+  if (!f) {
+    return false;
+  }
+  bool ok = fread(data, 1, length, f) == length;
+  fclose(f);
+  return ok;
+}
+
+bool FileSnapshotStorage::save(const uint8_t* data, size_t length) {
+  FILE* f = fopen(path.c_str(), "wb");
+  if (!f) {
+    return false;
+  }
+  bool ok = fwrite(data, 1, length, f) == length;
+  return fclose(f) == 0 && ok;
+}
+
+void FileSnapshotStorage::remove() {
+  ::remove(path.c_str());
+}
+
+#endif // ARDUINO
@@ -0,0 +1,43 @@
+#include "HttpCache.h"
+#include <string.h>
+
+bool etagMatches(const char* ifNoneMatch, const char* etag) {
+  if (!ifNoneMatch || !etag) {
+    return false;
+  }
+  size_t etagLength = strlen(etag);
+  const char* p = ifNoneMatch;
+  
+  while (*p) {
+    while (*p == ' ' || *p == '\t' || *p == ',') {
+      p++;
+    }
+    if (*p == '*') {
+      return true;
+    }
+    if (p[0] == 'W' && p[1] == '/') {
+      p += 2;
+    }
+    
+    // Entity tag runs to the closing quote
+    const char* start = p;
+    if (*p == '"') {
+      p++;
+      while (*p && *p != '"') {
+        p++;
+      }
+      if (*p == '"') {
+        p++;
+      }
+    } else {
+      while (*p && *p != ',' && *p != ' ') {
+        p++;
+      }
+    }
+    
+    if ((size_t)(p - start) == etagLength && strncmp(start, etag, etagLength) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
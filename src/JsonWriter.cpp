@@ -0,0 +1,220 @@
+#include "JsonWriter.h"
+#include <math.h>
+#include <string.h>
+
+JsonWriter::JsonWriter(char* buf, size_t cap)
+  : buffer(buf),
+    capacity(cap),
+    length(0),
+    overflow(cap == 0),
+    needComma(false) {
+  if (cap > 0) {
+    buffer[0] = '\0';
+  }
+}
+
+void JsonWriter::append(const char* text, size_t n) {
+  if (overflow) {
+    return;
+  }
+  if (length + n >= capacity) {
+    overflow = true;
+    return;
+  }
+  memcpy(buffer + length, text, n);
+  length += n;
+  buffer[length] = '\0';
+}
+
+void JsonWriter::appendString(const char* text) {
+  appendChar('"');
+  const char* run = text;
+  for (const char* p = text; *p; p++) {
+    unsigned char c = (unsigned char)*p;
+    if (c != '"' && c != '\\' && c >= 0x20) {
+      continue;
+    }
+    append(run, p - run);
+    char escaped[7] = {'\\', 'u', '0', '0', 0, 0, 0};
+    if (c == '"' || c == '\\') {
+      escaped[1] = (char)c;
+      append(escaped, 2);
+    } else {
+      static const char hex[] = "0123456789abcdef";
+      escaped[4] = hex[c >> 4];
+      escaped[5] = hex[c & 0x0F];
+      append(escaped, 6);
+    }
+    run = p + 1;
+  }
+  append(run, strlen(run));
+  appendChar('"');
+}
+
+void JsonWriter::appendKey(const char* key) {
+  if (needComma) {
+    appendChar(',');
+  }
+  needComma = true;
+  if (key) {
+    appendString(key);
+    appendChar(':');
+  }
+}
+
+void JsonWriter::beginObject() {
+  if (needComma) {
+    appendChar(',');
+  }
+  appendChar('{');
+  needComma = false;
+}
+
+void JsonWriter::beginObject(const char* key) {
+  appendKey(key);
+  appendChar('{');
+  needComma = false;
+}
+
+void JsonWriter::endObject() {
+  appendChar('}');
+  needComma = true;
+}
+
+void JsonWriter::beginArray(const char* key) {
+  appendKey(key);
+  appendChar('[');
+  needComma = false;
+}
+
+void JsonWriter::endArray() {
+  appendChar(']');
+  needComma = true;
+}
+
+void JsonWriter::addString(const char* key, const char* value) {
+  appendKey(key);
+  appendString(value);
+}
+
+void JsonWriter::addFloat(const char* key, float value, uint8_t decimals) {
+  char text[32];
+  appendKey(key);
+  append(text, formatFloat(text, sizeof(text), value, decimals));
+}
+
+void JsonWriter::addBool(const char* key, bool value) {
+  appendKey(key);
+  if (value) {
+    append("true", 4);
+  } else {
+    append("false", 5);
+  }
+}
+
+void JsonWriter::addUnsigned(const char* key, unsigned long value) {
+  char text[24];
+  appendKey(key);
+  append(text, formatUnsigned(text, sizeof(text), value));
+}
+
+void JsonWriter::addInt(const char* key, long value) {
+  char text[24];
+  appendKey(key);
+  if (value < 0) {
+    appendChar('-');
+    append(text, formatUnsigned(text, sizeof(text), 0UL - (unsigned long)value));
+  } else {
+    append(text, formatUnsigned(text, sizeof(text), (unsigned long)value));
+  }
+}
+
+void JsonWriter::addFloatElement(float value, uint8_t decimals) {
+  addFloat(NULL, value, decimals);
+}
+
+void JsonWriter::addUnsignedElement(unsigned long value) {
+  addUnsigned(NULL, value);
+}
+
+void JsonWriter::addIntElement(long value) {
+  addInt(NULL, value);
+}
+
+size_t JsonWriter::formatUnsigned(char* out, size_t outSize, unsigned long value) {
+  char digits[24];
+  size_t n = 0;
+  do {
+    digits[n++] = (char)('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+
+  if (n + 1 > outSize) {
+    return 0;
+  }
+  for (size_t i = 0; i < n; i++) {
+    out[i] = digits[n - 1 - i];
+  }
+  out[n] = '\0';
+  return n;
+}
+
+size_t JsonWriter::formatFloat(char* out, size_t outSize, float value, uint8_t decimals) {
+  static const char nanText[] = "nan";
+  static const char infText[] = "inf";
+  const char* special = isnan(value) ? nanText : isinf(value) ? infText : NULL;
+  if (special) {
+    if (outSize < 4) {
+      return 0;
+    }
+    memcpy(out, special, 4);
+    return 3;
+  }
+
+  if (decimals > JSON_MAX_DECIMALS) {
+    decimals = JSON_MAX_DECIMALS;
+  }
+  double scale = 1.0;
+  for (uint8_t i = 0; i < decimals; i++) {
+    scale *= 10.0;
+  }
+
+  // float * 10^6 fits in a double mantissa, so the scaled value is exact and
+  // round-half-even reproduces printf's correctly rounded output.
+  double scaled = fabs((double)value) * scale;
+  if (scaled > 9.0e18) {
+    scaled = 9.0e18;
+  }
+  double whole = floor(scaled);
+  double fraction = scaled - whole;
+  uint64_t units = (uint64_t)whole;
+  if (fraction > 0.5 || (fraction == 0.5 && (units & 1))) {
+    units++;
+  }
+
+  char digits[32];
+  size_t n = 0;
+  for (uint8_t i = 0; i < decimals; i++) {
+    digits[n++] = (char)('0' + units % 10);
+    units /= 10;
+  }
+  if (decimals > 0) {
+    digits[n++] = '.';
+  }
+  do {
+    digits[n++] = (char)('0' + units % 10);
+    units /= 10;
+  } while (units > 0);
+  if (signbit(value)) {
+    digits[n++] = '-';
+  }
+
+  if (n + 1 > outSize) {
+    return 0;
+  }
+  for (size_t i = 0; i < n; i++) {
+    out[i] = digits[n - 1 - i];
+  }
+  out[n] = '\0';
+  return n;
+}
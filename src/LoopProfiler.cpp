@@ -0,0 +1,77 @@
+#include "LoopProfiler.h"
+
+static const char* const PHASE_NAMES[LOOP_PHASE_COUNT] = {
+  "client", "sensor", "update", "events", "serial"
+};
+
+const char* loopPhaseName(LoopPhase phase) {
+  return phase < LOOP_PHASE_COUNT ? PHASE_NAMES[phase] : "";
+}
+
+void LoopProfileWindow::reset(uint32_t now) {
+  for (size_t i = 0; i < LOOP_PHASE_COUNT; i++) {
+    phases[i].reset();
+  }
+  loopPeriod.reset();
+  acquisitionInterval.reset();
+  acquisitionTime.reset();
+  startTime = now;
+  duration = 0;
+}
+
+LoopProfiler::LoopProfiler(uint32_t windowUs) : windowUs(windowUs) {
+  reset();
+}
+
+void LoopProfiler::reset() {
+  windows[0].reset(0);
+  windows[1].reset(0);
+  current = 0;
+  completed = false;
+  lastLoopStart = 0;
+  phaseStart = 0;
+  lastAcquisition = 0;
+  haveLoop = false;
+  haveAcquisition = false;
+}
+
+void LoopProfiler::beginLoop(uint32_t now) {
+  if (!haveLoop) {
+    // The first pass starts the first window
+    windows[current].reset(now);
+  } else {
+    windows[current].loopPeriod.record(now - lastLoopStart);
+    uint32_t elapsed = now - windows[current].startTime;
+    if (elapsed >= windowUs) {
+      windows[current].duration = elapsed;
+      completed = true;
+      current ^= 1;
+      windows[current].reset(now);
+    }
+  }
+  lastLoopStart = now;
+  phaseStart = now;
+  haveLoop = true;
+}
+
+void LoopProfiler::endPhase(LoopPhase phase, uint32_t now) {
+  if (!haveLoop || phase >= LOOP_PHASE_COUNT) {
+    return;
+  }
+  windows[current].phases[phase].record(now - phaseStart);
+  phaseStart = now;
+}
+
+void LoopProfiler::recordAcquisition(uint32_t start, uint32_t end) {
+  LoopProfileWindow& window = windows[current];
+  if (haveAcquisition) {
+    window.acquisitionInterval.record(start - lastAcquisition);
+  }
+  window.acquisitionTime.record(end - start);
+  lastAcquisition = start;
+  haveAcquisition = true;
+}
+
+const LoopProfileWindow& LoopProfiler::getWindow() const {
+  return completed ? windows[current ^ 1] : windows[current];
+}
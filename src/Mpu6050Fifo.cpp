@@ -0,0 +1,235 @@
+#include "Mpu6050Fifo.h"
+
+Mpu6050Fifo::Mpu6050Fifo(I2cBus& i2c, uint8_t i2cAddress)
+  : bus(i2c),
+    address(i2cAddress),
+    range(ACCEL_RANGE_8G),
+    samplePeriodUs(10000),
+    overflowCount(0),
+    cycling(false),
+    fifoDivider(9),
+    gyroX(false),
+    frameSize(MPU6050_ACCEL_FRAME_SIZE) {}
+
+uint8_t Mpu6050Fifo::rateDivider(unsigned int sampleRateHz) {
+  if (sampleRateHz < 4) {
+    sampleRateHz = 4;
+  } else if (sampleRateHz > MPU6050_GYRO_OUTPUT_RATE) {
+    sampleRateHz = MPU6050_GYRO_OUTPUT_RATE;
+  }
+  return (uint8_t)(MPU6050_GYRO_OUTPUT_RATE / sampleRateHz - 1);
+}
+
+bool Mpu6050Fifo::begin(AccelRange accelRange, unsigned int sampleRateHz, bool withGyroX) {
+  range = accelRange;
+  gyroX = withGyroX;
+  frameSize = withGyroX ? MPU6050_GYRO_X_FRAME_SIZE : MPU6050_ACCEL_FRAME_SIZE;
+  uint8_t divider = rateDivider(sampleRateHz);
+  fifoDivider = divider;
+  samplePeriodUs = 1000UL * (divider + 1);
+  cycling = false;
+
+  uint8_t whoAmI = 0;
+  if (!bus.readRegisters(address, MPU6050_REG_WHO_AM_I, &whoAmI, 1) || whoAmI != MPU6050_WHO_AM_I_VALUE) {
+    return false;
+  }
+
+  return bus.writeRegister(address, MPU6050_REG_PWR_MGMT_1, MPU6050_PWR_MGMT_1_CLK_PLL_X) &&
+         bus.writeRegister(address, MPU6050_REG_PWR_MGMT_2, 0) &&  // out of cycle mode after a warm reset
+         bus.writeRegister(address, MPU6050_REG_CONFIG, 0x04) &&  // DLPF 21 Hz, 1 kHz base rate
+         bus.writeRegister(address, MPU6050_REG_SMPLRT_DIV, divider) &&
+         bus.writeRegister(address, MPU6050_REG_GYRO_CONFIG, 0) &&  // +/-250 deg/s
+         bus.writeRegister(address, MPU6050_REG_ACCEL_CONFIG, (uint8_t)(accelRange << 3)) &&
+         bus.writeRegister(address, MPU6050_REG_FIFO_EN,
+                           withGyroX ? MPU6050_FIFO_EN_ACCEL | MPU6050_FIFO_EN_GYRO_X : MPU6050_FIFO_EN_ACCEL) &&
+         resetFifo();
+}
+
+bool Mpu6050Fifo::setSampleRate(unsigned int sampleRateHz) {
+  fifoDivider = rateDivider(sampleRateHz);
+  if (cycling) {
+    return true;  // applied by exitCycleMode()
+  }
+  samplePeriodUs = 1000UL * (fifoDivider + 1);
+  return bus.writeRegister(address, MPU6050_REG_SMPLRT_DIV, fifoDivider) && resetFifo();
+}
+
+bool Mpu6050Fifo::enterCycleMode(unsigned int sampleRateHz) {
+  static const unsigned long wakePeriodUs[] = {800000, 200000, 50000, 25000};
+  uint8_t wake = CYCLE_WAKE_40HZ;
+  if (sampleRateHz <= 1) {
+    wake = CYCLE_WAKE_1_25HZ;
+  } else if (sampleRateHz <= 5) {
+    wake = CYCLE_WAKE_5HZ;
+  } else if (sampleRateHz <= 20) {
+    wake = CYCLE_WAKE_20HZ;
+  }
+
+  // Stop the FIFO first, then let the chip cycle on its internal oscillator
+  // (the PLL references a gyro that is about to stand by)
+  if (!bus.writeRegister(address, MPU6050_REG_USER_CTRL, 0) ||
+      !bus.writeRegister(address, MPU6050_REG_PWR_MGMT_2, (uint8_t)((wake << 6) | MPU6050_PWR_MGMT_2_STBY_GYRO)) ||
+      !bus.writeRegister(address, MPU6050_REG_PWR_MGMT_1, MPU6050_PWR_MGMT_1_CYCLE | MPU6050_PWR_MGMT_1_TEMP_DIS)) {
+    return false;
+  }
+  cycling = true;
+  samplePeriodUs = wakePeriodUs[wake];
+  return true;
+}
+
+bool Mpu6050Fifo::exitCycleMode() {
+  if (!bus.writeRegister(address, MPU6050_REG_PWR_MGMT_1, MPU6050_PWR_MGMT_1_CLK_PLL_X) ||
+      !bus.writeRegister(address, MPU6050_REG_PWR_MGMT_2, 0)) {
+    return false;
+  }
+  cycling = false;
+  samplePeriodUs = 1000UL * (fifoDivider + 1);
+  return bus.writeRegister(address, MPU6050_REG_SMPLRT_DIV, fifoDivider) && resetFifo();
+}
+
+bool Mpu6050Fifo::readLatest(AccelData& sample) {
+  uint8_t frame[MPU6050_ACCEL_FRAME_SIZE];
+  if (!bus.readRegisters(address, MPU6050_REG_ACCEL_XOUT_H, frame, sizeof(frame))) {
+    return false;
+  }
+  RawAccelSample raw;
+  decodeFrame(frame, raw);
+  sample.x = countsToMs2(raw.x, range);
+  sample.y = countsToMs2(raw.y, range);
+  sample.z = countsToMs2(raw.z, range);
+  sample.valid = true;
+  return true;
+}
+
+bool Mpu6050Fifo::resetFifo() {
+  return bus.writeRegister(address, MPU6050_REG_USER_CTRL, MPU6050_USER_CTRL_FIFO_RESET) &&
+         bus.writeRegister(address, MPU6050_REG_USER_CTRL, MPU6050_USER_CTRL_FIFO_EN);
+}
+
+bool Mpu6050Fifo::readFifoCount(uint16_t& count) {
+  uint8_t data[2];
+  if (!bus.readRegisters(address, MPU6050_REG_FIFO_COUNT_H, data, 2)) {
+    return false;
+  }
+  count = (uint16_t)((data[0] << 8) | data[1]);
+  return true;
+}
+
+bool Mpu6050Fifo::queuedSamples(size_t maxSamples, size_t& count, size_t& available) {
+  count = 0;
+  available = 0;
+
+  uint16_t fifoBytes;
+  if (!readFifoCount(fifoBytes)) {
+    return false;
+  }
+
+  // A full FIFO has dropped data and may no longer be frame aligned
+  if (fifoBytes >= MPU6050_FIFO_SIZE) {
+    overflowCount++;
+    return resetFifo();
+  }
+
+  // A frame still being written stays queued for the next read
+  available = fifoBytes / frameSize;
+  count = available < maxSamples ? available : maxSamples;
+  return true;
+}
+
+// gyroCounts may be NULL; it is only written when frames carry gyro X
+bool Mpu6050Fifo::readFrames(RawAccelSample* samples, int16_t* gyroCounts, size_t count) {
+  uint8_t burst[MPU6050_BURST_BYTES];
+
+  if (!bus.readRegisters(address, MPU6050_REG_FIFO_R_W, burst, count * frameSize)) {
+    return false;
+  }
+  for (size_t i = 0; i < count; i++) {
+    const uint8_t* frame = burst + i * frameSize;
+    decodeFrame(frame, samples[i]);
+    if (gyroX && gyroCounts != NULL) {
+      gyroCounts[i] = (int16_t)((frame[6] << 8) | frame[7]);
+    }
+  }
+  return true;
+}
+
+bool Mpu6050Fifo::readRaw(RawAccelSample* samples, size_t maxSamples, size_t& count) {
+  size_t queued, available;
+  count = 0;
+  if (!queuedSamples(maxSamples, queued, available)) {
+    return false;
+  }
+
+  while (count < queued) {
+    size_t frames = queued - count;
+    if (frames > burstFrames()) {
+      frames = burstFrames();
+    }
+    if (!readFrames(samples + count, NULL, frames)) {
+      return false;
+    }
+    count += frames;
+  }
+
+  return true;
+}
+
+bool Mpu6050Fifo::readBatch(AccelData* samples, unsigned long* times, size_t maxSamples,
+                            unsigned long currentTime, size_t& count, float* gyroRates) {
+  size_t queued, available;
+  count = 0;
+  if (!queuedSamples(maxSamples, queued, available)) {
+    return false;
+  }
+
+  RawAccelSample raw[MPU6050_BURST_FRAMES];
+  int16_t gyro[MPU6050_BURST_FRAMES];
+  while (count < queued) {
+    size_t frames = queued - count;
+    if (frames > burstFrames()) {
+      frames = burstFrames();
+    }
+    if (!readFrames(raw, gyro, frames)) {
+      return false;
+    }
+    for (size_t i = 0; i < frames; i++) {
+      AccelData& sample = samples[count + i];
+      sample.x = countsToMs2(raw[i].x, range);
+      sample.y = countsToMs2(raw[i].y, range);
+      sample.z = countsToMs2(raw[i].z, range);
+      sample.valid = true;
+      if (gyroRates != NULL) {
+        gyroRates[count + i] = gyroX ? gyroCountsToDps(gyro[i]) : NAN;
+      }
+    }
+    count += frames;
+  }
+
+  // The newest queued frame was sampled at currentTime. With more queued than
+  // maxSamples the frames read are the oldest, and the rest (read next time)
+  // are newer, so count back from the newest queued frame, not the last read.
+  for (size_t i = 0; i < count; i++) {
+    times[i] = currentTime - ((available - 1 - i) * samplePeriodUs) / 1000;
+  }
+
+  return true;
+}
+
+float Mpu6050Fifo::countsPerG(AccelRange accelRange) {
+  return 16384.0f / (float)(1 << accelRange);
+}
+
+float Mpu6050Fifo::countsToMs2(int16_t counts, AccelRange accelRange) {
+  return counts * STANDARD_GRAVITY / countsPerG(accelRange);
+}
+
+float Mpu6050Fifo::gyroCountsToDps(int16_t counts) {
+  return counts / MPU6050_GYRO_COUNTS_PER_DPS;
+}
+
+void Mpu6050Fifo::decodeFrame(const uint8_t* frame, RawAccelSample& sample) {
+  // Registers are big-endian: XOUT_H, XOUT_L, YOUT_H, ...
+  sample.x = (int16_t)((frame[0] << 8) | frame[1]);
+  sample.y = (int16_t)((frame[2] << 8) | frame[3]);
+  sample.z = (int16_t)((frame[4] << 8) | frame[5]);
+}
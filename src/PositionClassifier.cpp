@@ -0,0 +1,149 @@
+#include "PositionClassifier.h"
+#include <math.h>
+#include <string.h>
+
+#if !defined(POSITION_CLASSIFIER_SCALAR) && defined(__AVX2__)
+#include <immintrin.h>
+#define POSITION_CLASSIFIER_AVX2 1
+#define POSITION_CLASSIFIER_STEP 8
+#elif !defined(POSITION_CLASSIFIER_SCALAR) && defined(__SSE2__)
+#include <emmintrin.h>
+#define POSITION_CLASSIFIER_SSE2 1
+#define POSITION_CLASSIFIER_STEP 4
+#endif
+
+static void clearMasks(size_t n, uint32_t* closedMask, uint32_t* openMask, uint32_t* intermediateMask) {
+  size_t bytes = positionMaskWords(n) * sizeof(uint32_t);
+  if (closedMask) memset(closedMask, 0, bytes);
+  if (openMask) memset(openMask, 0, bytes);
+  if (intermediateMask) memset(intermediateMask, 0, bytes);
+}
+
+// Bits for samples [begin, n), one at a time
+static void classifyTail(const float* accelY, const float* accelZ, size_t begin, size_t n,
+                         const DoorMonitorConfig& config,
+                         uint32_t* closedMask, uint32_t* openMask, uint32_t* intermediateMask) {
+  for (size_t i = begin; i < n; i++) {
+    bool closed = fabsf(accelY[i] - config.closedPositionY) <= config.positionTolerance &&
+                  fabsf(accelZ[i] - config.closedPositionZ) <= config.positionTolerance;
+    bool open = !closed &&
+                fabsf(accelY[i] - config.openPositionY) <= config.positionTolerance &&
+                fabsf(accelZ[i] - config.openPositionZ) <= config.positionTolerance;
+    uint32_t bit = 1u << (i % POSITION_MASK_BITS);
+    size_t word = i / POSITION_MASK_BITS;
+    if (closed && closedMask) closedMask[word] |= bit;
+    if (open && openMask) openMask[word] |= bit;
+    if (!closed && !open && intermediateMask) intermediateMask[word] |= bit;
+  }
+}
+
+void classifyPositionsScalar(const float* accelY, const float* accelZ, size_t n, const DoorMonitorConfig& config,
+                             uint32_t* closedMask, uint32_t* openMask, uint32_t* intermediateMask) {
+  clearMasks(n, closedMask, openMask, intermediateMask);
+  classifyTail(accelY, accelZ, 0, n, config, closedMask, openMask, intermediateMask);
+}
+
+#if defined(POSITION_CLASSIFIER_AVX2)
+
+void classifyPositions(const float* accelY, const float* accelZ, size_t n, const DoorMonitorConfig& config,
+                       uint32_t* closedMask, uint32_t* openMask, uint32_t* intermediateMask) {
+  clearMasks(n, closedMask, openMask, intermediateMask);
+
+  const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+  const __m256 closedY = _mm256_set1_ps(config.closedPositionY);
+  const __m256 closedZ = _mm256_set1_ps(config.closedPositionZ);
+  const __m256 openY = _mm256_set1_ps(config.openPositionY);
+  const __m256 openZ = _mm256_set1_ps(config.openPositionZ);
+  const __m256 tolerance = _mm256_set1_ps(config.positionTolerance);
+
+  size_t i = 0;
+  for (; i + POSITION_CLASSIFIER_STEP <= n; i += POSITION_CLASSIFIER_STEP) {
+    __m256 y = _mm256_loadu_ps(accelY + i);
+    __m256 z = _mm256_loadu_ps(accelZ + i);
+    __m256 closed = _mm256_and_ps(
+        _mm256_cmp_ps(_mm256_and_ps(_mm256_sub_ps(y, closedY), absMask), tolerance, _CMP_LE_OQ),
+        _mm256_cmp_ps(_mm256_and_ps(_mm256_sub_ps(z, closedZ), absMask), tolerance, _CMP_LE_OQ));
+    __m256 open = _mm256_and_ps(
+        _mm256_cmp_ps(_mm256_and_ps(_mm256_sub_ps(y, openY), absMask), tolerance, _CMP_LE_OQ),
+        _mm256_cmp_ps(_mm256_and_ps(_mm256_sub_ps(z, openZ), absMask), tolerance, _CMP_LE_OQ));
+
+    uint32_t closedBits = (uint32_t)_mm256_movemask_ps(closed);
+    uint32_t openBits = (uint32_t)_mm256_movemask_ps(open) & ~closedBits;
+    uint32_t intermediateBits = ~(closedBits | openBits) & 0xFFu;
+    unsigned shift = (unsigned)(i % POSITION_MASK_BITS);
+    size_t word = i / POSITION_MASK_BITS;
+    if (closedMask) closedMask[word] |= closedBits << shift;
+    if (openMask) openMask[word] |= openBits << shift;
+    if (intermediateMask) intermediateMask[word] |= intermediateBits << shift;
+  }
+  classifyTail(accelY, accelZ, i, n, config, closedMask, openMask, intermediateMask);
+}
+
+const char* positionClassifierImpl() {
+  return "avx2";
+}
+
+#elif defined(POSITION_CLASSIFIER_SSE2)
+
+void classifyPositions(const float* accelY, const float* accelZ, size_t n, const DoorMonitorConfig& config,
+                       uint32_t* closedMask, uint32_t* openMask, uint32_t* intermediateMask) {
+  clearMasks(n, closedMask, openMask, intermediateMask);
+
+  const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+  const __m128 closedY = _mm_set1_ps(config.closedPositionY);
+  const __m128 closedZ = _mm_set1_ps(config.closedPositionZ);
+  const __m128 openY = _mm_set1_ps(config.openPositionY);
+  const __m128 openZ = _mm_set1_ps(config.openPositionZ);
+  const __m128 tolerance = _mm_set1_ps(config.positionTolerance);
+
+  size_t i = 0;
+  for (; i + POSITION_CLASSIFIER_STEP <= n; i += POSITION_CLASSIFIER_STEP) {
+    __m128 y = _mm_loadu_ps(accelY + i);
+    __m128 z = _mm_loadu_ps(accelZ + i);
+    __m128 closed = _mm_and_ps(
+        _mm_cmple_ps(_mm_and_ps(_mm_sub_ps(y, closedY), absMask), tolerance),
+        _mm_cmple_ps(_mm_and_ps(_mm_sub_ps(z, closedZ), absMask), tolerance));
+    __m128 open = _mm_and_ps(
+        _mm_cmple_ps(_mm_and_ps(_mm_sub_ps(y, openY), absMask), tolerance),
+        _mm_cmple_ps(_mm_and_ps(_mm_sub_ps(z, openZ), absMask), tolerance));
+
+    uint32_t closedBits = (uint32_t)_mm_movemask_ps(closed);
+    uint32_t openBits = (uint32_t)_mm_movemask_ps(open) & ~closedBits;
+    uint32_t intermediateBits = ~(closedBits | openBits) & 0xFu;
+    unsigned shift = (unsigned)(i % POSITION_MASK_BITS);
+    size_t word = i / POSITION_MASK_BITS;
+    if (closedMask) closedMask[word] |= closedBits << shift;
+    if (openMask) openMask[word] |= openBits << shift;
+    if (intermediateMask) intermediateMask[word] |= intermediateBits << shift;
+  }
+  classifyTail(accelY, accelZ, i, n, config, closedMask, openMask, intermediateMask);
+}
+
+const char* positionClassifierImpl() {
+  return "sse2";
+}
+
+#else
+
+void classifyPositions(const float* accelY, const float* accelZ, size_t n, const DoorMonitorConfig& config,
+                       uint32_t* closedMask, uint32_t* openMask, uint32_t* intermediateMask) {
+  classifyPositionsScalar(accelY, accelZ, n, config, closedMask, openMask, intermediateMask);
+}
+
+const char* positionClassifierImpl() {
+  return "scalar";
+}
+
+#endif
+
+size_t countPositions(const uint32_t* mask, size_t n) {
+  size_t count = 0;
+  for (size_t w = 0; w < positionMaskWords(n); w++) {
+    uint32_t bits = mask[w];
+    while (bits) {
+      bits &= bits - 1;
+      count++;
+    }
+  }
+  return count;
+}
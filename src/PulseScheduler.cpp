@@ -0,0 +1,45 @@
+#include "PulseScheduler.h"
+
+PulseScheduler::PulseScheduler(unsigned long durationMs, unsigned long cooldownMs)
+  : pulseDuration(durationMs),
+    cooldown(cooldownMs),
+    pulseStart(0),
+    active(false),
+    pending(false),
+    pulseCount(0),
+    coalescedCount(0) {}
+
+bool PulseScheduler::request(unsigned long currentTime) {
+  update(currentTime);
+  if (active || pending) {
+    coalescedCount++;
+    return false;
+  }
+  
+  pulseStart = currentTime;
+  active = true;
+  pulseCount++;
+  return true;
+}
+
+bool PulseScheduler::update(unsigned long currentTime) {
+  unsigned long elapsed = currentTime - pulseStart;
+  
+  if (active && elapsed >= pulseDuration) {
+    active = false;
+    pending = cooldown > 0;
+  }
+  if (pending && elapsed >= pulseDuration + cooldown) {
+    pending = false;
+  }
+  
+  return active;
+}
+
+unsigned long PulseScheduler::getRemaining(unsigned long currentTime) const {
+  if (!active) {
+    return 0;
+  }
+  unsigned long elapsed = currentTime - pulseStart;
+  return elapsed >= pulseDuration ? 0 : pulseDuration - elapsed;
+}
@@ -0,0 +1,50 @@
+#include "SamplingScheduler.h"
+
+SamplingScheduler::SamplingScheduler(unsigned int idleRateHz, unsigned int activeRateHz, unsigned long idleDelayMs)
+  : idleRate(idleRateHz),
+    activeRate(activeRateHz),
+    idleDelay(idleDelayMs),
+    mode(SAMPLING_ACTIVE),
+    resting(false),
+    restStart(0),
+    modeStart(0),
+    idleTotal(0),
+    switchCount(0) {}
+
+void SamplingScheduler::setMode(SamplingMode next, unsigned long currentTime) {
+  if (next == mode) {
+    return;
+  }
+  if (mode == SAMPLING_IDLE) {
+    idleTotal += currentTime - modeStart;
+  }
+  mode = next;
+  modeStart = currentTime;
+  switchCount++;
+}
+
+SamplingMode SamplingScheduler::update(bool atRest, unsigned long currentTime) {
+  if (!atRest) {
+    resting = false;
+    setMode(SAMPLING_ACTIVE, currentTime);
+    return mode;
+  }
+  
+  if (!resting) {
+    resting = true;
+    restStart = currentTime;
+  }
+  if (currentTime - restStart >= idleDelay) {
+    setMode(SAMPLING_IDLE, currentTime);
+  }
+  return mode;
+}
+
+void SamplingScheduler::boost(unsigned long currentTime) {
+  restStart = currentTime;
+  setMode(SAMPLING_ACTIVE, currentTime);
+}
+
+unsigned long SamplingScheduler::getIdleTime(unsigned long currentTime) const {
+  return idleTotal + (mode == SAMPLING_IDLE ? currentTime - modeStart : 0);
+}
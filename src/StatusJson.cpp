@@ -0,0 +1,187 @@
+#include "StatusJson.h"
+#include <string.h>
+#include "JsonWriter.h"
+
+static void writeStatusFields(JsonWriter& json, const DoorMonitorBase& monitor, const AccelData& accel) {
+  json.addString("state", monitor.getStateString());
+  json.addString("details", monitor.getDetailedStatus());
+  json.addFloat("accelX", accel.x, 2);
+  json.addFloat("accelY", accel.y, 2);
+  json.addFloat("accelZ", accel.z, 2);
+  json.addBool("isMoving", monitor.isMoving());
+  json.addBool("isAtPosition", monitor.isAtPosition());
+  json.addBool("sensorHealthy", monitor.isSensorHealthy());
+}
+
+size_t writeStatusJson(char* buffer, size_t capacity, const DoorMonitorBase& monitor, const AccelData& accel) {
+  JsonWriter json(buffer, capacity);
+  
+  json.beginObject();
+  writeStatusFields(json, monitor, accel);
+  json.endObject();
+  
+  return json.overflowed() ? 0 : json.size();
+}
+
+size_t writeStatusJson(char* buffer, size_t capacity, const DoorMonitorBase& monitor, const AccelData& accel,
+                       const DoorPositionEstimator& position) {
+  JsonWriter json(buffer, capacity);
+  
+  json.beginObject();
+  writeStatusFields(json, monitor, accel);
+  json.beginObject("position");
+  json.addFloat("percent", position.getPosition() * 100, 1);
+  json.addFloat("velocity", position.getVelocity() * 100, 1);
+  unsigned long remaining;
+  if (position.estimateArrival(remaining)) {
+    json.addUnsigned("etaMs", remaining);
+  }
+  json.addUnsigned("openingMs", position.getTravelTime(DOOR_OPENING));
+  json.addUnsigned("closingMs", position.getTravelTime(DOOR_CLOSING));
+  json.endObject();
+  json.endObject();
+  
+  return json.overflowed() ? 0 : json.size();
+}
+
+template <size_t Buckets>
+static void writeHistogram(JsonWriter& json, const char* key, const Histogram<Buckets>& histogram, bool buckets) {
+  json.beginObject(key);
+  json.addUnsigned("count", histogram.getCount());
+  json.addUnsigned("min", histogram.getMin());
+  json.addUnsigned("max", histogram.getMax());
+  json.addUnsigned("mean", histogram.getMean());
+  json.addUnsigned("p50", histogram.getPercentile(50));
+  json.addUnsigned("p90", histogram.getPercentile(90));
+  json.addUnsigned("p99", histogram.getPercentile(99));
+  if (buckets) {
+    // Bucket k counts values up to 2^k - 1
+    json.beginArray("buckets");
+    for (size_t i = 0; i < histogram.bucketCount(); i++) {
+      json.addUnsignedElement(histogram.getBucket(i));
+    }
+    json.endArray();
+  }
+  json.endObject();
+}
+
+#ifdef DOOR_MONITOR_METRICS
+size_t writeMetricsJson(char* buffer, size_t capacity, const DoorMonitorMetrics& metrics) {
+  JsonWriter json(buffer, capacity);
+
+  json.beginObject();
+  json.addUnsigned("samples", metrics.samplesProcessed);
+  writeHistogram(json, "motionLatencyMs", metrics.motionLatency, true);
+  writeHistogram(json, "settleLatencyMs", metrics.settleLatency, true);
+  writeHistogram(json, "updateNs", metrics.updateTime, true);
+  json.endObject();
+
+  return json.overflowed() ? 0 : json.size();
+}
+#endif
+
+size_t writeLoopProfileJson(char* buffer, size_t capacity, const LoopProfiler& profiler) {
+  const LoopProfileWindow& window = profiler.getWindow();
+  JsonWriter json(buffer, capacity);
+
+  json.beginObject();
+  json.addUnsigned("windowUs", profiler.getWindowUs());
+  json.addBool("complete", profiler.isWindowComplete());
+  json.addUnsigned("durationUs", window.duration);
+  writeHistogram(json, "loopPeriodUs", window.loopPeriod, true);
+  writeHistogram(json, "acquisitionIntervalUs", window.acquisitionInterval, true);
+  writeHistogram(json, "acquisitionUs", window.acquisitionTime, false);
+  json.beginObject("phasesUs");
+  for (size_t i = 0; i < LOOP_PHASE_COUNT; i++) {
+    writeHistogram(json, loopPhaseName((LoopPhase)i), window.phases[i], false);
+  }
+  json.endObject();
+  json.endObject();
+
+  return json.overflowed() ? 0 : json.size();
+}
+
+size_t writeJournalEntryJson(char* buffer, size_t capacity, const JournalEntry& entry) {
+  JsonWriter json(buffer, capacity);
+
+  json.beginObject();
+  json.addUnsigned("time", entry.time);
+  if (entry.type == JOURNAL_ENTRY_BOOT) {
+    json.addBool("boot", true);
+  } else {
+    json.addString("state", doorStateName(entry.state));
+  }
+  json.endObject();
+
+  return json.overflowed() ? 0 : json.size();
+}
+
+size_t writeTelemetryJsonHeader(char* buffer, size_t capacity, const TelemetryHistory& history, uint8_t tier) {
+  JsonWriter json(buffer, capacity);
+
+  json.beginObject();
+  json.addUnsigned("tier", tier);
+  json.addUnsigned("periodMs", TelemetryHistory::getPeriod(tier));
+  json.addUnsigned("endMs", history.getEndTime(tier));
+  json.addFloat("scale", 1.0f / TELEMETRY_UNITS_PER_MS2, 2);
+  json.beginArray("buckets");
+
+  return json.overflowed() ? 0 : json.size();
+}
+
+size_t writeTelemetryBucketJson(char* buffer, size_t capacity, const TelemetryBucket& bucket) {
+  if (bucket.isEmpty()) {
+    if (capacity < 5) {
+      return 0;
+    }
+    memcpy(buffer, "null", 5);
+    return 4;
+  }
+
+  JsonWriter json(buffer, capacity);
+
+  json.beginArray(NULL);
+  json.addIntElement(bucket.minY);
+  json.addIntElement(bucket.maxY);
+  json.addIntElement(bucket.meanY);
+  json.addIntElement(bucket.minZ);
+  json.addIntElement(bucket.maxZ);
+  json.addIntElement(bucket.meanZ);
+  json.endArray();
+
+  return json.overflowed() ? 0 : json.size();
+}
+
+size_t writeTelemetryBucketEventJson(char* buffer, size_t capacity, const TelemetryHistory& history, uint8_t tier) {
+  size_t count = history.getBucketCount(tier);
+  if (count == 0) {
+    return 0;
+  }
+
+  JsonWriter json(buffer, capacity);
+
+  json.beginObject();
+  json.addUnsigned("tier", tier);
+  json.addUnsigned("periodMs", TelemetryHistory::getPeriod(tier));
+  json.addUnsigned("endMs", history.getEndTime(tier));
+  if (json.overflowed()) {
+    return 0;
+  }
+
+  // The bucket goes in as written by writeTelemetryBucketJson(), then "}"
+  static const char key[] = ",\"bucket\":";
+  size_t length = json.size();
+  if (length + sizeof(key) - 1 >= capacity) {
+    return 0;
+  }
+  memcpy(buffer + length, key, sizeof(key) - 1);
+  length += sizeof(key) - 1;
+  size_t bucketLength = writeTelemetryBucketJson(buffer + length, capacity - length, history.getBucket(tier, count - 1));
+  if (bucketLength == 0 || length + bucketLength + 1 >= capacity) {
+    return 0;
+  }
+  length += bucketLength;
+  buffer[length++] = '}';
+  buffer[length] = '\0';
+  return length;
+}
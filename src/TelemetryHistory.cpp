@@ -0,0 +1,132 @@
+#include "TelemetryHistory.h"
+#include <math.h>
+
+static const unsigned long TIER_PERIODS[TELEMETRY_TIER_COUNT] = {1000, 60000, 3600000};
+
+static int16_t toUnits(float value) {
+  float units = roundf(value * TELEMETRY_UNITS_PER_MS2);
+  if (!(units > -32768.0f)) {
+    return -32767;  // NaN and the NO_DATA marker clamp to the lowest real value
+  }
+  return units > 32767.0f ? 32767 : (int16_t)units;
+}
+
+static void putU16(uint8_t* out, uint16_t v) {
+  out[0] = (uint8_t)(v & 0xFF);
+  out[1] = (uint8_t)(v >> 8);
+}
+
+static void putU32(uint8_t* out, uint32_t v) {
+  putU16(out, (uint16_t)(v & 0xFFFF));
+  putU16(out + 2, (uint16_t)(v >> 16));
+}
+
+TelemetryHistory::TelemetryHistory() {
+  reset();
+}
+
+void TelemetryHistory::reset() {
+  for (uint8_t t = 0; t < TELEMETRY_TIER_COUNT; t++) {
+    head[t] = 0;
+    filled[t] = 0;
+  }
+  started = false;
+}
+
+unsigned long TelemetryHistory::getPeriod(uint8_t tier) {
+  return tier < TELEMETRY_TIER_COUNT ? TIER_PERIODS[tier] : 0;
+}
+
+const TelemetryBucket& TelemetryHistory::getBucket(uint8_t tier, size_t i) const {
+  size_t oldest = (head[tier] + TELEMETRY_TIER_BUCKETS - filled[tier]) % TELEMETRY_TIER_BUCKETS;
+  return buckets[tier][(oldest + i) % TELEMETRY_TIER_BUCKETS];
+}
+
+unsigned long TelemetryHistory::getEndTime(uint8_t tier) const {
+  return filled[tier] == 0 ? 0 : current[tier].start;
+}
+
+void TelemetryHistory::commit(uint8_t tier, const TelemetryBucket& bucket) {
+  buckets[tier][head[tier]] = bucket;
+  head[tier] = (head[tier] + 1) % TELEMETRY_TIER_BUCKETS;
+  if (filled[tier] < TELEMETRY_TIER_BUCKETS) {
+    filled[tier]++;
+  }
+}
+
+// Close the open bucket, add empty buckets for skipped periods and open the
+// one containing time
+void TelemetryHistory::roll(uint8_t tier, unsigned long time) {
+  Accumulator& a = current[tier];
+  unsigned long period = TIER_PERIODS[tier];
+
+  // The open bucket always holds the sample that opened it
+  TelemetryBucket bucket;
+  bucket.minY = a.minY;
+  bucket.maxY = a.maxY;
+  bucket.meanY = (int16_t)(a.sumY / (int64_t)a.count);
+  bucket.minZ = a.minZ;
+  bucket.maxZ = a.maxZ;
+  bucket.meanZ = (int16_t)(a.sumZ / (int64_t)a.count);
+  commit(tier, bucket);
+
+  unsigned long skipped = (time - a.end) / period;
+  if (skipped > 0) {
+    TelemetryBucket empty;
+    empty.minY = empty.maxY = empty.meanY = TELEMETRY_NO_DATA;
+    empty.minZ = empty.maxZ = empty.meanZ = TELEMETRY_NO_DATA;
+    for (unsigned long i = 0; i < skipped && i < TELEMETRY_TIER_BUCKETS; i++) {
+      commit(tier, empty);
+    }
+  }
+
+  a.start = a.end + skipped * period;
+  a.end = a.start + period;
+  a.sumY = 0;
+  a.sumZ = 0;
+  a.count = 0;
+}
+
+void TelemetryHistory::add(unsigned long time, float accelY, float accelZ) {
+  int16_t y = toUnits(accelY);
+  int16_t z = toUnits(accelZ);
+
+  for (uint8_t t = 0; t < TELEMETRY_TIER_COUNT; t++) {
+    Accumulator& a = current[t];
+    if (!started) {
+      a.start = time - time % TIER_PERIODS[t];
+      a.end = a.start + TIER_PERIODS[t];
+      a.sumY = 0;
+      a.sumZ = 0;
+      a.count = 0;
+    } else if ((long)(time - a.end) >= 0) {
+      roll(t, time);
+    }
+
+    if (a.count == 0 || y < a.minY) a.minY = y;
+    if (a.count == 0 || y > a.maxY) a.maxY = y;
+    if (a.count == 0 || z < a.minZ) a.minZ = z;
+    if (a.count == 0 || z > a.maxZ) a.maxZ = z;
+    a.sumY += y;
+    a.sumZ += z;
+    a.count++;
+  }
+  started = true;
+}
+
+void encodeTelemetryHeader(const TelemetryHistory& history, uint8_t tier, uint8_t* out) {
+  out[0] = TELEMETRY_BINARY_VERSION;
+  out[1] = tier;
+  putU16(out + 2, (uint16_t)history.getBucketCount(tier));
+  putU32(out + 4, (uint32_t)TelemetryHistory::getPeriod(tier));
+  putU32(out + 8, (uint32_t)history.getEndTime(tier));
+}
+
+void encodeTelemetryBucket(const TelemetryBucket& bucket, uint8_t* out) {
+  putU16(out, (uint16_t)bucket.minY);
+  putU16(out + 2, (uint16_t)bucket.maxY);
+  putU16(out + 4, (uint16_t)bucket.meanY);
+  putU16(out + 6, (uint16_t)bucket.minZ);
+  putU16(out + 8, (uint16_t)bucket.maxZ);
+  putU16(out + 10, (uint16_t)bucket.meanZ);
+}
@@ -0,0 +1,73 @@
+#include "TiltEstimator.h"
+#include <math.h>
+
+#define RAD_TO_DEG 57.29577951f
+
+TiltEstimator::TiltEstimator(float timeConstant, float sign)
+  : timeConstantMs(timeConstant),
+    gyroSign(sign),
+    angle(0),
+    rate(0),
+    bias(0),
+    lastAccelAngle(0),
+    lastTime(0),
+    primed(false) {}
+
+void TiltEstimator::reset(bool clearBias) {
+  angle = 0;
+  rate = 0;
+  lastAccelAngle = 0;
+  lastTime = 0;
+  primed = false;
+  if (clearBias) {
+    bias = 0;
+  }
+}
+
+float TiltEstimator::accelAngle(float accelY, float accelZ) {
+  return atan2f(accelZ, accelY) * RAD_TO_DEG;
+}
+
+float TiltEstimator::step(float accelAngleDeg, unsigned long time) {
+  unsigned long elapsed = time - lastTime;
+  lastTime = time;
+  if (!primed || elapsed > TILT_MAX_GAP_MS) {
+    angle = accelAngleDeg;
+    lastAccelAngle = accelAngleDeg;
+    rate = 0;
+    primed = true;
+    return -1.0f;
+  }
+  return elapsed / 1000.0f;
+}
+
+void TiltEstimator::update(float accelY, float accelZ, float gyroRate, unsigned long time) {
+  float measured = accelAngle(accelY, accelZ);
+  float dt = step(measured, time);
+  lastAccelAngle = measured;
+  if (dt < 0) {
+    rate = gyroSign * gyroRate - bias;
+    return;
+  }
+
+  float kp = 1000.0f / timeConstantMs;
+  float ki = kp * kp / 4;
+  float error = measured - angle;
+  bias -= ki * error * dt;
+  rate = gyroSign * gyroRate - bias;
+  angle += (rate + kp * error) * dt;
+}
+
+void TiltEstimator::updateAccelOnly(float accelY, float accelZ, unsigned long time) {
+  float measured = accelAngle(accelY, accelZ);
+  float dt = step(measured, time);
+  if (dt <= 0) {
+    lastAccelAngle = measured;
+    return;
+  }
+
+  float k = dt * 1000.0f / (timeConstantMs + dt * 1000.0f);
+  rate += ((measured - lastAccelAngle) / dt - rate) * k;
+  angle += (measured - angle) * k;
+  lastAccelAngle = measured;
+}
@@ -0,0 +1,144 @@
+#include "TraceFormat.h"
+#include <string.h>
+
+static void putU16(uint8_t* out, uint16_t v) {
+  out[0] = (uint8_t)(v & 0xFF);
+  out[1] = (uint8_t)(v >> 8);
+}
+
+static void putU32(uint8_t* out, uint32_t v) {
+  putU16(out, (uint16_t)(v & 0xFFFF));
+  putU16(out + 2, (uint16_t)(v >> 16));
+}
+
+static uint16_t getU16(const uint8_t* in) {
+  return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+static uint32_t getU32(const uint8_t* in) {
+  return (uint32_t)getU16(in) | ((uint32_t)getU16(in + 2) << 16);
+}
+
+void encodeTraceHeader(const TraceHeader& header, uint8_t* out) {
+  memcpy(out, TRACE_MAGIC, 4);
+  out[4] = header.version;
+  out[5] = (uint8_t)header.range;
+  putU16(out + 6, 0);
+  putU32(out + 8, (uint32_t)header.startTime);
+  putU32(out + 12, header.sampleCount);
+}
+
+bool decodeTraceHeader(const uint8_t* data, size_t size, TraceHeader& header) {
+  if (size < TRACE_HEADER_SIZE || memcmp(data, TRACE_MAGIC, 4) != 0) {
+    return false;
+  }
+  header.version = data[4];
+  if (header.version != TRACE_VERSION || data[5] > ACCEL_RANGE_16G) {
+    return false;
+  }
+  header.range = (AccelRange)data[5];
+  header.startTime = getU32(data + 8);
+  header.sampleCount = getU32(data + 12);
+  return true;
+}
+
+size_t TraceEncoder::encode(const TraceRecord& record, uint8_t* out, size_t outSize) {
+  unsigned long delta = record.time - lastTime;
+  size_t skips = delta / TRACE_DELTA_SKIP;
+  size_t needed = (skips + 1) * TRACE_RECORD_SIZE;
+  if (needed > outSize) {
+    return 0;
+  }
+
+  uint8_t* p = out;
+  for (size_t i = 0; i < skips; i++) {
+    putU16(p, TRACE_DELTA_SKIP);
+    putU16(p + 2, 0);
+    putU16(p + 4, 0);
+    putU16(p + 6, 0);
+    p += TRACE_RECORD_SIZE;
+  }
+
+  putU16(p, (uint16_t)(delta % TRACE_DELTA_SKIP));
+  if (record.valid) {
+    putU16(p + 2, (uint16_t)record.accel.x);
+    putU16(p + 4, (uint16_t)record.accel.y);
+    putU16(p + 6, (uint16_t)record.accel.z);
+  } else {
+    putU16(p + 2, (uint16_t)TRACE_INVALID_COUNTS);
+    putU16(p + 4, (uint16_t)TRACE_INVALID_COUNTS);
+    putU16(p + 6, (uint16_t)TRACE_INVALID_COUNTS);
+  }
+
+  lastTime = record.time;
+  return needed;
+}
+
+TraceReader::TraceReader(const uint8_t* traceData, size_t traceSize)
+  : data(traceData),
+    size(traceSize),
+    offset(TRACE_HEADER_SIZE),
+    time(0) {
+  headerValid = decodeTraceHeader(data, size, header);
+  if (headerValid) {
+    time = header.startTime;
+  } else {
+    offset = size;
+  }
+}
+
+void TraceReader::rewind() {
+  if (headerValid) {
+    offset = TRACE_HEADER_SIZE;
+    time = header.startTime;
+  }
+}
+
+bool TraceReader::next(TraceRecord& record) {
+  while (offset + TRACE_RECORD_SIZE <= size) {
+    const uint8_t* p = data + offset;
+    offset += TRACE_RECORD_SIZE;
+
+    uint16_t delta = getU16(p);
+    time += delta;
+    if (delta == TRACE_DELTA_SKIP) {
+      continue;
+    }
+
+    record.time = time;
+    record.accel.x = (int16_t)getU16(p + 2);
+    record.accel.y = (int16_t)getU16(p + 4);
+    record.accel.z = (int16_t)getU16(p + 6);
+    record.valid = !(record.accel.x == TRACE_INVALID_COUNTS &&
+                     record.accel.y == TRACE_INVALID_COUNTS &&
+                     record.accel.z == TRACE_INVALID_COUNTS);
+    return true;
+  }
+  return false;
+}
+
+size_t TraceReader::nextBatch(AccelData* samples, unsigned long* times, size_t maxSamples) {
+  size_t count = 0;
+  TraceRecord record;
+  while (count < maxSamples && next(record)) {
+    samples[count] = traceRecordToAccel(record, header.range);
+    times[count] = record.time;
+    count++;
+  }
+  return count;
+}
+
+AccelData traceRecordToAccel(const TraceRecord& record, AccelRange range) {
+  AccelData accel;
+  if (record.valid) {
+    accel.x = Mpu6050Fifo::countsToMs2(record.accel.x, range);
+    accel.y = Mpu6050Fifo::countsToMs2(record.accel.y, range);
+    accel.z = Mpu6050Fifo::countsToMs2(record.accel.z, range);
+  } else {
+    accel.x = 0;
+    accel.y = 0;
+    accel.z = 0;
+  }
+  accel.valid = record.valid;
+  return accel;
+}
@@ -2,9 +2,34 @@
 #include <ESP8266WiFi.h>
 #include <ESP8266WebServer.h>
 #include <Wire.h>
+#include <Ticker.h>
+#include <LittleFS.h>
 #include <Adafruit_MPU6050.h>
 #include <Adafruit_Sensor.h>
 #include "DoorMonitor.h"
+#include "SampleRingBuffer.h"
+#include "Mpu6050Fifo.h"
+#include "WireI2cBus.h"
+#include "StatusJson.h"
+#include "EventStream.h"
+#include "HttpCache.h"
+#include "IndexHtml.h"
+#include "PulseScheduler.h"
+#include "JsonWriter.h"
+#include "LoopProfiler.h"
+#include "EventJournal.h"
+#include "LittleFsJournalStorage.h"
+#include "TelemetryHistory.h"
+#include "SamplingScheduler.h"
+#include "SampleFilter.h"
+#include "TiltEstimator.h"
+#include "DoorPositionEstimator.h"
+#include "DoorSnapshot.h"
+#include "RtcSnapshotStorage.h"
+#ifdef DOOR_STATIC_CONFIG
+#include "DoorMonitorImpl.h"
+#include "DoorStaticConfig.h"
+#endif
 
 // WiFi credentials from environment
 const char* ssid = WIFI_SSID;
@@ -14,218 +39,438 @@ const char* password = WIFI_PASSWORD;
 #define SDA_PIN 4            // GPIO 4 (D2) - I2C Data
 #define SCL_PIN 5            // GPIO 5 (D1) - I2C Clock
 
-// MPU-6050 sensor
+// The sensor rate follows the door (SamplingScheduler): SAMPLING_ACTIVE_RATE_HZ
+// through the FIFO, SAMPLING_IDLE_RATE_HZ in cycle mode while it rests.
+// DoorMonitor thresholds compare consecutive samples and were tuned at 10 Hz,
+// so it is fed samples at least this far apart whatever the sensor rate.
+#define DOOR_MONITOR_INTERVAL_MS 100
+#define ACQUISITION_INTERVAL_MS 100    // How often the FIFO is drained
+#define ACQUISITION_BATCH_SIZE 32      // Max samples per FIFO drain
+#define FIFO_RETRY_INTERVAL_MS 1000    // How often a failed FIFO start is retried
+#define FIFO_STALL_PERIODS 5           // Sample periods without a frame before reporting a fault
+
+// MPU-6050 sensor (Adafruit driver for setup, FIFO burst reader for sampling)
 Adafruit_MPU6050 mpu;
+WireI2cBus i2cBus(Wire);
+Mpu6050Fifo mpuFifo(i2cBus);
+bool fifoStarted = false;           // mpuFifo.begin() succeeded; retried from loop() until then
+unsigned long lastFifoAttempt = 0;
+unsigned long lastFrameTime = 0;    // when acquireSamples() last got a sample
 
-// Door monitor instance
+// Door monitor instance; -DDOOR_STATIC_CONFIG (the d1_static env) compiles
+// the thresholds from DoorStaticConfig.h into the code
+#ifdef DOOR_STATIC_CONFIG
+DoorMonitorT<float, DefaultStaticConfig> doorMonitor;
+#else
 DoorMonitor doorMonitor;
+#endif
+
+// Fractional position and arrival estimate for /status
+DoorPositionEstimator doorPosition;
+
+// Noise filter on every sample ahead of DoorMonitor (kernels in SampleFilter.h);
+// override with -DSAMPLE_FILTER_KERNEL=... in platformio.ini. In cycle mode
+// samples are 200 ms apart, so SAMPLE_FILTER_IDLE_KERNEL keeps the delay down
+// to about one sample there. Both are reset when the rate changes.
+#ifndef SAMPLE_FILTER_KERNEL
+#define SAMPLE_FILTER_KERNEL MedianKernel<5>
+#endif
+#ifndef SAMPLE_FILTER_IDLE_KERNEL
+#define SAMPLE_FILTER_IDLE_KERNEL MedianKernel<3>
+#endif
+AccelFilter<SAMPLE_FILTER_KERNEL> sampleFilter;
+AccelFilter<SAMPLE_FILTER_IDLE_KERNEL> idleSampleFilter;
+
+// Angle mode (-DDOOR_ANGLE_MODE): gyro X goes into the FIFO and DoorMonitor
+// follows the fused door angle instead of comparing accel samples. Set
+// TILT_GYRO_SIGN to -1 if the door reads as closing while it opens.
+#ifdef DOOR_ANGLE_MODE
+#ifndef TILT_GYRO_SIGN
+#define TILT_GYRO_SIGN 1
+#endif
+#define FIFO_WITH_GYRO true
+TiltEstimator tiltEstimator(TILT_TIME_CONSTANT_MS, TILT_GYRO_SIGN);
+#else
+#define FIFO_WITH_GYRO false
+#endif
+
+// Sensor rate policy, applied by applySamplingMode()
+SamplingScheduler samplingScheduler;
+
+// Door trigger pulse, driven from loop() so sampling continues while the pin is high
+PulseScheduler triggerPulse(TRIGGER_PULSE_MS, TRIGGER_COOLDOWN_MS);
+
+// Sensor acquisition runs from a ticker and hands samples to loop() through this buffer
+Ticker sampleTicker;
+SampleRingBuffer sampleBuffer;
+TimedSample latestSample;  // most recent sample evaluated by doorMonitor
 
 ESP8266WebServer server(80);
 
-// HTML page
-const char* htmlPage = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-  <meta charset="UTF-8">
-  <meta name="viewport" content="width=device-width, initial-scale=1">
-  <style>
-    body { font-family: Arial; text-align: center; margin: 20px; background: #f5f5f5; }
-    .container { max-width: 800px; margin: 0 auto; }
-    h1 { color: #333; }
-    .button {
-      display: inline-block;
-      padding: 20px 40px;
-      font-size: 24px;
-      margin: 10px;
-      cursor: pointer;
-      border: none;
-      border-radius: 8px;
-      color: white;
-      background-color: #2196F3;
-      box-shadow: 0 4px 6px rgba(0,0,0,0.1);
-    }
-    .button:hover { opacity: 0.8; transform: translateY(-2px); }
-    .status {
-      font-size: 18px;
-      margin: 20px 0;
-      padding: 20px;
-      border-radius: 12px;
-      background-color: white;
-      box-shadow: 0 2px 8px rgba(0,0,0,0.1);
-      text-align: left;
+// Server-Sent Events subscribers (/events)
+SseHub<WiFiClient> eventHub;
+SsePublishPolicy eventPolicy(SSE_TELEMETRY_INTERVAL_MS);
+
+// Transition history on flash (/history), 4 x 4 KB segments
+LittleFsJournalStorage journalStorage("/journal.");
+EventJournal eventJournal(journalStorage);
+
+// DoorMonitor state in RTC memory, for picking up where it left off after a reset
+RtcSnapshotStorage snapshotStorage;
+
+// Downsampled accelY/accelZ in RAM (/telemetry), 1 s / 1 min / 1 h tiers
+TelemetryHistory telemetryHistory;
+
+// Streamed responses are sent in chunks of this size
+#define RESPONSE_CHUNK_SIZE 256
+
+#ifdef LOOP_PROFILER
+// Per-phase loop timing and acquisition jitter (/profile)
+LoopProfiler loopProfiler;
+#define PROFILE_LOOP_BEGIN() loopProfiler.beginLoop(micros())
+#define PROFILE_PHASE_END(phase) loopProfiler.endPhase(phase, micros())
+#else
+#define PROFILE_LOOP_BEGIN()
+#define PROFILE_PHASE_END(phase)
+#endif
+
+// Serve the embedded web page (web/index.html, gzipped into IndexHtml.h by tools/embed_web.py)
+void handleRoot() {
+  // Browsers revalidate on every load (no-cache) and get a 304 while the page is unchanged
+  server.sendHeader("ETag", INDEX_HTML_ETAG);
+  server.sendHeader("Cache-Control", "no-cache");
+  if (etagMatches(server.header("If-None-Match").c_str(), INDEX_HTML_ETAG)) {
+    server.send(304);
+    return;
+  }
+  
+  server.sendHeader("Content-Encoding", "gzip");
+  server.send_P(200, PSTR("text/html"), (PGM_P)INDEX_HTML_GZ, INDEX_HTML_GZ_LEN);
+}
+
+void updateTriggerPin() {
+  static bool pinHigh = false;
+  bool high = triggerPulse.update(millis());
+  if (high != pinHigh) {
+    digitalWrite(DOOR_TRIGGER_PIN, high ? HIGH : LOW);
+    pinHigh = high;
+  }
+}
+
+void acquireSamples() {
+  AccelData samples[ACQUISITION_BATCH_SIZE];
+  float gyroRates[ACQUISITION_BATCH_SIZE];
+  unsigned long times[ACQUISITION_BATCH_SIZE];
+  size_t count = 0;
+  TimedSample sample;
+#ifdef LOOP_PROFILER
+  unsigned long start = micros();
+#endif
+  
+  bool ok;
+  if (mpuFifo.isCycleMode()) {
+    // One sample per wake-up, read straight from the data registers
+    ok = mpuFifo.readLatest(samples[0]);
+    gyroRates[0] = NAN;
+    times[0] = millis();
+    count = ok ? 1 : 0;
+  } else {
+    ok = mpuFifo.readBatch(samples, times, ACQUISITION_BATCH_SIZE, millis(), count, gyroRates);
+    // A FIFO that never started or stopped filling reads as empty, not as an error
+    if (ok && count == 0 && millis() - lastFrameTime >= FIFO_STALL_PERIODS * mpuFifo.getSamplePeriodUs() / 1000) {
+      ok = false;
     }
-    .status-row { display: flex; justify-content: space-between; margin: 10px 0; padding: 8px; border-bottom: 1px solid #eee; }
-    .status-label { font-weight: bold; color: #666; }
-    .sensor-grid { display: grid; grid-template-columns: 1fr 1fr 1fr; gap: 15px; margin: 20px 0; }
-    .sensor-card {
-      background: white;
-      padding: 15px;
-      border-radius: 8px;
-      box-shadow: 0 2px 4px rgba(0,0,0,0.1);
+  }
+  if (ok && count > 0) {
+    lastFrameTime = millis();
+  }
+  
+  if (!ok) {
+    // Report the bus error so DoorMonitor can track sensor health
+    sample.accel.x = 0;
+    sample.accel.y = 0;
+    sample.accel.z = 0;
+    sample.accel.valid = false;
+    sample.gyroRate = NAN;
+    sample.time = millis();
+    sampleBuffer.push(sample);
+  } else {
+    for (size_t i = 0; i < count; i++) {
+      sample.accel = samples[i];
+      sample.gyroRate = gyroRates[i];
+      sample.time = times[i];
+      sampleBuffer.push(sample);
     }
-    .sensor-label { font-size: 14px; color: #666; margin-bottom: 5px; }
-    .sensor-value { font-size: 28px; font-weight: bold; color: #333; }
-    .sensor-unit { font-size: 14px; color: #999; }
-    .closed { color: #4CAF50; font-weight: bold; }
-    .open { color: #2196F3; font-weight: bold; }
-    .door_closed { color: #4CAF50; font-weight: bold; }
-    .door_open { color: #2196F3; font-weight: bold; }
-    .door_opening { color: #ff9800; font-weight: bold; }
-    .door_closing { color: #ff9800; font-weight: bold; }
-    .door_stopped { color: #f44336; font-weight: bold; }
-    .door_unknown { color: #999; font-weight: bold; }
-    .opening { color: #ff9800; }
-    .closing { color: #ff9800; }
-    .stopped { color: #f44336; }
-    .health-ok { color: #4CAF50; font-weight: bold; }
-    .health-fail { color: #f44336; font-weight: bold; }
-    .timestamp { font-size: 12px; color: #999; text-align: right; margin-top: 10px; }
-  </style>
-</head>
-<body>
-  <div class="container">
-    <h1>🚪 Garage Door Monitor</h1>
-    
-    <div class="sensor-grid">
-      <div class="sensor-card">
-        <div class="sensor-label">Accel Y (Vertical)</div>
-        <div class="sensor-value" id="accelY">--</div>
-        <div class="sensor-unit">m/s²</div>
-      </div>
-      <div class="sensor-card">
-        <div class="sensor-label">Accel Z (Horizontal)</div>
-        <div class="sensor-value" id="accelZ">--</div>
-        <div class="sensor-unit">m/s²</div>
-      </div>
-      <div class="sensor-card">
-        <div class="sensor-label">Accel X</div>
-        <div class="sensor-value" id="accelX">--</div>
-        <div class="sensor-unit">m/s²</div>
-      </div>
-    </div>
-    
-    <div class="status">
-      <div class="status-row">
-        <span class="status-label">Door State:</span>
-        <span id="status" class="stopped">Loading...</span>
-      </div>
-      <div class="status-row">
-        <span class="status-label">Status Details:</span>
-        <span id="details">Loading...</span>
-      </div>
-      <div class="status-row">
-        <span class="status-label">Movement:</span>
-        <span id="moving">--</span>
-      </div>
-      <div class="status-row">
-        <span class="status-label">At Position:</span>
-        <span id="atPosition">--</span>
-      </div>
-      <div class="status-row">
-        <span class="status-label">Sensor Health:</span>
-        <span id="sensorHealth">--</span>
-      </div>
-      <div class="timestamp">Last update: <span id="timestamp">--</span></div>
-    </div>
-    
-    <button class="button" onclick="triggerDoor()">Trigger Door</button>
-  </div>
-  <script>
-    function triggerDoor() {
-      fetch('/trigger')
-        .then(response => response.text())
-        .then(data => {
-          console.log('Door triggered:', data);
-        });
+  }
+#ifdef LOOP_PROFILER
+  loopProfiler.recordAcquisition(start, micros());
+#endif
+}
+
+// Start FIFO sampling; until this succeeds the drains report invalid samples
+void startFifo() {
+  lastFifoAttempt = millis();
+  fifoStarted = mpuFifo.begin(ACCEL_RANGE_8G, samplingScheduler.getRateHz(), FIFO_WITH_GYRO);
+  Serial.println(fifoStarted ? "MPU6050 FIFO enabled" : "Failed to enable MPU6050 FIFO");
+}
+
+// Bring the sensor and the acquisition ticker in line with the scheduler;
+// a failed switch is retried on the next call, and nothing switches until
+// the FIFO has started
+void applySamplingMode() {
+  static SamplingMode applied = SAMPLING_ACTIVE;
+  SamplingMode mode = samplingScheduler.getMode();
+  if (mode == applied || !fifoStarted) {
+    return;
+  }
+  
+  bool idle = mode == SAMPLING_IDLE;
+  if (!(idle ? mpuFifo.enterCycleMode(samplingScheduler.getRateHz()) : mpuFifo.exitCycleMode())) {
+    Serial.println("Failed to switch sampling mode");
+    return;
+  }
+  applied = mode;
+  // Never mix samples from both rates in one filter window
+  sampleFilter.reset();
+  idleSampleFilter.reset();
+  sampleTicker.attach_ms(idle ? mpuFifo.getSamplePeriodUs() / 1000 : ACQUISITION_INTERVAL_MS, acquireSamples);
+  
+  Serial.print("Sampling ");
+  Serial.print(idle ? "idle" : "active");
+  Serial.print(" at ");
+  Serial.print(samplingScheduler.getRateHz());
+  Serial.println(" Hz");
+}
+
+void handleTrigger() {
+  // Start the pulse (simulated button press) and answer immediately;
+  // clicks while a pulse is in progress are coalesced
+  bool triggered = triggerPulse.request(millis());
+  updateTriggerPin();
+  
+  // Full rate before the door starts to move
+  samplingScheduler.boost(millis());
+  applySamplingMode();
+  
+  if (triggered) {
+    Serial.println("Door trigger activated");
+  }
+  
+  char json[96];
+  JsonWriter writer(json, sizeof(json));
+  writer.beginObject();
+  writer.addBool("triggered", triggered);
+  writer.addBool("pulseActive", triggerPulse.isActive());
+  writer.addUnsigned("remainingMs", triggerPulse.getRemaining(millis()));
+  writer.endObject();
+  server.send(200, "application/json", json, writer.size());
+}
+
+void handleStatus() {
+  static char json[STATUS_JSON_BUFFER_SIZE];
+  size_t length = writeStatusJson(json, sizeof(json), doorMonitor, latestSample.accel, doorPosition);
+  
+  server.send(200, "application/json", json, length);
+}
+
+#ifdef DOOR_MONITOR_METRICS
+void handleMetrics() {
+  static char json[METRICS_JSON_BUFFER_SIZE];
+  size_t length = writeMetricsJson(json, sizeof(json), doorMonitor.getMetrics());
+  
+  server.send(200, "application/json", json, length);
+}
+#endif
+
+#ifdef LOOP_PROFILER
+void handleProfile() {
+  static char json[LOOP_PROFILE_JSON_BUFFER_SIZE];
+  size_t length = writeLoopProfileJson(json, sizeof(json), loopProfiler);
+  
+  server.send(200, "application/json", json, length);
+}
+#endif
+
+// Buffers a response body of unknown length and sends it with chunked
+// transfer encoding; each write() must fit in one chunk
+class ChunkedResponse {
+private:
+  char chunk[RESPONSE_CHUNK_SIZE];
+  size_t used;
+
+public:
+  explicit ChunkedResponse(const char* contentType) : used(0) {
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, contentType, "");
+  }
+
+  void write(const void* data, size_t length) {
+    if (used + length > sizeof(chunk)) {
+      server.sendContent(chunk, used);
+      used = 0;
     }
-    
-    function updateStatus() {
-      fetch('/status')
-        .then(response => response.json())
-        .then(data => {
-          let statusEl = document.getElementById('status');
-          statusEl.innerText = data.state;
-          statusEl.className = data.state.toLowerCase().replace(/ /g, '_');
-          
-          document.getElementById('details').innerText = data.details;
-          document.getElementById('accelY').innerText = data.accelY.toFixed(2);
-          document.getElementById('accelZ').innerText = data.accelZ.toFixed(2);
-          document.getElementById('accelX').innerText = data.accelX.toFixed(2);
-          
-          document.getElementById('moving').innerText = data.isMoving ? 'YES' : 'No';
-          document.getElementById('atPosition').innerText = data.isAtPosition ? 'YES' : 'No';
-          
-          let healthEl = document.getElementById('sensorHealth');
-          healthEl.innerText = data.sensorHealthy ? '✓ OK' : '✗ FAILED';
-          healthEl.className = data.sensorHealthy ? 'health-ok' : 'health-fail';
-          
-          let now = new Date();
-          document.getElementById('timestamp').innerText = now.toLocaleTimeString();
-        })
-        .catch(err => {
-          console.error('Update failed:', err);
-          document.getElementById('status').innerText = 'Connection Error';
-        });
+    memcpy(chunk + used, data, length);
+    used += length;
+  }
+
+  void end() {
+    if (used > 0) {
+      server.sendContent(chunk, used);
     }
-    
-    // Update status every 500ms
-    setInterval(updateStatus, 500);
-    updateStatus();
-  </script>
-</body>
-</html>
-)rawliteral";
+    server.sendContent("");
+  }
+};
 
-void handleRoot() {
-  server.send(200, "text/html", htmlPage);
+// Stream the journal as a JSON array, oldest first, a chunk at a time
+void handleHistory() {
+  eventJournal.flush();
+  JournalReader reader(journalStorage, eventJournal.getSegmentCount());
+  ChunkedResponse response("application/json");
+  
+  char entryJson[JOURNAL_ENTRY_JSON_BUFFER_SIZE];
+  response.write("[", 1);
+  JournalEntry entry;
+  bool first = true;
+  while (reader.next(entry)) {
+    if (!first) {
+      response.write(",", 1);
+    }
+    response.write(entryJson, writeJournalEntryJson(entryJson, sizeof(entryJson), entry));
+    first = false;
+  }
+  response.write("]", 1);
+  response.end();
 }
 
-void handleTrigger() {
-  // Pulse the door trigger pin (simulate button press)
-  digitalWrite(DOOR_TRIGGER_PIN, HIGH);
-  delay(500);  // 500ms pulse
-  digitalWrite(DOOR_TRIGGER_PIN, LOW);
+// One telemetry tier, oldest bucket first: /telemetry?tier=0..2&format=json|bin
+void handleTelemetry() {
+  long tier = server.hasArg("tier") ? server.arg("tier").toInt() : 0;
+  if (tier < 0 || tier >= TELEMETRY_TIER_COUNT) {
+    server.send(400, "text/plain", "tier must be 0, 1 or 2");
+    return;
+  }
+  size_t count = telemetryHistory.getBucketCount((uint8_t)tier);
   
-  Serial.println("Door trigger activated");
-  server.send(200, "text/plain", "Door triggered");
+  if (server.arg("format") == "bin") {
+    ChunkedResponse response("application/octet-stream");
+    uint8_t packed[TELEMETRY_BINARY_HEADER_SIZE];
+    encodeTelemetryHeader(telemetryHistory, (uint8_t)tier, packed);
+    response.write(packed, TELEMETRY_BINARY_HEADER_SIZE);
+    for (size_t i = 0; i < count; i++) {
+      encodeTelemetryBucket(telemetryHistory.getBucket((uint8_t)tier, i), packed);
+      response.write(packed, TELEMETRY_BINARY_BUCKET_SIZE);
+    }
+    response.end();
+    return;
+  }
+  
+  ChunkedResponse response("application/json");
+  char json[TELEMETRY_JSON_HEADER_BUFFER_SIZE];
+  response.write(json, writeTelemetryJsonHeader(json, sizeof(json), telemetryHistory, (uint8_t)tier));
+  for (size_t i = 0; i < count; i++) {
+    if (i > 0) {
+      response.write(",", 1);
+    }
+    response.write(json, writeTelemetryBucketJson(json, sizeof(json), telemetryHistory.getBucket((uint8_t)tier, i)));
+  }
+  response.write("]}", 2);
+  response.end();
 }
 
-AccelData readSensorData() {
-  AccelData data;
-  sensors_event_t a, g, temp;
+void handleEvents() {
+  if (!eventHub.hasCapacity()) {
+    server.send(503, "text/plain", "Too many event subscribers");
+    return;
+  }
   
-  if (mpu.getEvent(&a, &g, &temp)) {
-    data.x = a.acceleration.x;
-    data.y = a.acceleration.y;
-    data.z = a.acceleration.z;
-    data.valid = true;
-  } else {
-    data.x = 0;
-    data.y = 0;
-    data.z = 0;
-    data.valid = false;
+  // Take over the connection; the hub keeps it open after this handler returns
+  WiFiClient client = server.client();
+  client.setNoDelay(true);
+  // Broadcasts skip a subscriber without buffer space; this bounds the rest
+  client.setTimeout(SSE_WRITE_TIMEOUT_MS);
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.sendContent_P(PSTR("HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\nConnection: keep-alive\r\n\r\n"));
+  eventHub.subscribe(client);
+  
+  // Send the current state right away so the page does not wait for a change
+  char json[STATUS_JSON_BUFFER_SIZE];
+  char frame[SSE_MAX_FRAME_SIZE];
+  size_t length = writeStatusJson(json, sizeof(json), doorMonitor, latestSample.accel, doorPosition);
+  length = formatSseFrame(frame, sizeof(frame), SSE_EVENT_STATE, json, length);
+  client.write((const uint8_t*)frame, length);
+}
+
+// Transition listeners: called from doorMonitor.updateStateBatch() as each
+// change happens, so every transition in a batch is seen
+void logTransition(void*, const DoorTransition& transition, DoorState) {
+  Serial.print("*** STATE CHANGE *** Door state: ");
+  Serial.print(doorStateName(transition.to));
+  Serial.print(" | ");
+  Serial.println(doorMonitor.getDetailedStatus());
+}
+
+void journalTransition(void* context, const DoorTransition& transition, DoorState) {
+  ((EventJournal*)context)->append(transition.to, transition.time);
+}
+
+void markEventStateChanged(void* context, const DoorTransition&, DoorState) {
+  ((SsePublishPolicy*)context)->markStateChanged();
+}
+
+// One "bucket" event per newly committed telemetry bucket, so the page's
+// sparkline follows along without refetching /telemetry
+void publishTelemetryBuckets() {
+  static unsigned long publishedEnd[TELEMETRY_TIER_COUNT];
+  for (uint8_t tier = 0; tier < TELEMETRY_TIER_COUNT; tier++) {
+    unsigned long end = telemetryHistory.getEndTime(tier);
+    if (end == publishedEnd[tier]) {
+      continue;
+    }
+    publishedEnd[tier] = end;
+    
+    char json[TELEMETRY_BUCKET_EVENT_JSON_BUFFER_SIZE];
+    char frame[SSE_MAX_FRAME_SIZE];
+    size_t length = writeTelemetryBucketEventJson(json, sizeof(json), telemetryHistory, tier);
+    if (length == 0 || eventHub.subscriberCount() == 0) {
+      continue;
+    }
+    length = formatSseFrame(frame, sizeof(frame), SSE_EVENT_BUCKET, json, length);
+    eventHub.broadcast(frame, length);
+  }
+}
+
+void publishEvents() {
+  publishTelemetryBuckets();
+  SseEventType type = eventPolicy.poll(doorMonitor.getState(), millis());
+  if (type == SSE_EVENT_NONE || eventHub.subscriberCount() == 0) {
+    return;
   }
   
-  return data;
+  char json[STATUS_JSON_BUFFER_SIZE];
+  char frame[SSE_MAX_FRAME_SIZE];
+  size_t length = 0;
+  if (type != SSE_EVENT_KEEPALIVE) {
+    length = writeStatusJson(json, sizeof(json), doorMonitor, latestSample.accel, doorPosition);
+  }
+  length = formatSseFrame(frame, sizeof(frame), type, json, length);
+  eventHub.broadcast(frame, length);
 }
 
-void handleStatus() {
-  AccelData accel = readSensorData();
-  doorMonitor.updateState(accel, millis());
-  
-  String json = "{";
-  json += "\"state\":\"" + String(doorMonitor.getStateString()) + "\",";
-  json += "\"details\":\"" + String(doorMonitor.getDetailedStatus()) + "\",";
-  json += "\"accelX\":" + String(accel.x, 2) + ",";
-  json += "\"accelY\":" + String(accel.y, 2) + ",";
-  json += "\"accelZ\":" + String(accel.z, 2) + ",";
-  json += "\"isMoving\":" + String(doorMonitor.isMoving() ? "true" : "false") + ",";
-  json += "\"isAtPosition\":" + String(doorMonitor.isAtPosition() ? "true" : "false") + ",";
-  json += "\"sensorHealthy\":" + String(doorMonitor.isSensorHealthy() ? "true" : "false");
-  json += "}";
-  
-  server.send(200, "application/json", json);
+// Warm restart: the monitor state is saved after every batch and restored in
+// setup(); a blob left from a cold boot fails its CRC
+void saveMonitorSnapshot(unsigned long now) {
+  DoorSnapshot snapshot;
+  uint8_t blob[DOOR_SNAPSHOT_SIZE];
+  doorMonitor.saveSnapshot(snapshot, now);
+  encodeDoorSnapshot(snapshot, blob);
+  snapshotStorage.save(blob, sizeof(blob));
+}
+
+bool restoreMonitorSnapshot(unsigned long now) {
+  DoorSnapshot snapshot;
+  uint8_t blob[DOOR_SNAPSHOT_SIZE];
+  return snapshotStorage.load(blob, sizeof(blob)) && decodeDoorSnapshot(blob, sizeof(blob), snapshot) &&
+         doorMonitor.restoreSnapshot(snapshot, now);
 }
 
 void setup() {
@@ -253,10 +498,10 @@ void setup() {
   mpu.setGyroRange(MPU6050_RANGE_500_DEG);
   mpu.setFilterBandwidth(MPU6050_BAND_21_HZ);
   
-  // Get initial reading
-  sensors_event_t a, g, temp;
-  mpu.getEvent(&a, &g, &temp);
-  doorMonitor.initialize(a.acceleration.y, a.acceleration.z, millis());
+#ifndef DOOR_ANGLE_MODE
+  // Report CLOSED/OPEN as soon as the door has settled at an end stop
+  doorMonitor.setArrivalConfig(DEFAULT_ARRIVAL_CONFIG);
+#endif
   
   // Connect to WiFi
   Serial.println();
@@ -275,11 +520,59 @@ void setup() {
   Serial.print("IP address: ");
   Serial.println(WiFi.localIP());
   
-  doorMonitor.initialize(a.acceleration.y, a.acceleration.z, millis());
+  doorMonitor.addTransitionListener(logTransition, NULL);
+  doorMonitor.addTransitionListener(markEventStateChanged, &eventPolicy);
+  doorMonitor.addTransitionListener(DoorPositionEstimator::transitionListener, &doorPosition);
+  
+  // Journal transitions to flash; without a filesystem the firmware runs without history
+  if (!LittleFS.begin() || !eventJournal.begin(millis())) {
+    Serial.println("Event journal unavailable");
+  }
+  doorMonitor.addTransitionListener(journalTransition, &eventJournal);
+  
+  // Get initial reading
+  sensors_event_t a, g, temp;
+  mpu.getEvent(&a, &g, &temp);
+  latestSample.accel.x = a.acceleration.x;
+  latestSample.accel.y = a.acceleration.y;
+  latestSample.accel.z = a.acceleration.z;
+  latestSample.accel.valid = true;
+  latestSample.gyroRate = NAN;
+  latestSample.time = millis();
+  
+  // After a reset rather than a power-on, carry on from the snapshot in RTC
+  // memory (mid-travel, timers and all). Done right before sampling starts so
+  // the WiFi connect does not count against the restored timers.
+  bool warmStart = ESP.getResetInfoPtr()->reason != REASON_DEFAULT_RST && restoreMonitorSnapshot(millis());
+  if (!warmStart) {
+#ifdef DOOR_ANGLE_MODE
+    doorMonitor.initializeAngle(TiltEstimator::accelAngle(a.acceleration.y, a.acceleration.z), millis());
+#else
+    doorMonitor.initialize(a.acceleration.y, a.acceleration.z, millis());
+#endif
+  }
+  Serial.print(warmStart ? "Restored door state: " : "Initial door state: ");
+  Serial.println(doorMonitor.getStateString());
+  
+  // Start sampling into the on-chip FIFO and drain it on its own schedule,
+  // independent of HTTP handling
+  startFifo();
+  sampleTicker.attach_ms(ACQUISITION_INTERVAL_MS, acquireSamples);
   
+  static const char* cachedHeaders[] = {"If-None-Match"};
+  server.collectHeaders(cachedHeaders, 1);
   server.on("/", handleRoot);
   server.on("/trigger", handleTrigger);
   server.on("/status", handleStatus);
+  server.on("/events", handleEvents);
+  server.on("/history", handleHistory);
+  server.on("/telemetry", handleTelemetry);
+#ifdef DOOR_MONITOR_METRICS
+  server.on("/metrics", handleMetrics);
+#endif
+#ifdef LOOP_PROFILER
+  server.on("/profile", handleProfile);
+#endif
   
   server.begin();
   Serial.println("HTTP server started");
@@ -287,39 +580,113 @@ void setup() {
 }
 
 void loop() {
+  PROFILE_LOOP_BEGIN();
   server.handleClient();
+  updateTriggerPin();
+  eventJournal.poll(millis());
+  PROFILE_PHASE_END(LOOP_PHASE_CLIENT);
+  
+  // Ahead of the drain so keepalives go out while no samples arrive; state
+  // changes from the previous pass are picked up here
+  publishEvents();
+  PROFILE_PHASE_END(LOOP_PHASE_EVENTS);
+  
+  if (!fifoStarted && millis() - lastFifoAttempt >= FIFO_RETRY_INTERVAL_MS) {
+    startFifo();
+  }
   
-  // Continuously monitor door state
-  static unsigned long lastUpdate = 0;
+  // Drain all samples acquired since the last pass
+  static AccelData samples[SampleRingBuffer::capacity()];
+  static float gyroRates[SampleRingBuffer::capacity()];
+  static unsigned long times[SampleRingBuffer::capacity()];
   static unsigned long lastPrint = 0;
   
-  if (millis() - lastUpdate > 100) {  // Update every 100ms
-    AccelData accel = readSensorData();
-    doorMonitor.updateState(accel, millis());
-    lastUpdate = millis();
-    
-    // Print sensor readings every 2 seconds
-    if (millis() - lastPrint > 2000) {
-      Serial.print("MPU6050 - Y: ");
-      Serial.print(accel.y, 2);
-      Serial.print(" m/s², Z: ");
-      Serial.print(accel.z, 2);
-      Serial.print(" m/s² | State: ");
-      Serial.print(doorMonitor.getStateString());
-      Serial.print(" | ");
-      Serial.println(doorMonitor.getDetailedStatus());
-      lastPrint = millis();
+  size_t count = 0;
+  TimedSample sample;
+  while (count < SampleRingBuffer::capacity() && sampleBuffer.pop(sample)) {
+    samples[count] = sample.accel;
+    gyroRates[count] = sample.gyroRate;
+    times[count] = sample.time;
+    count++;
+  }
+  PROFILE_PHASE_END(LOOP_PHASE_SENSOR);
+  if (count == 0) {
+    return;
+  }
+  
+  if (mpuFifo.isCycleMode()) {
+    idleSampleFilter.applyBatch(samples, count);
+  } else {
+    sampleFilter.applyBatch(samples, count);
+  }
+  for (size_t i = 0; i < count; i++) {
+    if (samples[i].valid) {
+      telemetryHistory.add(times[i], samples[i].y, samples[i].z);
     }
-    
-    // Print status changes immediately
-    static DoorState lastPrintedState = DOOR_UNKNOWN;
-    DoorState currentState = doorMonitor.getState();
-    if (currentState != lastPrintedState) {
-      Serial.print("*** STATE CHANGE *** Door state: ");
-      Serial.print(doorMonitor.getStateString());
-      Serial.print(" | ");
-      Serial.println(doorMonitor.getDetailedStatus());
-      lastPrintedState = currentState;
+  }
+  latestSample.accel = samples[count - 1];
+  latestSample.gyroRate = gyroRates[count - 1];
+  latestSample.time = times[count - 1];
+  
+#ifdef DOOR_ANGLE_MODE
+  // Every sample goes through the estimator (accel alone while the sensor
+  // cycles without its gyro); nothing compares consecutive samples here, so
+  // there is no thinning
+  for (size_t i = 0; i < count; i++) {
+    DoorAngleSample angleSample;
+    angleSample.valid = samples[i].valid;
+    if (angleSample.valid) {
+      if (isnan(gyroRates[i])) {
+        tiltEstimator.updateAccelOnly(samples[i].y, samples[i].z, times[i]);
+      } else {
+        tiltEstimator.update(samples[i].y, samples[i].z, gyroRates[i], times[i]);
+      }
+    }
+    angleSample.angle = tiltEstimator.getAngle();
+    angleSample.rate = tiltEstimator.getRate();
+    doorMonitor.updateStateAngle(angleSample, times[i]);
+    doorPosition.update(samples[i], times[i]);
+  }
+#else
+  // Thin the batch in place to DoorMonitor's sample spacing (within half a
+  // sensor period of jitter); invalid samples always pass for health tracking
+  static unsigned long lastMonitored = 0;
+  unsigned long halfPeriod = mpuFifo.getSamplePeriodUs() / 2000;
+  unsigned long spacing = halfPeriod < DOOR_MONITOR_INTERVAL_MS ? DOOR_MONITOR_INTERVAL_MS - halfPeriod : 0;
+  size_t monitored = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (!samples[i].valid || times[i] - lastMonitored >= spacing) {
+      if (samples[i].valid) {
+        lastMonitored = times[i];
+      }
+      samples[monitored] = samples[i];
+      times[monitored] = times[i];
+      monitored++;
     }
   }
-}
\ No newline at end of file
+  doorMonitor.updateStateBatch(samples, times, monitored, NULL, 0);
+  // After the batch, so a run that started in it is already known
+  for (size_t i = 0; i < monitored; i++) {
+    doorPosition.update(samples[i], times[i]);
+  }
+#endif
+  saveMonitorSnapshot(millis());
+  samplingScheduler.update(doorMonitor.isAtPosition(), millis());
+  applySamplingMode();
+  PROFILE_PHASE_END(LOOP_PHASE_UPDATE);
+  const AccelData& accel = latestSample.accel;
+  
+  // Print sensor readings every 2 seconds
+  if (millis() - lastPrint > 2000) {
+    Serial.print("MPU6050 - Y: ");
+    Serial.print(accel.y, 2);
+    Serial.print(" m/s², Z: ");
+    Serial.print(accel.z, 2);
+    Serial.print(" m/s² | State: ");
+    Serial.print(doorMonitor.getStateString());
+    Serial.print(" | ");
+    Serial.println(doorMonitor.getDetailedStatus());
+    lastPrint = millis();
+  }
+  PROFILE_PHASE_END(LOOP_PHASE_SERIAL);
+}
@@ -0,0 +1,218 @@
+#ifndef DOOR_TRACE_FIXTURES_H
+#define DOOR_TRACE_FIXTURES_H
+
+// Synthetic door motion traces in raw MPU-6050 counts (+/-8 g, 4096 counts/g)
+// for tests and benchmarks.
+
+#include <stdint.h>
+#include <math.h>
+#include <vector>
+#include "TraceFormat.h"
+#include "Mpu6050Fifo.h"
+
+#define TRACE_COUNTS_PER_G 4096.0f
+#define TRACE_PERIOD_MS 100
+
+struct TraceSample {
+  unsigned long time;
+  int16_t x;
+  int16_t y;
+  int16_t z;
+  bool valid;
+};
+
+// A trace sample in m/s^2, converted the way Mpu6050Fifo converts sensor counts
+inline AccelData traceSampleToAccel(const TraceSample& raw) {
+  AccelData a = {Mpu6050Fifo::countsToMs2(raw.x, ACCEL_RANGE_8G), Mpu6050Fifo::countsToMs2(raw.y, ACCEL_RANGE_8G),
+                 Mpu6050Fifo::countsToMs2(raw.z, ACCEL_RANGE_8G), raw.valid};
+  return a;
+}
+
+// A stretch of the trace: the door angle moves linearly from startAngle to endAngle
+// (0 = closed/vertical, 90 = open/horizontal) with uniform noise on every axis.
+struct TraceSegment {
+  unsigned long durationMs;
+  float startAngleDeg;
+  float endAngleDeg;
+  int noiseCounts;
+  bool sensorFailure;
+};
+
+class TraceNoise {
+private:
+  uint32_t state;
+
+public:
+  explicit TraceNoise(uint32_t seed) : state(seed ? seed : 1) {}
+
+  uint32_t next() {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+  }
+
+  int uniform(int amplitude) {
+    if (amplitude <= 0) {
+      return 0;
+    }
+    return (int)(next() % (uint32_t)(2 * amplitude + 1)) - amplitude;
+  }
+};
+
+inline int16_t traceClamp(float counts) {
+  if (counts > 32767.0f) return 32767;
+  if (counts < -32768.0f) return -32768;
+  return (int16_t)lroundf(counts);
+}
+
+inline std::vector<TraceSample> synthesizeTrace(const TraceSegment* segments, size_t segmentCount,
+                                                unsigned long periodMs, uint32_t seed) {
+  std::vector<TraceSample> trace;
+  TraceNoise noise(seed);
+  unsigned long time = 1000;
+
+  for (size_t s = 0; s < segmentCount; s++) {
+    const TraceSegment& seg = segments[s];
+    unsigned long steps = seg.durationMs / periodMs;
+    for (unsigned long i = 0; i < steps; i++) {
+      float t = steps > 1 ? (float)(i + 1) / (float)steps : 1.0f;
+      float angle = (seg.startAngleDeg + (seg.endAngleDeg - seg.startAngleDeg) * t) * 3.14159265f / 180.0f;
+      TraceSample sample;
+      sample.time = time;
+      sample.valid = !seg.sensorFailure;
+      if (sample.valid) {
+        sample.x = traceClamp((float)noise.uniform(seg.noiseCounts));
+        sample.y = traceClamp(TRACE_COUNTS_PER_G * cosf(angle) + noise.uniform(seg.noiseCounts));
+        sample.z = traceClamp(TRACE_COUNTS_PER_G * sinf(angle) + noise.uniform(seg.noiseCounts));
+      } else {
+        sample.x = sample.y = sample.z = 0;
+      }
+      trace.push_back(sample);
+      time += periodMs;
+    }
+  }
+
+  return trace;
+}
+
+// Accel (m/s^2) and gyro X (deg/s) sample for the angle mode
+struct ImuTraceSample {
+  unsigned long time;
+  float y;
+  float z;
+  float gyroRate;
+  bool valid;
+};
+
+// Same segments as synthesizeTrace, plus the gyro rate of each segment's
+// travel with a constant bias and uniform +/-gyroNoise deg/s
+inline std::vector<ImuTraceSample> synthesizeImuTrace(const TraceSegment* segments, size_t segmentCount,
+                                                      unsigned long periodMs, float gyroBias, float gyroNoise,
+                                                      uint32_t seed) {
+  std::vector<TraceSample> accel = synthesizeTrace(segments, segmentCount, periodMs, seed);
+  std::vector<ImuTraceSample> trace;
+  TraceNoise noise(seed * 31 + 7);
+  const float ms2PerCount = 9.80665f / TRACE_COUNTS_PER_G;
+  size_t i = 0;
+
+  for (size_t s = 0; s < segmentCount; s++) {
+    const TraceSegment& seg = segments[s];
+    unsigned long steps = seg.durationMs / periodMs;
+    float rate = (seg.endAngleDeg - seg.startAngleDeg) * 1000.0f / (float)(steps * periodMs);
+    for (unsigned long k = 0; k < steps; k++, i++) {
+      ImuTraceSample sample;
+      sample.time = accel[i].time;
+      sample.y = accel[i].y * ms2PerCount;
+      sample.z = accel[i].z * ms2PerCount;
+      sample.gyroRate = rate + gyroBias + gyroNoise * (float)noise.uniform(1000) / 1000.0f;
+      sample.valid = accel[i].valid;
+      trace.push_back(sample);
+    }
+  }
+  return trace;
+}
+
+// Full open/close cycle with a mid-travel stop, a reversal, a stall and a sensor dropout
+inline std::vector<TraceSample> doorCycleTrace(uint32_t seed = 1) {
+  static const TraceSegment segments[] = {
+    {3000, 0, 0, 20, false},       // closed, at rest
+    {3000, 0, 90, 30, false},      // opening
+    {5000, 90, 90, 20, false},     // open
+    {3000, 90, 0, 30, false},      // closing
+    {5000, 0, 0, 20, false},       // closed
+    {1500, 0, 45, 30, false},      // partial open...
+    {4000, 45, 45, 20, false},     // ...stopped mid-travel
+    {1500, 45, 0, 30, false},      // close again
+    {3000, 0, 0, 20, false},
+    {1000, 0, 15, 30, false},      // start opening...
+    {6000, 15, 17, 5, false},      // ...creep (stall)
+    {2000, 17, 0, 30, false},
+    {1000, 0, 0, 20, true},        // sensor dropout
+    {4000, 0, 0, 20, false}
+  };
+  return synthesizeTrace(segments, sizeof(segments) / sizeof(segments[0]), TRACE_PERIOD_MS, seed);
+}
+
+// Long pseudo-random trace covering arbitrary state sequences
+inline std::vector<TraceSample> randomDoorTrace(size_t segmentCount, uint32_t seed) {
+  std::vector<TraceSegment> segments;
+  TraceNoise rng(seed);
+  float angle = 0;
+  for (size_t i = 0; i < segmentCount; i++) {
+    TraceSegment seg;
+    seg.durationMs = 500 + (rng.next() % 60) * 100;
+    seg.startAngleDeg = angle;
+    uint32_t kind = rng.next() % 4;
+    if (kind == 0) {
+      angle = (float)(rng.next() % 91);      // travel somewhere
+    } else if (kind == 1) {
+      angle = (rng.next() % 2) ? 90.0f : 0.0f;  // travel to an end stop
+    }
+    seg.endAngleDeg = angle;
+    seg.noiseCounts = (int)(rng.next() % 80);
+    seg.sensorFailure = (rng.next() % 25) == 0;
+    segments.push_back(seg);
+  }
+  return synthesizeTrace(segments.data(), segments.size(), TRACE_PERIOD_MS, seed);
+}
+
+// Add single-sample spikes of +/-amplitudeCounts on Y and Z to about one in
+// oneIn valid samples (I2C glitches, knocks on the door panel)
+inline void injectSpikes(std::vector<TraceSample>& trace, uint32_t oneIn, int amplitudeCounts, uint32_t seed) {
+  TraceNoise rng(seed);
+  for (size_t i = 0; i < trace.size(); i++) {
+    if (rng.next() % oneIn != 0 || !trace[i].valid) {
+      continue;
+    }
+    int y = (rng.next() % 2) ? amplitudeCounts : -amplitudeCounts;
+    int z = (rng.next() % 2) ? amplitudeCounts : -amplitudeCounts;
+    trace[i].y = traceClamp((float)(trace[i].y + y));
+    trace[i].z = traceClamp((float)(trace[i].z + z));
+  }
+}
+
+// Encode a synthetic trace in the binary .gdt format
+inline std::vector<uint8_t> encodeTrace(const std::vector<TraceSample>& trace) {
+  std::vector<uint8_t> out(TRACE_HEADER_SIZE);
+  TraceHeader header;
+  header.version = TRACE_VERSION;
+  header.range = ACCEL_RANGE_8G;
+  header.startTime = trace.empty() ? 0 : trace[0].time;
+  header.sampleCount = (uint32_t)trace.size();
+  encodeTraceHeader(header, &out[0]);
+
+  TraceEncoder encoder(header.startTime);
+  uint8_t record[4 * TRACE_RECORD_SIZE];
+  for (size_t i = 0; i < trace.size(); i++) {
+    TraceRecord r;
+    r.time = trace[i].time;
+    r.accel.x = trace[i].x;
+    r.accel.y = trace[i].y;
+    r.accel.z = trace[i].z;
+    r.valid = trace[i].valid;
+    size_t n = encoder.encode(r, record, sizeof(record));
+    out.insert(out.end(), record, record + n);
+  }
+  return out;
+}
+
+#endif // DOOR_TRACE_FIXTURES_H
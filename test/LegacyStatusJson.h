@@ -0,0 +1,34 @@
+#ifndef LEGACY_STATUS_JSON_H
+#define LEGACY_STATUS_JSON_H
+
+// Native re-creation of the original String-concatenating handleStatus() body,
+// used as the reference for byte-identical output and as the benchmark baseline.
+
+#include <stdio.h>
+#include <string>
+#include "DoorMonitor.h"
+
+// Arduino String(float, decimals) -> dtostrf(value, decimals + 2, decimals)
+inline std::string legacyFloatString(float value, int decimals) {
+  char text[48];
+  if (isnan(value)) return "nan";
+  if (isinf(value)) return "inf";
+  snprintf(text, sizeof(text), "%*.*f", decimals + 2, decimals, value);
+  return text;
+}
+
+inline std::string legacyStatusJson(const DoorMonitor& monitor, const AccelData& accel) {
+  std::string json = "{";
+  json += "\"state\":\"" + std::string(monitor.getStateString()) + "\",";
+  json += "\"details\":\"" + std::string(monitor.getDetailedStatus()) + "\",";
+  json += "\"accelX\":" + legacyFloatString(accel.x, 2) + ",";
+  json += "\"accelY\":" + legacyFloatString(accel.y, 2) + ",";
+  json += "\"accelZ\":" + legacyFloatString(accel.z, 2) + ",";
+  json += "\"isMoving\":" + std::string(monitor.isMoving() ? "true" : "false") + ",";
+  json += "\"isAtPosition\":" + std::string(monitor.isAtPosition() ? "true" : "false") + ",";
+  json += "\"sensorHealthy\":" + std::string(monitor.isSensorHealthy() ? "true" : "false");
+  json += "}";
+  return json;
+}
+
+#endif // LEGACY_STATUS_JSON_H
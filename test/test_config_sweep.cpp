@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "ConfigSweep.h"
+#include "DoorTraceFixtures.h"
+
+static LabeledTrace toLabeledTrace(const std::vector<TraceSample>& raw) {
+    LabeledTrace trace;
+    for (size_t i = 0; i < raw.size(); i++) {
+        trace.samples.push_back(traceSampleToAccel(raw[i]));
+        trace.times.push_back(raw[i].time);
+    }
+    return trace;
+}
+
+// Labels a trace with the transitions DoorMonitor makes on it, delayed by shiftMs
+static void labelWithConfig(LabeledTrace& trace, const DoorMonitorConfig& config, unsigned long shiftMs) {
+    std::vector<DoorTransition> transitions;
+    SweepScore ignored;
+    scoreConfig(config, trace, SweepOptions(), transitions, ignored);
+    trace.labels.clear();
+    for (size_t i = 0; i < transitions.size(); i++) {
+        TraceLabel label = {transitions[i].time - shiftMs, transitions[i].to};
+        trace.labels.push_back(label);
+    }
+}
+
+// ============================================================================
+// Test: Label files
+// ============================================================================
+
+TEST(ConfigSweepTest, ParsesLabelFiles) {
+    const char* text = "# door cycle\n4000 OPENING\n  7200\tOPEN  # settled\n\n12000 CLOSED\r\n";
+    std::vector<TraceLabel> labels;
+    ASSERT_TRUE(parseTraceLabels(text, strlen(text), labels, NULL));
+    ASSERT_EQ(3u, labels.size());
+    EXPECT_EQ(4000u, labels[0].time);
+    EXPECT_EQ(DOOR_OPENING, labels[0].state);
+    EXPECT_EQ(7200u, labels[1].time);
+    EXPECT_EQ(DOOR_OPEN, labels[1].state);
+    EXPECT_EQ(DOOR_CLOSED, labels[2].state);
+}
+
+TEST(ConfigSweepTest, RejectsMalformedLabels) {
+    std::vector<TraceLabel> labels;
+    size_t line = 0;
+    const char* badState = "100 OPEN\n200 AJAR\n";
+    EXPECT_FALSE(parseTraceLabels(badState, strlen(badState), labels, &line));
+    EXPECT_EQ(2u, line);
+
+    const char* outOfOrder = "500 OPEN\n100 CLOSED\n";
+    EXPECT_FALSE(parseTraceLabels(outOfOrder, strlen(outOfOrder), labels, &line));
+    EXPECT_EQ(2u, line);
+
+    const char* noTime = "OPEN\n";
+    EXPECT_FALSE(parseTraceLabels(noTime, strlen(noTime), labels, &line));
+}
+
+// ============================================================================
+// Test: Scoring
+// ============================================================================
+
+TEST(ConfigSweepTest, PerfectLabelsScoreFullAccuracy) {
+    LabeledTrace trace = toLabeledTrace(doorCycleTrace());
+    labelWithConfig(trace, DEFAULT_CONFIG, 0);
+    ASSERT_GT(trace.labels.size(), 3u);
+
+    std::vector<DoorTransition> transitions;
+    SweepScore score;
+    scoreConfig(DEFAULT_CONFIG, trace, SweepOptions(), transitions, score);
+    EXPECT_EQ(trace.labels.size(), score.matched);
+    EXPECT_FLOAT_EQ(1.0f, score.accuracy());
+    EXPECT_EQ(0u, score.totalLatency);
+}
+
+TEST(ConfigSweepTest, MeasuresDetectionLatency) {
+    LabeledTrace trace = toLabeledTrace(doorCycleTrace());
+    labelWithConfig(trace, DEFAULT_CONFIG, 300);
+
+    std::vector<DoorTransition> transitions;
+    SweepScore score;
+    scoreConfig(DEFAULT_CONFIG, trace, SweepOptions(), transitions, score);
+    EXPECT_FLOAT_EQ(1.0f, score.accuracy());
+    EXPECT_FLOAT_EQ(300.0f, score.meanLatency());
+    EXPECT_EQ(300u, score.maxLatency);
+}
+
+TEST(ConfigSweepTest, StartsFromFirstValidSample) {
+    LabeledTrace trace = toLabeledTrace(doorCycleTrace());
+    std::vector<DoorTransition> expected;
+    SweepScore ignored;
+    scoreConfig(DEFAULT_CONFIG, trace, SweepOptions(), expected, ignored);
+
+    // A dropout before the first reading must not become the starting position
+    LabeledTrace late = trace;
+    AccelData dropout = {0, 0, 0, false};
+    for (unsigned long t = 1; t <= 3; t++) {
+        late.samples.insert(late.samples.begin(), dropout);
+        late.times.insert(late.times.begin(), trace.times[0] - t * TRACE_PERIOD_MS);
+    }
+    std::vector<DoorTransition> transitions;
+    scoreConfig(DEFAULT_CONFIG, late, SweepOptions(), transitions, ignored);
+    ASSERT_EQ(expected.size(), transitions.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(expected[i].time, transitions[i].time) << "transition " << i;
+        EXPECT_EQ(expected[i].to, transitions[i].to) << "transition " << i;
+    }
+
+    // Nothing valid at all: nothing detected, every label missed
+    LabeledTrace dead;
+    dead.samples.assign(5, dropout);
+    for (unsigned long t = 0; t < 5; t++) {
+        dead.times.push_back(1000 + t * TRACE_PERIOD_MS);
+    }
+    TraceLabel open = {1200, DOOR_OPENING};
+    dead.labels.push_back(open);
+    SweepScore score;
+    scoreConfig(DEFAULT_CONFIG, dead, SweepOptions(), transitions, score);
+    EXPECT_TRUE(transitions.empty());
+    EXPECT_EQ(1u, score.expected);
+    EXPECT_EQ(0u, score.matched);
+}
+
+TEST(ConfigSweepTest, CountsMissedAndSpuriousTransitions) {
+    std::vector<TraceLabel> labels;
+    TraceLabel open = {1000, DOOR_OPENING};
+    TraceLabel closed = {9000, DOOR_CLOSED};
+    labels.push_back(open);
+    labels.push_back(closed);
+
+    std::vector<DoorTransition> detected;
+    DoorTransition early = {400, DOOR_CLOSED, DOOR_OPENING};     // too early to match
+    DoorTransition match = {1200, DOOR_CLOSED, DOOR_OPENING};
+    DoorTransition wrong = {9100, DOOR_OPENING, DOOR_OPEN};      // wrong state
+    detected.push_back(early);
+    detected.push_back(match);
+    detected.push_back(wrong);
+
+    SweepScore score;
+    scoreTransitions(detected, labels, SweepOptions(), score);
+    EXPECT_EQ(2u, score.expected);
+    EXPECT_EQ(3u, score.detected);
+    EXPECT_EQ(1u, score.matched);
+    EXPECT_EQ(200u, score.totalLatency);
+    EXPECT_FLOAT_EQ(2.0f / 5.0f, score.accuracy());
+}
+
+// ============================================================================
+// Test: Grid and sweep
+// ============================================================================
+
+TEST(ConfigSweepTest, BuildsCartesianGrid) {
+    std::vector<SweepAxis> axes;
+    SweepAxis threshold = {SWEEP_ACCEL_THRESHOLD, 0.3f, 0.7f, 0.1f};
+    SweepAxis stop = {SWEEP_STOP_TIMEOUT, 1000, 3000, 1000};
+    axes.push_back(threshold);
+    axes.push_back(stop);
+
+    std::vector<DoorMonitorConfig> grid = buildConfigGrid(DEFAULT_CONFIG, axes);
+    ASSERT_EQ(15u, grid.size());
+    EXPECT_FLOAT_EQ(0.3f, grid[0].accelThreshold);
+    EXPECT_EQ(1000u, grid[0].stopTimeout);
+    EXPECT_EQ(3000u, grid[2].stopTimeout);
+    EXPECT_NEAR(0.7f, grid[14].accelThreshold, 1e-6f);
+    EXPECT_FLOAT_EQ(DEFAULT_CONFIG.positionTolerance, grid[14].positionTolerance);
+
+    SweepParam param;
+    ASSERT_TRUE(sweepParamFromName("tolerance", param));
+    EXPECT_EQ(SWEEP_POSITION_TOLERANCE, param);
+    EXPECT_FALSE(sweepParamFromName("bogus", param));
+}
+
+TEST(ConfigSweepTest, ParallelSweepMatchesSerialAndRanksLabelConfigFirst) {
+    std::vector<LabeledTrace> traces;
+    for (uint32_t seed = 1; seed <= 4; seed++) {
+        traces.push_back(toLabeledTrace(randomDoorTrace(60, seed)));
+        labelWithConfig(traces.back(), DEFAULT_CONFIG, 0);
+    }
+
+    std::vector<SweepAxis> axes;
+    SweepAxis threshold = {SWEEP_ACCEL_THRESHOLD, 0.2f, 1.0f, 0.1f};
+    SweepAxis tolerance = {SWEEP_POSITION_TOLERANCE, 0.5f, 1.5f, 0.5f};
+    axes.push_back(threshold);
+    axes.push_back(tolerance);
+    std::vector<DoorMonitorConfig> grid = buildConfigGrid(DEFAULT_CONFIG, axes);
+
+    std::vector<SweepScore> serial, parallel;
+    runConfigSweep(traces, grid, SweepOptions(), 1, serial);
+    runConfigSweep(traces, grid, SweepOptions(), 4, parallel);
+    ASSERT_EQ(grid.size(), parallel.size());
+
+    size_t best = 0;
+    for (size_t i = 0; i < grid.size(); i++) {
+        EXPECT_EQ(serial[i].matched, parallel[i].matched);
+        EXPECT_EQ(serial[i].detected, parallel[i].detected);
+        EXPECT_EQ(serial[i].totalLatency, parallel[i].totalLatency);
+        if (sweepScoreBetter(parallel[i], parallel[best])) {
+            best = i;
+        }
+    }
+    EXPECT_FLOAT_EQ(1.0f, parallel[best].accuracy());
+    EXPECT_NEAR(DEFAULT_CONFIG.accelThreshold, grid[best].accelThreshold, 1e-6f);
+    EXPECT_FLOAT_EQ(DEFAULT_CONFIG.positionTolerance, grid[best].positionTolerance);
+}
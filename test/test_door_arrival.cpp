@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "DoorMonitor.h"
+#include "DoorTraceFixtures.h"
+
+// Replay an encoded trace the way tools/replay does: first sample initializes,
+// the rest go through updateStateBatch()
+template <typename Monitor>
+static std::vector<DoorTransition> replayTransitions(const std::vector<TraceSample>& trace, Monitor& monitor) {
+    std::vector<uint8_t> bytes = encodeTrace(trace);
+    TraceReader reader(&bytes[0], bytes.size());
+    std::vector<DoorTransition> out;
+    AccelData samples[64];
+    unsigned long times[64];
+    DoorTransition transitions[64];
+    bool initialized = false;
+    size_t n;
+    while ((n = reader.nextBatch(samples, times, 64)) > 0) {
+        size_t first = 0;
+        if (!initialized) {
+            monitor.initialize(samples[0].y, samples[0].z, times[0]);
+            initialized = true;
+            first = 1;
+        }
+        size_t count = monitor.updateStateBatch(samples + first, times + first, n - first, transitions, 64);
+        out.insert(out.end(), transitions, transitions + count);
+    }
+    return out;
+}
+
+static std::vector<DoorTransition> replayTransitions(const std::vector<TraceSample>& trace,
+                                                     const DoorArrivalConfig& arrival) {
+    DoorMonitor monitor;
+    monitor.setArrivalConfig(arrival);
+    return replayTransitions(trace, monitor);
+}
+
+static const DoorArrivalConfig ARRIVAL_OFF = {0, 0, 0};
+
+// ============================================================================
+// Test: Defaults
+// ============================================================================
+
+TEST(DoorArrivalTest, OffByDefault) {
+    DoorMonitor monitor;
+    EXPECT_EQ(0, monitor.getArrivalConfig().windowSamples);
+
+    std::vector<TraceSample> trace = doorCycleTrace(1);
+    std::vector<DoorTransition> byDefault = replayTransitions(trace, monitor);
+    std::vector<DoorTransition> off = replayTransitions(trace, ARRIVAL_OFF);
+    ASSERT_EQ(off.size(), byDefault.size());
+    for (size_t i = 0; i < off.size(); i++) {
+        EXPECT_EQ(off[i].time, byDefault[i].time);
+        EXPECT_EQ(off[i].to, byDefault[i].to);
+    }
+}
+
+// ============================================================================
+// Test: Latency on replayed traces
+// ============================================================================
+
+TEST(DoorArrivalTest, ReportsEndPositionsEarlierOnReplayedTraces) {
+    // doorCycleTrace: every move that ends at an end stop, by when it got there
+    static const unsigned long arrivals[] = {7000, 15000, 27000, 40000};
+    double baselineLatency = 0;
+    double earlyLatency = 0;
+    size_t count = 0;
+
+    for (uint32_t seed = 1; seed <= 8; seed++) {
+        std::vector<TraceSample> trace = doorCycleTrace(seed);
+        std::vector<DoorTransition> baseline = replayTransitions(trace, ARRIVAL_OFF);
+        std::vector<DoorTransition> early = replayTransitions(trace, DEFAULT_ARRIVAL_CONFIG);
+
+        // Same transitions; only CLOSED/OPEN move, and only earlier
+        ASSERT_EQ(baseline.size(), early.size()) << "seed " << seed;
+        size_t next = 0;
+        for (size_t i = 0; i < baseline.size(); i++) {
+            ASSERT_EQ(baseline[i].to, early[i].to) << "seed " << seed << " transition " << i;
+            if (baseline[i].to != DOOR_CLOSED && baseline[i].to != DOOR_OPEN) {
+                EXPECT_EQ(baseline[i].time, early[i].time) << "seed " << seed << " transition " << i;
+                continue;
+            }
+            ASSERT_LT(next, sizeof(arrivals) / sizeof(arrivals[0]));
+            unsigned long arrived = arrivals[next++];
+            EXPECT_GE(baseline[i].time - arrived, DEFAULT_CONFIG.stopTimeout - TRACE_PERIOD_MS);
+            // windowSamples still samples, plus the last travel sample or two
+            EXPECT_LE(early[i].time - arrived, 700u) << "seed " << seed << " arrival " << arrived;
+            baselineLatency += (double)(baseline[i].time - arrived);
+            earlyLatency += (double)(early[i].time - arrived);
+            count++;
+        }
+        EXPECT_EQ(4u, next) << "seed " << seed;
+    }
+
+    // About 2000 ms with the stop timeout alone, under 500 ms with the window
+    baselineLatency /= (double)count;
+    earlyLatency /= (double)count;
+    EXPECT_GT(baselineLatency, 1900.0);
+    EXPECT_LT(earlyLatency, 500.0);
+}
+
+TEST(DoorArrivalTest, MidTravelStopStillWaitsForTimeout) {
+    static const TraceSegment segments[] = {
+        {3000, 0, 0, 20, false},
+        {1500, 0, 45, 30, false},
+        {4000, 45, 45, 20, false}
+    };
+    std::vector<TraceSample> trace = synthesizeTrace(segments, 3, TRACE_PERIOD_MS, 3);
+    std::vector<DoorTransition> transitions = replayTransitions(trace, DEFAULT_ARRIVAL_CONFIG);
+    ASSERT_FALSE(transitions.empty());
+    EXPECT_EQ(DOOR_STOPPED, transitions.back().to);
+    EXPECT_GE(transitions.back().time, 1000u + 3000 + 1500 + DEFAULT_CONFIG.stopTimeout - TRACE_PERIOD_MS);
+}
+
+// ============================================================================
+// Test: The settling window
+// ============================================================================
+
+class DoorArrivalWindowTest : public ::testing::Test {
+protected:
+    DoorMonitor monitor;
+    unsigned long time;
+
+    void SetUp() override {
+        monitor.setArrivalConfig(DEFAULT_ARRIVAL_CONFIG);
+        monitor.initialize(0.0f, 9.8f, 1000);
+        time = 1000;
+        // Swing shut: open to closed in four big steps
+        feed(2.5f, 9.5f);
+        feed(6.9f, 6.9f);
+        feed(9.5f, 2.5f);
+        feed(9.8f, 0.0f);
+        EXPECT_TRUE(monitor.isMoving());
+    }
+
+    DoorState feed(float y, float z) {
+        time += 100;
+        AccelData a = {0.0f, y, z, true};
+        return monitor.updateState(a, time);
+    }
+};
+
+TEST_F(DoorArrivalWindowTest, WaitsForAFullWindow) {
+    for (int i = 1; i < DEFAULT_ARRIVAL_CONFIG.windowSamples; i++) {
+        feed(9.8f + (i % 2 ? 0.02f : -0.02f), 0.01f);
+        EXPECT_TRUE(monitor.isMoving()) << "sample " << i;
+    }
+    EXPECT_EQ(DOOR_CLOSED, feed(9.8f, 0.0f));
+}
+
+TEST_F(DoorArrivalWindowTest, BouncingFallsBackToTimeout) {
+    // In the band and below accelThreshold, but spread over settleDeviation
+    unsigned long stopped = time;
+    while (time - stopped <= DEFAULT_CONFIG.stopTimeout) {
+        bool up = (time / 100) % 2 == 0;
+        DoorState state = feed(up ? 9.92f : 9.68f, up ? 0.06f : -0.06f);
+        if (time - stopped <= DEFAULT_CONFIG.stopTimeout) {
+            ASSERT_TRUE(monitor.isMoving()) << "t=" << time - stopped;
+        } else {
+            EXPECT_EQ(DOOR_CLOSED, state);
+        }
+    }
+}
+
+TEST_F(DoorArrivalWindowTest, SignificantMovementRestartsWindow) {
+    for (int i = 1; i < DEFAULT_ARRIVAL_CONFIG.windowSamples; i++) {
+        feed(9.8f, 0.0f);
+    }
+    feed(9.2f, 0.4f);  // a knock, still inside the band...
+    feed(9.8f, 0.0f);  // ...and back
+    ASSERT_TRUE(monitor.isMoving());
+    for (int i = 1; i < DEFAULT_ARRIVAL_CONFIG.windowSamples; i++) {
+        feed(9.8f, 0.0f);
+        EXPECT_TRUE(monitor.isMoving()) << "sample " << i;
+    }
+    EXPECT_EQ(DOOR_CLOSED, feed(9.8f, 0.0f));
+}
+
+TEST_F(DoorArrivalWindowTest, SettleTimeAppliesAtHighSampleRates) {
+    // Samples 20 ms apart fill the window long before settleTime
+    unsigned long still = time;
+    while (monitor.isMoving()) {
+        time += 20 - 100;  // feed() adds 100
+        feed(9.8f, 0.0f);
+    }
+    EXPECT_GE(time - still, DEFAULT_ARRIVAL_CONFIG.settleTime);
+    EXPECT_LT(time - still, DEFAULT_ARRIVAL_CONFIG.settleTime + 40);
+}
+
+// ============================================================================
+// Test: Fixed-point monitors
+// ============================================================================
+
+TEST(DoorArrivalTest, FixedPointMatchesFloat) {
+    for (uint32_t seed = 1; seed <= 4; seed++) {
+        std::vector<TraceSample> trace = doorCycleTrace(seed);
+        DoorMonitor floatMonitor;
+        DoorMonitorFixed16 fixed16(quantizeConfig<int16_t>(DEFAULT_CONFIG));
+        DoorMonitorFixed32 fixed32(quantizeConfig<int32_t>(DEFAULT_CONFIG));
+        floatMonitor.setArrivalConfig(DEFAULT_ARRIVAL_CONFIG);
+        fixed16.setArrivalConfig(quantizeArrivalConfig<int16_t>(DEFAULT_ARRIVAL_CONFIG));
+        fixed32.setArrivalConfig(quantizeArrivalConfig<int32_t>(DEFAULT_ARRIVAL_CONFIG));
+
+        const TraceSample& first = trace[0];
+        AccelData start = traceSampleToAccel(first);
+        floatMonitor.initialize(start.y, start.z, first.time);
+        fixed16.initialize(first.y, first.z, first.time);
+        fixed32.initialize((int32_t)first.y << 8, (int32_t)first.z << 8, first.time);
+
+        for (size_t i = 1; i < trace.size(); i++) {
+            const TraceSample& s = trace[i];
+            AccelData f = traceSampleToAccel(s);
+            DoorMonitorFixed16::Sample q0 = {s.x, s.y, s.z, s.valid};
+            DoorMonitorFixed32::Sample q8 = {(int32_t)s.x << 8, (int32_t)s.y << 8, (int32_t)s.z << 8, s.valid};
+
+            DoorState expected = floatMonitor.updateState(f, s.time);
+            ASSERT_EQ(expected, fixed16.updateState(q0, s.time)) << "seed " << seed << " sample " << i;
+            ASSERT_EQ(expected, fixed32.updateState(q8, s.time)) << "seed " << seed << " sample " << i;
+        }
+    }
+}
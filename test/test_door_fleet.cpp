@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "DoorFleet.h"
+#include "DoorTraceFixtures.h"
+
+// Run one trace per door through both a DoorFleet and independent
+// DoorMonitors and require identical states and transitions on every tick.
+static void expectFleetMatchesMonitors(const std::vector<std::vector<TraceSample> >& traces,
+                                       const DoorMonitorConfig& config) {
+    size_t doors = traces.size();
+    size_t ticks = traces[0].size();
+    for (size_t d = 1; d < doors; d++) {
+        ticks = traces[d].size() < ticks ? traces[d].size() : ticks;
+    }
+
+    DoorFleet fleet(doors, config);
+    std::vector<DoorMonitor> monitors(doors, DoorMonitor(config));
+    std::vector<float> y(doors), z(doors);
+    std::vector<uint8_t> valid(doors);
+    std::vector<FleetTransition> transitions(doors);
+
+    for (size_t d = 0; d < doors; d++) {
+        AccelData start = traceSampleToAccel(traces[d][0]);
+        y[d] = start.y;
+        z[d] = start.z;
+        monitors[d].initialize(y[d], z[d], traces[d][0].time);
+    }
+    fleet.initializeAll(&y[0], &z[0], traces[0][0].time);
+
+    size_t totalTransitions = 0;
+    for (size_t t = 1; t < ticks; t++) {
+        unsigned long now = traces[0][t].time;
+        std::vector<FleetTransition> expected;
+        for (size_t d = 0; d < doors; d++) {
+            const TraceSample& s = traces[d][t];
+            AccelData a = traceSampleToAccel(s);
+            y[d] = a.y;
+            z[d] = a.z;
+            valid[d] = s.valid;
+
+            DoorState before = monitors[d].getState();
+            DoorState after = monitors[d].updateState(a, now);
+            if (after != before) {
+                FleetTransition tr = {(uint32_t)d, before, after};
+                expected.push_back(tr);
+            }
+        }
+
+        size_t n = fleet.update(&y[0], &z[0], &valid[0], now, &transitions[0], transitions.size());
+        ASSERT_EQ(expected.size(), n) << "tick " << t;
+        for (size_t i = 0; i < n; i++) {
+            EXPECT_EQ(expected[i].door, transitions[i].door);
+            EXPECT_EQ(expected[i].from, transitions[i].from);
+            EXPECT_EQ(expected[i].to, transitions[i].to);
+        }
+        for (size_t d = 0; d < doors; d++) {
+            ASSERT_EQ(monitors[d].getState(), fleet.getState(d)) << "door " << d << " tick " << t;
+            EXPECT_EQ(monitors[d].getLastMovementDirection(), fleet.getLastMovementDirection(d));
+            EXPECT_EQ(monitors[d].isSensorHealthy(), fleet.isSensorHealthy(d));
+            EXPECT_EQ(monitors[d].getTimeInCurrentState(now), fleet.getTimeInCurrentState(d, now));
+        }
+        totalTransitions += n;
+    }
+    EXPECT_GT(totalTransitions, doors);
+}
+
+// ============================================================================
+// Test: Equivalence with DoorMonitor
+// ============================================================================
+
+TEST(DoorFleetTest, MatchesIndependentMonitorsOnDoorCycle) {
+    std::vector<std::vector<TraceSample> > traces;
+    for (uint32_t seed = 1; seed <= 8; seed++) {
+        traces.push_back(doorCycleTrace(seed));
+    }
+    expectFleetMatchesMonitors(traces, DEFAULT_CONFIG);
+}
+
+TEST(DoorFleetTest, MatchesIndependentMonitorsOnRandomTraces) {
+    std::vector<std::vector<TraceSample> > traces;
+    for (uint32_t seed = 1; seed <= 37; seed++) {
+        traces.push_back(randomDoorTrace(80, seed));
+    }
+    expectFleetMatchesMonitors(traces, DEFAULT_CONFIG);
+}
+
+TEST(DoorFleetTest, MatchesIndependentMonitorsWithTightTimeouts) {
+    DoorMonitorConfig config = DEFAULT_CONFIG;
+    config.maxOpenTime = 1500;
+    config.maxCloseTime = 1500;
+    config.stallTimeout = 600;  // shorter than stopTimeout so stalls are reachable
+
+    std::vector<std::vector<TraceSample> > traces;
+    for (uint32_t seed = 100; seed < 120; seed++) {
+        traces.push_back(randomDoorTrace(60, seed));
+    }
+    expectFleetMatchesMonitors(traces, config);
+}
+
+// ============================================================================
+// Test: Fleet basics
+// ============================================================================
+
+TEST(DoorFleetTest, InitializesFromPosition) {
+    DoorFleet fleet(3);
+    float y[] = {9.8f, 0.0f, 6.9f};
+    float z[] = {0.0f, 9.8f, 6.9f};
+    fleet.initializeAll(y, z, 1000);
+
+    EXPECT_EQ(DOOR_CLOSED, fleet.getState(0));
+    EXPECT_EQ(DOOR_OPEN, fleet.getState(1));
+    EXPECT_EQ(DOOR_STOPPED, fleet.getState(2));
+
+    fleet.reset();
+    EXPECT_EQ(DOOR_UNKNOWN, fleet.getState(0));
+}
+
+TEST(DoorFleetTest, CountsTransitionsBeyondOutputCapacity) {
+    DoorFleet fleet(4);
+    float y[] = {9.8f, 9.8f, 9.8f, 9.8f};
+    float z[] = {0.0f, 0.0f, 0.0f, 0.0f};
+    uint8_t valid[] = {1, 1, 1, 1};
+    fleet.initializeAll(y, z, 1000);
+
+    float movedZ[] = {2.0f, 2.0f, 2.0f, 2.0f};
+    FleetTransition transitions[2];
+    EXPECT_EQ(4u, fleet.update(y, movedZ, valid, 1100, transitions, 2));
+    EXPECT_EQ(0u, transitions[0].door);
+    EXPECT_EQ(1u, transitions[1].door);
+    EXPECT_EQ(DOOR_OPENING, transitions[1].to);
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "Histogram.h"
+#include "DoorMonitor.h"
+#include "StatusJson.h"
+#include "DoorTraceFixtures.h"
+
+// ============================================================================
+// Test: Histogram
+// ============================================================================
+
+TEST(HistogramTest, BucketsByPowerOfTwo) {
+    EXPECT_EQ(0u, Histogram<8>::bucketFor(0));
+    EXPECT_EQ(1u, Histogram<8>::bucketFor(1));
+    EXPECT_EQ(2u, Histogram<8>::bucketFor(2));
+    EXPECT_EQ(2u, Histogram<8>::bucketFor(3));
+    EXPECT_EQ(7u, Histogram<8>::bucketFor(64));
+    EXPECT_EQ(7u, Histogram<8>::bucketFor(1000000));  // last bucket is open-ended
+    EXPECT_EQ(3u, Histogram<8>::bucketUpperBound(2));
+}
+
+TEST(HistogramTest, TracksCountMinMaxMean) {
+    Histogram<16> h;
+    EXPECT_EQ(0u, h.getPercentile(50));
+    h.record(10);
+    h.record(20);
+    h.record(300);
+    EXPECT_EQ(3u, h.getCount());
+    EXPECT_EQ(10u, h.getMin());
+    EXPECT_EQ(300u, h.getMax());
+    EXPECT_EQ(110u, h.getMean());
+
+    h.reset();
+    EXPECT_EQ(0u, h.getCount());
+    EXPECT_EQ(0u, h.getMax());
+}
+
+TEST(HistogramTest, PercentilesAreBucketUpperBounds) {
+    Histogram<16> h;
+    for (int i = 0; i < 90; i++) h.record(100);   // bucket [64, 127]
+    for (int i = 0; i < 10; i++) h.record(1000);  // bucket [512, 1023]
+    EXPECT_EQ(127u, h.getPercentile(50));
+    EXPECT_EQ(127u, h.getPercentile(90));
+    EXPECT_EQ(1000u, h.getPercentile(99));  // clamped to the real maximum
+}
+
+#ifdef DOOR_MONITOR_METRICS
+
+static AccelData sample(float y, float z) {
+    AccelData a = {0.0f, y, z, true};
+    return a;
+}
+
+// ============================================================================
+// Test: DoorMonitor instrumentation
+// ============================================================================
+
+TEST(DoorMetricsTest, CountsSamplesAndTimesUpdates) {
+    DoorMonitor monitor;
+    monitor.initialize(9.8f, 0.0f, 1000);
+    for (unsigned long t = 1100; t <= 2000; t += 100) {
+        monitor.updateState(sample(9.8f, 0.0f), t);
+    }
+    EXPECT_EQ(10u, monitor.getMetrics().samplesProcessed);
+    EXPECT_EQ(10u, monitor.getMetrics().updateTime.getCount());
+    EXPECT_EQ(0u, monitor.getMetrics().motionLatency.getCount());
+
+    monitor.resetMetrics();
+    EXPECT_EQ(0u, monitor.getMetrics().samplesProcessed);
+}
+
+TEST(DoorMetricsTest, MeasuresMotionLatencyFromFirstSignificantSample) {
+    DoorMonitor monitor;
+    monitor.initialize(9.8f, 0.0f, 1000);
+
+    // Significant in total (0.35 + 0.2 > 0.5) but neither axis alone shows a direction
+    monitor.updateState(sample(9.45f, 0.2f), 1100);
+    EXPECT_EQ(DOOR_CLOSED, monitor.getState());
+    monitor.updateState(sample(9.2f, 1.5f), 1200);
+    ASSERT_EQ(DOOR_OPENING, monitor.getState());
+
+    const Histogram<DOOR_METRICS_BUCKETS>& latency = monitor.getMetrics().motionLatency;
+    EXPECT_EQ(1u, latency.getCount());
+    EXPECT_EQ(100u, latency.getMax());
+}
+
+TEST(DoorMetricsTest, ForgetsBlipsThatNeverBecomeMotion) {
+    DoorMonitor monitor;
+    monitor.initialize(9.8f, 0.0f, 1000);
+    monitor.updateState(sample(9.45f, 0.2f), 1100);  // blip
+    monitor.updateState(sample(9.8f, 0.0f), 1200);  // and back, again without a direction
+    for (unsigned long t = 1300; t <= 5000; t += 100) {
+        monitor.updateState(sample(9.8f, 0.0f), t);
+    }
+    monitor.updateState(sample(9.8f, 2.0f), 5100);
+    ASSERT_EQ(DOOR_OPENING, monitor.getState());
+    EXPECT_EQ(0u, monitor.getMetrics().motionLatency.getMax());
+}
+
+TEST(DoorMetricsTest, MeasuresSettleLatencyOnDoorCycle) {
+    std::vector<TraceSample> trace = doorCycleTrace();
+    DoorMonitor monitor;
+    monitor.initialize(9.8f, 0.0f, trace[0].time);
+    for (size_t i = 0; i < trace.size(); i++) {
+        monitor.updateState(traceSampleToAccel(trace[i]), trace[i].time);
+    }
+
+    const DoorMonitorMetrics& metrics = monitor.getMetrics();
+    EXPECT_EQ(trace.size(), metrics.samplesProcessed);
+    EXPECT_GT(metrics.motionLatency.getCount(), 0u);
+    ASSERT_GT(metrics.settleLatency.getCount(), 0u);
+    // Settling is reported on the first sample after stopTimeout elapses
+    EXPECT_GT(metrics.settleLatency.getMin(), DEFAULT_CONFIG.stopTimeout);
+    EXPECT_LE(metrics.settleLatency.getMax(), DEFAULT_CONFIG.stopTimeout + TRACE_PERIOD_MS);
+}
+
+TEST(DoorMetricsTest, SerializesMetricsJson) {
+    DoorMonitor monitor;
+    monitor.initialize(9.8f, 0.0f, 1000);
+    monitor.updateState(sample(9.8f, 2.0f), 1100);
+
+    char buffer[METRICS_JSON_BUFFER_SIZE];
+    size_t n = writeMetricsJson(buffer, sizeof(buffer), monitor.getMetrics());
+    ASSERT_GT(n, 0u);
+    std::string json(buffer, n);
+    EXPECT_EQ(0u, json.find("{\"samples\":1,\"motionLatencyMs\":{\"count\":1,\"min\":0,\"max\":0"));
+    EXPECT_NE(std::string::npos, json.find("\"settleLatencyMs\":{\"count\":0"));
+    EXPECT_NE(std::string::npos, json.find("\"updateNs\":{\"count\":1"));
+    EXPECT_EQ('}', json[n - 1]);
+
+    // Fits the fixed buffer even with every bucket at its largest
+    DoorMonitorMetrics full;
+    full.samplesProcessed = 0xFFFFFFFFu;
+    for (size_t i = 0; i < DOOR_METRICS_BUCKETS; i++) {
+        for (int k = 0; k < 3; k++) {
+            full.motionLatency.record(0xFFFFFFFFu);
+        }
+    }
+    EXPECT_GT(writeMetricsJson(buffer, sizeof(buffer), full), 0u);
+}
+
+#endif // DOOR_MONITOR_METRICS
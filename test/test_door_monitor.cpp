@@ -43,24 +43,24 @@ protected:
 // ============================================================================
 
 TEST_F(DoorMonitorTest, InitialStateIsUnknown) {
-    EXPECT_EQ(UNKNOWN, monitor->getState());
+    EXPECT_EQ(DOOR_UNKNOWN, monitor->getState());
 }
 
 TEST_F(DoorMonitorTest, InitializeSetsClosed) {
     monitor->initialize(9.8, 0.0, 1000);  // Closed position (Y=9.8, Z=0)
-    EXPECT_EQ(CLOSED, monitor->getState());
+    EXPECT_EQ(DOOR_CLOSED, monitor->getState());
     EXPECT_TRUE(monitor->isSensorHealthy());
 }
 
 TEST_F(DoorMonitorTest, InitializeSetsOpen) {
     monitor->initialize(0.0, 9.8, 1000);  // Open position (Y=0, Z=9.8)
-    EXPECT_EQ(OPEN, monitor->getState());
+    EXPECT_EQ(DOOR_OPEN, monitor->getState());
     EXPECT_TRUE(monitor->isSensorHealthy());
 }
 
 TEST_F(DoorMonitorTest, InitializeSetsStopped) {
     monitor->initialize(5.0, 5.0, 1000);  // Not in closed or open position
-    EXPECT_EQ(STOPPED, monitor->getState());
+    EXPECT_EQ(DOOR_STOPPED, monitor->getState());
     EXPECT_TRUE(monitor->isSensorHealthy());
 }
 
@@ -70,7 +70,7 @@ TEST_F(DoorMonitorTest, ResetClearsState) {
     monitor->updateState(accel, 1100);
     
     monitor->reset();
-    EXPECT_EQ(UNKNOWN, monitor->getState());
+    EXPECT_EQ(DOOR_UNKNOWN, monitor->getState());
 }
 
 // ============================================================================
@@ -79,7 +79,7 @@ TEST_F(DoorMonitorTest, ResetClearsState) {
 
 TEST_F(DoorMonitorTest, DetectsClosedPosition) {
     monitor->initialize(5.0, 5.0, 1000);
-    EXPECT_EQ(STOPPED, monitor->getState());
+    EXPECT_EQ(DOOR_STOPPED, monitor->getState());
     
     // Move to closed position (Y=9.8, Z=0)
     AccelData accel = createAccelData(0, 9.8, 0.0);
@@ -87,12 +87,12 @@ TEST_F(DoorMonitorTest, DetectsClosedPosition) {
     
     // Wait for stop timeout
     monitor->updateState(accel, 4000);
-    EXPECT_EQ(CLOSED, monitor->getState());
+    EXPECT_EQ(DOOR_CLOSED, monitor->getState());
 }
 
 TEST_F(DoorMonitorTest, DetectsOpenPosition) {
     monitor->initialize(5.0, 5.0, 1000);
-    EXPECT_EQ(STOPPED, monitor->getState());
+    EXPECT_EQ(DOOR_STOPPED, monitor->getState());
     
     // Move to open position (Y=0, Z=9.8)
     AccelData accel = createAccelData(0, 0.0, 9.8);
@@ -100,22 +100,22 @@ TEST_F(DoorMonitorTest, DetectsOpenPosition) {
     
     // Wait for stop timeout
     monitor->updateState(accel, 4000);
-    EXPECT_EQ(OPEN, monitor->getState());
+    EXPECT_EQ(DOOR_OPEN, monitor->getState());
 }
 
 TEST_F(DoorMonitorTest, ClosedPositionWithinTolerance) {
     monitor->initialize(9.9, 0.2, 1000);  // Within 0.5 tolerance
-    EXPECT_EQ(CLOSED, monitor->getState());
+    EXPECT_EQ(DOOR_CLOSED, monitor->getState());
 }
 
 TEST_F(DoorMonitorTest, OpenPositionWithinTolerance) {
     monitor->initialize(0.2, 9.9, 1000);  // Within 0.5 tolerance
-    EXPECT_EQ(OPEN, monitor->getState());
+    EXPECT_EQ(DOOR_OPEN, monitor->getState());
 }
 
 TEST_F(DoorMonitorTest, NotInSpecialPositionOutsideTolerance) {
     monitor->initialize(10.5, 0.0, 1000);  // Outside tolerance
-    EXPECT_EQ(STOPPED, monitor->getState());
+    EXPECT_EQ(DOOR_STOPPED, monitor->getState());
 }
 
 TEST_F(DoorMonitorTest, IsInClosedPositionHelper) {
@@ -143,8 +143,8 @@ TEST_F(DoorMonitorTest, DetectsOpeningMovement) {
     AccelData accel = createAccelData(0, 10.5, 0.5);
     DoorState state = monitor->updateState(accel, 1100);
     
-    EXPECT_EQ(OPENING, state);
-    EXPECT_EQ(OPENING, monitor->getState());
+    EXPECT_EQ(DOOR_OPENING, state);
+    EXPECT_EQ(DOOR_OPENING, monitor->getState());
 }
 
 TEST_F(DoorMonitorTest, DetectsOpeningViaZChange) {
@@ -154,7 +154,7 @@ TEST_F(DoorMonitorTest, DetectsOpeningViaZChange) {
     AccelData accel = createAccelData(0, 9.5, 1.0);
     DoorState state = monitor->updateState(accel, 1100);
     
-    EXPECT_EQ(OPENING, state);
+    EXPECT_EQ(DOOR_OPENING, state);
 }
 
 TEST_F(DoorMonitorTest, ContinuesOpeningWithSustainedMovement) {
@@ -166,7 +166,7 @@ TEST_F(DoorMonitorTest, ContinuesOpeningWithSustainedMovement) {
     AccelData accel2 = createAccelData(0, 10.3, 1.5);
     monitor->updateState(accel2, 1200);
     
-    EXPECT_EQ(OPENING, monitor->getState());
+    EXPECT_EQ(DOOR_OPENING, monitor->getState());
 }
 
 TEST_F(DoorMonitorTest, OpeningStopsAfterTimeout) {
@@ -175,13 +175,13 @@ TEST_F(DoorMonitorTest, OpeningStopsAfterTimeout) {
     // Start opening
     AccelData accel1 = createAccelData(0, 10.5, 0.5);
     monitor->updateState(accel1, 1100);
-    EXPECT_EQ(OPENING, monitor->getState());
+    EXPECT_EQ(DOOR_OPENING, monitor->getState());
     
     // No movement for stopTimeout duration
     AccelData accel2 = createAccelData(0, 10.5, 0.5);
     monitor->updateState(accel2, 4000);
     
-    EXPECT_EQ(STOPPED, monitor->getState());
+    EXPECT_EQ(DOOR_STOPPED, monitor->getState());
 }
 
 // ============================================================================
@@ -195,8 +195,8 @@ TEST_F(DoorMonitorTest, DetectsClosingMovement) {
     AccelData accel = createAccelData(0, 0.5, 8.5);
     DoorState state = monitor->updateState(accel, 1100);
     
-    EXPECT_EQ(CLOSING, state);
-    EXPECT_EQ(CLOSING, monitor->getState());
+    EXPECT_EQ(DOOR_CLOSING, state);
+    EXPECT_EQ(DOOR_CLOSING, monitor->getState());
 }
 
 TEST_F(DoorMonitorTest, DetectsClosingViaYIncrease) {
@@ -206,7 +206,7 @@ TEST_F(DoorMonitorTest, DetectsClosingViaYIncrease) {
     AccelData accel = createAccelData(0, 6.0, 4.5);
     DoorState state = monitor->updateState(accel, 1100);
     
-    EXPECT_EQ(CLOSING, state);
+    EXPECT_EQ(DOOR_CLOSING, state);
 }
 
 TEST_F(DoorMonitorTest, ContinuesClosingWithSustainedMovement) {
@@ -218,7 +218,7 @@ TEST_F(DoorMonitorTest, ContinuesClosingWithSustainedMovement) {
     AccelData accel2 = createAccelData(0, 2.0, 7.5);
     monitor->updateState(accel2, 1200);
     
-    EXPECT_EQ(CLOSING, monitor->getState());
+    EXPECT_EQ(DOOR_CLOSING, monitor->getState());
 }
 
 TEST_F(DoorMonitorTest, ClosingStopsAtClosed) {
@@ -227,14 +227,14 @@ TEST_F(DoorMonitorTest, ClosingStopsAtClosed) {
     // Start closing
     AccelData accel1 = createAccelData(0, 5.0, 5.0);
     monitor->updateState(accel1, 1100);
-    EXPECT_EQ(CLOSING, monitor->getState());
+    EXPECT_EQ(DOOR_CLOSING, monitor->getState());
     
     // Reach closed position and stop
     AccelData accel2 = createAccelData(0, 9.8, 0.0);
     monitor->updateState(accel2, 2000);
     monitor->updateState(accel2, 5000);
     
-    EXPECT_EQ(CLOSED, monitor->getState());
+    EXPECT_EQ(DOOR_CLOSED, monitor->getState());
 }
 
 // ============================================================================
@@ -247,12 +247,12 @@ TEST_F(DoorMonitorTest, TransitionsFromOpeningToClosing) {
     // Start opening
     AccelData accel1 = createAccelData(0, 10.5, 0.5);
     monitor->updateState(accel1, 1100);
-    EXPECT_EQ(OPENING, monitor->getState());
+    EXPECT_EQ(DOOR_OPENING, monitor->getState());
     
     // Reverse to closing
     AccelData accel2 = createAccelData(0, 10.0, 0.2);
     monitor->updateState(accel2, 1200);
-    EXPECT_EQ(CLOSING, monitor->getState());
+    EXPECT_EQ(DOOR_CLOSING, monitor->getState());
 }
 
 TEST_F(DoorMonitorTest, TransitionsFromClosingToOpening) {
@@ -261,12 +261,12 @@ TEST_F(DoorMonitorTest, TransitionsFromClosingToOpening) {
     // Start closing
     AccelData accel1 = createAccelData(0, 1.0, 8.5);
     monitor->updateState(accel1, 1100);
-    EXPECT_EQ(CLOSING, monitor->getState());
+    EXPECT_EQ(DOOR_CLOSING, monitor->getState());
     
     // Reverse to opening
     AccelData accel2 = createAccelData(0, 0.5, 9.0);
     monitor->updateState(accel2, 1200);
-    EXPECT_EQ(OPENING, monitor->getState());
+    EXPECT_EQ(DOOR_OPENING, monitor->getState());
 }
 
 // ============================================================================
@@ -282,7 +282,7 @@ TEST_F(DoorMonitorTest, DetectsSensorFailure) {
         monitor->updateState(invalidAccel, 1000 + i * 100);
     }
     
-    EXPECT_EQ(ERROR_SENSOR_FAILURE, monitor->getState());
+    EXPECT_EQ(DOOR_ERROR_SENSOR_FAILURE, monitor->getState());
     EXPECT_FALSE(monitor->isSensorHealthy());
 }
 
@@ -294,14 +294,14 @@ TEST_F(DoorMonitorTest, RecoverFromSensorFailure) {
     for (int i = 0; i < 5; i++) {
         monitor->updateState(invalidAccel, 1000 + i * 100);
     }
-    EXPECT_EQ(ERROR_SENSOR_FAILURE, monitor->getState());
+    EXPECT_EQ(DOOR_ERROR_SENSOR_FAILURE, monitor->getState());
     
     // Recover with valid data
     AccelData validAccel = createAccelData(0, 9.8, 0.0, true);
     monitor->updateState(validAccel, 2000);
     
     EXPECT_TRUE(monitor->isSensorHealthy());
-    EXPECT_NE(ERROR_SENSOR_FAILURE, monitor->getState());
+    EXPECT_NE(DOOR_ERROR_SENSOR_FAILURE, monitor->getState());
 }
 
 // ============================================================================
@@ -314,12 +314,12 @@ TEST_F(DoorMonitorTest, DetectsOpeningTimeout) {
     // Start opening
     AccelData accel = createAccelData(0, 10.5, 0.5);
     monitor->updateState(accel, 1100);
-    EXPECT_EQ(OPENING, monitor->getState());
+    EXPECT_EQ(DOOR_OPENING, monitor->getState());
     
     // Still opening after maxOpenTime
     monitor->updateState(accel, 12000);
     
-    EXPECT_EQ(ERROR_TIMEOUT, monitor->getState());
+    EXPECT_EQ(DOOR_ERROR_TIMEOUT, monitor->getState());
 }
 
 TEST_F(DoorMonitorTest, DetectsClosingTimeout) {
@@ -328,12 +328,12 @@ TEST_F(DoorMonitorTest, DetectsClosingTimeout) {
     // Start closing
     AccelData accel = createAccelData(0, 1.0, 8.5);
     monitor->updateState(accel, 1100);
-    EXPECT_EQ(CLOSING, monitor->getState());
+    EXPECT_EQ(DOOR_CLOSING, monitor->getState());
     
     // Still closing after maxCloseTime
     monitor->updateState(accel, 12000);
     
-    EXPECT_EQ(ERROR_TIMEOUT, monitor->getState());
+    EXPECT_EQ(DOOR_ERROR_TIMEOUT, monitor->getState());
 }
 
 // ============================================================================
@@ -346,7 +346,7 @@ TEST_F(DoorMonitorTest, DetectsStall) {
     // Start opening
     AccelData accel1 = createAccelData(0, 10.5, 0.5);
     monitor->updateState(accel1, 1100);
-    EXPECT_EQ(OPENING, monitor->getState());
+    EXPECT_EQ(DOOR_OPENING, monitor->getState());
     
     // Very slow movement
     AccelData accel2 = createAccelData(0, 10.52, 0.52);
@@ -355,7 +355,7 @@ TEST_F(DoorMonitorTest, DetectsStall) {
     // Continue slow movement past stallTimeout
     monitor->updateState(accel2, 5000);
     
-    EXPECT_EQ(ERROR_STALLED, monitor->getState());
+    EXPECT_EQ(DOOR_ERROR_STALLED, monitor->getState());
 }
 
 // ============================================================================
@@ -375,21 +375,21 @@ TEST_F(DoorMonitorTest, IsMovementSignificant) {
 TEST_F(DoorMonitorTest, DetermineDirectionOpening) {
     // Y increases = opening
     DoorState state = DoorMonitor::determineDirection(10.5, 9.8, 0.5, 0.5, 0.5);
-    EXPECT_EQ(OPENING, state);
+    EXPECT_EQ(DOOR_OPENING, state);
     
     // Z increases = opening
     state = DoorMonitor::determineDirection(9.8, 9.8, 1.0, 0.0, 0.5);
-    EXPECT_EQ(OPENING, state);
+    EXPECT_EQ(DOOR_OPENING, state);
 }
 
 TEST_F(DoorMonitorTest, DetermineDirectionClosing) {
     // Y decreases = closing (when coming from high Y)
     DoorState state = DoorMonitor::determineDirection(5.0, 6.0, 5.0, 5.0, 0.5);
-    EXPECT_EQ(CLOSING, state);
+    EXPECT_EQ(DOOR_CLOSING, state);
     
     // Z decreases = closing
     state = DoorMonitor::determineDirection(5.0, 5.0, 5.0, 6.0, 0.5);
-    EXPECT_EQ(CLOSING, state);
+    EXPECT_EQ(DOOR_CLOSING, state);
 }
 
 TEST_F(DoorMonitorTest, HasTimedOut) {
@@ -432,6 +432,199 @@ TEST_F(DoorMonitorTest, GetStateStringStopped) {
     EXPECT_STREQ("STOPPED", monitor->getStateString());
 }
 
+// ============================================================================
+// Test: Batch Update
+// ============================================================================
+
+TEST_F(DoorMonitorTest, BatchMatchesSingleSampleUpdates) {
+    AccelData samples[] = {
+        createAccelData(0, 9.8, 0.0),
+        createAccelData(0, 10.5, 0.5),
+        createAccelData(0, 10.3, 1.5),
+        createAccelData(0, 10.3, 1.5),
+        createAccelData(0, 10.3, 1.5),
+        createAccelData(0, 0, 0, false),
+        createAccelData(0, 10.3, 1.5)
+    };
+    unsigned long times[] = {1100, 1200, 1300, 2000, 4000, 4100, 4200};
+    const size_t n = sizeof(times) / sizeof(times[0]);
+    
+    DoorMonitor reference(config);
+    reference.initialize(9.8, 0.0, 1000);
+    for (size_t i = 0; i < n; i++) {
+        reference.updateState(samples[i], times[i]);
+    }
+    
+    monitor->initialize(9.8, 0.0, 1000);
+    DoorTransition transitions[8];
+    monitor->updateStateBatch(samples, times, n, transitions, 8);
+    
+    EXPECT_EQ(reference.getState(), monitor->getState());
+    EXPECT_EQ(reference.getLastMovementDirection(), monitor->getLastMovementDirection());
+    EXPECT_EQ(reference.getTimeInCurrentState(5000), monitor->getTimeInCurrentState(5000));
+}
+
+TEST_F(DoorMonitorTest, BatchReportsTransitionsWithTimestamps) {
+    monitor->initialize(9.8, 0.0, 1000);
+    
+    AccelData samples[] = {
+        createAccelData(0, 10.5, 0.5),  // start opening
+        createAccelData(0, 10.5, 0.5),  // no movement
+        createAccelData(0, 10.5, 0.5)   // stop timeout elapsed
+    };
+    unsigned long times[] = {1100, 1200, 4000};
+    DoorTransition transitions[4];
+    
+    size_t count = monitor->updateStateBatch(samples, times, 3, transitions, 4);
+    
+    ASSERT_EQ(2u, count);
+    EXPECT_EQ(1100u, transitions[0].time);
+    EXPECT_EQ(DOOR_CLOSED, transitions[0].from);
+    EXPECT_EQ(DOOR_OPENING, transitions[0].to);
+    EXPECT_EQ(4000u, transitions[1].time);
+    EXPECT_EQ(DOOR_OPENING, transitions[1].from);
+    EXPECT_EQ(DOOR_STOPPED, transitions[1].to);
+}
+
+TEST_F(DoorMonitorTest, BatchCountsTransitionsBeyondOutputCapacity) {
+    monitor->initialize(9.8, 0.0, 1000);
+    
+    AccelData samples[] = {
+        createAccelData(0, 10.5, 0.5),
+        createAccelData(0, 10.5, 0.5)
+    };
+    unsigned long times[] = {1100, 4000};
+    DoorTransition transitions[1];
+    
+    size_t count = monitor->updateStateBatch(samples, times, 2, transitions, 1);
+    
+    EXPECT_EQ(2u, count);
+    EXPECT_EQ(DOOR_OPENING, transitions[0].to);
+    EXPECT_EQ(DOOR_STOPPED, monitor->getState());
+    
+    // Output array is optional
+    EXPECT_EQ(0u, monitor->updateStateBatch(samples, times, 0, NULL, 0));
+}
+
+// ============================================================================
+// Test: Transition Listeners
+// ============================================================================
+
+struct RecordedTransition {
+    DoorTransition transition;
+    DoorState direction;
+    DoorState stateDuringCall;
+};
+
+struct TransitionRecorder {
+    const DoorMonitor* monitor;
+    RecordedTransition calls[8];
+    size_t count;
+    TransitionRecorder(const DoorMonitor* m) : monitor(m), count(0) {}
+};
+
+static void recordTransition(void* context, const DoorTransition& transition, DoorState direction) {
+    TransitionRecorder* recorder = (TransitionRecorder*)context;
+    if (recorder->count < 8) {
+        RecordedTransition& call = recorder->calls[recorder->count];
+        call.transition = transition;
+        call.direction = direction;
+        call.stateDuringCall = recorder->monitor->getState();
+    }
+    recorder->count++;
+}
+
+static void countTransition(void* context, const DoorTransition&, DoorState) {
+    (*(int*)context)++;
+}
+
+TEST_F(DoorMonitorTest, ListenerFiresOncePerTransition) {
+    TransitionRecorder recorder(monitor);
+    ASSERT_TRUE(monitor->addTransitionListener(recordTransition, &recorder));
+    monitor->initialize(9.8, 0.0, 1000);  // initialize does not notify
+    
+    monitor->updateState(createAccelData(0, 10.5, 0.5), 1100);  // start opening
+    monitor->updateState(createAccelData(0, 10.5, 0.5), 1200);  // no change
+    monitor->updateState(createAccelData(0, 10.5, 0.5), 4000);  // stop timeout elapsed
+    
+    ASSERT_EQ(2u, recorder.count);
+    EXPECT_EQ(1100u, recorder.calls[0].transition.time);
+    EXPECT_EQ(DOOR_CLOSED, recorder.calls[0].transition.from);
+    EXPECT_EQ(DOOR_OPENING, recorder.calls[0].transition.to);
+    EXPECT_EQ(DOOR_OPENING, recorder.calls[0].direction);
+    EXPECT_EQ(DOOR_OPENING, recorder.calls[0].stateDuringCall);
+    EXPECT_EQ(4000u, recorder.calls[1].transition.time);
+    EXPECT_EQ(DOOR_OPENING, recorder.calls[1].transition.from);
+    EXPECT_EQ(DOOR_STOPPED, recorder.calls[1].transition.to);
+    EXPECT_EQ(DOOR_OPENING, recorder.calls[1].direction);  // direction it stopped in
+}
+
+TEST_F(DoorMonitorTest, ListenerMatchesBatchTransitions) {
+    TransitionRecorder recorder(monitor);
+    monitor->addTransitionListener(recordTransition, &recorder);
+    monitor->initialize(9.8, 0.0, 1000);
+    
+    AccelData samples[] = {
+        createAccelData(0, 10.5, 0.5),
+        createAccelData(0, 10.5, 0.5),
+        createAccelData(0, 0, 0, false),
+        createAccelData(0, 0, 0, false),
+        createAccelData(0, 0, 0, false),
+        createAccelData(0, 0, 0, false),
+        createAccelData(0, 0, 0, false),
+        createAccelData(0, 10.5, 0.5)
+    };
+    unsigned long times[] = {1100, 4000, 4100, 4200, 4300, 4400, 4500, 4600};
+    DoorTransition transitions[8];
+    size_t count = monitor->updateStateBatch(samples, times, 8, transitions, 8);
+    
+    ASSERT_EQ(count, recorder.count);
+    for (size_t i = 0; i < count; i++) {
+        EXPECT_EQ(transitions[i].time, recorder.calls[i].transition.time);
+        EXPECT_EQ(transitions[i].from, recorder.calls[i].transition.from);
+        EXPECT_EQ(transitions[i].to, recorder.calls[i].transition.to);
+    }
+}
+
+TEST_F(DoorMonitorTest, ListenersFanOutInRegistrationOrder) {
+    int counts[DOOR_MONITOR_MAX_LISTENERS] = {0};
+    for (size_t i = 0; i < DOOR_MONITOR_MAX_LISTENERS; i++) {
+        ASSERT_TRUE(monitor->addTransitionListener(countTransition, &counts[i]));
+    }
+    int extra = 0;
+    EXPECT_FALSE(monitor->addTransitionListener(countTransition, &extra));  // full
+    EXPECT_FALSE(monitor->addTransitionListener(NULL, NULL));
+    EXPECT_EQ((size_t)DOOR_MONITOR_MAX_LISTENERS, monitor->getListenerCount());
+    
+    monitor->initialize(9.8, 0.0, 1000);
+    monitor->updateState(createAccelData(0, 10.5, 0.5), 1100);
+    for (size_t i = 0; i < DOOR_MONITOR_MAX_LISTENERS; i++) {
+        EXPECT_EQ(1, counts[i]);
+    }
+    EXPECT_EQ(0, extra);
+}
+
+TEST_F(DoorMonitorTest, RemovedListenerIsNotCalled) {
+    int first = 0;
+    int second = 0;
+    monitor->addTransitionListener(countTransition, &first);
+    monitor->addTransitionListener(countTransition, &second);
+    EXPECT_FALSE(monitor->removeTransitionListener(countTransition, NULL));  // context must match
+    EXPECT_TRUE(monitor->removeTransitionListener(countTransition, &first));
+    EXPECT_EQ(1u, monitor->getListenerCount());
+    
+    monitor->initialize(9.8, 0.0, 1000);
+    monitor->updateState(createAccelData(0, 10.5, 0.5), 1100);
+    EXPECT_EQ(0, first);
+    EXPECT_EQ(1, second);
+    
+    // Listeners survive reset()
+    monitor->reset();
+    monitor->initialize(9.8, 0.0, 2000);
+    monitor->updateState(createAccelData(0, 10.5, 0.5), 2100);
+    EXPECT_EQ(2, second);
+}
+
 // Main function
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "DoorPositionEstimator.h"
+#include "DoorTraceFixtures.h"
+
+static AccelData atAngle(float degrees) {
+    float radians = degrees * 3.14159265f / 180.0f;
+    AccelData a = {0.0f, 9.8f * cosf(radians), 9.8f * sinf(radians), true};
+    return a;
+}
+
+// Two full cycles: closed, open over 3 s, open, close over 3 s, closed
+static const TraceSegment TWO_CYCLES[] = {
+    {3000, 0, 0, 20, false},
+    {3000, 0, 90, 30, false},
+    {4000, 90, 90, 20, false},
+    {3000, 90, 0, 30, false},
+    {4000, 0, 0, 20, false},
+    {3000, 0, 90, 30, false},
+    {4000, 90, 90, 20, false},
+    {3000, 90, 0, 30, false},
+    {4000, 0, 0, 20, false}
+};
+
+class DoorPositionTest : public ::testing::Test {
+protected:
+    DoorMonitor monitor;
+    DoorPositionEstimator position;
+
+    void SetUp() override {
+        monitor.addTransitionListener(DoorPositionEstimator::transitionListener, &position);
+    }
+
+    void feed(const TraceSample& raw) {
+        AccelData a = traceSampleToAccel(raw);
+        monitor.updateState(a, raw.time);
+        position.update(a, raw.time);
+    }
+
+    void start(const std::vector<TraceSample>& trace) {
+        AccelData a = traceSampleToAccel(trace[0]);
+        monitor.initialize(a.y, a.z, trace[0].time);
+    }
+};
+
+// ============================================================================
+// Test: Position and velocity
+// ============================================================================
+
+TEST_F(DoorPositionTest, ProjectsOntoReferenceLine) {
+    position.update(atAngle(0), 0);
+    EXPECT_NEAR(0.0f, position.getPosition(), 0.001f);
+    position.update(atAngle(90), 100);
+    EXPECT_NEAR(1.0f, position.getPosition(), 0.001f);
+    position.update(atAngle(45), 200);
+    EXPECT_NEAR(0.5f, position.getPosition(), 0.001f);
+    position.update(atAngle(22.5f), 300);
+    EXPECT_NEAR(0.25f, position.getPosition(), 0.03f);
+
+    // Past either reference clamps
+    AccelData beyondClosed = {0.0f, 11.0f, -1.0f, true};
+    position.update(beyondClosed, 400);
+    EXPECT_FLOAT_EQ(0.0f, position.getPosition());
+    AccelData beyondOpen = {0.0f, -1.0f, 11.0f, true};
+    position.update(beyondOpen, 500);
+    EXPECT_FLOAT_EQ(1.0f, position.getPosition());
+
+    AccelData invalid = {0.0f, 9.8f, 0.0f, false};
+    position.update(invalid, 600);
+    EXPECT_FLOAT_EQ(1.0f, position.getPosition());
+}
+
+TEST_F(DoorPositionTest, VelocityFollowsTravel) {
+    // 0 -> 90 degrees over 10 s, then still
+    for (unsigned long t = 0; t <= 10000; t += 100) {
+        position.update(atAngle(t * 0.009f), t);
+        if (t == 5000) {
+            EXPECT_NEAR(0.11f, position.getVelocity(), 0.02f);
+        }
+    }
+    for (unsigned long t = 10100; t <= 12000; t += 100) {
+        position.update(atAngle(90), t);
+    }
+    EXPECT_NEAR(0.0f, position.getVelocity(), 0.005f);
+
+    // Closing is negative
+    for (unsigned long t = 12100; t <= 13000; t += 100) {
+        position.update(atAngle(90 - (t - 12000) * 0.009f), t);
+    }
+    EXPECT_LT(position.getVelocity(), -0.05f);
+}
+
+// ============================================================================
+// Test: Travel times and arrival
+// ============================================================================
+
+TEST_F(DoorPositionTest, LearnsTravelTimesFromFullRunsOnly) {
+    std::vector<TraceSample> trace = doorCycleTrace(1);
+    start(trace);
+    for (size_t i = 0; i < trace.size(); i++) {
+        feed(trace[i]);
+    }
+    // The 3 s runs; detection is a sample or two behind the motion
+    EXPECT_NEAR(3000.0, (double)position.getTravelTime(DOOR_OPENING), 300.0);
+    EXPECT_NEAR(3000.0, (double)position.getTravelTime(DOOR_CLOSING), 300.0);
+    // The partial open, the close from mid-travel and the creep were not learned
+    EXPECT_EQ(1u, position.getTravelCount(DOOR_OPENING));
+    EXPECT_EQ(1u, position.getTravelCount(DOOR_CLOSING));
+}
+
+TEST_F(DoorPositionTest, EstimatesArrivalDuringTravel) {
+    std::vector<TraceSample> trace = synthesizeTrace(TWO_CYCLES, 9, TRACE_PERIOD_MS, 5);
+    start(trace);
+    unsigned long secondOpening = 1000 + 3000 + 3000 + 4000 + 3000 + 4000;
+    unsigned long secondOpen = secondOpening + 3000;
+    size_t estimates = 0;
+    for (size_t i = 0; i < trace.size(); i++) {
+        feed(trace[i]);
+        unsigned long remaining;
+        bool estimated = position.estimateArrival(remaining);
+        if (trace[i].time >= secondOpening && trace[i].time < secondOpen && monitor.isMoving()) {
+            ASSERT_TRUE(estimated) << "t=" << trace[i].time;
+            EXPECT_NEAR((double)(secondOpen - trace[i].time), (double)remaining, 500.0) << "t=" << trace[i].time;
+            estimates++;
+        }
+    }
+    // 3 s at 10 Hz, less the sample or two before movement is detected
+    EXPECT_GE(estimates, 25u);
+    EXPECT_EQ(2u, position.getTravelCount(DOOR_OPENING));
+    EXPECT_EQ(2u, position.getTravelCount(DOOR_CLOSING));
+}
+
+TEST_F(DoorPositionTest, UsesVelocityBeforeFirstRun) {
+    std::vector<TraceSample> trace = synthesizeTrace(TWO_CYCLES, 2, TRACE_PERIOD_MS, 6);
+    start(trace);
+    unsigned long open = 1000 + 3000 + 3000;
+    unsigned long mid = open - 1500;
+    for (size_t i = 0; i < trace.size() && trace[i].time <= mid; i++) {
+        feed(trace[i]);
+    }
+    ASSERT_TRUE(monitor.isMoving());
+    ASSERT_EQ(0u, position.getTravelTime(DOOR_OPENING));
+    unsigned long remaining;
+    ASSERT_TRUE(position.estimateArrival(remaining));
+    EXPECT_NEAR(1500.0, (double)remaining, 600.0);
+}
+
+TEST_F(DoorPositionTest, NoArrivalWhileAtRest) {
+    std::vector<TraceSample> trace = doorCycleTrace(2);
+    start(trace);
+    for (size_t i = 0; i < trace.size(); i++) {
+        feed(trace[i]);
+    }
+    ASSERT_EQ(DOOR_CLOSED, monitor.getState());
+    unsigned long remaining;
+    EXPECT_FALSE(position.estimateArrival(remaining));
+}
+
+TEST_F(DoorPositionTest, RestoredTravelTimeIsUsed) {
+    position.setTravelTime(DOOR_CLOSING, 10000);
+    EXPECT_EQ(10000u, position.getTravelTime(DOOR_CLOSING));
+    EXPECT_EQ(0u, position.getTravelTime(DOOR_OPENING));
+
+    position.update(atAngle(90), 1000);
+    DoorTransition closing = {1000, DOOR_OPEN, DOOR_CLOSING};
+    DoorPositionEstimator::transitionListener(&position, closing, DOOR_CLOSING);
+    unsigned long remaining;
+    ASSERT_TRUE(position.estimateArrival(remaining));
+    EXPECT_NEAR(10000.0, (double)remaining, 10.0);
+
+    // reset() keeps what was learned
+    position.reset();
+    EXPECT_EQ(10000u, position.getTravelTime(DOOR_CLOSING));
+    EXPECT_FALSE(position.estimateArrival(remaining));
+}
@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "DoorMonitor.h"
+#include "DoorSnapshot.h"
+#include "FileSnapshotStorage.h"
+#include "DoorTraceFixtures.h"
+
+// millis() right after the simulated reboot; lower than every time saved
+// before it, as on the device
+#define REBOOT_TIME 50
+
+static DoorSnapshot sampleSnapshot() {
+    DoorSnapshot s;
+    s.sampleKind = DoorScalarTraits<float>::SNAPSHOT_KIND;
+    s.state = DOOR_CLOSING;
+    s.lastMovementDirection = DOOR_CLOSING;
+    s.sensorHealthy = true;
+    s.sensorFailures = 3;
+    s.stateAge = 1234;
+    s.movementAge = 100;
+    s.stallCheckAge = 0xFFFFFFF0u;
+    s.lastAccelY = 0x41100000u;
+    s.lastAccelZ = 0xC0A00000u;
+    s.arrivalCount = 2;
+    s.arrivalNext = 7;
+    for (size_t i = 0; i < DOOR_ARRIVAL_MAX_WINDOW; i++) {
+        s.arrivalY[i] = 0x01010101u * (uint32_t)i;
+        s.arrivalZ[i] = 0x80000000u + (uint32_t)i;
+    }
+    return s;
+}
+
+// ============================================================================
+// Test: Blob encoding
+// ============================================================================
+
+TEST(DoorSnapshotTest, RoundTripsEveryField) {
+    DoorSnapshot in = sampleSnapshot();
+    uint8_t blob[DOOR_SNAPSHOT_SIZE];
+    encodeDoorSnapshot(in, blob);
+    EXPECT_EQ(0, memcmp(blob, DOOR_SNAPSHOT_MAGIC, 4));
+
+    DoorSnapshot out;
+    ASSERT_TRUE(decodeDoorSnapshot(blob, sizeof(blob), out));
+    EXPECT_EQ(in.sampleKind, out.sampleKind);
+    EXPECT_EQ(in.state, out.state);
+    EXPECT_EQ(in.lastMovementDirection, out.lastMovementDirection);
+    EXPECT_EQ(in.sensorHealthy, out.sensorHealthy);
+    EXPECT_EQ(in.sensorFailures, out.sensorFailures);
+    EXPECT_EQ(in.stateAge, out.stateAge);
+    EXPECT_EQ(in.movementAge, out.movementAge);
+    EXPECT_EQ(in.stallCheckAge, out.stallCheckAge);
+    EXPECT_EQ(in.lastAccelY, out.lastAccelY);
+    EXPECT_EQ(in.lastAccelZ, out.lastAccelZ);
+    EXPECT_EQ(in.arrivalCount, out.arrivalCount);
+    EXPECT_EQ(in.arrivalNext, out.arrivalNext);
+    for (size_t i = 0; i < DOOR_ARRIVAL_MAX_WINDOW; i++) {
+        EXPECT_EQ(in.arrivalY[i], out.arrivalY[i]);
+        EXPECT_EQ(in.arrivalZ[i], out.arrivalZ[i]);
+    }
+}
+
+TEST(DoorSnapshotTest, RejectsDamagedBlobs) {
+    uint8_t blob[DOOR_SNAPSHOT_SIZE];
+    encodeDoorSnapshot(sampleSnapshot(), blob);
+    DoorSnapshot out;
+    EXPECT_FALSE(decodeDoorSnapshot(blob, sizeof(blob) - 1, out));
+
+    // Any single bit flip, CRC included
+    for (size_t i = 0; i < sizeof(blob); i++) {
+        for (int bit = 0; bit < 8; bit++) {
+            blob[i] ^= (uint8_t)(1 << bit);
+            EXPECT_FALSE(decodeDoorSnapshot(blob, sizeof(blob), out)) << "byte " << i << " bit " << bit;
+            blob[i] ^= (uint8_t)(1 << bit);
+        }
+    }
+
+    // What RTC memory holds after power-on
+    memset(blob, 0, sizeof(blob));
+    EXPECT_FALSE(decodeDoorSnapshot(blob, sizeof(blob), out));
+    memset(blob, 0xFF, sizeof(blob));
+    EXPECT_FALSE(decodeDoorSnapshot(blob, sizeof(blob), out));
+}
+
+// ============================================================================
+// Test: Warm restart
+// ============================================================================
+
+// Runs the trace once without interruption and once rebooting after sample
+// cut (snapshot through a file, clock restarting at REBOOT_TIME); every state
+// after the reboot must match
+static void expectSeamlessRestart(const std::vector<TraceSample>& trace, size_t cut, bool arrival,
+                                  FileSnapshotStorage& storage) {
+    DoorMonitor reference;
+    DoorMonitor before;
+    if (arrival) {
+        reference.setArrivalConfig(DEFAULT_ARRIVAL_CONFIG);
+        before.setArrivalConfig(DEFAULT_ARRIVAL_CONFIG);
+    }
+    AccelData first = traceSampleToAccel(trace[0]);
+    reference.initialize(first.y, first.z, trace[0].time);
+    before.initialize(first.y, first.z, trace[0].time);
+    std::vector<DoorState> expected;
+    std::vector<DoorState> expectedDirection;
+    for (size_t i = 1; i < trace.size(); i++) {
+        expected.push_back(reference.updateState(traceSampleToAccel(trace[i]), trace[i].time));
+        expectedDirection.push_back(reference.getLastMovementDirection());
+        if (i <= cut) {
+            before.updateState(traceSampleToAccel(trace[i]), trace[i].time);
+        }
+    }
+
+    DoorSnapshot saved;
+    uint8_t blob[DOOR_SNAPSHOT_SIZE];
+    before.saveSnapshot(saved, trace[cut].time);
+    encodeDoorSnapshot(saved, blob);
+    ASSERT_TRUE(storage.save(blob, sizeof(blob)));
+
+    DoorMonitor after;
+    DoorSnapshot loaded;
+    if (arrival) {
+        after.setArrivalConfig(DEFAULT_ARRIVAL_CONFIG);
+    }
+    ASSERT_TRUE(storage.load(blob, sizeof(blob)));
+    ASSERT_TRUE(decodeDoorSnapshot(blob, sizeof(blob), loaded));
+    ASSERT_TRUE(after.restoreSnapshot(loaded, REBOOT_TIME));
+    EXPECT_EQ(before.getState(), after.getState());
+    EXPECT_EQ(before.getTimeInCurrentState(trace[cut].time), after.getTimeInCurrentState(REBOOT_TIME));
+
+    unsigned long shift = trace[cut].time - REBOOT_TIME;
+    for (size_t i = cut + 1; i < trace.size(); i++) {
+        ASSERT_EQ(expected[i - 1], after.updateState(traceSampleToAccel(trace[i]), trace[i].time - shift))
+            << "cut " << cut << " sample " << i;
+        ASSERT_EQ(expectedDirection[i - 1], after.getLastMovementDirection()) << "cut " << cut << " sample " << i;
+    }
+}
+
+class DoorSnapshotRestartTest : public ::testing::Test {
+protected:
+    FileSnapshotStorage storage;
+
+    DoorSnapshotRestartTest() : storage(::testing::TempDir() + "test_door_snapshot.bin") {}
+    void TearDown() override { storage.remove(); }
+};
+
+TEST_F(DoorSnapshotRestartTest, ResumesAnywhereInACycle) {
+    std::vector<TraceSample> trace = doorCycleTrace(1);
+    for (size_t cut = 1; cut < trace.size() - 1; cut += 3) {
+        expectSeamlessRestart(trace, cut, false, storage);
+        if (HasFatalFailure()) {
+            return;
+        }
+    }
+}
+
+TEST_F(DoorSnapshotRestartTest, ResumesWithTheArrivalWindow) {
+    for (uint32_t seed = 1; seed <= 2; seed++) {
+        std::vector<TraceSample> trace = randomDoorTrace(40, seed);
+        for (size_t cut = 1; cut < trace.size() - 1; cut += 7) {
+            expectSeamlessRestart(trace, cut, true, storage);
+            if (HasFatalFailure()) {
+                return;
+            }
+        }
+    }
+}
+
+TEST_F(DoorSnapshotRestartTest, ColdStartMidTravelLosesTheMove) {
+    // What the snapshot is for: one reading mid-travel says nothing of motion
+    std::vector<TraceSample> trace = doorCycleTrace(1);
+    size_t cut = 45;  // 4.5 s in, opening
+    DoorMonitor monitor;
+    AccelData first = traceSampleToAccel(trace[0]);
+    monitor.initialize(first.y, first.z, trace[0].time);
+    for (size_t i = 1; i <= cut; i++) {
+        monitor.updateState(traceSampleToAccel(trace[i]), trace[i].time);
+    }
+    ASSERT_TRUE(monitor.isMoving());
+
+    DoorMonitor cold;
+    AccelData reading = traceSampleToAccel(trace[cut]);
+    cold.initialize(reading.y, reading.z, REBOOT_TIME);
+    EXPECT_FALSE(cold.isMoving());
+    expectSeamlessRestart(trace, cut, false, storage);
+}
+
+TEST_F(DoorSnapshotRestartTest, MissingFileIsNoSnapshot) {
+    uint8_t blob[DOOR_SNAPSHOT_SIZE];
+    storage.remove();
+    EXPECT_FALSE(storage.load(blob, sizeof(blob)));
+}
+
+// ============================================================================
+// Test: Restore checks
+// ============================================================================
+
+TEST(DoorSnapshotTest, RejectsOtherSampleTypes) {
+    DoorMonitor floatMonitor;
+    floatMonitor.initialize(0.0f, 9.8f, 1000);
+    DoorSnapshot snapshot;
+    floatMonitor.saveSnapshot(snapshot, 2000);
+
+    DoorMonitorFixed16 fixed16;
+    fixed16.initialize(4096, 0, 10);
+    EXPECT_FALSE(fixed16.restoreSnapshot(snapshot, 20));
+    EXPECT_EQ(DOOR_CLOSED, fixed16.getState());
+    EXPECT_EQ(10u, fixed16.getTimeInCurrentState(20));
+
+    DoorMonitorFixed32 fixed32;
+    EXPECT_FALSE(fixed32.restoreSnapshot(snapshot, 20));
+
+    DoorMonitor other;
+    EXPECT_TRUE(other.restoreSnapshot(snapshot, 20));
+    EXPECT_EQ(DOOR_OPEN, other.getState());
+}
+
+TEST(DoorSnapshotTest, RejectsOutOfRangeFields) {
+    DoorMonitor monitor;
+    monitor.initialize(9.8f, 0.0f, 1000);
+    DoorSnapshot good;
+    monitor.saveSnapshot(good, 1000);
+
+    DoorSnapshot bad = good;
+    bad.state = (DoorState)(DOOR_ERROR_STALLED + 1);
+    EXPECT_FALSE(monitor.restoreSnapshot(bad, 0));
+    bad = good;
+    bad.arrivalCount = DOOR_ARRIVAL_MAX_WINDOW + 1;
+    EXPECT_FALSE(monitor.restoreSnapshot(bad, 0));
+    bad = good;
+    bad.arrivalNext = DOOR_ARRIVAL_MAX_WINDOW;
+    EXPECT_FALSE(monitor.restoreSnapshot(bad, 0));
+    EXPECT_TRUE(monitor.restoreSnapshot(good, 0));
+}
+
+TEST(DoorSnapshotTest, KeepsSensorFailureCount) {
+    DoorMonitor monitor;
+    monitor.initialize(9.8f, 0.0f, 1000);
+    AccelData bad = {0, 0, 0, false};
+    for (int i = 1; i <= 4; i++) {
+        monitor.updateState(bad, 1000 + 100 * i);
+    }
+    ASSERT_TRUE(monitor.isSensorHealthy());
+    DoorSnapshot snapshot;
+    monitor.saveSnapshot(snapshot, 1400);
+    EXPECT_EQ(4, snapshot.sensorFailures);
+
+    // One more failure after the reboot is the fifth
+    DoorMonitor restored;
+    ASSERT_TRUE(restored.restoreSnapshot(snapshot, REBOOT_TIME));
+    EXPECT_EQ(DOOR_ERROR_SENSOR_FAILURE, restored.updateState(bad, REBOOT_TIME + 100));
+}
+
+TEST(DoorSnapshotTest, FixedPointRoundTrip) {
+    std::vector<TraceSample> trace = doorCycleTrace(2);
+    DoorMonitorFixed16 reference(quantizeConfig<int16_t>(DEFAULT_CONFIG));
+    DoorMonitorFixed16 restored(quantizeConfig<int16_t>(DEFAULT_CONFIG));
+    reference.initialize(trace[0].y, trace[0].z, trace[0].time);
+    size_t cut = 45;
+    for (size_t i = 1; i <= cut; i++) {
+        DoorMonitorFixed16::Sample s = {trace[i].x, trace[i].y, trace[i].z, trace[i].valid};
+        reference.updateState(s, trace[i].time);
+    }
+    DoorSnapshot snapshot;
+    uint8_t blob[DOOR_SNAPSHOT_SIZE];
+    reference.saveSnapshot(snapshot, trace[cut].time);
+    encodeDoorSnapshot(snapshot, blob);
+    ASSERT_TRUE(decodeDoorSnapshot(blob, sizeof(blob), snapshot));
+    ASSERT_TRUE(restored.restoreSnapshot(snapshot, trace[cut].time));
+    for (size_t i = cut + 1; i < trace.size(); i++) {
+        DoorMonitorFixed16::Sample s = {trace[i].x, trace[i].y, trace[i].z, trace[i].valid};
+        ASSERT_EQ(reference.updateState(s, trace[i].time), restored.updateState(s, trace[i].time)) << "sample " << i;
+    }
+}
@@ -0,0 +1,280 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "EventJournal.h"
+#include "FileJournalStorage.h"
+#include "StatusJson.h"
+
+// In-memory segments with optional write failures
+class MemoryJournalStorage : public JournalStorage {
+public:
+    std::vector<uint8_t> segments[JOURNAL_MAX_SEGMENTS];
+    bool failWrites;
+    size_t appends;
+
+    MemoryJournalStorage() : failWrites(false), appends(0) {}
+
+    uint32_t size(uint8_t segment) override { return (uint32_t)segments[segment].size(); }
+
+    bool read(uint8_t segment, uint32_t offset, uint8_t* data, size_t length) override {
+        const std::vector<uint8_t>& s = segments[segment];
+        if (offset + length > s.size()) {
+            return false;
+        }
+        std::copy(s.begin() + offset, s.begin() + offset + length, data);
+        return true;
+    }
+
+    bool append(uint8_t segment, const uint8_t* data, size_t length) override {
+        if (failWrites) {
+            return false;
+        }
+        appends++;
+        segments[segment].insert(segments[segment].end(), data, data + length);
+        return true;
+    }
+
+    bool clear(uint8_t segment) override {
+        if (failWrites) {
+            return false;
+        }
+        segments[segment].clear();
+        return true;
+    }
+};
+
+static std::vector<JournalEntry> readAll(JournalStorage& storage, uint8_t segmentCount) {
+    std::vector<JournalEntry> entries;
+    JournalReader reader(storage, segmentCount);
+    JournalEntry entry;
+    while (reader.next(entry)) {
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+// ============================================================================
+// Test: Record encoding
+// ============================================================================
+
+TEST(EventJournalTest, RecordSizeGrowsWithDelta) {
+    uint8_t out[JOURNAL_MAX_RECORD_SIZE];
+    EXPECT_EQ(1u, encodeJournalRecord(DOOR_OPEN, 0, out));
+    EXPECT_EQ(1u, encodeJournalRecord(DOOR_OPEN, 7, out));
+    EXPECT_EQ(2u, encodeJournalRecord(DOOR_OPEN, 1000, out));
+    EXPECT_EQ(3u, encodeJournalRecord(DOOR_OPEN, 120000, out));
+    EXPECT_EQ(6u, encodeJournalRecord(DOOR_OPEN, 0xFFFFFFFFu, out));
+}
+
+TEST(EventJournalTest, RecordRoundTrip) {
+    const uint32_t deltas[] = {0, 1, 127, 128, 16383, 1000000, 0xFFFFFFFFu};
+    for (size_t i = 0; i < sizeof(deltas) / sizeof(deltas[0]); i++) {
+        uint8_t out[JOURNAL_MAX_RECORD_SIZE];
+        size_t n = encodeJournalRecord(DOOR_ERROR_STALLED, deltas[i], out);
+        uint8_t kind = 0;
+        uint32_t delta = 0;
+        EXPECT_EQ(n, decodeJournalRecord(out, n, kind, delta));
+        EXPECT_EQ((uint8_t)DOOR_ERROR_STALLED, kind);
+        EXPECT_EQ(deltas[i], delta);
+        // A truncated record is not decoded
+        if (n > 1) {
+            EXPECT_EQ(0u, decodeJournalRecord(out, n - 1, kind, delta));
+        }
+    }
+}
+
+// ============================================================================
+// Test: Writing and reading back
+// ============================================================================
+
+TEST(EventJournalTest, ReadsBackBootAndTransitions) {
+    MemoryJournalStorage storage;
+    EventJournal journal(storage);
+    ASSERT_TRUE(journal.begin(500));
+    EXPECT_TRUE(journal.append(DOOR_OPENING, 1200));
+    EXPECT_TRUE(journal.append(DOOR_OPEN, 9000));
+    EXPECT_TRUE(journal.append(DOOR_CLOSING, 3609000));
+    ASSERT_TRUE(journal.flush());
+
+    std::vector<JournalEntry> entries = readAll(storage, JOURNAL_DEFAULT_SEGMENTS);
+    ASSERT_EQ(4u, entries.size());
+    EXPECT_EQ(JOURNAL_ENTRY_BOOT, entries[0].type);
+    EXPECT_EQ(500u, entries[0].time);
+    EXPECT_EQ(JOURNAL_ENTRY_STATE, entries[1].type);
+    EXPECT_EQ(DOOR_OPENING, entries[1].state);
+    EXPECT_EQ(1200u, entries[1].time);
+    EXPECT_EQ(DOOR_OPEN, entries[2].state);
+    EXPECT_EQ(9000u, entries[2].time);
+    EXPECT_EQ(DOOR_CLOSING, entries[3].state);
+    EXPECT_EQ(3609000u, entries[3].time);
+
+    // Header plus 2 + 2 + 3 + 4 bytes of records
+    EXPECT_EQ((uint32_t)JOURNAL_HEADER_SIZE + 11, storage.size(0));
+}
+
+TEST(EventJournalTest, BatchesWritesUntilIntervalOrFull) {
+    MemoryJournalStorage storage;
+    EventJournal journal(storage, 4, 4096, 60000);
+    ASSERT_TRUE(journal.begin(0));
+    size_t appendsAfterBegin = storage.appends;
+
+    journal.append(DOOR_OPENING, 1000);
+    journal.append(DOOR_OPEN, 2000);
+    EXPECT_TRUE(journal.poll(60999));
+    EXPECT_EQ(appendsAfterBegin, storage.appends);  // not yet due
+    EXPECT_GT(journal.getBuffered(), 0u);
+    EXPECT_TRUE(journal.poll(61000));
+    EXPECT_EQ(appendsAfterBegin + 1, storage.appends);
+    EXPECT_EQ(0u, journal.getBuffered());
+
+    // A full buffer is written without waiting for poll()
+    for (int i = 0; i < 100; i++) {
+        journal.append(i % 2 ? DOOR_OPEN : DOOR_CLOSED, 70000 + i * 100);
+    }
+    EXPECT_GT(storage.appends, appendsAfterBegin + 1);
+    EXPECT_LT(storage.appends, appendsAfterBegin + 10);
+    journal.flush();
+    EXPECT_EQ(103u, readAll(storage, 4).size());
+
+    // Reopening keeps appending to the same (intact, multi-chunk) segment
+    EventJournal reopened(storage, 4, 4096, 60000);
+    ASSERT_TRUE(reopened.begin(0));
+    EXPECT_EQ(journal.getCurrentSegment(), reopened.getCurrentSegment());
+}
+
+TEST(EventJournalTest, RingDropsOldestSegment) {
+    MemoryJournalStorage storage;
+    EventJournal journal(storage, 3, 40, 60000);
+    ASSERT_TRUE(journal.begin(0));
+    unsigned long time = 0;
+    for (int i = 0; i < 200; i++) {
+        time += 1000;
+        ASSERT_TRUE(journal.append(i % 2 ? DOOR_OPEN : DOOR_CLOSED, time));
+    }
+    journal.flush();
+
+    for (uint8_t s = 0; s < 3; s++) {
+        EXPECT_LE(storage.size(s), 40u);
+    }
+    std::vector<JournalEntry> entries = readAll(storage, 3);
+    ASSERT_GT(entries.size(), 20u);
+    ASSERT_LT(entries.size(), 60u);
+    // The newest entries survive, in order, with correct times
+    EXPECT_EQ(time, entries.back().time);
+    EXPECT_EQ(DOOR_OPEN, entries.back().state);
+    for (size_t i = 1; i < entries.size(); i++) {
+        EXPECT_EQ(entries[i - 1].time + 1000, entries[i].time);
+        EXPECT_NE(entries[i - 1].state, entries[i].state);
+    }
+}
+
+TEST(EventJournalTest, ContinuesAfterReboot) {
+    MemoryJournalStorage storage;
+    {
+        EventJournal journal(storage);
+        ASSERT_TRUE(journal.begin(100));
+        journal.append(DOOR_OPENING, 5000);
+        journal.flush();
+    }
+    EventJournal journal(storage);
+    ASSERT_TRUE(journal.begin(80));  // clock restarted
+    journal.append(DOOR_CLOSED, 2000);
+    journal.flush();
+    EXPECT_EQ(0u, journal.getCurrentSegment());
+
+    std::vector<JournalEntry> entries = readAll(storage, JOURNAL_DEFAULT_SEGMENTS);
+    ASSERT_EQ(4u, entries.size());
+    EXPECT_EQ(JOURNAL_ENTRY_BOOT, entries[0].type);
+    EXPECT_EQ(5000u, entries[1].time);
+    EXPECT_EQ(JOURNAL_ENTRY_BOOT, entries[2].type);
+    EXPECT_EQ(80u, entries[2].time);
+    EXPECT_EQ(DOOR_CLOSED, entries[3].state);
+    EXPECT_EQ(2000u, entries[3].time);
+}
+
+TEST(EventJournalTest, TornRecordStartsFreshSegment) {
+    MemoryJournalStorage storage;
+    {
+        EventJournal journal(storage);
+        journal.begin(0);
+        journal.append(DOOR_OPENING, 5000);
+        journal.flush();
+    }
+    storage.segments[0].push_back(0x80);  // power lost mid-record
+
+    EventJournal journal(storage);
+    ASSERT_TRUE(journal.begin(10));
+    EXPECT_EQ(1u, journal.getCurrentSegment());
+    journal.append(DOOR_CLOSING, 700);
+    journal.flush();
+
+    std::vector<JournalEntry> entries = readAll(storage, JOURNAL_DEFAULT_SEGMENTS);
+    ASSERT_EQ(4u, entries.size());
+    EXPECT_EQ(DOOR_OPENING, entries[1].state);
+    EXPECT_EQ(JOURNAL_ENTRY_BOOT, entries[2].type);
+    EXPECT_EQ(DOOR_CLOSING, entries[3].state);
+    EXPECT_EQ(700u, entries[3].time);
+}
+
+TEST(EventJournalTest, FailedFlushKeepsRecordsForRetry) {
+    MemoryJournalStorage storage;
+    EventJournal journal(storage);
+    ASSERT_TRUE(journal.begin(0));
+    journal.append(DOOR_OPENING, 1000);
+
+    storage.failWrites = true;
+    EXPECT_FALSE(journal.flush());
+    EXPECT_GT(journal.getBuffered(), 0u);
+
+    storage.failWrites = false;
+    EXPECT_TRUE(journal.flush());
+    std::vector<JournalEntry> entries = readAll(storage, JOURNAL_DEFAULT_SEGMENTS);
+    ASSERT_EQ(2u, entries.size());
+    EXPECT_EQ(1000u, entries[1].time);
+}
+
+TEST(EventJournalTest, IgnoresAppendsWhenStorageUnavailable) {
+    MemoryJournalStorage storage;
+    storage.failWrites = true;
+    EventJournal journal(storage);
+    EXPECT_FALSE(journal.begin(0));
+    EXPECT_FALSE(journal.isReady());
+    EXPECT_FALSE(journal.append(DOOR_OPEN, 100));
+}
+
+TEST(EventJournalTest, WritesHistoryEntryJson) {
+    char buffer[JOURNAL_ENTRY_JSON_BUFFER_SIZE];
+    JournalEntry boot = {JOURNAL_ENTRY_BOOT, 500, DOOR_UNKNOWN};
+    size_t n = writeJournalEntryJson(buffer, sizeof(buffer), boot);
+    EXPECT_EQ("{\"time\":500,\"boot\":true}", std::string(buffer, n));
+
+    JournalEntry worst = {JOURNAL_ENTRY_STATE, 0xFFFFFFFFu, DOOR_ERROR_SENSOR_FAILURE};
+    n = writeJournalEntryJson(buffer, sizeof(buffer), worst);
+    EXPECT_EQ("{\"time\":4294967295,\"state\":\"ERROR_SENSOR_FAILURE\"}", std::string(buffer, n));
+}
+
+// ============================================================================
+// Test: File backend
+// ============================================================================
+
+TEST(EventJournalTest, FileStorageRoundTrip) {
+    std::string prefix = ::testing::TempDir() + "test_event_journal.";
+    FileJournalStorage storage(prefix);
+    storage.removeAll(2);
+    EXPECT_EQ(0u, storage.size(0));
+    {
+        EventJournal journal(storage, 2, 64, 60000);
+        ASSERT_TRUE(journal.begin(0));
+        for (int i = 0; i < 40; i++) {
+            journal.append(i % 2 ? DOOR_OPEN : DOOR_CLOSED, 1000 * (i + 1));
+        }
+        journal.flush();
+    }
+
+    std::vector<JournalEntry> entries = readAll(storage, 2);
+    ASSERT_FALSE(entries.empty());
+    EXPECT_EQ(40000u, entries.back().time);
+    EXPECT_LE(storage.size(0), 64u);
+    EXPECT_LE(storage.size(1), 64u);
+    storage.removeAll(2);
+}
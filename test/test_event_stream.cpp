@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include "EventStream.h"
+
+// Stand-in for WiFiClient: copies share one connection
+struct FakeConnection {
+    bool open;
+    size_t writeLimit;  // bytes accepted per write, simulates a stalled peer
+    size_t writeSpace;  // what availableForWrite() reports
+    size_t writes;
+    std::string received;
+    FakeConnection() : open(true), writeLimit((size_t)-1), writeSpace(2920), writes(0) {}
+};
+
+class FakeSseClient {
+public:
+    std::shared_ptr<FakeConnection> connection;
+
+    FakeSseClient() {}
+    explicit FakeSseClient(const std::shared_ptr<FakeConnection>& c) : connection(c) {}
+
+    bool connected() const { return connection && connection->open; }
+    void stop() {
+        if (connection) {
+            connection->open = false;
+        }
+    }
+    int availableForWrite() const { return (int)connection->writeSpace; }
+    size_t write(const uint8_t* data, size_t length) {
+        connection->writes++;
+        size_t n = length < connection->writeLimit ? length : connection->writeLimit;
+        connection->received.append((const char*)data, n);
+        return n;
+    }
+};
+
+// ============================================================================
+// Test: Publish policy
+// ============================================================================
+
+TEST(EventStreamTest, PublishesStateImmediatelyOnChange) {
+    SsePublishPolicy policy(1000);
+    EXPECT_EQ(SSE_EVENT_STATE, policy.poll(DOOR_CLOSED, 100));   // initial state
+    EXPECT_EQ(SSE_EVENT_NONE, policy.poll(DOOR_CLOSED, 200));
+    EXPECT_EQ(SSE_EVENT_STATE, policy.poll(DOOR_OPENING, 250));
+    EXPECT_EQ(SSE_EVENT_NONE, policy.poll(DOOR_OPENING, 300));
+}
+
+TEST(EventStreamTest, PublishesMarkedChangeEvenIfStateReturned) {
+    // A transition listener saw CLOSED -> OPENING -> CLOSED between polls
+    SsePublishPolicy policy(1000);
+    policy.poll(DOOR_CLOSED, 0);
+    policy.markStateChanged();
+    EXPECT_EQ(SSE_EVENT_STATE, policy.poll(DOOR_CLOSED, 100));
+    EXPECT_EQ(SSE_EVENT_NONE, policy.poll(DOOR_CLOSED, 200));
+}
+
+TEST(EventStreamTest, PublishesTelemetryAtConfiguredRate) {
+    SsePublishPolicy policy(1000);
+    policy.poll(DOOR_CLOSED, 0);
+    EXPECT_EQ(SSE_EVENT_NONE, policy.poll(DOOR_CLOSED, 999));
+    EXPECT_EQ(SSE_EVENT_TELEMETRY, policy.poll(DOOR_CLOSED, 1000));
+    EXPECT_EQ(SSE_EVENT_NONE, policy.poll(DOOR_CLOSED, 1500));
+    EXPECT_EQ(SSE_EVENT_TELEMETRY, policy.poll(DOOR_CLOSED, 2100));
+}
+
+TEST(EventStreamTest, FallsBackToKeepAliveWhenTelemetryOff) {
+    SsePublishPolicy policy(0);
+    policy.poll(DOOR_OPEN, 0);
+    EXPECT_EQ(SSE_EVENT_NONE, policy.poll(DOOR_OPEN, SSE_KEEPALIVE_INTERVAL_MS - 1));
+    EXPECT_EQ(SSE_EVENT_KEEPALIVE, policy.poll(DOOR_OPEN, SSE_KEEPALIVE_INTERVAL_MS));
+}
+
+// ============================================================================
+// Test: Frame formatting
+// ============================================================================
+
+TEST(EventStreamTest, FormatsEventFrames) {
+    char frame[64];
+    const char* data = "{\"state\":\"OPEN\"}";
+    size_t n = formatSseFrame(frame, sizeof(frame), SSE_EVENT_STATE, data, strlen(data));
+    EXPECT_EQ("event: state\ndata: {\"state\":\"OPEN\"}\n\n", std::string(frame, n));
+
+    n = formatSseFrame(frame, sizeof(frame), SSE_EVENT_BUCKET, "null", 4);
+    EXPECT_EQ("event: bucket\ndata: null\n\n", std::string(frame, n));
+
+    n = formatSseFrame(frame, sizeof(frame), SSE_EVENT_KEEPALIVE, NULL, 0);
+    EXPECT_EQ(":\n\n", std::string(frame, n));
+
+    EXPECT_EQ(0u, formatSseFrame(frame, 10, SSE_EVENT_TELEMETRY, data, strlen(data)));
+}
+
+// ============================================================================
+// Test: Subscribers
+// ============================================================================
+
+TEST(EventStreamTest, BroadcastsToAllSubscribers) {
+    SseHub<FakeSseClient, 2> hub;
+    std::shared_ptr<FakeConnection> a(new FakeConnection), b(new FakeConnection);
+    EXPECT_TRUE(hub.subscribe(FakeSseClient(a)));
+    EXPECT_TRUE(hub.subscribe(FakeSseClient(b)));
+
+    EXPECT_EQ(2u, hub.broadcast("x\n\n", 3));
+    EXPECT_EQ("x\n\n", a->received);
+    EXPECT_EQ("x\n\n", b->received);
+}
+
+TEST(EventStreamTest, LimitsSubscribers) {
+    SseHub<FakeSseClient, 2> hub;
+    std::shared_ptr<FakeConnection> a(new FakeConnection), b(new FakeConnection), c(new FakeConnection);
+    EXPECT_TRUE(hub.subscribe(FakeSseClient(a)));
+    EXPECT_TRUE(hub.subscribe(FakeSseClient(b)));
+    EXPECT_FALSE(hub.hasCapacity());
+    EXPECT_FALSE(hub.subscribe(FakeSseClient(c)));
+
+    // A closed subscriber frees its slot
+    a->open = false;
+    EXPECT_TRUE(hub.hasCapacity());
+    EXPECT_TRUE(hub.subscribe(FakeSseClient(c)));
+    EXPECT_EQ(2u, hub.subscriberCount());
+}
+
+TEST(EventStreamTest, DropsStalledSubscribers) {
+    SseHub<FakeSseClient, 2> hub;
+    std::shared_ptr<FakeConnection> fast(new FakeConnection), slow(new FakeConnection);
+    slow->writeLimit = 1;
+    hub.subscribe(FakeSseClient(fast));
+    hub.subscribe(FakeSseClient(slow));
+
+    EXPECT_EQ(1u, hub.broadcast("data\n\n", 6));
+    EXPECT_FALSE(slow->open);
+    EXPECT_EQ(1u, hub.subscriberCount());
+}
+
+TEST(EventStreamTest, DropsSubscribersWithoutWriteSpaceBeforeWriting) {
+    // A full send buffer: on the device write() would block until timeout
+    SseHub<FakeSseClient, 2> hub;
+    std::shared_ptr<FakeConnection> fast(new FakeConnection), stalled(new FakeConnection);
+    stalled->writeSpace = 5;
+    hub.subscribe(FakeSseClient(fast));
+    hub.subscribe(FakeSseClient(stalled));
+
+    EXPECT_EQ(1u, hub.broadcast("data\n\n", 6));
+    EXPECT_EQ(0u, stalled->writes);
+    EXPECT_TRUE(stalled->received.empty());
+    EXPECT_FALSE(stalled->open);
+    EXPECT_EQ(1u, hub.subscriberCount());
+    EXPECT_EQ("data\n\n", fast->received);
+
+    // Exactly enough space is enough
+    std::shared_ptr<FakeConnection> tight(new FakeConnection);
+    tight->writeSpace = 6;
+    hub.subscribe(FakeSseClient(tight));
+    EXPECT_EQ(2u, hub.broadcast("data\n\n", 6));
+    EXPECT_TRUE(tight->open);
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <set>
+#include "DoorMonitor.h"
+#include "DoorTraceFixtures.h"
+
+// Runs the float, Q15.0 and Q23.8 engines side by side over a raw-count trace and
+// checks that every sample produces the same state and direction.
+static size_t expectEquivalent(const std::vector<TraceSample>& trace, const DoorMonitorConfig& config) {
+    DoorMonitor floatMonitor(config);
+    DoorMonitorFixed16 fixed16(quantizeConfig<int16_t>(config));
+    DoorMonitorFixed32 fixed32(quantizeConfig<int32_t>(config));
+    std::set<int> statesSeen;
+
+    const TraceSample& first = trace[0];
+    AccelData start = traceSampleToAccel(first);
+    floatMonitor.initialize(start.y, start.z, first.time);
+    fixed16.initialize(first.y, first.z, first.time);
+    fixed32.initialize((int32_t)first.y << 8, (int32_t)first.z << 8, first.time);
+
+    for (size_t i = 1; i < trace.size(); i++) {
+        const TraceSample& s = trace[i];
+
+        AccelData f = traceSampleToAccel(s);
+
+        DoorMonitorFixed16::Sample q0;
+        q0.x = s.x;
+        q0.y = s.y;
+        q0.z = s.z;
+        q0.valid = s.valid;
+
+        DoorMonitorFixed32::Sample q8;
+        q8.x = (int32_t)s.x << 8;
+        q8.y = (int32_t)s.y << 8;
+        q8.z = (int32_t)s.z << 8;
+        q8.valid = s.valid;
+
+        DoorState expected = floatMonitor.updateState(f, s.time);
+        EXPECT_EQ(expected, fixed16.updateState(q0, s.time)) << "Q15.0 diverged at sample " << i;
+        EXPECT_EQ(expected, fixed32.updateState(q8, s.time)) << "Q23.8 diverged at sample " << i;
+        EXPECT_EQ(floatMonitor.getLastMovementDirection(), fixed16.getLastMovementDirection());
+        EXPECT_EQ(floatMonitor.getLastMovementDirection(), fixed32.getLastMovementDirection());
+        if (::testing::Test::HasFailure()) {
+            break;
+        }
+        statesSeen.insert(expected);
+    }
+
+    return statesSeen.size();
+}
+
+// ============================================================================
+// Test: Configuration quantization
+// ============================================================================
+
+TEST(FixedPointTest, QuantizedThresholdsPreserveComparisons) {
+    DoorMonitorFixed16::Config q = quantizeConfig<int16_t>(DEFAULT_CONFIG);
+
+    // 0.5 m/s^2 = 208.8 counts: "> 208.8" on integers is "> 208"
+    EXPECT_EQ(208, q.accelThreshold);
+    // 0.1 m/s^2 = 41.8 counts: "< 41.8" on integers is "< 42"
+    EXPECT_EQ(42, q.stallThreshold);
+    EXPECT_EQ(4093, q.closedPositionY);
+    EXPECT_EQ(0, q.closedPositionZ);
+    EXPECT_EQ(4093, q.openPositionZ);
+    EXPECT_EQ(417, q.positionTolerance);
+    EXPECT_EQ(DEFAULT_CONFIG.stopTimeout, q.stopTimeout);
+}
+
+TEST(FixedPointTest, Q8ConfigKeepsFractionalCounts) {
+    DoorMonitorFixed32::Config q = quantizeConfig<int32_t>(DEFAULT_CONFIG);
+    EXPECT_EQ(53462, q.accelThreshold);     // floor(208.84 * 256)
+    EXPECT_EQ(1047865, q.closedPositionY);  // round(4093.22 * 256)
+}
+
+// ============================================================================
+// Test: Fixed-point engine behaviour
+// ============================================================================
+
+TEST(FixedPointTest, Fixed16DetectsOpeningFromRawCounts) {
+    DoorMonitorFixed16 monitor;
+    monitor.initialize(4096, 0, 1000);
+    EXPECT_EQ(DOOR_CLOSED, monitor.getState());
+
+    DoorMonitorFixed16::Sample sample = {0, 3950, 600, true};
+    EXPECT_EQ(DOOR_OPENING, monitor.updateState(sample, 1100));
+
+    monitor.updateState(sample, 4000);
+    EXPECT_EQ(DOOR_STOPPED, monitor.getState());
+}
+
+TEST(FixedPointTest, Fixed16HelpersUseWideIntermediates) {
+    // Differences of extreme int16 values must not overflow
+    EXPECT_EQ(65535, DoorMonitorFixed16::calculateAccelChange(32767, -32768));
+    EXPECT_EQ(DOOR_CLOSING, DoorMonitorFixed16::determineDirection(-32768, 32767, 0, 0, 100));
+    EXPECT_TRUE(DoorMonitorFixed16::isInClosedPosition(4000, 50, 4093, 0, 417));
+    EXPECT_FALSE(DoorMonitorFixed16::isInOpenPosition(4000, 50, 0, 4093, 417));
+}
+
+// ============================================================================
+// Test: Equivalence with the float engine on traces
+// ============================================================================
+
+TEST(FixedPointTest, DoorCycleTraceMatchesFloatEngine) {
+    std::vector<TraceSample> trace = doorCycleTrace();
+    size_t states = expectEquivalent(trace, DEFAULT_CONFIG);
+    EXPECT_GE(states, 5u);
+}
+
+TEST(FixedPointTest, RandomTracesMatchFloatEngine) {
+    for (uint32_t seed = 1; seed <= 20; seed++) {
+        std::vector<TraceSample> trace = randomDoorTrace(200, seed);
+        expectEquivalent(trace, DEFAULT_CONFIG);
+        ASSERT_FALSE(::testing::Test::HasFailure()) << "seed " << seed;
+    }
+}
+
+TEST(FixedPointTest, TightToleranceConfigMatchesFloatEngine) {
+    DoorMonitorConfig config = DEFAULT_CONFIG;
+    config.positionTolerance = 0.5;
+    config.stallTimeout = 3000;
+    config.maxOpenTime = 10000;
+    config.maxCloseTime = 10000;
+
+    expectEquivalent(doorCycleTrace(7), config);
+    for (uint32_t seed = 100; seed < 105; seed++) {
+        expectEquivalent(randomDoorTrace(200, seed), config);
+    }
+}
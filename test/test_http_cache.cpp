@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+#include "HttpCache.h"
+
+TEST(HttpCacheTest, MatchesExactTag) {
+    EXPECT_TRUE(etagMatches("\"abc123\"", "\"abc123\""));
+    EXPECT_FALSE(etagMatches("\"abc124\"", "\"abc123\""));
+    EXPECT_FALSE(etagMatches("\"abc\"", "\"abc123\""));
+}
+
+TEST(HttpCacheTest, MatchesAnyTagInList) {
+    EXPECT_TRUE(etagMatches("\"old\", \"abc123\"", "\"abc123\""));
+    EXPECT_TRUE(etagMatches("\"abc123\",\"other\"", "\"abc123\""));
+    EXPECT_FALSE(etagMatches("\"old\", \"older\"", "\"abc123\""));
+}
+
+TEST(HttpCacheTest, UsesWeakComparison) {
+    EXPECT_TRUE(etagMatches("W/\"abc123\"", "\"abc123\""));
+}
+
+TEST(HttpCacheTest, WildcardMatches) {
+    EXPECT_TRUE(etagMatches("*", "\"abc123\""));
+}
+
+TEST(HttpCacheTest, MissingHeaderDoesNotMatch) {
+    EXPECT_FALSE(etagMatches("", "\"abc123\""));
+    EXPECT_FALSE(etagMatches(NULL, "\"abc123\""));
+}
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <string.h>
+#include "JsonWriter.h"
+#include "StatusJson.h"
+#include "LegacyStatusJson.h"
+#include "DoorTraceFixtures.h"
+
+static std::string formatted(float value, uint8_t decimals) {
+    char text[48];
+    size_t n = JsonWriter::formatFloat(text, sizeof(text), value, decimals);
+    return std::string(text, n);
+}
+
+static std::string printfFormatted(float value, int decimals) {
+    char text[48];
+    snprintf(text, sizeof(text), "%.*f", decimals, value);
+    return text;
+}
+
+// ============================================================================
+// Test: Float formatting
+// ============================================================================
+
+TEST(JsonWriterTest, FormatsCommonValues) {
+    EXPECT_EQ("9.80", formatted(9.8f, 2));
+    EXPECT_EQ("0.00", formatted(0.0f, 2));
+    EXPECT_EQ("-0.50", formatted(-0.5f, 2));
+    EXPECT_EQ("2.00", formatted(1.999f, 2));
+    EXPECT_EQ("10", formatted(9.6f, 0));
+    EXPECT_EQ("123.456", formatted(123.456f, 3));
+}
+
+TEST(JsonWriterTest, MatchesPrintfRounding) {
+    // Exact binary ties round half to even like printf
+    EXPECT_EQ(printfFormatted(0.125f, 2), formatted(0.125f, 2));
+    EXPECT_EQ(printfFormatted(0.375f, 2), formatted(0.375f, 2));
+    EXPECT_EQ(printfFormatted(2.5f, 0), formatted(2.5f, 0));
+    EXPECT_EQ(printfFormatted(-0.001f, 2), formatted(-0.001f, 2));  // "-0.00"
+    EXPECT_EQ(printfFormatted(-0.0f, 2), formatted(-0.0f, 2));
+
+    TraceNoise rng(7);
+    for (int i = 0; i < 200000; i++) {
+        float value = ((int)(rng.next() % 2000001) - 1000000) / 997.0f;
+        uint8_t decimals = (uint8_t)(i % 7);
+        ASSERT_EQ(printfFormatted(value, decimals), formatted(value, decimals)) << value;
+    }
+}
+
+TEST(JsonWriterTest, FormatsSpecialValuesLikeDtostrf) {
+    EXPECT_EQ("nan", formatted(NAN, 2));
+    EXPECT_EQ("inf", formatted(INFINITY, 2));
+}
+
+TEST(JsonWriterTest, FormatFailsWhenOutputTooSmall) {
+    char text[4];
+    EXPECT_EQ(0u, JsonWriter::formatFloat(text, sizeof(text), 12.5f, 2));
+    EXPECT_EQ(3u, JsonWriter::formatFloat(text, sizeof(text), 1.5f, 1));
+    EXPECT_STREQ("1.5", text);
+}
+
+// ============================================================================
+// Test: Document structure
+// ============================================================================
+
+TEST(JsonWriterTest, WritesObjectsAndArrays) {
+    char buffer[128];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.addString("name", "door");
+    json.addUnsigned("count", 42);
+    json.addInt("offset", -7);
+    json.beginArray("values");
+    json.addFloatElement(1.5f, 1);
+    json.addUnsignedElement(3);
+    json.endArray();
+    json.addBool("ok", false);
+    json.endObject();
+
+    EXPECT_FALSE(json.overflowed());
+    EXPECT_STREQ("{\"name\":\"door\",\"count\":42,\"offset\":-7,\"values\":[1.5,3],\"ok\":false}", json.c_str());
+    EXPECT_EQ(strlen(buffer), json.size());
+}
+
+TEST(JsonWriterTest, EscapesStrings) {
+    char buffer[64];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.addString("s", "a\"b\\c\n");
+    json.endObject();
+    EXPECT_STREQ("{\"s\":\"a\\\"b\\\\c\\u000a\"}", json.c_str());
+}
+
+TEST(JsonWriterTest, ReportsOverflow) {
+    char buffer[16];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.addString("details", "this does not fit");
+    json.endObject();
+    EXPECT_TRUE(json.overflowed());
+    EXPECT_LT(strlen(buffer), sizeof(buffer));
+}
+
+// ============================================================================
+// Test: /status document
+// ============================================================================
+
+TEST(JsonWriterTest, StatusJsonIsByteIdenticalToStringVersion) {
+    DoorMonitor monitor;
+    monitor.initialize(9.8f, 0.0f, 1000);
+    std::vector<TraceSample> trace = doorCycleTrace(3);
+    char buffer[STATUS_JSON_BUFFER_SIZE];
+
+    for (size_t i = 0; i < trace.size(); i++) {
+        AccelData accel;
+        accel.x = trace[i].x * 9.80665f / 4096.0f;
+        accel.y = trace[i].y * 9.80665f / 4096.0f;
+        accel.z = trace[i].z * 9.80665f / 4096.0f;
+        accel.valid = trace[i].valid;
+        monitor.updateState(accel, trace[i].time);
+
+        size_t n = writeStatusJson(buffer, sizeof(buffer), monitor, accel);
+        ASSERT_GT(n, 0u);
+        ASSERT_EQ(legacyStatusJson(monitor, accel), std::string(buffer, n)) << "sample " << i;
+    }
+}
+
+TEST(JsonWriterTest, StatusJsonReportsSmallBuffer) {
+    DoorMonitor monitor;
+    AccelData accel = {0.0f, 9.8f, 0.0f, true};
+    char buffer[32];
+    EXPECT_EQ(0u, writeStatusJson(buffer, sizeof(buffer), monitor, accel));
+}
+
+TEST(JsonWriterTest, StatusJsonWithPositionFitsBuffer) {
+    DoorMonitor monitor;
+    DoorPositionEstimator position;
+    monitor.addTransitionListener(DoorPositionEstimator::transitionListener, &position);
+    monitor.initialize(9.8f, 0.0f, 1000);
+    std::vector<TraceSample> trace = doorCycleTrace(3);
+    char buffer[STATUS_JSON_BUFFER_SIZE];
+    size_t withEta = 0;
+
+    for (size_t i = 0; i < trace.size(); i++) {
+        AccelData accel;
+        accel.x = trace[i].x * 9.80665f / 4096.0f;
+        accel.y = trace[i].y * 9.80665f / 4096.0f;
+        accel.z = trace[i].z * 9.80665f / 4096.0f;
+        accel.valid = trace[i].valid;
+        monitor.updateState(accel, trace[i].time);
+        position.update(accel, trace[i].time);
+
+        size_t n = writeStatusJson(buffer, sizeof(buffer), monitor, accel, position);
+        ASSERT_GT(n, 0u) << "sample " << i;
+        std::string json(buffer, n);
+        std::string legacy = legacyStatusJson(monitor, accel);
+        // Same fields, position object last
+        ASSERT_EQ(legacy.substr(0, legacy.size() - 1), json.substr(0, legacy.size() - 1));
+        ASSERT_NE(std::string::npos, json.find(",\"position\":{\"percent\":"));
+        unsigned long remaining;
+        if (position.estimateArrival(remaining)) {
+            ASSERT_NE(std::string::npos, json.find("\"etaMs\":"));
+            withEta++;
+        } else {
+            ASSERT_EQ(std::string::npos, json.find("\"etaMs\":"));
+        }
+    }
+    EXPECT_GT(withEta, 0u);
+}
+
+TEST(JsonWriterTest, StatusJsonWithPositionWorstCaseFits) {
+    // Longest details string, widest numbers everywhere
+    static const TraceSegment stopMidClose[] = {
+        {3000, 90, 90, 20, false},
+        {1500, 90, 45, 30, false},
+        {3000, 45, 45, 20, false}
+    };
+    std::vector<TraceSample> trace = synthesizeTrace(stopMidClose, 3, TRACE_PERIOD_MS, 1);
+    DoorMonitor monitor;
+    monitor.initialize(0.0f, 9.8f, trace[0].time);
+    for (size_t i = 0; i < trace.size(); i++) {
+        AccelData accel = {0.0f, trace[i].y * 9.80665f / 4096.0f, trace[i].z * 9.80665f / 4096.0f, true};
+        monitor.updateState(accel, trace[i].time);
+    }
+    ASSERT_EQ(DOOR_STOPPED, monitor.getState());
+
+    DoorPositionEstimator position;
+    position.setTravelTime(DOOR_OPENING, 4294967295UL);
+    position.setTravelTime(DOOR_CLOSING, 4294967295UL);
+    AccelData extreme = {-156.9f, -156.9f, -156.9f, true};
+    char buffer[STATUS_JSON_BUFFER_SIZE];
+    size_t n = writeStatusJson(buffer, sizeof(buffer), monitor, extreme, position);
+    ASSERT_GT(n, 0u);
+    // Room for the longest details string whichever way the stop was read
+    size_t longest = strlen("Door STOPPED mid-close (was closing, not at full closed)");
+    EXPECT_LT(n - strlen(monitor.getDetailedStatus()) + longest, sizeof(buffer));
+}
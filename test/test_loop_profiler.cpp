@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "LoopProfiler.h"
+#include "StatusJson.h"
+
+// All tests drive the profiler with a fake microsecond clock
+
+// ============================================================================
+// Test: Phase timing
+// ============================================================================
+
+TEST(LoopProfilerTest, PhasesMeasureFromPreviousMark) {
+    LoopProfiler profiler;
+    profiler.beginLoop(1000);
+    profiler.endPhase(LOOP_PHASE_CLIENT, 1300);
+    profiler.endPhase(LOOP_PHASE_SENSOR, 1310);
+    profiler.endPhase(LOOP_PHASE_UPDATE, 1350);
+    profiler.endPhase(LOOP_PHASE_EVENTS, 1350);
+    profiler.endPhase(LOOP_PHASE_SERIAL, 3350);
+
+    const LoopProfileWindow& window = profiler.getWindow();
+    EXPECT_EQ(300u, window.phases[LOOP_PHASE_CLIENT].getMax());
+    EXPECT_EQ(10u, window.phases[LOOP_PHASE_SENSOR].getMax());
+    EXPECT_EQ(40u, window.phases[LOOP_PHASE_UPDATE].getMax());
+    EXPECT_EQ(0u, window.phases[LOOP_PHASE_EVENTS].getMax());
+    EXPECT_EQ(2000u, window.phases[LOOP_PHASE_SERIAL].getMax());
+    EXPECT_EQ(1u, window.phases[LOOP_PHASE_SERIAL].getCount());
+}
+
+TEST(LoopProfilerTest, SkippedPhasesAreNotRecorded) {
+    // An idle pass returns after the sensor phase
+    LoopProfiler profiler;
+    profiler.beginLoop(0);
+    profiler.endPhase(LOOP_PHASE_CLIENT, 5);
+    profiler.endPhase(LOOP_PHASE_SENSOR, 6);
+    profiler.beginLoop(10);
+    profiler.endPhase(LOOP_PHASE_CLIENT, 12);
+
+    const LoopProfileWindow& window = profiler.getWindow();
+    EXPECT_EQ(2u, window.phases[LOOP_PHASE_CLIENT].getCount());
+    EXPECT_EQ(1u, window.phases[LOOP_PHASE_SENSOR].getCount());
+    EXPECT_EQ(0u, window.phases[LOOP_PHASE_UPDATE].getCount());
+}
+
+TEST(LoopProfilerTest, IgnoresPhasesBeforeFirstLoop) {
+    LoopProfiler profiler;
+    profiler.endPhase(LOOP_PHASE_CLIENT, 100);
+    EXPECT_EQ(0u, profiler.getWindow().phases[LOOP_PHASE_CLIENT].getCount());
+}
+
+TEST(LoopProfilerTest, LoopPeriodBetweenEntries) {
+    LoopProfiler profiler;
+    profiler.beginLoop(100);
+    profiler.beginLoop(150);
+    profiler.beginLoop(5150);
+
+    const Histogram<LOOP_PROFILER_BUCKETS>& period = profiler.getWindow().loopPeriod;
+    EXPECT_EQ(2u, period.getCount());
+    EXPECT_EQ(50u, period.getMin());
+    EXPECT_EQ(5000u, period.getMax());
+}
+
+TEST(LoopProfilerTest, HandlesClockWrap) {
+    LoopProfiler profiler;
+    profiler.beginLoop(0xFFFFFF00u);
+    profiler.endPhase(LOOP_PHASE_CLIENT, 0x40u);
+    profiler.beginLoop(0x80u);
+
+    EXPECT_EQ(0x140u, profiler.getWindow().phases[LOOP_PHASE_CLIENT].getMax());
+    EXPECT_EQ(0x180u, profiler.getWindow().loopPeriod.getMax());
+    EXPECT_FALSE(profiler.isWindowComplete());
+}
+
+// ============================================================================
+// Test: Acquisition jitter
+// ============================================================================
+
+TEST(LoopProfilerTest, AcquisitionIntervalAndDuration) {
+    LoopProfiler profiler;
+    profiler.beginLoop(0);
+    profiler.recordAcquisition(100000, 100400);
+    profiler.recordAcquisition(200000, 200350);
+    profiler.recordAcquisition(312000, 312500);  // drain delayed by 12 ms
+
+    const LoopProfileWindow& window = profiler.getWindow();
+    EXPECT_EQ(2u, window.acquisitionInterval.getCount());
+    EXPECT_EQ(100000u, window.acquisitionInterval.getMin());
+    EXPECT_EQ(112000u, window.acquisitionInterval.getMax());
+    EXPECT_EQ(3u, window.acquisitionTime.getCount());
+    EXPECT_EQ(350u, window.acquisitionTime.getMin());
+    EXPECT_EQ(500u, window.acquisitionTime.getMax());
+}
+
+// ============================================================================
+// Test: Rolling window
+// ============================================================================
+
+TEST(LoopProfilerTest, ReportsInProgressWindowUntilFirstCompletes) {
+    LoopProfiler profiler(1000);
+    profiler.beginLoop(0);
+    profiler.beginLoop(400);
+    EXPECT_FALSE(profiler.isWindowComplete());
+    EXPECT_EQ(1u, profiler.getWindow().loopPeriod.getCount());
+}
+
+TEST(LoopProfilerTest, RollsToLastCompleteWindow) {
+    LoopProfiler profiler(1000);
+    profiler.beginLoop(0);
+    profiler.beginLoop(500);
+    profiler.beginLoop(900);
+    profiler.beginLoop(1200);  // closes the first window
+    profiler.beginLoop(1250);
+
+    ASSERT_TRUE(profiler.isWindowComplete());
+    const LoopProfileWindow& first = profiler.getWindow();
+    EXPECT_EQ(0u, first.startTime);
+    EXPECT_EQ(1200u, first.duration);
+    // The period that closes a window is counted in it
+    EXPECT_EQ(3u, first.loopPeriod.getCount());
+    EXPECT_EQ(500u, first.loopPeriod.getMax());
+
+    profiler.beginLoop(2300);  // closes the second
+    const LoopProfileWindow& second = profiler.getWindow();
+    EXPECT_EQ(1200u, second.startTime);
+    EXPECT_EQ(1100u, second.duration);
+    EXPECT_EQ(2u, second.loopPeriod.getCount());
+    EXPECT_EQ(1050u, second.loopPeriod.getMax());
+}
+
+TEST(LoopProfilerTest, ResetClearsEverything) {
+    LoopProfiler profiler(1000);
+    profiler.beginLoop(0);
+    profiler.recordAcquisition(10, 20);
+    profiler.beginLoop(2000);
+    profiler.reset();
+
+    EXPECT_FALSE(profiler.isWindowComplete());
+    EXPECT_EQ(0u, profiler.getWindow().loopPeriod.getCount());
+    EXPECT_EQ(0u, profiler.getWindow().acquisitionTime.getCount());
+    profiler.beginLoop(5000);
+    EXPECT_EQ(0u, profiler.getWindow().loopPeriod.getCount());
+}
+
+// ============================================================================
+// Test: /profile JSON
+// ============================================================================
+
+TEST(LoopProfilerTest, WritesProfileJson) {
+    LoopProfiler profiler;
+    profiler.beginLoop(0);
+    profiler.endPhase(LOOP_PHASE_CLIENT, 300);
+    profiler.beginLoop(1000);
+    EXPECT_STREQ("serial", loopPhaseName(LOOP_PHASE_SERIAL));
+
+    char buffer[LOOP_PROFILE_JSON_BUFFER_SIZE];
+    size_t n = writeLoopProfileJson(buffer, sizeof(buffer), profiler);
+    ASSERT_GT(n, 0u);
+    std::string json(buffer, n);
+    EXPECT_EQ(0u, json.find("{\"windowUs\":10000000,\"complete\":false,\"durationUs\":0,"
+                            "\"loopPeriodUs\":{\"count\":1,\"min\":1000,\"max\":1000"));
+    EXPECT_NE(std::string::npos, json.find("\"acquisitionIntervalUs\":{\"count\":0"));
+    EXPECT_NE(std::string::npos, json.find("\"phasesUs\":{\"client\":{\"count\":1,\"min\":300,\"max\":300"));
+    EXPECT_NE(std::string::npos, json.find("\"serial\":{\"count\":0"));
+    EXPECT_EQ('}', json[n - 1]);
+}
+
+TEST(LoopProfilerTest, ProfileJsonFitsWorstCase) {
+    LoopProfiler profiler(0xFFFFFFFFu);
+    uint32_t now = 0;
+    profiler.beginLoop(now);
+    for (size_t i = 0; i < 1000; i++) {
+        uint32_t step = 0xFFFFFFFFu >> (i % 32);
+        now += step;
+        profiler.beginLoop(now);
+        profiler.recordAcquisition(now, now + step);
+        for (int p = 0; p < LOOP_PHASE_COUNT; p++) {
+            profiler.endPhase((LoopPhase)p, now + step);
+        }
+    }
+
+    char buffer[LOOP_PROFILE_JSON_BUFFER_SIZE];
+    EXPECT_GT(writeLoopProfileJson(buffer, sizeof(buffer), profiler), 0u);
+}
@@ -0,0 +1,372 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include <string.h>
+#include <math.h>
+#include "Mpu6050Fifo.h"
+
+// Register-level model of the MPU-6050 FIFO for off-hardware tests
+class FakeMpu6050Bus : public I2cBus {
+public:
+    uint8_t registers[128];
+    std::deque<uint8_t> fifo;
+    unsigned int transactions;
+    unsigned int bytesTransferred;
+    bool failReads;
+
+    FakeMpu6050Bus() : transactions(0), bytesTransferred(0), failReads(false) {
+        memset(registers, 0, sizeof(registers));
+        registers[MPU6050_REG_WHO_AM_I] = MPU6050_WHO_AM_I_VALUE;
+    }
+
+    void queueSample(int16_t x, int16_t y, int16_t z) {
+        int16_t values[3] = {x, y, z};
+        for (int i = 0; i < 3; i++) {
+            fifo.push_back((uint8_t)((uint16_t)values[i] >> 8));
+            fifo.push_back((uint8_t)(values[i] & 0xFF));
+        }
+    }
+
+    void queueGyroSample(int16_t x, int16_t y, int16_t z, int16_t gyroX) {
+        queueSample(x, y, z);
+        fifo.push_back((uint8_t)((uint16_t)gyroX >> 8));
+        fifo.push_back((uint8_t)(gyroX & 0xFF));
+    }
+
+    bool writeRegister(uint8_t address, uint8_t reg, uint8_t value) override {
+        if (address != MPU6050_DEFAULT_ADDRESS) {
+            return false;
+        }
+        transactions++;
+        bytesTransferred += 2;
+        registers[reg] = value;
+        if (reg == MPU6050_REG_USER_CTRL && (value & MPU6050_USER_CTRL_FIFO_RESET)) {
+            fifo.clear();
+        }
+        return true;
+    }
+
+    bool readRegisters(uint8_t address, uint8_t reg, uint8_t* data, size_t length) override {
+        if (address != MPU6050_DEFAULT_ADDRESS || failReads) {
+            return false;
+        }
+        transactions++;
+        bytesTransferred += 1 + length;
+        for (size_t i = 0; i < length; i++) {
+            if (reg == MPU6050_REG_FIFO_R_W) {
+                if (fifo.empty()) {
+                    return false;
+                }
+                data[i] = fifo.front();
+                fifo.pop_front();
+            } else if (reg == MPU6050_REG_FIFO_COUNT_H && i < 2) {
+                size_t count = fifo.size() > MPU6050_FIFO_SIZE ? MPU6050_FIFO_SIZE : fifo.size();
+                data[i] = (i == 0) ? (uint8_t)(count >> 8) : (uint8_t)(count & 0xFF);
+            } else {
+                data[i] = registers[reg + i];
+            }
+        }
+        return true;
+    }
+};
+
+class Mpu6050FifoTest : public ::testing::Test {
+protected:
+    FakeMpu6050Bus bus;
+    Mpu6050Fifo* fifo;
+
+    void SetUp() override {
+        fifo = new Mpu6050Fifo(bus);
+    }
+
+    void TearDown() override {
+        delete fifo;
+    }
+};
+
+// ============================================================================
+// Test: Configuration
+// ============================================================================
+
+TEST_F(Mpu6050FifoTest, BeginConfiguresAccelOnlyFifo) {
+    ASSERT_TRUE(fifo->begin(ACCEL_RANGE_8G, 100));
+
+    EXPECT_EQ(9, bus.registers[MPU6050_REG_SMPLRT_DIV]);  // 1 kHz / (1 + 9) = 100 Hz
+    EXPECT_EQ(ACCEL_RANGE_8G << 3, bus.registers[MPU6050_REG_ACCEL_CONFIG]);
+    EXPECT_EQ(MPU6050_FIFO_EN_ACCEL, bus.registers[MPU6050_REG_FIFO_EN]);
+    EXPECT_EQ(MPU6050_USER_CTRL_FIFO_EN, bus.registers[MPU6050_REG_USER_CTRL]);
+    EXPECT_EQ(10000u, fifo->getSamplePeriodUs());
+}
+
+TEST_F(Mpu6050FifoTest, SetSampleRateDiscardsQueuedSamples) {
+    ASSERT_TRUE(fifo->begin(ACCEL_RANGE_8G, 10));
+    bus.queueSample(0, 1, 0);
+    ASSERT_TRUE(fifo->setSampleRate(50));
+    EXPECT_EQ(19, bus.registers[MPU6050_REG_SMPLRT_DIV]);
+    EXPECT_EQ(20000u, fifo->getSamplePeriodUs());
+    EXPECT_TRUE(bus.fifo.empty());
+}
+
+TEST_F(Mpu6050FifoTest, CycleModeStandsByGyrosAndStopsFifo) {
+    ASSERT_TRUE(fifo->begin(ACCEL_RANGE_8G, 50));
+    ASSERT_TRUE(fifo->enterCycleMode(5));
+    EXPECT_TRUE(fifo->isCycleMode());
+    EXPECT_EQ(MPU6050_PWR_MGMT_1_CYCLE | MPU6050_PWR_MGMT_1_TEMP_DIS, bus.registers[MPU6050_REG_PWR_MGMT_1]);
+    EXPECT_EQ((CYCLE_WAKE_5HZ << 6) | MPU6050_PWR_MGMT_2_STBY_GYRO, bus.registers[MPU6050_REG_PWR_MGMT_2]);
+    EXPECT_EQ(0, bus.registers[MPU6050_REG_USER_CTRL]);
+    EXPECT_EQ(200000u, fifo->getSamplePeriodUs());
+
+    // Rates between the fixed wake rates round up
+    ASSERT_TRUE(fifo->enterCycleMode(10));
+    EXPECT_EQ(CYCLE_WAKE_20HZ << 6, bus.registers[MPU6050_REG_PWR_MGMT_2] & 0xC0);
+
+    // A rate change while cycling is applied on exit
+    ASSERT_TRUE(fifo->setSampleRate(100));
+    EXPECT_EQ(19, bus.registers[MPU6050_REG_SMPLRT_DIV]);
+    ASSERT_TRUE(fifo->exitCycleMode());
+    EXPECT_FALSE(fifo->isCycleMode());
+    EXPECT_EQ(MPU6050_PWR_MGMT_1_CLK_PLL_X, bus.registers[MPU6050_REG_PWR_MGMT_1]);
+    EXPECT_EQ(0, bus.registers[MPU6050_REG_PWR_MGMT_2]);
+    EXPECT_EQ(9, bus.registers[MPU6050_REG_SMPLRT_DIV]);
+    EXPECT_EQ(MPU6050_USER_CTRL_FIFO_EN, bus.registers[MPU6050_REG_USER_CTRL]);
+    EXPECT_EQ(10000u, fifo->getSamplePeriodUs());
+}
+
+TEST_F(Mpu6050FifoTest, ReadLatestConvertsDataRegisters) {
+    fifo->begin(ACCEL_RANGE_8G, 50);
+    uint8_t frame[6] = {0x00, 0x00, 0x10, 0x00, 0xF8, 0x00};  // 0, 4096, -2048
+    memcpy(bus.registers + MPU6050_REG_ACCEL_XOUT_H, frame, sizeof(frame));
+
+    AccelData sample;
+    ASSERT_TRUE(fifo->readLatest(sample));
+    EXPECT_TRUE(sample.valid);
+    EXPECT_NEAR(0.0, sample.x, 0.001);
+    EXPECT_NEAR(9.80665, sample.y, 0.001);
+    EXPECT_NEAR(-4.903, sample.z, 0.001);
+
+    bus.failReads = true;
+    EXPECT_FALSE(fifo->readLatest(sample));
+}
+
+TEST_F(Mpu6050FifoTest, BeginAddsGyroXToFrames) {
+    ASSERT_TRUE(fifo->begin(ACCEL_RANGE_8G, 50, true));
+    EXPECT_TRUE(fifo->hasGyroX());
+    EXPECT_EQ(MPU6050_FIFO_EN_ACCEL | MPU6050_FIFO_EN_GYRO_X, bus.registers[MPU6050_REG_FIFO_EN]);
+    EXPECT_EQ(0, bus.registers[MPU6050_REG_GYRO_CONFIG]);  // +/-250 deg/s
+
+    ASSERT_TRUE(fifo->begin(ACCEL_RANGE_8G, 50));
+    EXPECT_FALSE(fifo->hasGyroX());
+    EXPECT_EQ(MPU6050_FIFO_EN_ACCEL, bus.registers[MPU6050_REG_FIFO_EN]);
+}
+
+TEST_F(Mpu6050FifoTest, BeginFailsWithoutDevice) {
+    bus.registers[MPU6050_REG_WHO_AM_I] = 0;
+    EXPECT_FALSE(fifo->begin(ACCEL_RANGE_8G, 100));
+}
+
+// ============================================================================
+// Test: Burst reads
+// ============================================================================
+
+TEST_F(Mpu6050FifoTest, ReadsRawSamplesInOrder) {
+    fifo->begin(ACCEL_RANGE_8G, 100);
+    bus.queueSample(1, 4014, -2);
+    bus.queueSample(-300, 2000, 2000);
+
+    RawAccelSample samples[4];
+    size_t count = 0;
+    ASSERT_TRUE(fifo->readRaw(samples, 4, count));
+    ASSERT_EQ(2u, count);
+    EXPECT_EQ(1, samples[0].x);
+    EXPECT_EQ(4014, samples[0].y);
+    EXPECT_EQ(-2, samples[0].z);
+    EXPECT_EQ(-300, samples[1].x);
+    EXPECT_TRUE(bus.fifo.empty());
+}
+
+TEST_F(Mpu6050FifoTest, ReadBatchConvertsAndTimestamps) {
+    fifo->begin(ACCEL_RANGE_8G, 100);
+    bus.queueSample(0, 4096, 0);   // 1 g on Y: closed
+    bus.queueSample(0, 0, 4096);   // 1 g on Z: open
+    bus.queueSample(0, -2048, 0);
+
+    AccelData samples[8];
+    unsigned long times[8];
+    size_t count = 0;
+    ASSERT_TRUE(fifo->readBatch(samples, times, 8, 5000, count));
+    ASSERT_EQ(3u, count);
+
+    EXPECT_NEAR(9.80665, samples[0].y, 0.001);
+    EXPECT_NEAR(0.0, samples[0].z, 0.001);
+    EXPECT_NEAR(9.80665, samples[1].z, 0.001);
+    EXPECT_NEAR(-4.903, samples[2].y, 0.001);
+    EXPECT_TRUE(samples[2].valid);
+
+    EXPECT_EQ(4980u, times[0]);
+    EXPECT_EQ(4990u, times[1]);
+    EXPECT_EQ(5000u, times[2]);
+}
+
+TEST_F(Mpu6050FifoTest, LargeReadsAreSplitIntoBursts) {
+    fifo->begin(ACCEL_RANGE_8G, 200);
+    for (int i = 0; i < 50; i++) {
+        bus.queueSample(0, (int16_t)i, 0);
+    }
+    bus.transactions = 0;
+    bus.bytesTransferred = 0;
+
+    RawAccelSample samples[64];
+    size_t count = 0;
+    ASSERT_TRUE(fifo->readRaw(samples, 64, count));
+    ASSERT_EQ(50u, count);
+    for (int i = 0; i < 50; i++) {
+        EXPECT_EQ(i, samples[i].y);
+    }
+
+    // One count read plus ceil(50 / 20) bursts
+    EXPECT_EQ(4u, bus.transactions);
+    // Far below the 15 bytes per sample of a getEvent() read
+    EXPECT_LT(bus.bytesTransferred, 50u * 7);
+}
+
+TEST_F(Mpu6050FifoTest, RespectsMaxSamples) {
+    fifo->begin(ACCEL_RANGE_8G, 100);
+    for (int i = 0; i < 5; i++) {
+        bus.queueSample(0, (int16_t)i, 0);
+    }
+
+    RawAccelSample samples[3];
+    size_t count = 0;
+    ASSERT_TRUE(fifo->readRaw(samples, 3, count));
+    EXPECT_EQ(3u, count);
+    EXPECT_EQ(12u, bus.fifo.size());
+}
+
+TEST_F(Mpu6050FifoTest, OverflowResetsFifo) {
+    fifo->begin(ACCEL_RANGE_8G, 100);
+    for (int i = 0; i < 200; i++) {
+        bus.queueSample(0, 1, 0);
+    }
+
+    RawAccelSample samples[4];
+    size_t count = 99;
+    ASSERT_TRUE(fifo->readRaw(samples, 4, count));
+    EXPECT_EQ(0u, count);
+    EXPECT_EQ(1u, fifo->getOverflowCount());
+    EXPECT_TRUE(bus.fifo.empty());
+}
+
+TEST_F(Mpu6050FifoTest, ReportsBusErrors) {
+    fifo->begin(ACCEL_RANGE_8G, 100);
+    bus.queueSample(0, 1, 0);
+    bus.failReads = true;
+
+    AccelData samples[4];
+    unsigned long times[4];
+    size_t count = 0;
+    EXPECT_FALSE(fifo->readBatch(samples, times, 4, 1000, count));
+    EXPECT_EQ(0u, count);
+}
+
+TEST_F(Mpu6050FifoTest, ReadBatchReturnsGyroRates) {
+    fifo->begin(ACCEL_RANGE_8G, 50, true);
+    for (int i = 0; i < 40; i++) {
+        bus.queueGyroSample(0, 4096, (int16_t)i, (int16_t)(131 * i));
+    }
+    bus.transactions = 0;
+
+    AccelData samples[64];
+    float gyroRates[64];
+    unsigned long times[64];
+    size_t count = 0;
+    ASSERT_TRUE(fifo->readBatch(samples, times, 64, 5000, count, gyroRates));
+    ASSERT_EQ(40u, count);
+    for (int i = 0; i < 40; i++) {
+        EXPECT_NEAR(9.80665, samples[i].y, 0.001);
+        EXPECT_NEAR(i * 9.80665 / 4096, samples[i].z, 0.0001);
+        EXPECT_FLOAT_EQ((float)i, gyroRates[i]);
+    }
+    // 8-byte frames: 15 per 120-byte burst
+    EXPECT_EQ(4u, bus.transactions);
+    EXPECT_EQ(4220u, times[0]);
+}
+
+TEST_F(Mpu6050FifoTest, GyroRatesAreNanWithoutGyroFrames) {
+    fifo->begin(ACCEL_RANGE_8G, 50);
+    bus.queueSample(0, 4096, 0);
+
+    AccelData samples[4];
+    float gyroRates[4] = {0, 0, 0, 0};
+    unsigned long times[4];
+    size_t count = 0;
+    ASSERT_TRUE(fifo->readBatch(samples, times, 4, 1000, count, gyroRates));
+    ASSERT_EQ(1u, count);
+    EXPECT_TRUE(isnan(gyroRates[0]));
+}
+
+TEST_F(Mpu6050FifoTest, PartialFrameStaysQueued) {
+    fifo->begin(ACCEL_RANGE_8G, 50, true);
+    bus.queueGyroSample(0, 4096, 0, 0);
+    bus.queueSample(0, 2048, 0);  // 14 bytes: the second 8-byte frame is still being written
+
+    RawAccelSample samples[4];
+    size_t count = 99;
+    ASSERT_TRUE(fifo->readRaw(samples, 4, count));
+    EXPECT_EQ(1u, count);
+    EXPECT_EQ(4096, samples[0].y);
+    EXPECT_EQ(0u, fifo->getOverflowCount());
+    EXPECT_EQ(6u, bus.fifo.size());
+
+    // The rest of the frame arrives
+    bus.fifo.push_back(0);
+    bus.fifo.push_back(0);
+    ASSERT_TRUE(fifo->readRaw(samples, 4, count));
+    EXPECT_EQ(1u, count);
+    EXPECT_EQ(2048, samples[0].y);
+}
+
+TEST_F(Mpu6050FifoTest, BacklogTimestampsStayMonotonic) {
+    // After a loop stall: 50 frames queued, drained 32 at a time
+    fifo->begin(ACCEL_RANGE_8G, 100);
+    for (int i = 0; i < 50; i++) {
+        bus.queueSample(0, (int16_t)i, 0);
+    }
+
+    AccelData samples[32];
+    unsigned long times[64];
+    size_t first = 0;
+    ASSERT_TRUE(fifo->readBatch(samples, times, 32, 5000, first));
+    ASSERT_EQ(32u, first);
+    EXPECT_EQ(5000u - 490, times[0]);
+    EXPECT_EQ(5000u - 180, times[31]);
+
+    // Next drain 20 ms later, two more frames in
+    bus.queueSample(0, 50, 0);
+    bus.queueSample(0, 51, 0);
+    size_t second = 0;
+    ASSERT_TRUE(fifo->readBatch(samples, times + first, 32, 5020, second));
+    ASSERT_EQ(20u, second);
+    EXPECT_EQ(5020u, times[first + second - 1]);
+    for (size_t i = 1; i < first + second; i++) {
+        EXPECT_EQ(times[i - 1] + 10, times[i]) << "sample " << i;
+    }
+}
+
+// ============================================================================
+// Test: Conversion helpers
+// ============================================================================
+
+TEST_F(Mpu6050FifoTest, CountsPerGMatchesRange) {
+    EXPECT_FLOAT_EQ(16384.0f, Mpu6050Fifo::countsPerG(ACCEL_RANGE_2G));
+    EXPECT_FLOAT_EQ(8192.0f, Mpu6050Fifo::countsPerG(ACCEL_RANGE_4G));
+    EXPECT_FLOAT_EQ(4096.0f, Mpu6050Fifo::countsPerG(ACCEL_RANGE_8G));
+    EXPECT_FLOAT_EQ(2048.0f, Mpu6050Fifo::countsPerG(ACCEL_RANGE_16G));
+}
+
+TEST_F(Mpu6050FifoTest, DecodesBigEndianFrames) {
+    uint8_t frame[6] = {0x12, 0x34, 0xFF, 0xFE, 0x80, 0x00};
+    RawAccelSample sample;
+    Mpu6050Fifo::decodeFrame(frame, sample);
+    EXPECT_EQ(0x1234, sample.x);
+    EXPECT_EQ(-2, sample.y);
+    EXPECT_EQ(-32768, sample.z);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <math.h>
+#include <vector>
+#include "PositionClassifier.h"
+#include "DoorTraceFixtures.h"
+
+static bool maskBit(const std::vector<uint32_t>& mask, size_t i) {
+    return (mask[i / POSITION_MASK_BITS] >> (i % POSITION_MASK_BITS)) & 1u;
+}
+
+// Samples spread over and around both positions, including exact tolerance
+// boundaries and a NaN
+static void makeSamples(size_t n, uint32_t seed, std::vector<float>& y, std::vector<float>& z) {
+    TraceNoise rng(seed);
+    y.resize(n);
+    z.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        y[i] = (float)(rng.next() % 2400) / 100.0f - 6.0f;
+        z[i] = (float)(rng.next() % 2400) / 100.0f - 6.0f;
+    }
+    if (n > 3) {
+        y[0] = 9.8f + 1.0f; z[0] = 0.0f;   // on the closed boundary
+        y[1] = 0.0f; z[1] = 9.8f - 1.0f;   // on the open boundary
+        y[2] = NAN; z[2] = 0.0f;
+        y[3] = 9.8f; z[3] = 0.0f;
+    }
+}
+
+static void expectMatchesScalarHelpers(size_t n, const DoorMonitorConfig& config, uint32_t seed) {
+    std::vector<float> y, z;
+    makeSamples(n, seed, y, z);
+    size_t words = positionMaskWords(n) + 1;
+    std::vector<uint32_t> closed(words, 0xDEADBEEF), open(words, 0xDEADBEEF), intermediate(words, 0xDEADBEEF);
+
+    classifyPositions(y.data(), z.data(), n, config, closed.data(), open.data(), intermediate.data());
+
+    for (size_t i = 0; i < n; i++) {
+        bool isClosed = DoorMonitor::isInClosedPosition(y[i], z[i], config.closedPositionY,
+                                                        config.closedPositionZ, config.positionTolerance);
+        bool isOpen = !isClosed && DoorMonitor::isInOpenPosition(y[i], z[i], config.openPositionY,
+                                                                 config.openPositionZ, config.positionTolerance);
+        ASSERT_EQ(isClosed, maskBit(closed, i)) << "sample " << i << " of " << n;
+        ASSERT_EQ(isOpen, maskBit(open, i)) << "sample " << i << " of " << n;
+        ASSERT_EQ(!isClosed && !isOpen, maskBit(intermediate, i)) << "sample " << i << " of " << n;
+    }
+    // Bits past n are clear and words past the masks are untouched
+    for (size_t i = n; i < positionMaskWords(n) * POSITION_MASK_BITS; i++) {
+        EXPECT_FALSE(maskBit(closed, i) || maskBit(open, i) || maskBit(intermediate, i));
+    }
+    EXPECT_EQ(0xDEADBEEFu, intermediate[words - 1]);
+}
+
+// ============================================================================
+// Test: Equivalence with the scalar helpers
+// ============================================================================
+
+TEST(PositionClassifierTest, MatchesScalarHelpersForAllBlockSizes) {
+    for (size_t n = 0; n <= 70; n++) {
+        expectMatchesScalarHelpers(n, DEFAULT_CONFIG, (uint32_t)n + 1);
+    }
+    expectMatchesScalarHelpers(1000, DEFAULT_CONFIG, 99);
+}
+
+TEST(PositionClassifierTest, MatchesScalarHelpersAcrossTolerances) {
+    DoorMonitorConfig config = DEFAULT_CONFIG;
+    for (int t = 0; t <= 12; t++) {
+        config.positionTolerance = 0.25f * t;  // up to overlapping closed/open windows
+        expectMatchesScalarHelpers(257, config, 7 + t);
+    }
+}
+
+TEST(PositionClassifierTest, ScalarFallbackMatchesSelectedImplementation) {
+    std::vector<float> y, z;
+    makeSamples(333, 3, y, z);
+    size_t words = positionMaskWords(333);
+    std::vector<uint32_t> closed(words), open(words), scalarClosed(words), scalarOpen(words);
+
+    classifyPositions(y.data(), z.data(), 333, DEFAULT_CONFIG, closed.data(), open.data(), NULL);
+    classifyPositionsScalar(y.data(), z.data(), 333, DEFAULT_CONFIG, scalarClosed.data(), scalarOpen.data(), NULL);
+
+    EXPECT_EQ(scalarClosed, closed) << positionClassifierImpl();
+    EXPECT_EQ(scalarOpen, open) << positionClassifierImpl();
+}
+
+// ============================================================================
+// Test: Counting
+// ============================================================================
+
+TEST(PositionClassifierTest, CountsPartitionTheSamples) {
+    std::vector<float> y, z;
+    makeSamples(500, 11, y, z);
+    size_t words = positionMaskWords(500);
+    std::vector<uint32_t> closed(words), open(words), intermediate(words);
+    classifyPositions(y.data(), z.data(), 500, DEFAULT_CONFIG, closed.data(), open.data(), intermediate.data());
+
+    size_t closedCount = countPositions(closed.data(), 500);
+    size_t openCount = countPositions(open.data(), 500);
+    EXPECT_GT(closedCount, 0u);
+    EXPECT_GT(openCount, 0u);
+    EXPECT_EQ(500u, closedCount + openCount + countPositions(intermediate.data(), 500));
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "PulseScheduler.h"
+
+// All tests drive the scheduler with a fake clock
+
+TEST(PulseSchedulerTest, IdleByDefault) {
+    PulseScheduler pulse(500, 1000);
+    EXPECT_FALSE(pulse.isActive());
+    EXPECT_FALSE(pulse.update(1000));
+    EXPECT_EQ(0u, pulse.getRemaining(1000));
+}
+
+TEST(PulseSchedulerTest, PulseLastsConfiguredDuration) {
+    PulseScheduler pulse(500, 1000);
+    EXPECT_TRUE(pulse.request(1000));
+    EXPECT_TRUE(pulse.isActive());
+    EXPECT_TRUE(pulse.update(1000));
+    EXPECT_TRUE(pulse.update(1499));
+    EXPECT_EQ(1u, pulse.getRemaining(1499));
+    EXPECT_FALSE(pulse.update(1500));
+    EXPECT_FALSE(pulse.isActive());
+    EXPECT_EQ(1u, pulse.getPulseCount());
+}
+
+TEST(PulseSchedulerTest, CoalescesRequestsDuringPulse) {
+    PulseScheduler pulse(500, 1000);
+    EXPECT_TRUE(pulse.request(1000));
+    EXPECT_FALSE(pulse.request(1100));
+    EXPECT_FALSE(pulse.request(1200));
+    EXPECT_EQ(2u, pulse.getCoalescedCount());
+
+    // The coalesced requests do not extend the pulse
+    EXPECT_FALSE(pulse.update(1500));
+}
+
+TEST(PulseSchedulerTest, CoalescesRequestsDuringCooldown) {
+    PulseScheduler pulse(500, 1000);
+    pulse.request(1000);
+    pulse.update(1600);
+    EXPECT_TRUE(pulse.isBusy());
+    EXPECT_FALSE(pulse.request(1900));
+    EXPECT_TRUE(pulse.request(2500));
+    EXPECT_EQ(2u, pulse.getPulseCount());
+}
+
+TEST(PulseSchedulerTest, RequestEndsExpiredPulseWithoutUpdate) {
+    PulseScheduler pulse(500, 0);
+    pulse.request(1000);
+    // update() was never called; the old pulse has long expired
+    EXPECT_TRUE(pulse.request(5000));
+    EXPECT_TRUE(pulse.update(5100));
+}
+
+TEST(PulseSchedulerTest, HandlesMillisWraparound) {
+    PulseScheduler pulse(500, 0);
+    unsigned long start = (unsigned long)-200;
+    EXPECT_TRUE(pulse.request(start));
+    EXPECT_TRUE(pulse.update(start + 400));  // wrapped past zero
+    EXPECT_FALSE(pulse.update(start + 500));
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "SampleFilter.h"
+#include "ConfigSweep.h"
+#include "DoorTraceFixtures.h"
+
+static std::vector<float> randomSignal(size_t n, uint32_t seed) {
+    TraceNoise noise(seed);
+    std::vector<float> signal;
+    for (size_t i = 0; i < n; i++) {
+        signal.push_back((float)noise.uniform(500) / 50.0f);
+    }
+    return signal;
+}
+
+static LabeledTrace toFilteredTrace(const std::vector<TraceSample>& raw, SampleFilterKind kind) {
+    LabeledTrace trace;
+    for (size_t i = 0; i < raw.size(); i++) {
+        trace.samples.push_back(traceSampleToAccel(raw[i]));
+        trace.times.push_back(raw[i].time);
+    }
+    SelectableSampleFilter filter(kind);
+    filter.applyBatch(&trace.samples[0], trace.samples.size());
+    return trace;
+}
+
+// ============================================================================
+// Test: Kernels
+// ============================================================================
+
+TEST(SampleFilterTest, KernelsStartAtFirstSample) {
+    MovingAverageKernel<4> average;
+    ExponentialKernel<2> exponential;
+    MedianKernel<5> median;
+    EXPECT_FLOAT_EQ(9.8f, average.apply(9.8f));
+    EXPECT_FLOAT_EQ(9.8f, exponential.apply(9.8f));
+    EXPECT_FLOAT_EQ(9.8f, median.apply(9.8f));
+    EXPECT_FLOAT_EQ(9.8f, average.apply(9.8f));
+    EXPECT_FLOAT_EQ(9.8f, median.apply(9.8f));
+}
+
+TEST(SampleFilterTest, MovingAverageMatchesWindowMean) {
+    MovingAverageKernel<4> kernel;
+    std::vector<float> signal = randomSignal(1000, 3);
+    std::vector<float> history(4, signal[0]);
+    for (size_t i = 0; i < signal.size(); i++) {
+        float out = kernel.apply(signal[i]);
+        history.erase(history.begin());
+        history.push_back(signal[i]);
+        float mean = (history[0] + history[1] + history[2] + history[3]) / 4;
+        ASSERT_NEAR(mean, out, 1e-4) << "sample " << i;
+    }
+}
+
+TEST(SampleFilterTest, ExponentialStepResponse) {
+    ExponentialKernel<2> kernel;
+    kernel.apply(0.0f);
+    EXPECT_FLOAT_EQ(2.5f, kernel.apply(10.0f));
+    EXPECT_FLOAT_EQ(4.375f, kernel.apply(10.0f));
+    kernel.reset();
+    EXPECT_FLOAT_EQ(10.0f, kernel.apply(10.0f));
+}
+
+template <size_t N>
+static void expectMedianMatchesSort(uint32_t seed) {
+    MedianKernel<N> kernel;
+    std::vector<float> signal = randomSignal(2000, seed);
+    // Repeated values exercise the search for the outgoing sample
+    for (size_t i = 0; i < signal.size(); i += 7) {
+        signal[i] = 1.0f;
+    }
+    std::vector<float> history(N, signal[0]);
+    for (size_t i = 0; i < signal.size(); i++) {
+        float out = kernel.apply(signal[i]);
+        history.erase(history.begin());
+        history.push_back(signal[i]);
+        std::vector<float> sorted(history);
+        std::sort(sorted.begin(), sorted.end());
+        ASSERT_FLOAT_EQ(sorted[N / 2], out) << "N=" << N << " sample " << i;
+    }
+}
+
+TEST(SampleFilterTest, MedianMatchesSortedWindow) {
+    expectMedianMatchesSort<3>(1);
+    expectMedianMatchesSort<5>(2);
+    expectMedianMatchesSort<9>(3);
+}
+
+TEST(SampleFilterTest, MedianRemovesShortSpikes) {
+    MedianKernel<5> kernel;
+    const float input[] = {9.8f, 9.8f, 30.0f, 9.8f, -5.0f, -6.0f, 9.8f, 9.8f, 9.8f};
+    for (size_t i = 0; i < sizeof(input) / sizeof(input[0]); i++) {
+        EXPECT_FLOAT_EQ(9.8f, kernel.apply(input[i])) << "sample " << i;
+    }
+}
+
+// ============================================================================
+// Test: Axis stage
+// ============================================================================
+
+TEST(SampleFilterTest, FiltersYAndZOnly) {
+    AccelFilter<ExponentialKernel<1> > filter;
+    AccelData samples[2] = {{1.0f, 0.0f, 0.0f, true}, {5.0f, 4.0f, 8.0f, true}};
+    filter.applyBatch(samples, 2);
+    EXPECT_FLOAT_EQ(5.0f, samples[1].x);
+    EXPECT_FLOAT_EQ(2.0f, samples[1].y);
+    EXPECT_FLOAT_EQ(4.0f, samples[1].z);
+}
+
+TEST(SampleFilterTest, InvalidSampleResetsHistory) {
+    AccelFilter<MedianKernel<3> > filter;
+    AccelData samples[4] = {{0, 9.8f, 0, true}, {0, 9.8f, 0, true}, {0, 0, 0, false}, {0, 0.5f, 9.8f, true}};
+    filter.applyBatch(samples, 4);
+    EXPECT_FALSE(samples[2].valid);
+    EXPECT_FLOAT_EQ(0.0f, samples[2].y);
+    // The first sample after the dropout is not mixed with older ones
+    EXPECT_FLOAT_EQ(0.5f, samples[3].y);
+    EXPECT_FLOAT_EQ(9.8f, samples[3].z);
+}
+
+TEST(SampleFilterTest, ParsesFilterNames) {
+    for (int i = 0; i < SAMPLE_FILTER_KIND_COUNT; i++) {
+        SampleFilterKind kind;
+        ASSERT_TRUE(sampleFilterFromName(sampleFilterName((SampleFilterKind)i), kind));
+        EXPECT_EQ(i, kind);
+    }
+    SampleFilterKind kind;
+    EXPECT_FALSE(sampleFilterFromName("median", kind));
+    EXPECT_FALSE(sampleFilterFromName("median55", kind));
+}
+
+// ============================================================================
+// Test: False transitions on spiked traces
+// ============================================================================
+
+TEST(SampleFilterTest, MedianRemovesSpikeTransitions) {
+    for (uint32_t seed = 1; seed <= 3; seed++) {
+        std::vector<TraceSample> clean = doorCycleTrace(seed);
+        std::vector<TraceSample> spiked = clean;
+        injectSpikes(spiked, 50, 1200, seed * 7);
+
+        // Label with what DoorMonitor sees on the clean trace
+        LabeledTrace reference = toFilteredTrace(clean, SAMPLE_FILTER_NONE);
+        std::vector<DoorTransition> transitions;
+        SweepScore ignored;
+        scoreConfig(DEFAULT_CONFIG, reference, SweepOptions(), transitions, ignored);
+        ASSERT_GT(transitions.size(), 5u);
+        for (size_t i = 0; i < transitions.size(); i++) {
+            TraceLabel label = {transitions[i].time, transitions[i].to};
+            reference.labels.push_back(label);
+        }
+
+        LabeledTrace raw = toFilteredTrace(spiked, SAMPLE_FILTER_NONE);
+        LabeledTrace median = toFilteredTrace(spiked, SAMPLE_FILTER_MEDIAN5);
+        raw.labels = median.labels = reference.labels;
+        SweepScore rawScore;
+        SweepScore medianScore;
+        scoreConfig(DEFAULT_CONFIG, raw, SweepOptions(), transitions, rawScore);
+        scoreConfig(DEFAULT_CONFIG, median, SweepOptions(), transitions, medianScore);
+
+        EXPECT_GT(rawScore.detected, rawScore.matched) << "seed " << seed;
+        EXPECT_EQ(medianScore.expected, medianScore.matched) << "seed " << seed;
+        EXPECT_EQ(medianScore.matched, medianScore.detected) << "seed " << seed;
+    }
+}
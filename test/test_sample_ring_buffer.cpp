@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "SampleRingBuffer.h"
+
+// ============================================================================
+// Test: Single-threaded behaviour
+// ============================================================================
+
+TEST(SampleRingBufferTest, StartsEmpty) {
+    SampleRingBuffer buffer;
+    TimedSample sample;
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(0u, buffer.size());
+    EXPECT_FALSE(buffer.pop(sample));
+}
+
+TEST(SampleRingBufferTest, PopsInFifoOrder) {
+    SampleRingBuffer buffer;
+    for (unsigned long i = 0; i < 10; i++) {
+        TimedSample sample;
+        sample.accel.x = 0;
+        sample.accel.y = i * 0.5f;
+        sample.accel.z = 0;
+        sample.accel.valid = true;
+        sample.time = 1000 + i;
+        EXPECT_TRUE(buffer.push(sample));
+    }
+    EXPECT_EQ(10u, buffer.size());
+
+    for (unsigned long i = 0; i < 10; i++) {
+        TimedSample sample;
+        ASSERT_TRUE(buffer.pop(sample));
+        EXPECT_EQ(1000 + i, sample.time);
+        EXPECT_FLOAT_EQ(i * 0.5f, sample.accel.y);
+    }
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(SampleRingBufferTest, RejectsPushWhenFull) {
+    SpscRingBuffer<int, 4> buffer;
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(buffer.push(i));
+    }
+    EXPECT_FALSE(buffer.push(99));
+    EXPECT_EQ(1u, buffer.getDroppedCount());
+
+    int value;
+    ASSERT_TRUE(buffer.pop(value));
+    EXPECT_EQ(0, value);
+    EXPECT_TRUE(buffer.push(4));
+}
+
+TEST(SampleRingBufferTest, WrapsAround) {
+    SpscRingBuffer<int, 4> buffer;
+    int value;
+    for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(buffer.push(i));
+        ASSERT_TRUE(buffer.pop(value));
+        EXPECT_EQ(i, value);
+    }
+    EXPECT_EQ(0u, buffer.getDroppedCount());
+}
+
+TEST(SampleRingBufferTest, PopBatchDrainsUpToLimit) {
+    SpscRingBuffer<int, 8> buffer;
+    for (int i = 0; i < 6; i++) {
+        buffer.push(i);
+    }
+
+    int items[4];
+    ASSERT_EQ(4u, buffer.popBatch(items, 4));
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(i, items[i]);
+    }
+    ASSERT_EQ(2u, buffer.popBatch(items, 4));
+    EXPECT_EQ(4, items[0]);
+    EXPECT_EQ(5, items[1]);
+    EXPECT_EQ(0u, buffer.popBatch(items, 4));
+}
+
+// ============================================================================
+// Test: Producer/consumer stress
+// ============================================================================
+
+TEST(SampleRingBufferTest, ProducerConsumerThreadsLoseNothing) {
+    static SampleRingBuffer buffer;
+    const unsigned long sampleCount = 1000000;
+
+    std::thread producer([&]() {
+        for (unsigned long i = 0; i < sampleCount; i++) {
+            TimedSample sample;
+            sample.accel.x = 0;
+            sample.accel.y = (float)(i & 0xFFFF);
+            sample.accel.z = 0;
+            sample.accel.valid = true;
+            sample.time = i;
+            while (!buffer.push(sample)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    unsigned long expected = 0;
+    bool inOrder = true;
+    TimedSample batch[16];
+    while (expected < sampleCount) {
+        size_t count = buffer.popBatch(batch, 16);
+        if (count == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (batch[i].time != expected || batch[i].accel.y != (float)(expected & 0xFFFF)) {
+                inOrder = false;
+            }
+            expected++;
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(inOrder);
+    EXPECT_EQ(sampleCount, expected);
+    EXPECT_TRUE(buffer.empty());
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "SamplingScheduler.h"
+
+// All tests drive the scheduler with a fake clock
+
+TEST(SamplingSchedulerTest, StartsActive) {
+    SamplingScheduler scheduler(5, 50, 30000);
+    EXPECT_EQ(SAMPLING_ACTIVE, scheduler.getMode());
+    EXPECT_EQ(50u, scheduler.getRateHz());
+    EXPECT_EQ(0u, scheduler.getSwitchCount());
+}
+
+TEST(SamplingSchedulerTest, DropsToIdleAfterStableRest) {
+    SamplingScheduler scheduler(5, 50, 30000);
+    EXPECT_EQ(SAMPLING_ACTIVE, scheduler.update(true, 1000));
+    EXPECT_EQ(SAMPLING_ACTIVE, scheduler.update(true, 30999));
+    EXPECT_EQ(SAMPLING_IDLE, scheduler.update(true, 31000));
+    EXPECT_EQ(5u, scheduler.getRateHz());
+    EXPECT_EQ(1u, scheduler.getSwitchCount());
+}
+
+TEST(SamplingSchedulerTest, MotionRestartsRestPeriod) {
+    SamplingScheduler scheduler(5, 50, 30000);
+    scheduler.update(true, 0);
+    scheduler.update(false, 20000);   // door left its position
+    EXPECT_EQ(SAMPLING_ACTIVE, scheduler.update(true, 35000));
+    EXPECT_EQ(SAMPLING_ACTIVE, scheduler.update(true, 64999));
+    EXPECT_EQ(SAMPLING_IDLE, scheduler.update(true, 65000));
+}
+
+TEST(SamplingSchedulerTest, WakesImmediatelyOnMotion) {
+    SamplingScheduler scheduler(5, 50, 30000);
+    scheduler.update(true, 0);
+    ASSERT_EQ(SAMPLING_IDLE, scheduler.update(true, 30000));
+    EXPECT_EQ(SAMPLING_ACTIVE, scheduler.update(false, 30200));
+    EXPECT_EQ(50u, scheduler.getRateHz());
+    EXPECT_EQ(2u, scheduler.getSwitchCount());
+}
+
+TEST(SamplingSchedulerTest, BoostWakesAndHoldsActive) {
+    SamplingScheduler scheduler(5, 50, 30000);
+    scheduler.update(true, 0);
+    ASSERT_EQ(SAMPLING_IDLE, scheduler.update(true, 30000));
+
+    // A trigger wakes the sensor before the door starts to move, and the
+    // idle delay starts over even if the door never leaves its position
+    scheduler.boost(40000);
+    EXPECT_EQ(SAMPLING_ACTIVE, scheduler.getMode());
+    EXPECT_EQ(SAMPLING_ACTIVE, scheduler.update(true, 40100));
+    EXPECT_EQ(SAMPLING_ACTIVE, scheduler.update(true, 69999));
+    EXPECT_EQ(SAMPLING_IDLE, scheduler.update(true, 70000));
+}
+
+TEST(SamplingSchedulerTest, AccumulatesIdleTime) {
+    SamplingScheduler scheduler(5, 50, 1000);
+    scheduler.update(true, 0);
+    scheduler.update(true, 1000);      // idle from 1000
+    EXPECT_EQ(500u, scheduler.getIdleTime(1500));
+    scheduler.update(false, 5000);     // active from 5000
+    scheduler.update(true, 6000);
+    scheduler.update(true, 7000);      // idle again from 7000
+    EXPECT_EQ(4000u + 2000u, scheduler.getIdleTime(9000));
+}
+
+TEST(SamplingSchedulerTest, HandlesMillisWraparound) {
+    SamplingScheduler scheduler(5, 50, 30000);
+    unsigned long start = (unsigned long)-10000;
+    scheduler.update(true, start);   // wraps past zero below
+    EXPECT_EQ(SAMPLING_ACTIVE, scheduler.update(true, start + 29999));
+    EXPECT_EQ(SAMPLING_IDLE, scheduler.update(true, start + 30000));
+}
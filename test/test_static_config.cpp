@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "DoorMonitorImpl.h"
+#include "DoorStaticConfig.h"
+#include "StatusJson.h"
+#include "DoorTraceFixtures.h"
+
+typedef DoorMonitorT<float, DefaultStaticConfig> StaticDoorMonitor;
+
+// Stop timeout long enough for the stall check to matter
+template <unsigned long StallTimeout>
+struct SlowStopConfig : public DefaultStaticConfig {
+    static constexpr unsigned long stopTimeout = 10000;
+    static constexpr unsigned long stallTimeout = StallTimeout;
+};
+
+// Runs both monitors over the trace and checks every sample gives the same
+// state and direction
+template <typename A, typename B>
+static void expectSameStates(A& a, B& b, const std::vector<TraceSample>& trace) {
+    AccelData first = traceSampleToAccel(trace[0]);
+    a.initialize(first.y, first.z, trace[0].time);
+    b.initialize(first.y, first.z, trace[0].time);
+    for (size_t i = 1; i < trace.size(); i++) {
+        AccelData sample = traceSampleToAccel(trace[i]);
+        ASSERT_EQ(a.updateState(sample, trace[i].time), b.updateState(sample, trace[i].time)) << "sample " << i;
+        ASSERT_EQ(a.getLastMovementDirection(), b.getLastMovementDirection()) << "sample " << i;
+    }
+}
+
+// ============================================================================
+// Test: Same behaviour as the runtime config
+// ============================================================================
+
+TEST(StaticConfigTest, ReportsCompiledValues) {
+    StaticDoorMonitor monitor;
+    DoorMonitorConfig config = monitor.getConfig();
+    EXPECT_EQ(DEFAULT_CONFIG.accelThreshold, config.accelThreshold);
+    EXPECT_EQ(DEFAULT_CONFIG.stopTimeout, config.stopTimeout);
+    EXPECT_EQ(DEFAULT_CONFIG.maxOpenTime, config.maxOpenTime);
+    EXPECT_EQ(DEFAULT_CONFIG.maxCloseTime, config.maxCloseTime);
+    EXPECT_EQ(DEFAULT_CONFIG.stallThreshold, config.stallThreshold);
+    EXPECT_EQ(DEFAULT_CONFIG.stallTimeout, config.stallTimeout);
+    EXPECT_EQ(DEFAULT_CONFIG.closedPositionY, config.closedPositionY);
+    EXPECT_EQ(DEFAULT_CONFIG.closedPositionZ, config.closedPositionZ);
+    EXPECT_EQ(DEFAULT_CONFIG.openPositionY, config.openPositionY);
+    EXPECT_EQ(DEFAULT_CONFIG.openPositionZ, config.openPositionZ);
+    EXPECT_EQ(DEFAULT_CONFIG.positionTolerance, config.positionTolerance);
+}
+
+TEST(StaticConfigTest, MatchesRuntimeMonitorOnCycles) {
+    for (uint32_t seed = 1; seed <= 4; seed++) {
+        DoorMonitor runtime;
+        StaticDoorMonitor fixed;
+        expectSameStates(runtime, fixed, doorCycleTrace(seed));
+    }
+}
+
+TEST(StaticConfigTest, MatchesRuntimeMonitorOnRandomTraces) {
+    for (uint32_t seed = 1; seed <= 4; seed++) {
+        DoorMonitor runtime;
+        StaticDoorMonitor fixed;
+        runtime.setArrivalConfig(DEFAULT_ARRIVAL_CONFIG);
+        fixed.setArrivalConfig(DEFAULT_ARRIVAL_CONFIG);
+        expectSameStates(runtime, fixed, randomDoorTrace(200, seed));
+    }
+}
+
+TEST(StaticConfigTest, WorksWithListenersAndStatusJson) {
+    DoorMonitor runtime;
+    StaticDoorMonitor fixed;
+    size_t runtimeTransitions = 0;
+    size_t staticTransitions = 0;
+    DoorTransitionListener count = [](void* context, const DoorTransition&, DoorState) {
+        (*static_cast<size_t*>(context))++;
+    };
+    runtime.addTransitionListener(count, &runtimeTransitions);
+    fixed.addTransitionListener(count, &staticTransitions);
+
+    std::vector<TraceSample> trace = doorCycleTrace(2);
+    char runtimeJson[STATUS_JSON_BUFFER_SIZE];
+    char staticJson[STATUS_JSON_BUFFER_SIZE];
+    runtime.initialize(9.8f, 0.0f, trace[0].time);
+    fixed.initialize(9.8f, 0.0f, trace[0].time);
+    for (size_t i = 0; i < trace.size(); i++) {
+        AccelData sample = traceSampleToAccel(trace[i]);
+        runtime.updateState(sample, trace[i].time);
+        fixed.updateState(sample, trace[i].time);
+        size_t a = writeStatusJson(runtimeJson, sizeof(runtimeJson), runtime, sample);
+        size_t b = writeStatusJson(staticJson, sizeof(staticJson), fixed, sample);
+        ASSERT_EQ(std::string(runtimeJson, a), std::string(staticJson, b)) << "sample " << i;
+    }
+    EXPECT_GT(staticTransitions, 0u);
+    EXPECT_EQ(runtimeTransitions, staticTransitions);
+}
+
+// ============================================================================
+// Test: Disabled checks
+// ============================================================================
+
+TEST(StaticConfigTest, StallCheckCanBeCompiledOut) {
+    DoorMonitorT<float, SlowStopConfig<3000> > stalling;
+    DoorMonitorT<float, SlowStopConfig<DOOR_CHECK_DISABLED> > noStall;
+    stalling.initialize(9.8f, 0.0f, 0);
+    noStall.initialize(9.8f, 0.0f, 0);
+
+    // One jolt, then the door hangs still part way
+    AccelData jolt = {0.0f, 8.0f, 4.0f, true};
+    EXPECT_EQ(DOOR_OPENING, stalling.updateState(jolt, 100));
+    EXPECT_EQ(DOOR_OPENING, noStall.updateState(jolt, 100));
+    for (unsigned long t = 200; t <= 9000; t += 100) {
+        stalling.updateState(jolt, t);
+        noStall.updateState(jolt, t);
+    }
+    EXPECT_EQ(DOOR_ERROR_STALLED, stalling.getState());
+    EXPECT_EQ(DOOR_OPENING, noStall.getState());
+    for (unsigned long t = 9100; t <= 10200; t += 100) {
+        noStall.updateState(jolt, t);
+    }
+    EXPECT_EQ(DOOR_STOPPED, noStall.getState());
+}
+
+TEST(StaticConfigTest, DisabledCheckMatchesRuntimeDisabledCheck) {
+    DoorMonitorConfig config = DEFAULT_CONFIG;
+    config.stopTimeout = 10000;
+    config.stallTimeout = DOOR_CHECK_DISABLED;
+    for (uint32_t seed = 1; seed <= 4; seed++) {
+        DoorMonitor runtime(config);
+        DoorMonitorT<float, SlowStopConfig<DOOR_CHECK_DISABLED> > fixed;
+        expectSameStates(runtime, fixed, randomDoorTrace(200, seed));
+    }
+}
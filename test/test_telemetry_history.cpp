@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "TelemetryHistory.h"
+#include "StatusJson.h"
+
+// ============================================================================
+// Test: Aggregation
+// ============================================================================
+
+TEST(TelemetryHistoryTest, EmptyUntilFirstPeriodCloses) {
+    TelemetryHistory history;
+    for (uint8_t t = 0; t < TELEMETRY_TIER_COUNT; t++) {
+        EXPECT_EQ(0u, history.getBucketCount(t));
+        EXPECT_EQ(0u, history.getEndTime(t));
+    }
+    history.add(100, 1.0f, 2.0f);
+    history.add(900, 1.0f, 2.0f);
+    EXPECT_EQ(0u, history.getBucketCount(0));
+}
+
+TEST(TelemetryHistoryTest, BucketHoldsMinMaxMean) {
+    TelemetryHistory history;
+    history.add(5000, 9.0f, -1.5f);
+    history.add(5300, 9.5f, -0.5f);
+    history.add(5600, 10.0f, 0.5f);
+    history.add(6000, 0.0f, 0.0f);  // opens the next second
+
+    ASSERT_EQ(1u, history.getBucketCount(0));
+    EXPECT_EQ(6000u, history.getEndTime(0));
+    const TelemetryBucket& b = history.getBucket(0, 0);
+    EXPECT_FALSE(b.isEmpty());
+    EXPECT_EQ(900, b.minY);
+    EXPECT_EQ(1000, b.maxY);
+    EXPECT_EQ(950, b.meanY);
+    EXPECT_EQ(-150, b.minZ);
+    EXPECT_EQ(50, b.maxZ);
+    EXPECT_EQ(-50, b.meanZ);
+}
+
+TEST(TelemetryHistoryTest, CoarserTiersSeeEverySample) {
+    TelemetryHistory history;
+    // 10 Hz for just over two minutes, accelY ramping once per second
+    for (unsigned long t = 0; t <= 120000; t += 100) {
+        history.add(t, (float)(t / 1000), 9.8f);
+    }
+
+    ASSERT_EQ(120u, history.getBucketCount(0));
+    EXPECT_EQ(0, history.getBucket(0, 0).meanY);
+    EXPECT_EQ(11900, history.getBucket(0, 119).meanY);
+
+    ASSERT_EQ(2u, history.getBucketCount(1));
+    EXPECT_EQ(120000u, history.getEndTime(1));
+    const TelemetryBucket& first = history.getBucket(1, 0);
+    EXPECT_EQ(0, first.minY);
+    EXPECT_EQ(5900, first.maxY);
+    EXPECT_EQ(2950, first.meanY);
+    EXPECT_EQ(980, first.meanZ);
+    EXPECT_EQ(6000, history.getBucket(1, 1).minY);
+
+    EXPECT_EQ(0u, history.getBucketCount(2));
+}
+
+TEST(TelemetryHistoryTest, ClampsOutOfRangeValues) {
+    TelemetryHistory history;
+    history.add(0, 1000.0f, -1000.0f);
+    history.add(1000, 0.0f, 0.0f);
+    const TelemetryBucket& b = history.getBucket(0, 0);
+    EXPECT_EQ(32767, b.maxY);
+    EXPECT_EQ(-32767, b.minZ);
+    EXPECT_FALSE(b.isEmpty());
+}
+
+// ============================================================================
+// Test: Gaps and ring wrap
+// ============================================================================
+
+TEST(TelemetryHistoryTest, GapsBecomeEmptyBuckets) {
+    TelemetryHistory history;
+    history.add(1500, 1.0f, 1.0f);
+    history.add(4200, 2.0f, 2.0f);  // nothing during seconds 2 and 3
+    history.add(5000, 3.0f, 3.0f);
+
+    ASSERT_EQ(4u, history.getBucketCount(0));
+    EXPECT_EQ(5000u, history.getEndTime(0));
+    EXPECT_EQ(100, history.getBucket(0, 0).meanY);
+    EXPECT_TRUE(history.getBucket(0, 1).isEmpty());
+    EXPECT_TRUE(history.getBucket(0, 2).isEmpty());
+    EXPECT_EQ(200, history.getBucket(0, 3).meanY);
+}
+
+TEST(TelemetryHistoryTest, RingKeepsNewestBuckets) {
+    TelemetryHistory history;
+    for (unsigned long s = 0; s <= 300; s++) {
+        history.add(s * 1000, (float)s / 100.0f, 0.0f);
+    }
+    ASSERT_EQ((size_t)TELEMETRY_TIER_BUCKETS, history.getBucketCount(0));
+    EXPECT_EQ(300000u, history.getEndTime(0));
+    EXPECT_EQ(300 - TELEMETRY_TIER_BUCKETS, history.getBucket(0, 0).meanY);
+    EXPECT_EQ(299, history.getBucket(0, TELEMETRY_TIER_BUCKETS - 1).meanY);
+}
+
+TEST(TelemetryHistoryTest, LongGapIsBoundedByRing) {
+    TelemetryHistory history;
+    history.add(0, 1.0f, 1.0f);
+    history.add(3000000, 2.0f, 2.0f);  // 50 min later
+
+    ASSERT_EQ((size_t)TELEMETRY_TIER_BUCKETS, history.getBucketCount(0));
+    EXPECT_EQ(3000000u, history.getEndTime(0));
+    for (size_t i = 0; i < TELEMETRY_TIER_BUCKETS; i++) {
+        EXPECT_TRUE(history.getBucket(0, i).isEmpty());
+    }
+    // The 1 min tier still holds the first minute, then 49 empty minutes
+    ASSERT_EQ(50u, history.getBucketCount(1));
+    EXPECT_EQ(100, history.getBucket(1, 0).meanY);
+    EXPECT_TRUE(history.getBucket(1, 49).isEmpty());
+}
+
+// ============================================================================
+// Test: Encoding
+// ============================================================================
+
+TEST(TelemetryHistoryTest, EncodesPackedLittleEndian) {
+    TelemetryHistory history;
+    history.add(0x12345000UL, -1.0f, 2.56f);
+    history.add(0x12345000UL + 2000, 0.0f, 0.0f);
+
+    uint8_t header[TELEMETRY_BINARY_HEADER_SIZE];
+    encodeTelemetryHeader(history, 0, header);
+    EXPECT_EQ(TELEMETRY_BINARY_VERSION, header[0]);
+    EXPECT_EQ(0, header[1]);
+    EXPECT_EQ(2, header[2] | (header[3] << 8));
+    EXPECT_EQ(1000u, (uint32_t)(header[4] | (header[5] << 8) | (header[6] << 16) | ((uint32_t)header[7] << 24)));
+    uint32_t end = header[8] | (header[9] << 8) | (header[10] << 16) | ((uint32_t)header[11] << 24);
+    EXPECT_EQ((uint32_t)history.getEndTime(0), end);
+
+    uint8_t packed[TELEMETRY_BINARY_BUCKET_SIZE];
+    encodeTelemetryBucket(history.getBucket(0, 0), packed);
+    EXPECT_EQ(-100, (int16_t)(packed[4] | (packed[5] << 8)));
+    EXPECT_EQ(256, (int16_t)(packed[10] | (packed[11] << 8)));
+    encodeTelemetryBucket(history.getBucket(0, 1), packed);
+    EXPECT_EQ(0x00, packed[4]);
+    EXPECT_EQ(0x80, packed[5]);
+}
+
+TEST(TelemetryHistoryTest, WritesJsonHeaderAndBuckets) {
+    TelemetryHistory history;
+    history.add(1000, -1.0f, 9.81f);
+    history.add(3000, 0.0f, 0.0f);
+
+    char buffer[TELEMETRY_JSON_HEADER_BUFFER_SIZE];
+    size_t n = writeTelemetryJsonHeader(buffer, sizeof(buffer), history, 0);
+    EXPECT_EQ("{\"tier\":0,\"periodMs\":1000,\"endMs\":3000,\"scale\":0.01,\"buckets\":[", std::string(buffer, n));
+
+    n = writeTelemetryBucketJson(buffer, sizeof(buffer), history.getBucket(0, 0));
+    EXPECT_EQ("[-100,-100,-100,981,981,981]", std::string(buffer, n));
+    n = writeTelemetryBucketJson(buffer, sizeof(buffer), history.getBucket(0, 1));
+    EXPECT_EQ("null", std::string(buffer, n));
+
+    // Worst case header and bucket fit their buffers
+    TelemetryHistory worst;
+    worst.add(0xFFFFFFFFUL - 7200000UL, -400.0f, -400.0f);
+    worst.add(0xFFFFFFFFUL, 0.0f, 0.0f);
+    EXPECT_GT(writeTelemetryJsonHeader(buffer, sizeof(buffer), worst, 2), 0u);
+    char bucketJson[TELEMETRY_BUCKET_JSON_BUFFER_SIZE];
+    EXPECT_GT(writeTelemetryBucketJson(bucketJson, sizeof(bucketJson), worst.getBucket(2, 0)), 0u);
+}
+
+TEST(TelemetryHistoryTest, WritesNewestBucketEventJson) {
+    TelemetryHistory history;
+    char buffer[TELEMETRY_BUCKET_EVENT_JSON_BUFFER_SIZE];
+    history.add(1000, -1.0f, 9.81f);
+    EXPECT_EQ(0u, writeTelemetryBucketEventJson(buffer, sizeof(buffer), history, 0));
+
+    history.add(2000, 0.5f, 9.0f);
+    size_t n = writeTelemetryBucketEventJson(buffer, sizeof(buffer), history, 0);
+    EXPECT_EQ("{\"tier\":0,\"periodMs\":1000,\"endMs\":2000,\"bucket\":[-100,-100,-100,981,981,981]}",
+              std::string(buffer, n));
+
+    // Skipped periods are empty; the event carries the newest of them
+    history.add(5000, 0.0f, 0.0f);
+    n = writeTelemetryBucketEventJson(buffer, sizeof(buffer), history, 0);
+    EXPECT_EQ("{\"tier\":0,\"periodMs\":1000,\"endMs\":5000,\"bucket\":null}", std::string(buffer, n));
+
+    // Worst case fits its buffer and still fails cleanly one byte short
+    TelemetryHistory worst;
+    worst.add(0xFFFFFFFFUL - 7200000UL, -400.0f, -400.0f);
+    worst.add(0xFFFFFFFFUL - 3600000UL, -400.0f, -400.0f);
+    n = writeTelemetryBucketEventJson(buffer, sizeof(buffer), worst, 2);
+    ASSERT_GT(n, 0u);
+    EXPECT_EQ(0u, writeTelemetryBucketEventJson(buffer, n, worst, 2));
+}
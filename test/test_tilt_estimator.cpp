@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "TiltEstimator.h"
+#include "DoorMonitor.h"
+#include "DoorTraceFixtures.h"
+
+#define IMU_PERIOD_MS 20   // SAMPLING_ACTIVE_RATE_HZ
+
+// Closed, open over 6 s, open, close over 6 s, closed
+static const TraceSegment IMU_CYCLE[] = {
+    {3000, 0, 0, 30, false},
+    {6000, 0, 90, 30, false},
+    {3000, 90, 90, 30, false},
+    {6000, 90, 0, 30, false},
+    {3000, 0, 0, 30, false}
+};
+#define IMU_CYCLE_COUNT (sizeof(IMU_CYCLE) / sizeof(IMU_CYCLE[0]))
+
+static std::vector<DoorTransition> runAngleMode(DoorMonitor& monitor, const std::vector<ImuTraceSample>& trace) {
+    TiltEstimator estimator;
+    std::vector<DoorTransition> transitions;
+    monitor.initializeAngle(TiltEstimator::accelAngle(trace[0].y, trace[0].z), trace[0].time);
+    for (size_t i = 0; i < trace.size(); i++) {
+        DoorAngleSample sample;
+        sample.valid = trace[i].valid;
+        if (sample.valid) {
+            estimator.update(trace[i].y, trace[i].z, trace[i].gyroRate, trace[i].time);
+        }
+        sample.angle = estimator.getAngle();
+        sample.rate = estimator.getRate();
+        DoorState before = monitor.getState();
+        DoorState after = monitor.updateStateAngle(sample, trace[i].time);
+        if (after != before) {
+            DoorTransition t = {trace[i].time, before, after};
+            transitions.push_back(t);
+        }
+    }
+    return transitions;
+}
+
+// Time of the first sample of segment index
+static unsigned long segmentStart(const TraceSegment* segments, size_t index, unsigned long periodMs) {
+    unsigned long time = 1000;  // synthesizeTrace start time
+    for (size_t s = 0; s < index; s++) {
+        time += segments[s].durationMs / periodMs * periodMs;
+    }
+    return time;
+}
+
+// ============================================================================
+// Test: TiltEstimator
+// ============================================================================
+
+TEST(TiltEstimatorTest, AccelAngleSpansClosedToOpen) {
+    EXPECT_NEAR(0.0f, TiltEstimator::accelAngle(9.8f, 0.0f), 0.01f);
+    EXPECT_NEAR(90.0f, TiltEstimator::accelAngle(0.0f, 9.8f), 0.01f);
+    EXPECT_NEAR(45.0f, TiltEstimator::accelAngle(6.93f, 6.93f), 0.01f);
+}
+
+TEST(TiltEstimatorTest, StartsAtAccelAngle) {
+    TiltEstimator estimator;
+    EXPECT_FALSE(estimator.isPrimed());
+    estimator.update(0.0f, 9.8f, 5.0f, 1000);
+    EXPECT_TRUE(estimator.isPrimed());
+    EXPECT_NEAR(90.0f, estimator.getAngle(), 0.01f);
+    EXPECT_FLOAT_EQ(5.0f, estimator.getRate());
+}
+
+TEST(TiltEstimatorTest, LearnsGyroBiasAtRest) {
+    static const TraceSegment rest[] = {{8000, 30, 30, 30, false}};
+    std::vector<ImuTraceSample> trace = synthesizeImuTrace(rest, 1, IMU_PERIOD_MS, 4.0f, 0.5f, 1);
+    TiltEstimator estimator;
+    for (size_t i = 0; i < trace.size(); i++) {
+        estimator.update(trace[i].y, trace[i].z, trace[i].gyroRate, trace[i].time);
+    }
+    EXPECT_NEAR(4.0f, estimator.getBias(), 0.3f);
+    EXPECT_NEAR(0.0f, estimator.getRate(), 0.8f);
+    EXPECT_NEAR(30.0f, estimator.getAngle(), 1.0f);
+}
+
+TEST(TiltEstimatorTest, GyroSignFlipsRate) {
+    TiltEstimator estimator(TILT_TIME_CONSTANT_MS, -1.0f);
+    estimator.update(9.8f, 0.0f, -12.0f, 1000);
+    EXPECT_FLOAT_EQ(12.0f, estimator.getRate());
+}
+
+TEST(TiltEstimatorTest, TracksSwing) {
+    std::vector<ImuTraceSample> trace = synthesizeImuTrace(IMU_CYCLE, IMU_CYCLE_COUNT, IMU_PERIOD_MS, 1.0f, 0.5f, 2);
+    TiltEstimator estimator;
+    unsigned long openingStart = segmentStart(IMU_CYCLE, 1, IMU_PERIOD_MS);
+    unsigned long openingEnd = segmentStart(IMU_CYCLE, 2, IMU_PERIOD_MS);
+    for (size_t i = 0; i < trace.size(); i++) {
+        estimator.update(trace[i].y, trace[i].z, trace[i].gyroRate, trace[i].time);
+        if (trace[i].time >= openingStart && trace[i].time < openingEnd) {
+            float expected = 90.0f * (trace[i].time - openingStart + IMU_PERIOD_MS) / (openingEnd - openingStart);
+            ASSERT_NEAR(expected, estimator.getAngle(), 2.0f) << "t=" << trace[i].time;
+            ASSERT_NEAR(15.0f, estimator.getRate(), 1.5f) << "t=" << trace[i].time;
+        }
+    }
+}
+
+TEST(TiltEstimatorTest, KnockBarelyMovesRate) {
+    TiltEstimator estimator;
+    unsigned long t = 1000;
+    for (int i = 0; i < 100; i++, t += IMU_PERIOD_MS) {
+        estimator.update(9.8f, 0.0f, 0.0f, t);
+    }
+    // One sample with 3 m/s^2 of vibration on Z (about 17 degrees of accel angle)
+    estimator.update(9.8f, 3.0f, 0.0f, t);
+    EXPECT_LT(estimator.getAngle(), 1.0f);
+    EXPECT_LT(estimator.getRate(), 0.5f);
+}
+
+TEST(TiltEstimatorTest, AccelOnlyRateStaysBelowThresholdAtRest) {
+    static const TraceSegment rest[] = {{20000, 0, 0, 30, false}};
+    std::vector<TraceSample> trace = synthesizeTrace(rest, 1, 200, 3);  // cycle mode at 5 Hz
+    TiltEstimator estimator;
+    for (size_t i = 0; i < trace.size(); i++) {
+        estimator.updateAccelOnly(trace[i].y, trace[i].z, trace[i].time);
+        ASSERT_LT(estimator.getRate() < 0 ? -estimator.getRate() : estimator.getRate(),
+                  DEFAULT_ANGLE_CONFIG.rateThreshold) << "t=" << trace[i].time;
+    }
+}
+
+TEST(TiltEstimatorTest, RestartsAfterLongGap) {
+    TiltEstimator estimator;
+    estimator.update(9.8f, 0.0f, 0.0f, 1000);
+    estimator.update(9.8f, 0.0f, 0.0f, 1020);
+    estimator.update(0.0f, 9.8f, 0.0f, 1020 + TILT_MAX_GAP_MS + 1);
+    EXPECT_NEAR(90.0f, estimator.getAngle(), 0.01f);
+    estimator.reset();
+    EXPECT_FALSE(estimator.isPrimed());
+}
+
+// ============================================================================
+// Test: DoorMonitor angle mode
+// ============================================================================
+
+TEST(DoorMonitorAngleTest, InitializesFromAngle) {
+    DoorMonitor monitor;
+    monitor.initializeAngle(2.0f, 0);
+    EXPECT_EQ(DOOR_CLOSED, monitor.getState());
+    monitor.initializeAngle(88.0f, 0);
+    EXPECT_EQ(DOOR_OPEN, monitor.getState());
+    monitor.initializeAngle(45.0f, 0);
+    EXPECT_EQ(DOOR_STOPPED, monitor.getState());
+}
+
+TEST(DoorMonitorAngleTest, DetectsMotionWithinTwoSamples) {
+    for (uint32_t seed = 1; seed <= 5; seed++) {
+        std::vector<ImuTraceSample> trace = synthesizeImuTrace(IMU_CYCLE, IMU_CYCLE_COUNT, IMU_PERIOD_MS, 1.5f, 0.5f, seed);
+        DoorMonitor monitor;
+        std::vector<DoorTransition> transitions = runAngleMode(monitor, trace);
+
+        ASSERT_EQ(4u, transitions.size()) << "seed " << seed;
+        EXPECT_EQ(DOOR_OPENING, transitions[0].to);
+        EXPECT_EQ(DOOR_OPEN, transitions[1].to);
+        EXPECT_EQ(DOOR_CLOSING, transitions[2].to);
+        EXPECT_EQ(DOOR_CLOSED, transitions[3].to);
+
+        unsigned long opening = segmentStart(IMU_CYCLE, 1, IMU_PERIOD_MS);
+        unsigned long open = segmentStart(IMU_CYCLE, 2, IMU_PERIOD_MS);
+        unsigned long closing = segmentStart(IMU_CYCLE, 3, IMU_PERIOD_MS);
+        unsigned long closed = segmentStart(IMU_CYCLE, 4, IMU_PERIOD_MS);
+        EXPECT_LT(transitions[0].time - opening, 2u * IMU_PERIOD_MS) << "seed " << seed;
+        EXPECT_LT(transitions[2].time - closing, 2u * IMU_PERIOD_MS) << "seed " << seed;
+        // Settles one stop timeout after the door comes to rest
+        EXPECT_LE(transitions[1].time - open, DEFAULT_ANGLE_CONFIG.stopTimeout + 2 * IMU_PERIOD_MS);
+        EXPECT_LE(transitions[3].time - closed, DEFAULT_ANGLE_CONFIG.stopTimeout + 2 * IMU_PERIOD_MS);
+    }
+}
+
+TEST(DoorMonitorAngleTest, SlowDoorHasNoFalseStops) {
+    // 90 degrees in 15 s: about 0.1 m/s^2 between 10 Hz accel samples near
+    // the end stops, well under accelThreshold
+    static const TraceSegment slow[] = {
+        {2000, 0, 0, 40, false},
+        {15000, 0, 90, 40, false},
+        {2000, 90, 90, 40, false}
+    };
+    for (uint32_t seed = 1; seed <= 5; seed++) {
+        std::vector<ImuTraceSample> trace = synthesizeImuTrace(slow, 3, IMU_PERIOD_MS, -1.0f, 0.8f, seed);
+        DoorMonitor monitor;
+        std::vector<DoorTransition> transitions = runAngleMode(monitor, trace);
+        ASSERT_EQ(2u, transitions.size()) << "seed " << seed;
+        EXPECT_EQ(DOOR_OPENING, transitions[0].to);
+        EXPECT_EQ(DOOR_OPEN, transitions[1].to);
+    }
+}
+
+TEST(DoorMonitorAngleTest, StopsMidTravelAndResumes) {
+    static const TraceSegment partial[] = {
+        {2000, 0, 0, 30, false},
+        {3000, 0, 45, 30, false},
+        {2000, 45, 45, 30, false},
+        {3000, 45, 90, 30, false},
+        {2000, 90, 90, 30, false}
+    };
+    std::vector<ImuTraceSample> trace = synthesizeImuTrace(partial, 5, IMU_PERIOD_MS, 0.5f, 0.5f, 4);
+    DoorMonitor monitor;
+    std::vector<DoorTransition> transitions = runAngleMode(monitor, trace);
+    ASSERT_EQ(4u, transitions.size());
+    EXPECT_EQ(DOOR_OPENING, transitions[0].to);
+    EXPECT_EQ(DOOR_STOPPED, transitions[1].to);
+    EXPECT_EQ(DOOR_OPENING, transitions[2].to);
+    EXPECT_EQ(DOOR_OPEN, transitions[3].to);
+    EXPECT_EQ(DOOR_OPENING, monitor.getLastMovementDirection());
+}
+
+TEST(DoorMonitorAngleTest, InvalidSamplesOnlyCountTowardsFailure) {
+    DoorMonitor monitor;
+    monitor.initializeAngle(0.0f, 0);
+    DoorAngleSample invalid = {0.0f, 0.0f, false};
+    for (unsigned long t = 20; t <= 80; t += 20) {
+        EXPECT_EQ(DOOR_CLOSED, monitor.updateStateAngle(invalid, t));
+    }
+    EXPECT_EQ(DOOR_ERROR_SENSOR_FAILURE, monitor.updateStateAngle(invalid, 100));
+    EXPECT_FALSE(monitor.isSensorHealthy());
+
+    DoorAngleSample valid = {0.0f, 0.0f, true};
+    EXPECT_EQ(DOOR_UNKNOWN, monitor.updateStateAngle(valid, 120));
+    EXPECT_EQ(DOOR_CLOSED, monitor.updateStateAngle(valid, 120 + DEFAULT_ANGLE_CONFIG.stopTimeout + 1));
+}
+
+TEST(DoorMonitorAngleTest, TimesOutWhenTravelNeverEnds) {
+    DoorMonitor monitor;
+    DoorMonitorConfig config = DEFAULT_CONFIG;
+    config.maxOpenTime = 1000;
+    monitor.setConfig(config);
+    monitor.initializeAngle(0.0f, 0);
+
+    DoorAngleSample moving = {10.0f, 10.0f, true};
+    EXPECT_EQ(DOOR_OPENING, monitor.updateStateAngle(moving, 20));
+    // Slowing below the threshold but not yet stopped, past maxOpenTime
+    DoorAngleSample slowing = {20.0f, 2.0f, true};
+    EXPECT_EQ(DOOR_ERROR_TIMEOUT, monitor.updateStateAngle(slowing, 1100));
+}
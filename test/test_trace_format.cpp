@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <string.h>
+#include "TraceFormat.h"
+#include "DoorTraceFixtures.h"
+
+// ============================================================================
+// Test: Header
+// ============================================================================
+
+TEST(TraceFormatTest, HeaderRoundTrips) {
+    TraceHeader header;
+    header.version = TRACE_VERSION;
+    header.range = ACCEL_RANGE_4G;
+    header.startTime = 123456789;
+    header.sampleCount = 42;
+
+    uint8_t bytes[TRACE_HEADER_SIZE];
+    encodeTraceHeader(header, bytes);
+    EXPECT_EQ(0, memcmp(bytes, "GDTR", 4));
+
+    TraceHeader decoded;
+    ASSERT_TRUE(decodeTraceHeader(bytes, sizeof(bytes), decoded));
+    EXPECT_EQ(ACCEL_RANGE_4G, decoded.range);
+    EXPECT_EQ(123456789u, decoded.startTime);
+    EXPECT_EQ(42u, decoded.sampleCount);
+}
+
+TEST(TraceFormatTest, RejectsBadHeaders) {
+    uint8_t bytes[TRACE_HEADER_SIZE] = {'G', 'D', 'T', 'X', TRACE_VERSION, 0};
+    TraceHeader header;
+    EXPECT_FALSE(decodeTraceHeader(bytes, sizeof(bytes), header));
+
+    memcpy(bytes, "GDTR", 4);
+    bytes[4] = TRACE_VERSION + 1;
+    EXPECT_FALSE(decodeTraceHeader(bytes, sizeof(bytes), header));
+    EXPECT_FALSE(decodeTraceHeader(bytes, 8, header));
+
+    TraceReader reader(bytes, 8);
+    TraceRecord record;
+    EXPECT_FALSE(reader.isValid());
+    EXPECT_FALSE(reader.next(record));
+}
+
+// ============================================================================
+// Test: Records
+// ============================================================================
+
+TEST(TraceFormatTest, RecordsRoundTrip) {
+    std::vector<TraceSample> trace = doorCycleTrace();
+    std::vector<uint8_t> bytes = encodeTrace(trace);
+    EXPECT_EQ(TRACE_HEADER_SIZE + trace.size() * TRACE_RECORD_SIZE, bytes.size());
+
+    TraceReader reader(&bytes[0], bytes.size());
+    ASSERT_TRUE(reader.isValid());
+    EXPECT_EQ(trace.size(), reader.getHeader().sampleCount);
+
+    TraceRecord record;
+    for (size_t i = 0; i < trace.size(); i++) {
+        ASSERT_TRUE(reader.next(record));
+        EXPECT_EQ(trace[i].time, record.time);
+        EXPECT_EQ(trace[i].valid, record.valid);
+        if (trace[i].valid) {
+            EXPECT_EQ(trace[i].x, record.accel.x);
+            EXPECT_EQ(trace[i].y, record.accel.y);
+            EXPECT_EQ(trace[i].z, record.accel.z);
+        }
+    }
+    EXPECT_FALSE(reader.next(record));
+}
+
+TEST(TraceFormatTest, EncodesLongGapsWithSkipRecords) {
+    TraceEncoder encoder(0);
+    uint8_t out[4 * TRACE_RECORD_SIZE];
+    TraceRecord record = {200000, {1, 2, 3}, true};
+
+    size_t n = encoder.encode(record, out, sizeof(out));
+    EXPECT_EQ(4u * TRACE_RECORD_SIZE, n);  // 3 skips of 65535 ms + the sample
+
+    std::vector<uint8_t> bytes(TRACE_HEADER_SIZE);
+    TraceHeader header = {TRACE_VERSION, ACCEL_RANGE_8G, 0, 1};
+    encodeTraceHeader(header, &bytes[0]);
+    bytes.insert(bytes.end(), out, out + n);
+
+    TraceReader reader(&bytes[0], bytes.size());
+    TraceRecord decoded;
+    ASSERT_TRUE(reader.next(decoded));
+    EXPECT_EQ(200000u, decoded.time);
+    EXPECT_EQ(3, decoded.accel.z);
+    EXPECT_FALSE(reader.next(decoded));
+}
+
+TEST(TraceFormatTest, EncodeFailsWhenOutputTooSmall) {
+    TraceEncoder encoder(0);
+    uint8_t out[TRACE_RECORD_SIZE];
+    TraceRecord record = {70000, {1, 2, 3}, true};
+    EXPECT_EQ(0u, encoder.encode(record, out, sizeof(out)));
+}
+
+// ============================================================================
+// Test: Replay through DoorMonitor
+// ============================================================================
+
+TEST(TraceFormatTest, BatchReplayMatchesDirectFeed) {
+    std::vector<TraceSample> trace = randomDoorTrace(100, 5);
+    std::vector<uint8_t> bytes = encodeTrace(trace);
+
+    DoorMonitor direct;
+    DoorMonitor replayed;
+    direct.initialize(9.8f, 0.0f, trace[0].time);
+    replayed.initialize(9.8f, 0.0f, trace[0].time);
+
+    size_t directTransitions = 0;
+    for (size_t i = 0; i < trace.size(); i++) {
+        TraceRecord r = {trace[i].time, {trace[i].x, trace[i].y, trace[i].z}, trace[i].valid};
+        DoorState before = direct.getState();
+        if (direct.updateState(traceRecordToAccel(r, ACCEL_RANGE_8G), r.time) != before) {
+            directTransitions++;
+        }
+    }
+
+    TraceReader reader(&bytes[0], bytes.size());
+    AccelData samples[64];
+    unsigned long times[64];
+    size_t replayTransitions = 0;
+    size_t n;
+    while ((n = reader.nextBatch(samples, times, 64)) > 0) {
+        replayTransitions += replayed.updateStateBatch(samples, times, n, NULL, 0);
+    }
+
+    EXPECT_GT(directTransitions, 0u);
+    EXPECT_EQ(directTransitions, replayTransitions);
+    EXPECT_EQ(direct.getState(), replayed.getState());
+}
@@ -0,0 +1,61 @@
+"""Convert a CSV sensor capture to the binary .gdt trace format.
+
+Input rows: time_ms,x,y,z with raw MPU-6050 counts; an empty x/y/z field marks a
+failed read. Lines starting with '#' and a non-numeric header row are skipped.
+
+    python3 tools/csv_to_trace.py capture.csv capture.gdt [--range 8]
+
+See include/TraceFormat.h for the layout.
+"""
+
+import argparse
+import csv
+import struct
+
+RANGES = {2: 0, 4: 1, 8: 2, 16: 3}
+DELTA_SKIP = 0xFFFF
+INVALID = -32768
+
+
+def read_rows(path):
+    with open(path, newline="") as f:
+        for row in csv.reader(f):
+            if not row or row[0].startswith("#"):
+                continue
+            try:
+                time = int(row[0])
+            except ValueError:
+                continue
+            values = row[1:4]
+            if len(values) == 3 and all(v.strip() for v in values):
+                yield time, [int(v) for v in values]
+            else:
+                yield time, None
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("source")
+    parser.add_argument("target")
+    parser.add_argument("--range", type=int, default=8, choices=sorted(RANGES), help="accelerometer range in g")
+    args = parser.parse_args()
+
+    rows = list(read_rows(args.source))
+    start = rows[0][0] if rows else 0
+    with open(args.target, "wb") as out:
+        out.write(b"GDTR" + struct.pack("<BBHII", 1, RANGES[args.range], 0, start & 0xFFFFFFFF, len(rows)))
+        last = start
+        for time, xyz in rows:
+            delta = time - last
+            if delta < 0:
+                raise SystemExit("timestamps must not go backwards (at %d)" % time)
+            while delta >= DELTA_SKIP:
+                out.write(struct.pack("<Hhhh", DELTA_SKIP, 0, 0, 0))
+                delta -= DELTA_SKIP
+            out.write(struct.pack("<Hhhh", delta, *(xyz if xyz is not None else [INVALID] * 3)))
+            last = time
+    print("%s: %d samples" % (args.target, len(rows)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,74 @@
+"""Gzip web/index.html into include/IndexHtml.h as a PROGMEM byte array.
+
+Runs automatically before the d1 build (extra_scripts = pre:tools/embed_web.py)
+and can be run by hand: python3 tools/embed_web.py
+The output is deterministic (no gzip timestamp), so the ETag only changes when
+the page does.
+"""
+
+import gzip
+import hashlib
+import io
+import os
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCE = os.path.join(PROJECT_DIR, "web", "index.html")
+TARGET = os.path.join(PROJECT_DIR, "include", "IndexHtml.h")
+
+
+def gzip_bytes(data):
+    out = io.BytesIO()
+    with gzip.GzipFile(filename="", mode="wb", compresslevel=9, fileobj=out, mtime=0) as f:
+        f.write(data)
+    return out.getvalue()
+
+
+def render_header(compressed, etag, source_size):
+    lines = [
+        "// Generated by tools/embed_web.py from web/index.html - do not edit.",
+        "#ifndef INDEX_HTML_H",
+        "#define INDEX_HTML_H",
+        "",
+        "#include <stdint.h>",
+        "#include <stddef.h>",
+        "",
+        "#ifndef PROGMEM",
+        "#define PROGMEM",
+        "#endif",
+        "",
+        "// %d bytes uncompressed" % source_size,
+        "#define INDEX_HTML_ETAG \"\\\"%s\\\"\"" % etag,
+        "",
+        "const size_t INDEX_HTML_GZ_LEN = %d;" % len(compressed),
+        "const uint8_t INDEX_HTML_GZ[] PROGMEM = {",
+    ]
+    for i in range(0, len(compressed), 16):
+        chunk = compressed[i:i + 16]
+        lines.append("  " + ", ".join("0x%02x" % b for b in chunk) + ",")
+    lines += ["};", "", "#endif // INDEX_HTML_H", ""]
+    return "\n".join(lines)
+
+
+def main():
+    with open(SOURCE, "rb") as f:
+        html = f.read()
+    compressed = gzip_bytes(html)
+    etag = hashlib.sha256(compressed).hexdigest()[:16]
+    header = render_header(compressed, etag, len(html))
+
+    existing = None
+    if os.path.exists(TARGET):
+        with open(TARGET, "r") as f:
+            existing = f.read()
+    if existing != header:
+        with open(TARGET, "w") as f:
+            f.write(header)
+        print("embed_web: %s -> %d bytes gzip, ETag %s" % (os.path.relpath(SOURCE, PROJECT_DIR), len(compressed), etag))
+
+
+main()
@@ -0,0 +1,166 @@
+// Replay a recorded .gdt sensor trace through DoorMonitor on the host.
+//
+//   pio run -e replay
+//   .pio/build/replay/program [-q] [-a] [-t tolerance] [-f filter] capture.gdt [more.gdt ...]
+//
+// Prints every state transition with its timestamp, then the sample count and
+// throughput, and how many samples fall in the closed / open / intermediate
+// position windows. -t overrides positionTolerance (m/s^2) for both. -f runs
+// the samples through a noise filter first (none, median3, median5, average4,
+// exponential2; see SampleFilter.h) to compare transition counts. -a turns on
+// early arrival detection (DEFAULT_ARRIVAL_CONFIG) as the firmware does. The file
+// is memory-mapped so multi-gigabyte captures stream without being read into
+// memory.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <chrono>
+#include "DoorMonitor.h"
+#include "PositionClassifier.h"
+#include "SampleFilter.h"
+#include "TraceFormat.h"
+
+#define REPLAY_BATCH_SIZE 256
+#define REPLAY_MAX_TRANSITIONS REPLAY_BATCH_SIZE
+
+static bool replayTrace(const char* path, const DoorMonitorConfig& config, const DoorArrivalConfig& arrival,
+                        SampleFilterKind filterKind, bool quiet) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    fprintf(stderr, "%s: cannot open\n", path);
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < TRACE_HEADER_SIZE) {
+    fprintf(stderr, "%s: not a trace file\n", path);
+    close(fd);
+    return false;
+  }
+
+  size_t size = (size_t)st.st_size;
+  void* mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    fprintf(stderr, "%s: mmap failed\n", path);
+    return false;
+  }
+  madvise(mapped, size, MADV_SEQUENTIAL);
+
+  TraceReader reader((const uint8_t*)mapped, size);
+  if (!reader.isValid()) {
+    fprintf(stderr, "%s: bad trace header\n", path);
+    munmap(mapped, size);
+    return false;
+  }
+
+  static AccelData samples[REPLAY_BATCH_SIZE];
+  static unsigned long times[REPLAY_BATCH_SIZE];
+  static DoorTransition transitions[REPLAY_MAX_TRANSITIONS];
+  static float accelY[REPLAY_BATCH_SIZE];
+  static float accelZ[REPLAY_BATCH_SIZE];
+  static uint32_t closedMask[REPLAY_BATCH_SIZE / POSITION_MASK_BITS];
+  static uint32_t openMask[REPLAY_BATCH_SIZE / POSITION_MASK_BITS];
+
+  DoorMonitor monitor(config);
+  monitor.setArrivalConfig(arrival);
+  SelectableSampleFilter filter(filterKind);
+  bool initialized = false;
+  size_t sampleCount = 0;
+  size_t transitionCount = 0;
+  size_t closedCount = 0;
+  size_t openCount = 0;
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  size_t n;
+  while ((n = reader.nextBatch(samples, times, REPLAY_BATCH_SIZE)) > 0) {
+    filter.applyBatch(samples, n);
+    for (size_t i = 0; i < n; i++) {
+      accelY[i] = samples[i].y;
+      accelZ[i] = samples[i].z;
+    }
+    classifyPositions(accelY, accelZ, n, config, closedMask, openMask, NULL);
+    closedCount += countPositions(closedMask, n);
+    openCount += countPositions(openMask, n);
+
+    size_t first = 0;
+    if (!initialized) {
+      // Take the first valid reading as the starting position, as setup() does on the device
+      while (first < n && !samples[first].valid) {
+        first++;
+      }
+      if (first == n) {
+        continue;
+      }
+      monitor.initialize(samples[first].y, samples[first].z, times[first]);
+      initialized = true;
+      if (!quiet) {
+        printf("%10lu  initial %s\n", times[first], monitor.getStateString());
+      }
+    }
+
+    size_t count = monitor.updateStateBatch(samples + first, times + first, n - first,
+                                            transitions, REPLAY_MAX_TRANSITIONS);
+    if (!quiet) {
+      for (size_t i = 0; i < count && i < REPLAY_MAX_TRANSITIONS; i++) {
+        printf("%10lu  %s -> %s\n", transitions[i].time,
+               doorStateName(transitions[i].from),
+               doorStateName(transitions[i].to));
+      }
+    }
+    transitionCount += count;
+    sampleCount += n;
+  }
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  printf("%s: %zu samples, %zu transitions (filter %s), %.3f s, %.1f M samples/s\n",
+         path, sampleCount, transitionCount, sampleFilterName(filterKind), seconds,
+         seconds > 0 ? sampleCount / seconds / 1e6 : 0.0);
+  printf("%s: tolerance %.2f: %zu closed, %zu open, %zu intermediate (%s)\n",
+         path, config.positionTolerance, closedCount, openCount,
+         sampleCount - closedCount - openCount, positionClassifierImpl());
+
+  munmap(mapped, size);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  DoorMonitorConfig config = DEFAULT_CONFIG;
+  DoorArrivalConfig arrival = {0, 0, 0};
+  SampleFilterKind filterKind = SAMPLE_FILTER_NONE;
+  bool quiet = false;
+  int firstFile = 1;
+  while (firstFile < argc && argv[firstFile][0] == '-') {
+    if (strcmp(argv[firstFile], "-q") == 0) {
+      quiet = true;
+      firstFile++;
+    } else if (strcmp(argv[firstFile], "-a") == 0) {
+      arrival = DEFAULT_ARRIVAL_CONFIG;
+      firstFile++;
+    } else if (strcmp(argv[firstFile], "-t") == 0 && firstFile + 1 < argc) {
+      config.positionTolerance = (float)atof(argv[firstFile + 1]);
+      firstFile += 2;
+    } else if (strcmp(argv[firstFile], "-f") == 0 && firstFile + 1 < argc &&
+               sampleFilterFromName(argv[firstFile + 1], filterKind)) {
+      firstFile += 2;
+    } else {
+      break;
+    }
+  }
+  if (firstFile >= argc || argv[firstFile][0] == '-') {
+    fprintf(stderr, "usage: %s [-q] [-a] [-t tolerance] [-f filter] trace.gdt [...]\n", argv[0]);
+    return 2;
+  }
+
+  bool ok = true;
+  for (int i = firstFile; i < argc; i++) {
+    ok = replayTrace(argv[i], config, arrival, filterKind, quiet) && ok;
+  }
+  return ok ? 0 : 1;
+}
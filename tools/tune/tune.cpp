@@ -0,0 +1,210 @@
+// Sweep a grid of DoorMonitorConfig values over labeled traces on all cores.
+//
+//   pio run -e tune
+//   .pio/build/tune/program [-j threads] [-n top] [-w window_ms] [-e early_ms]
+//       [-f filter] -s threshold=0.3:0.8:0.05 -s tolerance=0.5:1.5:0.25 capture.gdt [...]
+//
+// Each capture.gdt needs a capture.labels file next to it (format in
+// include/ConfigSweep.h). Sweepable parameters: threshold, stop, maxopen,
+// maxclose, stall, stalltime, tolerance; everything else stays at
+// DEFAULT_CONFIG. -f runs the samples through a noise filter from
+// SampleFilter.h first (none, median3, median5, average4, exponential2).
+// Prints the best configs by transition accuracy, then mean detection
+// latency, with the number of spurious (unlabeled) transitions.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ConfigSweep.h"
+#include "SampleFilter.h"
+#include "TraceFormat.h"
+
+#define TUNE_DEFAULT_TOP 10
+
+// Map a whole file read-only; NULL on failure
+static const uint8_t* mapFile(const char* path, size_t& size) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return NULL;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return NULL;
+  }
+  size = (size_t)st.st_size;
+  void* mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  return mapped == MAP_FAILED ? NULL : (const uint8_t*)mapped;
+}
+
+static std::string labelPath(const char* tracePath) {
+  std::string path(tracePath);
+  size_t dot = path.rfind('.');
+  size_t slash = path.rfind('/');
+  if (dot != std::string::npos && (slash == std::string::npos || dot > slash)) {
+    path.erase(dot);
+  }
+  return path + ".labels";
+}
+
+static bool loadLabeledTrace(const char* path, SampleFilterKind filterKind, LabeledTrace& trace) {
+  size_t size = 0;
+  const uint8_t* data = mapFile(path, size);
+  if (!data) {
+    fprintf(stderr, "%s: cannot read\n", path);
+    return false;
+  }
+  TraceReader reader(data, size);
+  if (!reader.isValid()) {
+    fprintf(stderr, "%s: bad trace header\n", path);
+    munmap((void*)data, size);
+    return false;
+  }
+  // Decode once; every worker reads these arrays
+  AccelData samples[256];
+  unsigned long times[256];
+  SelectableSampleFilter filter(filterKind);
+  size_t n;
+  while ((n = reader.nextBatch(samples, times, 256)) > 0) {
+    filter.applyBatch(samples, n);
+    trace.samples.insert(trace.samples.end(), samples, samples + n);
+    trace.times.insert(trace.times.end(), times, times + n);
+  }
+  munmap((void*)data, size);
+
+  std::string labels = labelPath(path);
+  const uint8_t* text = mapFile(labels.c_str(), size);
+  if (!text) {
+    fprintf(stderr, "%s: cannot read labels\n", labels.c_str());
+    return false;
+  }
+  size_t errorLine = 0;
+  bool ok = parseTraceLabels((const char*)text, size, trace.labels, &errorLine);
+  munmap((void*)text, size);
+  if (!ok) {
+    fprintf(stderr, "%s:%zu: bad label\n", labels.c_str(), errorLine);
+  }
+  return ok;
+}
+
+// name=first:last:step
+static bool parseAxis(const char* spec, SweepAxis& axis) {
+  const char* eq = strchr(spec, '=');
+  if (!eq) {
+    return false;
+  }
+  std::string name(spec, eq - spec);
+  if (!sweepParamFromName(name.c_str(), axis.param)) {
+    return false;
+  }
+  return sscanf(eq + 1, "%f:%f:%f", &axis.first, &axis.last, &axis.step) == 3 &&
+         axis.step > 0 && axis.last >= axis.first;
+}
+
+static void usage(const char* program) {
+  fprintf(stderr, "usage: %s [-j threads] [-n top] [-w window_ms] [-e early_ms] [-f filter] "
+                  "-s param=first:last:step [...] trace.gdt [...]\n", program);
+}
+
+int main(int argc, char** argv) {
+  unsigned threads = 0;
+  size_t top = TUNE_DEFAULT_TOP;
+  SweepOptions options;
+  SampleFilterKind filterKind = SAMPLE_FILTER_NONE;
+  std::vector<SweepAxis> axes;
+  std::vector<const char*> paths;
+
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+    if (strcmp(argv[i], "-j") == 0 && hasValue) {
+      threads = (unsigned)atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0 && hasValue) {
+      top = (size_t)atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-w") == 0 && hasValue) {
+      options.matchWindowMs = (unsigned long)atol(argv[++i]);
+    } else if (strcmp(argv[i], "-e") == 0 && hasValue) {
+      options.earlyToleranceMs = (unsigned long)atol(argv[++i]);
+    } else if (strcmp(argv[i], "-f") == 0 && hasValue) {
+      if (!sampleFilterFromName(argv[++i], filterKind)) {
+        fprintf(stderr, "unknown filter: %s\n", argv[i]);
+        return 2;
+      }
+    } else if (strcmp(argv[i], "-s") == 0 && hasValue) {
+      SweepAxis axis;
+      if (!parseAxis(argv[++i], axis)) {
+        fprintf(stderr, "bad sweep axis: %s\n", argv[i]);
+        return 2;
+      }
+      axes.push_back(axis);
+    } else if (argv[i][0] == '-') {
+      usage(argv[0]);
+      return 2;
+    } else {
+      paths.push_back(argv[i]);
+    }
+  }
+  if (paths.empty()) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::vector<LabeledTrace> traces(paths.size());
+  size_t totalSamples = 0;
+  for (size_t i = 0; i < paths.size(); i++) {
+    if (!loadLabeledTrace(paths[i], filterKind, traces[i])) {
+      return 1;
+    }
+    totalSamples += traces[i].samples.size();
+  }
+
+  std::vector<DoorMonitorConfig> grid = buildConfigGrid(DEFAULT_CONFIG, axes);
+  if (threads == 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+  printf("%zu traces, %zu samples, %zu configs, %u threads, filter %s\n",
+         traces.size(), totalSamples, grid.size(), threads, sampleFilterName(filterKind));
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  std::vector<SweepScore> scores;
+  runConfigSweep(traces, grid, options, threads, scores);
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::vector<size_t> order(grid.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return sweepScoreBetter(scores[a], scores[b]);
+  });
+
+  printf("%8s %9s %9s %9s %9s %9s", "accuracy", "matched", "detected", "spurious", "mean ms", "max ms");
+  for (size_t a = 0; a < axes.size(); a++) {
+    printf(" %10s", sweepParamName(axes[a].param));
+  }
+  printf("\n");
+  for (size_t r = 0; r < order.size() && r < top; r++) {
+    const SweepScore& s = scores[order[r]];
+    char matched[32];
+    snprintf(matched, sizeof(matched), "%zu/%zu", s.matched, s.expected);
+    printf("%8.4f %9s %9zu %9zu %9.1f %9lu", s.accuracy(), matched, s.detected, s.detected - s.matched,
+           s.meanLatency(), s.maxLatency);
+    for (size_t a = 0; a < axes.size(); a++) {
+      printf(" %10g", getSweepParam(grid[order[r]], axes[a].param));
+    }
+    printf("\n");
+  }
+
+  printf("%.2f s, %.1f M samples/s\n", seconds,
+         seconds > 0 ? (double)totalSamples * grid.size() / seconds / 1e6 : 0.0);
+  return 0;
+}